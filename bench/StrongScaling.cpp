@@ -0,0 +1,62 @@
+#include "../src/matrix.h"
+#include "../src/Parallel/threadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Strong scaling of the matrix product: fixed problem size, growing thread count.
+// Usage: MatrixStrongScaling [size] [max threads] [repetitions]
+int main(int argc, char **argv)
+{
+    const std::size_t tSize = argc > 1 ? std::stoul(argv[1]) : 2048;
+    const std::size_t tMaxThreads = argc > 2 ? std::stoul(argv[2]) : std::max(1U, std::thread::hardware_concurrency());
+    const std::size_t tRepetitions = argc > 3 ? std::stoul(argv[3]) : 3;
+
+    auto tLhs = Matrix<double>::create(Row{tSize}, Column{tSize});
+    auto tRhs = Matrix<double>::create(Row{tSize}, Column{tSize});
+    std::mt19937 tRng(42);
+    std::uniform_real_distribution<double> tDist(-1.0, 1.0);
+    for (auto &tElem : tLhs.getData())
+        tElem = tDist(tRng);
+    for (auto &tElem : tRhs.getData())
+        tElem = tDist(tRng);
+
+    std::vector<std::size_t> tThreadCounts;
+    for (std::size_t tThreads = 1; tThreads < tMaxThreads; tThreads *= 2)
+        tThreadCounts.push_back(tThreads);
+    tThreadCounts.push_back(tMaxThreads);
+
+    std::printf("%8s %12s %10s %10s %10s\n", "threads", "seconds", "GFLOP/s", "speedup", "efficiency");
+
+    double tBaseline{0.0};
+    for (const auto tThreads : tThreadCounts)
+    {
+        Parallel::ThreadPool tPool{tThreads};
+        multiply(tLhs, tRhs, tPool); // warm up pack buffers and workers
+
+        double tBest{1e300};
+        for (std::size_t r = 0; r < tRepetitions; r++)
+        {
+            const auto tStart = std::chrono::steady_clock::now();
+            auto tResult = multiply(tLhs, tRhs, tPool);
+            const auto tStop = std::chrono::steady_clock::now();
+            tBest = std::min(tBest, std::chrono::duration<double>(tStop - tStart).count());
+        }
+
+        if (tBaseline == 0.0)
+            tBaseline = tBest;
+
+        const double tFlops = 2.0 * static_cast<double>(tSize) * static_cast<double>(tSize) * static_cast<double>(tSize);
+        const double tSpeedup = tBaseline / tBest;
+        std::printf("%8zu %12.4f %10.2f %10.2f %9.1f%%\n", tThreads, tBest, tFlops / tBest * 1e-9, tSpeedup,
+                    100.0 * tSpeedup / static_cast<double>(tThreads));
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,293 @@
+#pragma once
+
+#include "../matrix.h"
+#include "../Parallel/threadPool.h"
+#include "../Types/column.h"
+#include "../Types/half.h"
+#include "../Types/row.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace Io
+{
+    struct CsvSettings
+    {
+        // ' ' or '\t' separate fields by any run of blanks; any other character separates
+        // fields one to one.
+        char m_Delimiter{','};
+        // Lines skipped before the data, e.g. a header.
+        std::size_t m_SkipLines{0};
+        // Unit of the buffered reads and of the parallel parse; a chunk grows to hold at least
+        // one whole line.
+        std::size_t m_ChunkBytes{1UL << 20};
+    };
+
+    namespace Detail
+    {
+        // A run of whole lines and the matrix row of its first non blank line.
+        struct CsvChunk
+        {
+            std::uint64_t m_Offset;
+            std::size_t m_Size;
+            std::size_t m_FirstRow;
+        };
+
+        struct CsvLayout
+        {
+            std::vector<CsvChunk> m_Chunks;
+            std::size_t m_Rows{0};
+            std::size_t m_Cols{0};
+            std::size_t m_SkipLines{0};
+        };
+
+        inline bool isBlank(char xChar) noexcept { return xChar == ' ' || xChar == '\t' || xChar == '\r'; }
+
+        inline const char *skipBlanks(const char *xBegin, const char *xEnd) noexcept
+        {
+            while (xBegin != xEnd && isBlank(*xBegin))
+                ++xBegin;
+            return xBegin;
+        }
+
+        inline const char *lineEnd(const char *xBegin, const char *xEnd) noexcept
+        {
+            const auto *tNewline = static_cast<const char *>(std::memchr(xBegin, '\n', static_cast<std::size_t>(xEnd - xBegin)));
+            return tNewline ? tNewline : xEnd;
+        }
+
+        inline std::size_t countFields(const char *xBegin, const char *xEnd, char xDelimiter) noexcept
+        {
+            if (xDelimiter == ' ' || xDelimiter == '\t')
+            {
+                std::size_t tFields{0};
+                for (const char *p = skipBlanks(xBegin, xEnd); p != xEnd; p = skipBlanks(p, xEnd), tFields++)
+                    while (p != xEnd && !isBlank(*p))
+                        ++p;
+                return tFields;
+            }
+            return 1 + static_cast<std::size_t>(std::count(xBegin, xEnd, xDelimiter));
+        }
+
+        // Records xLines, whole lines starting at byte xOffset, as one chunk: drops the lines
+        // still to be skipped, counts the non blank ones and takes the column count from the
+        // first of them.
+        inline void addCsvChunk(std::string_view xLines, std::uint64_t xOffset, char xDelimiter, CsvLayout &xLayout) noexcept
+        {
+            const char *tBegin = xLines.data(), *tEnd = xLines.data() + xLines.size();
+            for (; xLayout.m_SkipLines > 0 && tBegin != tEnd; xLayout.m_SkipLines--)
+            {
+                const char *tNext = lineEnd(tBegin, tEnd);
+                xOffset += static_cast<std::uint64_t>(tNext - tBegin) + (tNext != tEnd);
+                tBegin = tNext == tEnd ? tEnd : tNext + 1;
+            }
+            if (tBegin == tEnd)
+                return;
+
+            const std::size_t tFirstRow = xLayout.m_Rows;
+            for (const char *p = tBegin; p != tEnd;)
+            {
+                const char *tNext = lineEnd(p, tEnd);
+                if (skipBlanks(p, tNext) != tNext)
+                {
+                    if (xLayout.m_Rows == 0)
+                        xLayout.m_Cols = countFields(p, tNext, xDelimiter);
+                    xLayout.m_Rows++;
+                }
+                p = tNext == tEnd ? tEnd : tNext + 1;
+            }
+            xLayout.m_Chunks.push_back({xOffset, static_cast<std::size_t>(tEnd - tBegin), tFirstRow});
+        }
+
+        template <typename T>
+        std::from_chars_result parseField(const char *xBegin, const char *xEnd, T &xValue) noexcept
+        {
+            // from_chars accepts a leading '-' but not '+'.
+            if (xBegin != xEnd && *xBegin == '+' && xEnd - xBegin > 1 && xBegin[1] != '-')
+                ++xBegin;
+            if constexpr (gIsFloat16<T>)
+            {
+                float tValue{};
+                const auto tResult = std::from_chars(xBegin, xEnd, tValue);
+                xValue = T{tValue};
+                return tResult;
+            }
+            else
+            {
+                return std::from_chars(xBegin, xEnd, xValue);
+            }
+        }
+
+        // Parses one line of exactly xCols fields into xRow.
+        template <typename T>
+        bool parseCsvLine(const char *xBegin, const char *xEnd, char xDelimiter, T *xRow, std::size_t xCols) noexcept
+        {
+            const bool tBlankDelimiter = xDelimiter == ' ' || xDelimiter == '\t';
+            const char *p = xBegin;
+            for (std::size_t j = 0; j < xCols; j++)
+            {
+                p = skipBlanks(p, xEnd);
+                const auto [tNext, tError] = parseField(p, xEnd, xRow[j]);
+                if (tError != std::errc{})
+                    return false;
+                p = tNext;
+                if (j + 1 == xCols)
+                    break;
+                if (tBlankDelimiter)
+                {
+                    if (p == xEnd || !isBlank(*p))
+                        return false;
+                }
+                else
+                {
+                    p = skipBlanks(p, xEnd);
+                    if (p == xEnd || *p != xDelimiter)
+                        return false;
+                    ++p;
+                }
+            }
+            return skipBlanks(p, xEnd) == xEnd;
+        }
+
+        // Parses the lines of one chunk into rows xChunk.m_FirstRow, ... of xResult.
+        template <typename T>
+        bool parseCsvChunk(const char *xBegin, const char *xEnd, const CsvChunk &xChunk, char xDelimiter, Matrix<T> &xResult) noexcept
+        {
+            const std::size_t tRows = xResult.getRows().get(), tCols = xResult.getCols().get();
+            std::size_t tRow = xChunk.m_FirstRow;
+            for (const char *p = xBegin; p != xEnd;)
+            {
+                const char *tNext = lineEnd(p, xEnd);
+                if (skipBlanks(p, tNext) != tNext)
+                {
+                    if (tRow >= tRows || !parseCsvLine(p, tNext, xDelimiter, xResult.getRow(tRow).data(), tCols))
+                        return false;
+                    tRow++;
+                }
+                p = tNext == xEnd ? xEnd : tNext + 1;
+            }
+            return true;
+        }
+
+        // Parses every chunk of xLayout, in parallel on xExecutor when there are several.
+        // xChunkText(chunk, buffer) returns the text of a chunk, read into buffer if needed.
+        template <typename T, typename ChunkText>
+        std::optional<Matrix<T>> parseCsvChunks(const CsvLayout &xLayout, const CsvSettings &xSettings, Parallel::Executor &xExecutor, const ChunkText &xChunkText)
+        {
+            auto tResult = Matrix<T>::create(Row{xLayout.m_Rows}, Column{xLayout.m_Rows == 0 ? 0 : xLayout.m_Cols});
+            std::atomic<bool> tFailed{false};
+            auto tParse = [&](std::size_t xChunk)
+            {
+                thread_local std::vector<char> tBuffer;
+                const auto &tChunk = xLayout.m_Chunks[xChunk];
+                const std::optional<std::string_view> tText = tFailed.load(std::memory_order_relaxed) ? std::nullopt : xChunkText(tChunk, tBuffer);
+                if (!tText || !parseCsvChunk(tText->data(), tText->data() + tText->size(), tChunk, xSettings.m_Delimiter, tResult))
+                    tFailed.store(true, std::memory_order_relaxed);
+            };
+            if (xLayout.m_Chunks.size() > 1 && xExecutor.concurrency() > 1)
+                xExecutor.parallelFor(xLayout.m_Chunks.size(), tParse);
+            else
+                for (std::size_t c = 0; c < xLayout.m_Chunks.size(); c++)
+                    tParse(c);
+            if (tFailed.load())
+                return std::nullopt;
+            return tResult;
+        }
+    } // namespace Detail
+
+    // Parses numeric CSV (or blank separated) text into a Matrix<T> with std::from_chars.
+    // A first pass finds line boundaries and counts rows with memchr; the second parses
+    // m_ChunkBytes sized runs of lines in parallel on xExecutor, straight into the rows of the
+    // result. Blank lines are ignored. Fields may not be quoted. std::nullopt if a field is not
+    // a number of type T or a row has a different number of fields than the first one.
+    template <typename T>
+    std::optional<Matrix<T>> parseCsv(std::string_view xText, const CsvSettings &xSettings, Parallel::Executor &xExecutor)
+    {
+        Detail::CsvLayout tLayout;
+        tLayout.m_SkipLines = xSettings.m_SkipLines;
+        const std::size_t tChunkBytes = std::max<std::size_t>(xSettings.m_ChunkBytes, 1);
+        for (std::size_t tOffset = 0; tOffset < xText.size();)
+        {
+            std::size_t tEnd = std::min(xText.size(), tOffset + tChunkBytes);
+            tEnd = Detail::lineEnd(xText.data() + tEnd - 1, xText.data() + xText.size()) - xText.data();
+            tEnd = std::min(xText.size(), tEnd + 1);
+            Detail::addCsvChunk(xText.substr(tOffset, tEnd - tOffset), tOffset, xSettings.m_Delimiter, tLayout);
+            tOffset = tEnd;
+        }
+        return Detail::parseCsvChunks<T>(tLayout, xSettings, xExecutor, [&](const Detail::CsvChunk &xChunk, std::vector<char> &)
+                                         { return std::optional<std::string_view>{xText.substr(static_cast<std::size_t>(xChunk.m_Offset), xChunk.m_Size)}; });
+    }
+
+    template <typename T>
+    std::optional<Matrix<T>> parseCsv(std::string_view xText, const CsvSettings &xSettings = {})
+    {
+        return parseCsv<T>(xText, xSettings, Parallel::defaultExecutor());
+    }
+
+    // parseCsv() on a file. Both passes read it in m_ChunkBytes sized pieces, so the extra
+    // memory is one chunk per thread plus 24 bytes per chunk, whatever the file size.
+    // std::nullopt also if the file cannot be read.
+    template <typename T>
+    std::optional<Matrix<T>> readCsv(const std::string &xPath, const CsvSettings &xSettings, Parallel::Executor &xExecutor)
+    {
+        std::ifstream tFile{xPath, std::ios::binary};
+        if (!tFile)
+            return std::nullopt;
+
+        Detail::CsvLayout tLayout;
+        tLayout.m_SkipLines = xSettings.m_SkipLines;
+        std::vector<char> tBuffer(std::max<std::size_t>(xSettings.m_ChunkBytes, 1));
+        std::uint64_t tOffset{0};
+        std::size_t tFilled{0};
+        for (bool tEof = false; !tEof || tFilled > 0;)
+        {
+            // A line longer than the buffer doubles it.
+            if (tFilled == tBuffer.size())
+                tBuffer.resize(2 * tBuffer.size());
+            if (!tEof)
+            {
+                tFile.read(tBuffer.data() + tFilled, static_cast<std::streamsize>(tBuffer.size() - tFilled));
+                tFilled += static_cast<std::size_t>(tFile.gcount());
+                tEof = !tFile;
+            }
+            std::size_t tWhole = tFilled;
+            if (!tEof)
+            {
+                const auto tLast = std::string_view{tBuffer.data(), tFilled}.rfind('\n');
+                if (tLast == std::string_view::npos)
+                    continue;
+                tWhole = tLast + 1;
+            }
+            Detail::addCsvChunk(std::string_view{tBuffer.data(), tWhole}, tOffset, xSettings.m_Delimiter, tLayout);
+            std::memmove(tBuffer.data(), tBuffer.data() + tWhole, tFilled - tWhole);
+            tFilled -= tWhole;
+            tOffset += tWhole;
+        }
+
+        return Detail::parseCsvChunks<T>(tLayout, xSettings, xExecutor, [&](const Detail::CsvChunk &xChunk, std::vector<char> &xBuffer) -> std::optional<std::string_view>
+                                         {
+                                             std::ifstream tChunkFile{xPath, std::ios::binary};
+                                             xBuffer.resize(xChunk.m_Size);
+                                             if (!tChunkFile.seekg(static_cast<std::streamoff>(xChunk.m_Offset)) ||
+                                                 !tChunkFile.read(xBuffer.data(), static_cast<std::streamsize>(xChunk.m_Size)))
+                                                 return std::nullopt;
+                                             return std::string_view{xBuffer.data(), xBuffer.size()};
+                                         });
+    }
+
+    template <typename T>
+    std::optional<Matrix<T>> readCsv(const std::string &xPath, const CsvSettings &xSettings = {})
+    {
+        return readCsv<T>(xPath, xSettings, Parallel::defaultExecutor());
+    }
+} // namespace Io
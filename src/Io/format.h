@@ -0,0 +1,176 @@
+#pragma once
+
+#include "../Parallel/threadPool.h"
+#include "../Types/half.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <ios>
+#include <locale>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace Io
+{
+    enum class FloatFormat
+    {
+        // Fewest digits that parse back to the same value.
+        Shortest,
+        Fixed,
+        Scientific,
+        // Like printf's %g.
+        General
+    };
+
+    // Layout of formatted matrices: every row is m_RowPrefix, the elements joined by
+    // m_Separator, then m_RowSuffix. Integers are always printed exactly.
+    struct FormatSettings
+    {
+        FloatFormat m_FloatFormat{FloatFormat::Shortest};
+        // Digits after the point (Fixed, Scientific) or significant digits (General).
+        int m_Precision{6};
+        std::string m_RowPrefix{" | "};
+        std::string m_Separator{" | "};
+        std::string m_RowSuffix{" | \n"};
+    };
+
+    // The layout of Matrix::toString(): six fixed decimals, like std::to_string.
+    inline FormatSettings toStringFormat()
+    {
+        return FormatSettings{FloatFormat::Fixed, 6};
+    }
+
+    // Elements per block that is formatted as one task.
+    constexpr std::size_t gFormatBlockElements{1UL << 14};
+
+    namespace Detail
+    {
+        // to_chars into xOut for arithmetic and Float16 elements; other types fall back to an
+        // ADL to_string.
+        template <typename T>
+        void appendField(std::string &xOut, const T &xValue, const FormatSettings &xSettings)
+        {
+            if constexpr (gIsFloat16<T>)
+            {
+                appendField(xOut, static_cast<float>(xValue), xSettings);
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                // Enough for every double in fixed notation with 100 decimals.
+                char tField[512];
+                std::to_chars_result tResult{};
+                const int tPrecision = std::clamp(xSettings.m_Precision, 0, 100);
+                switch (xSettings.m_FloatFormat)
+                {
+                case FloatFormat::Shortest:
+                    tResult = std::to_chars(tField, tField + sizeof(tField), xValue);
+                    break;
+                case FloatFormat::Fixed:
+                    tResult = std::to_chars(tField, tField + sizeof(tField), xValue, std::chars_format::fixed, tPrecision);
+                    break;
+                case FloatFormat::Scientific:
+                    tResult = std::to_chars(tField, tField + sizeof(tField), xValue, std::chars_format::scientific, tPrecision);
+                    break;
+                case FloatFormat::General:
+                    tResult = std::to_chars(tField, tField + sizeof(tField), xValue, std::chars_format::general, tPrecision);
+                    break;
+                }
+                xOut.append(tField, tResult.ptr);
+            }
+            else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+            {
+                char tField[24];
+                xOut.append(tField, std::to_chars(tField, tField + sizeof(tField), xValue).ptr);
+            }
+            else
+            {
+                using std::to_string;
+                xOut += to_string(xValue);
+            }
+        }
+
+        template <typename T>
+        void formatRows(std::string &xOut, const T *xData, std::size_t xFirstRow, std::size_t xLastRow, std::size_t xCols,
+                        std::size_t xLeadingDimension, const FormatSettings &xSettings)
+        {
+            for (std::size_t i = xFirstRow; i < xLastRow; i++)
+            {
+                xOut += xSettings.m_RowPrefix;
+                const T *tRow = xData + i * xLeadingDimension;
+                for (std::size_t j = 0; j < xCols; j++)
+                {
+                    if (j > 0)
+                        xOut += xSettings.m_Separator;
+                    appendField(xOut, tRow[j], xSettings);
+                }
+                xOut += xSettings.m_RowSuffix;
+            }
+        }
+    } // namespace Detail
+
+    // Formats an xRows x xCols row-major matrix. Large matrices are cut into blocks of rows
+    // that are formatted in parallel on xExecutor into their own buffers. The result is
+    // then allocated once at its final size, and the blocks are copied into it.
+    template <typename T>
+    std::string format(const T *xData, std::size_t xRows, std::size_t xCols, std::size_t xLeadingDimension,
+                       const FormatSettings &xSettings, Parallel::Executor &xExecutor)
+    {
+        // Guess of the average field width, so the buffers rarely grow.
+        const std::size_t tFieldGuess = std::is_integral_v<T> ? 8 : xSettings.m_FloatFormat == FloatFormat::Shortest ? 20
+                                                                                                                       : std::size_t(std::clamp(xSettings.m_Precision, 0, 100)) + 8;
+        const std::size_t tRowGuess = xSettings.m_RowPrefix.size() + xSettings.m_RowSuffix.size() + xCols * (tFieldGuess + xSettings.m_Separator.size());
+        const std::size_t tRowsPerBlock = std::max<std::size_t>(1, gFormatBlockElements / std::max<std::size_t>(xCols, 1));
+        const std::size_t tBlocks = (xRows + tRowsPerBlock - 1) / tRowsPerBlock;
+
+        std::string tResult;
+        if (tBlocks <= 1 || xExecutor.concurrency() <= 1)
+        {
+            tResult.reserve(xRows * tRowGuess);
+            Detail::formatRows(tResult, xData, 0, xRows, xCols, xLeadingDimension, xSettings);
+            return tResult;
+        }
+
+        std::vector<std::string> tParts(tBlocks);
+        xExecutor.parallelFor(tBlocks, [&](std::size_t xBlock)
+                              {
+                                  const std::size_t tFirst = xBlock * tRowsPerBlock, tLast = std::min(xRows, tFirst + tRowsPerBlock);
+                                  tParts[xBlock].reserve((tLast - tFirst) * tRowGuess);
+                                  Detail::formatRows(tParts[xBlock], xData, tFirst, tLast, xCols, xLeadingDimension, xSettings);
+                              });
+
+        std::vector<std::size_t> tOffsets(tBlocks + 1, 0);
+        for (std::size_t b = 0; b < tBlocks; b++)
+            tOffsets[b + 1] = tOffsets[b] + tParts[b].size();
+        tResult.resize(tOffsets[tBlocks]);
+        xExecutor.parallelFor(tBlocks, [&](std::size_t xBlock)
+                              { std::memcpy(tResult.data() + tOffsets[xBlock], tParts[xBlock].data(), tParts[xBlock].size()); });
+        return tResult;
+    }
+
+    // The settings matching what operator<< would print element by element on xStream, or
+    // false if its flags (width, showpos, hex, ...) or an imbued locale need the stream itself.
+    inline bool streamFormat(const std::ios_base &xStream, FormatSettings &xSettings) noexcept
+    {
+        if (xStream.getloc() != std::locale::classic())
+            return false;
+        const auto tFlags = xStream.flags();
+        if (xStream.width() != 0 || (tFlags & (std::ios_base::showpos | std::ios_base::showpoint | std::ios_base::uppercase | std::ios_base::boolalpha)) ||
+            (tFlags & std::ios_base::basefield) != std::ios_base::dec)
+            return false;
+        const auto tFloatField = tFlags & std::ios_base::floatfield;
+        if (tFloatField == std::ios_base::fixed)
+            xSettings.m_FloatFormat = FloatFormat::Fixed;
+        else if (tFloatField == std::ios_base::scientific)
+            xSettings.m_FloatFormat = FloatFormat::Scientific;
+        else if (tFloatField == std::ios_base::fmtflags{})
+            xSettings.m_FloatFormat = FloatFormat::General;
+        else
+            return false;
+        xSettings.m_Precision = static_cast<int>(xStream.precision());
+        return true;
+    }
+} // namespace Io
@@ -0,0 +1,434 @@
+#pragma once
+
+#include "../matrixView.h"
+#include "../Types/column.h"
+#include "../Types/half.h"
+#include "../Types/row.h"
+#include "../Types/span.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Binary matrix files, version 1. A 64 byte header is followed by the payload at
+// m_PayloadOffset, a multiple of 64: m_Rows rows of m_Stride elements each, row-major, in
+// the byte order of the writer. Elements past m_Cols in a row are zero and take less than
+// 64 bytes. The checksum covers the whole payload, padding included.
+namespace Io
+{
+    constexpr std::uint32_t gFileVersion{1};
+    constexpr std::size_t gPayloadAlignment{64};
+    // Written in native byte order; a reader with the other byte order sees 0x04030201.
+    constexpr std::uint32_t gByteOrderMark{0x01020304};
+    constexpr char gFileMagic[8]{'M', 'A', 'T', 'R', 'I', 'X', '\r', '\n'};
+
+    enum class ElementType : std::uint32_t
+    {
+        Int8 = 1,
+        UInt8,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Int64,
+        UInt64,
+        Float16,
+        BFloat16,
+        Float32,
+        Float64
+    };
+
+    struct FileHeader
+    {
+        char m_Magic[8];
+        std::uint32_t m_Version;
+        std::uint32_t m_ByteOrder;
+        ElementType m_ElementType;
+        std::uint32_t m_ElementSize;
+        std::uint64_t m_Rows;
+        std::uint64_t m_Cols;
+        std::uint64_t m_Stride;
+        std::uint64_t m_PayloadOffset;
+        std::uint64_t m_Checksum;
+    };
+    static_assert(sizeof(FileHeader) == gPayloadAlignment, "FileHeader must fill exactly one payload alignment unit");
+
+    // The file tag of T; only arithmetic types and the Float16 types can be stored.
+    template <typename T>
+    constexpr ElementType elementType() noexcept
+    {
+        if constexpr (std::is_same_v<T, Half>)
+            return ElementType::Float16;
+        else if constexpr (std::is_same_v<T, BFloat16>)
+            return ElementType::BFloat16;
+        else if constexpr (std::is_same_v<T, float>)
+            return ElementType::Float32;
+        else if constexpr (std::is_same_v<T, double>)
+            return ElementType::Float64;
+        else
+        {
+            static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8, "Matrix files store arithmetic or Float16 elements");
+            constexpr std::uint32_t tLog = sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1
+                                                            : sizeof(T) == 4   ? 2
+                                                                               : 3;
+            return static_cast<ElementType>(1 + 2 * tLog + (std::is_signed_v<T> ? 0 : 1));
+        }
+    }
+
+    // Streaming 64-bit checksum in the style of XXH64: four independent multiply-rotate lanes
+    // over 32 byte blocks, so it runs at memory speed. Not compatible with XXH64 itself. It is
+    // a function of the bytes only, so it covers the payload exactly as stored in the file.
+    class Checksum
+    {
+    private:
+        static constexpr std::uint64_t gPrime1{0x9E3779B185EBCA87ULL};
+        static constexpr std::uint64_t gPrime2{0xC2B2AE3D27D4EB4FULL};
+        static constexpr std::uint64_t gPrime3{0x165667B19E3779F9ULL};
+
+        std::uint64_t m_Lanes[4]{gPrime1 + gPrime2, gPrime2, 0, 0 - gPrime1};
+        unsigned char m_Pending[32]{};
+        std::size_t m_PendingSize{0};
+        std::uint64_t m_Length{0};
+
+        static constexpr std::uint64_t rotate(std::uint64_t xValue, int xBits) noexcept { return (xValue << xBits) | (xValue >> (64 - xBits)); }
+
+        // Words are read little-endian whatever the host, so the checksum of a file does not
+        // depend on the byte order of the machine that wrote it. Compilers turn this into a
+        // plain load on little-endian hosts.
+        static constexpr std::uint64_t loadLittleEndian(const unsigned char *xData) noexcept
+        {
+            std::uint64_t tWord{0};
+            for (std::size_t i = 0; i < 8; i++)
+                tWord |= static_cast<std::uint64_t>(xData[i]) << (8 * i);
+            return tWord;
+        }
+
+        void block(const unsigned char *xData) noexcept
+        {
+            for (std::size_t i = 0; i < 4; i++)
+                m_Lanes[i] = rotate(m_Lanes[i] + loadLittleEndian(xData + 8 * i) * gPrime2, 31) * gPrime1;
+        }
+
+    public:
+        void update(const void *xData, std::size_t xSize) noexcept
+        {
+            const auto *tData = static_cast<const unsigned char *>(xData);
+            m_Length += xSize;
+            if (m_PendingSize > 0)
+            {
+                const std::size_t tTake = std::min(xSize, sizeof(m_Pending) - m_PendingSize);
+                std::memcpy(m_Pending + m_PendingSize, tData, tTake);
+                m_PendingSize += tTake;
+                tData += tTake;
+                xSize -= tTake;
+                if (m_PendingSize < sizeof(m_Pending))
+                    return;
+                block(m_Pending);
+                m_PendingSize = 0;
+            }
+            for (; xSize >= sizeof(m_Pending); tData += sizeof(m_Pending), xSize -= sizeof(m_Pending))
+                block(tData);
+            std::memcpy(m_Pending, tData, xSize);
+            m_PendingSize = xSize;
+        }
+
+        std::uint64_t value() const noexcept
+        {
+            std::uint64_t tHash = rotate(m_Lanes[0], 1) + rotate(m_Lanes[1], 7) + rotate(m_Lanes[2], 12) + rotate(m_Lanes[3], 18);
+            tHash ^= m_Length;
+            for (std::size_t i = 0; i < m_PendingSize; i++)
+                tHash = rotate(tHash ^ (m_Pending[i] * gPrime3), 11) * gPrime1;
+            tHash ^= tHash >> 33;
+            tHash *= gPrime2;
+            tHash ^= tHash >> 29;
+            tHash *= gPrime3;
+            return tHash ^ (tHash >> 32);
+        }
+    };
+
+    namespace Detail
+    {
+        template <typename T>
+        T byteSwap(T xValue) noexcept
+        {
+            unsigned char tBytes[sizeof(T)];
+            std::memcpy(tBytes, &xValue, sizeof(T));
+            for (std::size_t i = 0; i < sizeof(T) / 2; i++)
+                std::swap(tBytes[i], tBytes[sizeof(T) - 1 - i]);
+            std::memcpy(&xValue, tBytes, sizeof(T));
+            return xValue;
+        }
+
+        inline void swapHeader(FileHeader &xHeader) noexcept
+        {
+            xHeader.m_Version = byteSwap(xHeader.m_Version);
+            xHeader.m_ByteOrder = byteSwap(xHeader.m_ByteOrder);
+            xHeader.m_ElementType = static_cast<ElementType>(byteSwap(static_cast<std::uint32_t>(xHeader.m_ElementType)));
+            xHeader.m_ElementSize = byteSwap(xHeader.m_ElementSize);
+            xHeader.m_Rows = byteSwap(xHeader.m_Rows);
+            xHeader.m_Cols = byteSwap(xHeader.m_Cols);
+            xHeader.m_Stride = byteSwap(xHeader.m_Stride);
+            xHeader.m_PayloadOffset = byteSwap(xHeader.m_PayloadOffset);
+            xHeader.m_Checksum = byteSwap(xHeader.m_Checksum);
+        }
+
+        // Brings the header to native byte order and checks it against T and the file size.
+        // xSwapped reports a file written with the other byte order.
+        template <typename T>
+        bool validHeader(FileHeader &xHeader, std::uint64_t xFileSize, bool &xSwapped) noexcept
+        {
+            if (std::memcmp(xHeader.m_Magic, gFileMagic, sizeof(gFileMagic)) != 0)
+                return false;
+            xSwapped = xHeader.m_ByteOrder != gByteOrderMark;
+            if (xSwapped)
+                swapHeader(xHeader);
+            if (xHeader.m_ByteOrder != gByteOrderMark || xHeader.m_Version == 0 || xHeader.m_Version > gFileVersion)
+                return false;
+            if (xHeader.m_ElementType != elementType<T>() || xHeader.m_ElementSize != sizeof(T))
+                return false;
+            if (xHeader.m_Stride < xHeader.m_Cols || xHeader.m_PayloadOffset < sizeof(FileHeader) || xHeader.m_PayloadOffset % gPayloadAlignment != 0)
+                return false;
+            // Checked before the row count, which does not bound the stride of an empty matrix.
+            if (xHeader.m_Stride - xHeader.m_Cols >= gPayloadAlignment / sizeof(T))
+                return false;
+            // Overflow safe form of offset + rows * stride * sizeof(T) <= file size.
+            const std::uint64_t tAvailable = (xFileSize - std::min(xFileSize, xHeader.m_PayloadOffset)) / sizeof(T);
+            // Without a stride there is no payload, and so no row to bound the row count by.
+            return xHeader.m_Stride == 0 ? xHeader.m_Rows == 0 : xHeader.m_Rows <= tAvailable / xHeader.m_Stride;
+        }
+
+        template <typename T>
+        FileHeader makeHeader(std::size_t xRows, std::size_t xCols, std::size_t xStride) noexcept
+        {
+            FileHeader tHeader{};
+            std::memcpy(tHeader.m_Magic, gFileMagic, sizeof(gFileMagic));
+            tHeader.m_Version = gFileVersion;
+            tHeader.m_ByteOrder = gByteOrderMark;
+            tHeader.m_ElementType = elementType<T>();
+            tHeader.m_ElementSize = sizeof(T);
+            tHeader.m_Rows = xRows;
+            tHeader.m_Cols = xCols;
+            tHeader.m_Stride = xStride;
+            tHeader.m_PayloadOffset = gPayloadAlignment;
+            return tHeader;
+        }
+
+        // Writes xRows rows of xCols elements, xLeadingDimension apart in memory, as a version 1
+        // file with stride xCols. The checksum is patched into the header after the payload.
+        // A matrix without columns is stored as 0 x 0.
+        template <typename T>
+        bool writeFile(const std::string &xPath, const T *xData, std::size_t xRows, std::size_t xCols, std::size_t xLeadingDimension)
+        {
+            std::ofstream tFile{xPath, std::ios::binary | std::ios::trunc};
+            if (!tFile)
+                return false;
+            if (xCols == 0)
+                xRows = 0;
+            auto tHeader = makeHeader<T>(xRows, xCols, xCols);
+            tFile.write(reinterpret_cast<const char *>(&tHeader), sizeof(tHeader));
+
+            Checksum tChecksum;
+            for (std::size_t i = 0; i < xRows; i++)
+            {
+                tChecksum.update(xData + i * xLeadingDimension, xCols * sizeof(T));
+                tFile.write(reinterpret_cast<const char *>(xData + i * xLeadingDimension), static_cast<std::streamsize>(xCols * sizeof(T)));
+            }
+            tHeader.m_Checksum = tChecksum.value();
+            tFile.seekp(0);
+            tFile.write(reinterpret_cast<const char *>(&tHeader), sizeof(tHeader));
+            return static_cast<bool>(tFile.flush());
+        }
+
+        // Reads a file written by writeFile() in either byte order. xAllocate(rows, cols) returns
+        // the destination and its leading dimension. False if the header does not match T, the
+        // file is truncated or the checksum differs.
+        template <typename T, typename Allocate>
+        bool readFile(const std::string &xPath, Allocate &&xAllocate)
+        {
+            std::ifstream tFile{xPath, std::ios::binary | std::ios::ate};
+            if (!tFile)
+                return false;
+            const auto tFileSize = static_cast<std::uint64_t>(tFile.tellg());
+            tFile.seekg(0);
+            FileHeader tHeader;
+            bool tSwapped{false};
+            if (tFileSize < sizeof(tHeader) || !tFile.read(reinterpret_cast<char *>(&tHeader), sizeof(tHeader)) || !validHeader<T>(tHeader, tFileSize, tSwapped))
+                return false;
+
+            const auto [tData, tLeadingDimension] = xAllocate(static_cast<std::size_t>(tHeader.m_Rows), static_cast<std::size_t>(tHeader.m_Cols));
+            const std::size_t tStride = static_cast<std::size_t>(tHeader.m_Stride), tCols = static_cast<std::size_t>(tHeader.m_Cols);
+            tFile.seekg(static_cast<std::streamoff>(tHeader.m_PayloadOffset));
+            Checksum tChecksum;
+            std::vector<T> tPadding(tStride - tCols);
+            for (std::size_t i = 0; i < tHeader.m_Rows; i++)
+            {
+                T *tRow = tData + i * tLeadingDimension;
+                tFile.read(reinterpret_cast<char *>(tRow), static_cast<std::streamsize>(tCols * sizeof(T)));
+                tFile.read(reinterpret_cast<char *>(tPadding.data()), static_cast<std::streamsize>(tPadding.size() * sizeof(T)));
+                tChecksum.update(tRow, tCols * sizeof(T));
+                tChecksum.update(tPadding.data(), tPadding.size() * sizeof(T));
+                if (tSwapped)
+                    for (std::size_t j = 0; j < tCols; j++)
+                        tRow[j] = byteSwap(tRow[j]);
+            }
+            return static_cast<bool>(tFile) && tChecksum.value() == tHeader.m_Checksum;
+        }
+    } // namespace Detail
+} // namespace Io
+
+// Read-only matrix backed by a memory-mapped matrix file, see Matrix::mapFile(). Opening
+// touches only the header; pages of the payload are read by the OS on first access. The
+// mapping lives as long as the object, which is movable but not copyable.
+template <typename T>
+class MappedMatrix
+{
+private:
+    void *m_Mapping{nullptr};
+    std::size_t m_MappingSize{0};
+    const T *m_Data{nullptr};
+    std::size_t m_Rows{0};
+    std::size_t m_Cols{0};
+    std::size_t m_Stride{0};
+    std::uint64_t m_Checksum{0};
+
+    void unmap() noexcept
+    {
+        if (m_Mapping == nullptr)
+            return;
+#if defined(_WIN32)
+        UnmapViewOfFile(m_Mapping);
+#else
+        munmap(m_Mapping, m_MappingSize);
+#endif
+        m_Mapping = nullptr;
+    }
+
+    // Maps the whole file read only; nullptr on failure.
+    static void *mapReadOnly(const std::string &xPath, std::size_t &xSize) noexcept
+    {
+#if defined(_WIN32)
+        HANDLE tFile = CreateFileA(xPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (tFile == INVALID_HANDLE_VALUE)
+            return nullptr;
+        LARGE_INTEGER tSize{};
+        void *tMapping{nullptr};
+        if (GetFileSizeEx(tFile, &tSize) && tSize.QuadPart > 0)
+        {
+            HANDLE tSection = CreateFileMappingA(tFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (tSection != nullptr)
+            {
+                tMapping = MapViewOfFile(tSection, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(tSection);
+            }
+        }
+        CloseHandle(tFile);
+        xSize = static_cast<std::size_t>(tSize.QuadPart);
+        return tMapping;
+#else
+        const int tFile = ::open(xPath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (tFile < 0)
+            return nullptr;
+        struct stat tStat
+        {
+        };
+        void *tMapping{nullptr};
+        if (fstat(tFile, &tStat) == 0 && tStat.st_size > 0)
+        {
+            tMapping = mmap(nullptr, static_cast<std::size_t>(tStat.st_size), PROT_READ, MAP_SHARED, tFile, 0);
+            if (tMapping == MAP_FAILED)
+                tMapping = nullptr;
+        }
+        ::close(tFile);
+        xSize = static_cast<std::size_t>(tStat.st_size);
+        return tMapping;
+#endif
+    }
+
+public:
+    using value_type = T;
+
+    MappedMatrix() noexcept = default;
+    MappedMatrix(const MappedMatrix &) = delete;
+    MappedMatrix &operator=(const MappedMatrix &) = delete;
+    MappedMatrix(MappedMatrix &&xOther) noexcept { *this = std::move(xOther); }
+    MappedMatrix &operator=(MappedMatrix &&xOther) noexcept
+    {
+        if (this != &xOther)
+        {
+            unmap();
+            m_Mapping = std::exchange(xOther.m_Mapping, nullptr);
+            m_MappingSize = std::exchange(xOther.m_MappingSize, 0);
+            m_Data = std::exchange(xOther.m_Data, nullptr);
+            m_Rows = std::exchange(xOther.m_Rows, 0);
+            m_Cols = std::exchange(xOther.m_Cols, 0);
+            m_Stride = std::exchange(xOther.m_Stride, 0);
+            m_Checksum = xOther.m_Checksum;
+        }
+        return *this;
+    }
+    ~MappedMatrix() { unmap(); }
+
+    // std::nullopt if the file cannot be mapped, its header does not describe a T matrix in
+    // native byte order or it is truncated. The checksum is not verified, see verify().
+    static std::optional<MappedMatrix> open(const std::string &xPath)
+    {
+        MappedMatrix tResult;
+        tResult.m_Mapping = mapReadOnly(xPath, tResult.m_MappingSize);
+        if (tResult.m_Mapping == nullptr || tResult.m_MappingSize < sizeof(Io::FileHeader))
+            return std::nullopt;
+
+        Io::FileHeader tHeader;
+        std::memcpy(&tHeader, tResult.m_Mapping, sizeof(tHeader));
+        bool tSwapped{false};
+        if (!Io::Detail::validHeader<T>(tHeader, tResult.m_MappingSize, tSwapped) || tSwapped)
+            return std::nullopt;
+
+        tResult.m_Data = reinterpret_cast<const T *>(static_cast<const unsigned char *>(tResult.m_Mapping) + tHeader.m_PayloadOffset);
+        tResult.m_Rows = static_cast<std::size_t>(tHeader.m_Rows);
+        tResult.m_Cols = static_cast<std::size_t>(tHeader.m_Cols);
+        tResult.m_Stride = static_cast<std::size_t>(tHeader.m_Stride);
+        tResult.m_Checksum = tHeader.m_Checksum;
+        return tResult;
+    }
+
+    Row getRows() const noexcept { return Row{m_Rows}; }
+    Column getCols() const noexcept { return Column{m_Cols}; }
+    std::size_t getLeadingDimension() const noexcept { return m_Stride; }
+    // The payload, row padding included.
+    Span<const T> getData() const noexcept { return {m_Data, m_Rows * m_Stride}; }
+    Span<const T> getRow(std::size_t xRow) const noexcept { return {m_Data + xRow * m_Stride, m_Cols}; }
+
+    const T &operator()(const std::size_t &xRow, const std::size_t &xCol) const noexcept { return m_Data[xRow * m_Stride + xCol]; }
+
+    // Takes part in expressions and products like any ConstMatrixView; Matrix<T>{view()}
+    // copies the file into memory.
+    ConstMatrixView<T> view() const noexcept { return ConstMatrixView<T>{m_Data, m_Rows, m_Cols, m_Stride}; }
+
+    // Reads the whole payload and compares its checksum with the header.
+    bool verify() const noexcept
+    {
+        Io::Checksum tChecksum;
+        tChecksum.update(m_Data, m_Rows * m_Stride * sizeof(T));
+        return tChecksum.value() == m_Checksum;
+    }
+};
@@ -0,0 +1,460 @@
+#pragma once
+
+#include "simd.h"
+#include "../Memory/alignedAllocator.h"
+#include "../Parallel/threadPool.h"
+#include "../Types/half.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace Kernels
+{
+    // Register tile shape for the widest vector ISA enabled at compile time:
+    // gGemmTileRows x gGemmTileVectors vectors of accumulators.
+#if defined(__AVX512F__)
+    constexpr std::size_t gGemmVectorBytes{64};
+    constexpr std::size_t gGemmTileRows{8};
+    constexpr std::size_t gGemmTileVectors{3};
+#elif defined(__AVX__)
+    constexpr std::size_t gGemmVectorBytes{32};
+    constexpr std::size_t gGemmTileRows{6};
+    constexpr std::size_t gGemmTileVectors{2};
+#else
+    constexpr std::size_t gGemmVectorBytes{16};
+    constexpr std::size_t gGemmTileRows{4};
+    constexpr std::size_t gGemmTileVectors{2};
+#endif
+
+#if defined(__GNUC__)
+#define MATRIX_GEMM_VECTOR_EXTENSIONS 1
+#endif
+
+    // Register tile (MR x NR) and cache blocks: KC x NR panels of B stay in L1,
+    // MC x KC blocks of A in L2 and KC x NC panels of B in L3.
+    template <typename T>
+    struct GemmBlocking
+    {
+        static constexpr std::size_t MR{4};
+        static constexpr std::size_t NR{4};
+        static constexpr std::size_t MC{64};
+        static constexpr std::size_t KC{128};
+        static constexpr std::size_t NC{1024};
+    };
+
+    template <>
+    struct GemmBlocking<double>
+    {
+        static constexpr std::size_t MR{gGemmTileRows};
+        static constexpr std::size_t NR{gGemmTileVectors * gGemmVectorBytes / sizeof(double)};
+        static constexpr std::size_t MC{96};
+        static constexpr std::size_t KC{256};
+        static constexpr std::size_t NC{2048};
+    };
+
+    template <>
+    struct GemmBlocking<float>
+    {
+        static constexpr std::size_t MR{gGemmTileRows};
+        static constexpr std::size_t NR{gGemmTileVectors * gGemmVectorBytes / sizeof(float)};
+        static constexpr std::size_t MC{96};
+        static constexpr std::size_t KC{256};
+        static constexpr std::size_t NC{4096};
+    };
+
+    // Float16 products run on the float kernel, see Detail::gemmWidened().
+    template <typename Encoding>
+    struct GemmBlocking<Float16<Encoding>> : GemmBlocking<float>
+    {
+    };
+
+    // Below this many multiply-adds packing costs more than it saves.
+    constexpr std::size_t gGemmSmallProduct{32 * 32 * 32};
+    // Below this many multiply-adds a product stays on the calling thread.
+    constexpr std::size_t gGemmParallelProduct{96 * 96 * 96};
+
+    namespace Detail
+    {
+        template <typename T>
+        using PackBuffer = std::vector<T, AlignedAllocator<T>>;
+
+        template <typename T>
+        PackBuffer<T> &packBufferA()
+        {
+            thread_local PackBuffer<T> tBuffer;
+            return tBuffer;
+        }
+
+        template <typename T>
+        PackBuffer<T> &packBufferB()
+        {
+            thread_local PackBuffer<T> tBuffer;
+            return tBuffer;
+        }
+
+        // Packs an xMc x xKc block of A into MR row micro-panels, k-major, zero padded.
+        template <typename T>
+        void packA(std::size_t xMc, std::size_t xKc, const T *xA, std::size_t xLda, T *xPacked) noexcept
+        {
+            constexpr std::size_t MR = GemmBlocking<T>::MR;
+            for (std::size_t i = 0; i < xMc; i += MR)
+            {
+                const std::size_t tRows = std::min(MR, xMc - i);
+                for (std::size_t k = 0; k < xKc; k++)
+                {
+                    std::size_t r = 0;
+                    for (; r < tRows; r++)
+                        xPacked[r] = xA[(i + r) * xLda + k];
+                    for (; r < MR; r++)
+                        xPacked[r] = T{};
+                    xPacked += MR;
+                }
+            }
+        }
+
+        // Packs an xKc x xNc panel of B into NR column micro-panels, k-major, zero padded.
+        template <typename T>
+        void packB(std::size_t xKc, std::size_t xNc, const T *xB, std::size_t xLdb, T *xPacked) noexcept
+        {
+            constexpr std::size_t NR = GemmBlocking<T>::NR;
+            for (std::size_t j = 0; j < xNc; j += NR)
+            {
+                const std::size_t tCols = std::min(NR, xNc - j);
+                for (std::size_t k = 0; k < xKc; k++)
+                {
+                    const T *tSource = xB + k * xLdb + j;
+                    std::size_t c = 0;
+                    for (; c < tCols; c++)
+                        xPacked[c] = tSource[c];
+                    for (; c < NR; c++)
+                        xPacked[c] = T{};
+                    xPacked += NR;
+                }
+            }
+        }
+
+        // C[0:xRows, 0:xCols] += xAlpha * Apanel * Bpanel
+        template <typename T>
+        void microKernel(std::size_t xKc, const T *__restrict xA, const T *__restrict xB, const T &xAlpha,
+                         T *xC, std::size_t xLdc, std::size_t xRows, std::size_t xCols) noexcept
+        {
+            constexpr std::size_t MR = GemmBlocking<T>::MR;
+            constexpr std::size_t NR = GemmBlocking<T>::NR;
+
+            T tAcc[MR][NR]{};
+#if MATRIX_GEMM_VECTOR_EXTENSIONS
+            if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+            {
+                // Spelled with vector extensions so the compiler keeps the tile in registers
+                // instead of vectorizing along k.
+                typedef T Vec __attribute__((vector_size(gGemmVectorBytes), __may_alias__));
+                constexpr std::size_t NV = NR * sizeof(T) / gGemmVectorBytes;
+
+                Vec tVecAcc[MR][NV]{};
+                for (std::size_t k = 0; k < xKc; k++)
+                {
+                    // Packed panels are aligned to gMatrixAlignment and NR spans whole vectors.
+                    const Vec *tB = reinterpret_cast<const Vec *>(xB);
+                    for (std::size_t i = 0; i < MR; i++)
+                    {
+                        const T tA = xA[i];
+                        for (std::size_t j = 0; j < NV; j++)
+                            tVecAcc[i][j] += tA * tB[j];
+                    }
+                    xA += MR;
+                    xB += NR;
+                }
+                std::memcpy(tAcc, tVecAcc, sizeof(tAcc));
+            }
+            else
+#endif
+            {
+                for (std::size_t k = 0; k < xKc; k++)
+                {
+                    for (std::size_t i = 0; i < MR; i++)
+                    {
+                        const T tA = xA[i];
+                        for (std::size_t j = 0; j < NR; j++)
+                            tAcc[i][j] += tA * xB[j];
+                    }
+                    xA += MR;
+                    xB += NR;
+                }
+            }
+
+            if (xRows == MR && xCols == NR)
+            {
+                for (std::size_t i = 0; i < MR; i++)
+                    for (std::size_t j = 0; j < NR; j++)
+                        xC[i * xLdc + j] += xAlpha * tAcc[i][j];
+            }
+            else
+            {
+                for (std::size_t i = 0; i < xRows; i++)
+                    for (std::size_t j = 0; j < xCols; j++)
+                        xC[i * xLdc + j] += xAlpha * tAcc[i][j];
+            }
+        }
+
+        template <typename T>
+        void macroKernel(std::size_t xMc, std::size_t xNc, std::size_t xKc, const T &xAlpha,
+                         const T *xPackedA, const T *xPackedB, T *xC, std::size_t xLdc) noexcept
+        {
+            constexpr std::size_t MR = GemmBlocking<T>::MR;
+            constexpr std::size_t NR = GemmBlocking<T>::NR;
+
+            for (std::size_t j = 0; j < xNc; j += NR)
+            {
+                const T *tB = xPackedB + j * xKc;
+                for (std::size_t i = 0; i < xMc; i += MR)
+                {
+                    microKernel(xKc, xPackedA + i * xKc, tB, xAlpha,
+                                xC + i * xLdc + j, xLdc, std::min(MR, xMc - i), std::min(NR, xNc - j));
+                }
+            }
+        }
+
+        template <typename T>
+        void scale(std::size_t xM, std::size_t xN, const T &xBeta, T *xC, std::size_t xLdc) noexcept
+        {
+            if (xBeta == T{1})
+                return;
+
+            for (std::size_t i = 0; i < xM; i++)
+            {
+                T *tRow = xC + i * xLdc;
+                if (xBeta == T{})
+                    std::fill(tRow, tRow + xN, T{});
+                else
+                    for (std::size_t j = 0; j < xN; j++)
+                        tRow[j] *= xBeta;
+            }
+        }
+
+        // i-k-j loop for products too small to be worth packing.
+        template <typename T>
+        void gemmSmall(std::size_t xM, std::size_t xN, std::size_t xK, const T &xAlpha,
+                       const T *xA, std::size_t xLda, const T *xB, std::size_t xLdb, T *xC, std::size_t xLdc) noexcept
+        {
+            for (std::size_t i = 0; i < xM; i++)
+            {
+                T *tC = xC + i * xLdc;
+                for (std::size_t k = 0; k < xK; k++)
+                {
+                    const T tA = xAlpha * xA[i * xLda + k];
+                    const T *tB = xB + k * xLdb;
+                    for (std::size_t j = 0; j < xN; j++)
+                        tC[j] += tA * tB[j];
+                }
+            }
+        }
+
+        // Columns of C per block of the Float16 path; the packed B panel spans all of K.
+        constexpr std::size_t gWidenedNc{GemmBlocking<float>::NR * 8};
+
+        // packA for Float16 sources: each row is widened into xRow, then scattered.
+        template <typename T>
+        void packWidenedA(std::size_t xMc, std::size_t xKc, const T *xA, std::size_t xLda, float *xRow, float *xPacked) noexcept
+        {
+            constexpr std::size_t MR = GemmBlocking<float>::MR;
+            for (std::size_t i = 0; i < xMc; i += MR)
+            {
+                const std::size_t tRows = std::min(MR, xMc - i);
+                for (std::size_t r = 0; r < MR; r++)
+                {
+                    if (r < tRows)
+                        widen(xA + (i + r) * xLda, xRow, xKc);
+                    for (std::size_t k = 0; k < xKc; k++)
+                        xPacked[k * MR + r] = r < tRows ? xRow[k] : 0.0f;
+                }
+                xPacked += MR * xKc;
+            }
+        }
+
+        template <typename T>
+        void packWidenedB(std::size_t xKc, std::size_t xNc, const T *xB, std::size_t xLdb, float *xRow, float *xPacked) noexcept
+        {
+            constexpr std::size_t NR = GemmBlocking<float>::NR;
+            const std::size_t tPanels = (xNc + NR - 1) / NR;
+            for (std::size_t k = 0; k < xKc; k++)
+            {
+                widen(xB + k * xLdb, xRow, xNc);
+                for (std::size_t p = 0; p < tPanels; p++)
+                {
+                    float *tOut = xPacked + (p * xKc + k) * NR;
+                    const std::size_t tCols = std::min(NR, xNc - p * NR);
+                    std::copy(xRow + p * NR, xRow + p * NR + tCols, tOut);
+                    std::fill(tOut + tCols, tOut + NR, 0.0f);
+                }
+            }
+        }
+
+        // Float16 GEMM with float accumulation. A and B are widened while they are packed,
+        // which keeps the reads from memory at 16 bits, and the float micro-kernel runs over
+        // all of K into a float block of C before C is rounded, once, to 16 bits.
+        template <typename T>
+        void gemmWidened(std::size_t xM, std::size_t xN, std::size_t xK, const T &xAlpha,
+                         const T *xA, std::size_t xLda, const T *xB, std::size_t xLdb,
+                         const T &xBeta, T *xC, std::size_t xLdc)
+        {
+            using Blocking = GemmBlocking<float>;
+            const float tAlpha = static_cast<float>(xAlpha), tBeta = static_cast<float>(xBeta);
+            const auto tRoundUp = [](std::size_t xValue, std::size_t xMultiple)
+            { return (xValue + xMultiple - 1) / xMultiple * xMultiple; };
+
+            auto &tPackedA = packBufferA<float>();
+            auto &tPackedB = packBufferB<float>();
+            thread_local PackBuffer<float> tBlockC, tRow;
+            const std::size_t tNcMax = tRoundUp(std::min(xN, gWidenedNc), Blocking::NR);
+            tPackedA.resize(tRoundUp(std::min(xM, Blocking::MC), Blocking::MR) * std::min(xK, Blocking::KC));
+            tPackedB.resize(tNcMax * xK);
+            tBlockC.resize(std::min(xM, Blocking::MC) * tNcMax);
+            tRow.resize(std::max(Blocking::KC, tNcMax));
+
+            for (std::size_t jc = 0; jc < xN; jc += gWidenedNc)
+            {
+                const std::size_t tNc = std::min(gWidenedNc, xN - jc), tLdc = tRoundUp(tNc, Blocking::NR);
+                for (std::size_t pc = 0; pc < xK; pc += Blocking::KC)
+                    packWidenedB(std::min(Blocking::KC, xK - pc), tNc, xB + pc * xLdb + jc, xLdb, tRow.data(), tPackedB.data() + tLdc * pc);
+
+                for (std::size_t ic = 0; ic < xM; ic += Blocking::MC)
+                {
+                    const std::size_t tMc = std::min(Blocking::MC, xM - ic);
+                    std::fill(tBlockC.begin(), tBlockC.begin() + tMc * tLdc, 0.0f);
+                    for (std::size_t pc = 0; pc < xK; pc += Blocking::KC)
+                    {
+                        const std::size_t tKc = std::min(Blocking::KC, xK - pc);
+                        packWidenedA(tMc, tKc, xA + ic * xLda + pc, xLda, tRow.data(), tPackedA.data());
+                        macroKernel(tMc, tNc, tKc, 1.0f, tPackedA.data(), tPackedB.data() + tLdc * pc, tBlockC.data(), tLdc);
+                    }
+
+                    for (std::size_t r = 0; r < tMc; r++)
+                    {
+                        T *tC = xC + (ic + r) * xLdc + jc;
+                        float *tSum = tBlockC.data() + r * tLdc;
+                        if (tBeta == 0.0f)
+                        {
+                            for (std::size_t j = 0; j < tNc; j++)
+                                tSum[j] *= tAlpha;
+                        }
+                        else
+                        {
+                            widen(tC, tRow.data(), tNc);
+                            for (std::size_t j = 0; j < tNc; j++)
+                                tSum[j] = tAlpha * tSum[j] + tBeta * tRow[j];
+                        }
+                        narrow(tSum, tC, tNc);
+                    }
+                }
+            }
+        }
+    } // namespace Detail
+
+    // Single threaded C = alpha * A * B + beta * C, see gemm().
+    template <typename T>
+    void gemmSequential(std::size_t xM, std::size_t xN, std::size_t xK, const T &xAlpha,
+                        const T *xA, std::size_t xLda, const T *xB, std::size_t xLdb,
+                        const T &xBeta, T *xC, std::size_t xLdc)
+    {
+        using Blocking = GemmBlocking<T>;
+
+        if (xM == 0 || xN == 0)
+            return;
+
+        if constexpr (gIsFloat16<T>)
+        {
+            Detail::gemmWidened(xM, xN, xK, xAlpha, xA, xLda, xB, xLdb, xBeta, xC, xLdc);
+            return;
+        }
+
+        Detail::scale(xM, xN, xBeta, xC, xLdc);
+
+        if (xK == 0 || xAlpha == T{})
+            return;
+
+        if (xM * xN * xK <= gGemmSmallProduct)
+        {
+            Detail::gemmSmall(xM, xN, xK, xAlpha, xA, xLda, xB, xLdb, xC, xLdc);
+            return;
+        }
+
+        auto &tPackedA = Detail::packBufferA<T>();
+        auto &tPackedB = Detail::packBufferB<T>();
+        const auto tRoundUp = [](std::size_t xValue, std::size_t xMultiple)
+        { return (xValue + xMultiple - 1) / xMultiple * xMultiple; };
+        tPackedA.resize(tRoundUp(std::min(xM, Blocking::MC), Blocking::MR) * std::min(xK, Blocking::KC));
+        tPackedB.resize(tRoundUp(std::min(xN, Blocking::NC), Blocking::NR) * std::min(xK, Blocking::KC));
+
+        for (std::size_t jc = 0; jc < xN; jc += Blocking::NC)
+        {
+            const std::size_t tNc = std::min(Blocking::NC, xN - jc);
+            for (std::size_t pc = 0; pc < xK; pc += Blocking::KC)
+            {
+                const std::size_t tKc = std::min(Blocking::KC, xK - pc);
+                Detail::packB(tKc, tNc, xB + pc * xLdb + jc, xLdb, tPackedB.data());
+
+                for (std::size_t ic = 0; ic < xM; ic += Blocking::MC)
+                {
+                    const std::size_t tMc = std::min(Blocking::MC, xM - ic);
+                    Detail::packA(tMc, tKc, xA + ic * xLda + pc, xLda, tPackedA.data());
+                    Detail::macroKernel(tMc, tNc, tKc, xAlpha, tPackedA.data(), tPackedB.data(), xC + ic * xLdc + jc, xLdc);
+                }
+            }
+        }
+    }
+
+    // C = alpha * A * B + beta * C for row-major operands with leading dimensions lda, ldb, ldc.
+    // A is xM x xK, B is xK x xN, C is xM x xN. C must not alias A or B.
+    // The output is cut into 2D tiles that are load balanced over xExecutor.
+    template <typename T>
+    void gemm(std::size_t xM, std::size_t xN, std::size_t xK, const T &xAlpha,
+              const T *xA, std::size_t xLda, const T *xB, std::size_t xLdb,
+              const T &xBeta, T *xC, std::size_t xLdc, Parallel::Executor &xExecutor)
+    {
+        using Blocking = GemmBlocking<T>;
+
+        const std::size_t tThreads = xExecutor.concurrency();
+        if (tThreads <= 1 || xM * xN * xK < gGemmParallelProduct)
+        {
+            gemmSequential(xM, xN, xK, xAlpha, xA, xLda, xB, xLdb, xBeta, xC, xLdc);
+            return;
+        }
+
+        // Start from cache-block sized tiles and split the larger side until every
+        // thread gets a few tiles to balance.
+        std::size_t tTileRows = std::min(xM, Blocking::MC);
+        std::size_t tTileCols = std::min(xN, Blocking::NC);
+        const auto tTiles = [&]
+        { return ((xM + tTileRows - 1) / tTileRows) * ((xN + tTileCols - 1) / tTileCols); };
+        while (tTiles() < 4 * tThreads)
+        {
+            if (tTileCols >= tTileRows && tTileCols >= 2 * Blocking::NR)
+                tTileCols = (tTileCols / 2 + Blocking::NR - 1) / Blocking::NR * Blocking::NR;
+            else if (tTileRows >= 2 * Blocking::MR)
+                tTileRows = (tTileRows / 2 + Blocking::MR - 1) / Blocking::MR * Blocking::MR;
+            else
+                break;
+        }
+
+        const std::size_t tRowTiles = (xM + tTileRows - 1) / tTileRows;
+        const std::size_t tColTiles = (xN + tTileCols - 1) / tTileCols;
+        xExecutor.parallelFor(tRowTiles * tColTiles, [&](std::size_t xTile)
+                              {
+                                  const std::size_t i = (xTile / tColTiles) * tTileRows;
+                                  const std::size_t j = (xTile % tColTiles) * tTileCols;
+                                  gemmSequential(std::min(tTileRows, xM - i), std::min(tTileCols, xN - j), xK, xAlpha,
+                                                 xA + i * xLda, xLda, xB + j, xLdb, xBeta, xC + i * xLdc + j, xLdc);
+                              });
+    }
+
+    template <typename T>
+    void gemm(std::size_t xM, std::size_t xN, std::size_t xK, const T &xAlpha,
+              const T *xA, std::size_t xLda, const T *xB, std::size_t xLdb,
+              const T &xBeta, T *xC, std::size_t xLdc)
+    {
+        gemm(xM, xN, xK, xAlpha, xA, xLda, xB, xLdb, xBeta, xC, xLdc, Parallel::defaultExecutor());
+    }
+} // namespace Kernels
@@ -0,0 +1,256 @@
+#pragma once
+
+#include "gemm.h"
+#include "simd.h"
+#include "../Parallel/threadPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Kernels
+{
+    // Register tile of the int8 kernel: gQgemmMR rows of A times gQgemmNR columns of B. k is
+    // consumed in groups of four bytes, the unit of vpdpbusd.
+    constexpr std::size_t gQgemmMR{8};
+    constexpr std::size_t gQgemmNR{16};
+    // Cache blocks: a packed A micro-panel plus a B micro-panel fill about half of L1, a
+    // gQgemmMC x gQgemmKC block of A stays in L2.
+    constexpr std::size_t gQgemmKC{1024};
+    constexpr std::size_t gQgemmMC{128};
+    constexpr std::size_t gQgemmNC{512};
+    // Every product is at most 255 * 128 in magnitude, so int32 sums of this many cannot overflow.
+    constexpr std::size_t gQgemmMaxK{65536};
+
+    namespace Detail
+    {
+        // Packs an xMc x xKc block of A into MR row micro-panels. Each group of four k holds
+        // MR x 4 bytes, so one row's group is a single int32 to broadcast. Zero padded.
+        inline void packQuantizedA(std::size_t xMc, std::size_t xKc, const std::uint8_t *xA, std::size_t xLda, std::uint8_t *xPacked) noexcept
+        {
+            const std::size_t tGroups = (xKc + 3) / 4;
+            for (std::size_t i0 = 0; i0 < xMc; i0 += gQgemmMR)
+            {
+                const std::size_t tRows = std::min(gQgemmMR, xMc - i0);
+                for (std::size_t g = 0; g < tGroups; g++)
+                {
+                    const std::size_t tDepth = std::min<std::size_t>(4, xKc - 4 * g);
+                    for (std::size_t i = 0; i < gQgemmMR; i++, xPacked += 4)
+                    {
+                        std::memset(xPacked, 0, 4);
+                        if (i < tRows)
+                            std::memcpy(xPacked, xA + (i0 + i) * xLda + 4 * g, tDepth);
+                    }
+                }
+            }
+        }
+
+        // Packs an xKc x xNc block of B into NR column micro-panels. Each group of four k holds
+        // NR x 4 bytes, the four k of one column adjacent. Zero padded.
+        inline void packQuantizedB(std::size_t xKc, std::size_t xNc, const std::int8_t *xB, std::size_t xLdb, std::int8_t *xPacked) noexcept
+        {
+            const std::size_t tGroups = (xKc + 3) / 4;
+            for (std::size_t j0 = 0; j0 < xNc; j0 += gQgemmNR)
+            {
+                const std::size_t tCols = std::min(gQgemmNR, xNc - j0);
+                for (std::size_t g = 0; g < tGroups; g++)
+                {
+                    for (std::size_t j = 0; j < gQgemmNR; j++)
+                        for (std::size_t r = 0; r < 4; r++)
+                            *xPacked++ = j < tCols && 4 * g + r < xKc ? xB[(4 * g + r) * xLdb + j0 + j] : std::int8_t{0};
+                }
+            }
+        }
+
+        // Each micro-kernel overwrites the MR x NR int32 tile xTile with the product of one
+        // packed A and one packed B micro-panel.
+        inline void qgemmKernelScalar(std::size_t xGroups, const std::uint8_t *xA, const std::int8_t *xB, std::int32_t *xTile) noexcept
+        {
+            std::fill(xTile, xTile + gQgemmMR * gQgemmNR, 0);
+            for (std::size_t g = 0; g < xGroups; g++)
+                for (std::size_t i = 0; i < gQgemmMR; i++)
+                    for (std::size_t j = 0; j < gQgemmNR; j++)
+                        for (std::size_t r = 0; r < 4; r++)
+                            xTile[i * gQgemmNR + j] += std::int32_t{xA[(g * gQgemmMR + i) * 4 + r]} * std::int32_t{xB[(g * gQgemmNR + j) * 4 + r]};
+        }
+
+#if defined(MATRIX_SIMD_X86)
+        // vpmaddubsw saturates once both pairs are large, so A is split into its low seven bits,
+        // whose pair sums stay below 2^15, and its top bit, which is added back shifted by 7.
+        MATRIX_TARGET_AVX2 inline void qgemmKernelAvx2(std::size_t xGroups, const std::uint8_t *xA, const std::int8_t *xB, std::int32_t *xTile) noexcept
+        {
+            constexpr std::size_t tRows{4};
+            const __m256i tOnes = _mm256_set1_epi16(1);
+            const __m256i tLowBits = _mm256_set1_epi8(0x7F);
+            const __m256i tLowBit = _mm256_set1_epi8(0x01);
+            for (std::size_t i0 = 0; i0 < gQgemmMR; i0 += tRows)
+            {
+                __m256i tAcc[tRows][2];
+                for (auto &tRow : tAcc)
+                    tRow[0] = tRow[1] = _mm256_setzero_si256();
+                for (std::size_t g = 0; g < xGroups; g++)
+                {
+                    const __m256i tB[2] = {_mm256_loadu_si256(reinterpret_cast<const __m256i *>(xB + g * gQgemmNR * 4)),
+                                           _mm256_loadu_si256(reinterpret_cast<const __m256i *>(xB + g * gQgemmNR * 4 + 32))};
+                    for (std::size_t i = 0; i < tRows; i++)
+                    {
+                        std::int32_t tGroup;
+                        std::memcpy(&tGroup, xA + (g * gQgemmMR + i0 + i) * 4, 4);
+                        const __m256i tA = _mm256_set1_epi32(tGroup);
+                        const __m256i tLow = _mm256_and_si256(tA, tLowBits);
+                        const __m256i tHigh = _mm256_and_si256(_mm256_srli_epi16(tA, 7), tLowBit);
+                        for (std::size_t h = 0; h < 2; h++)
+                        {
+                            const __m256i tSumLow = _mm256_madd_epi16(_mm256_maddubs_epi16(tLow, tB[h]), tOnes);
+                            const __m256i tSumHigh = _mm256_madd_epi16(_mm256_maddubs_epi16(tHigh, tB[h]), tOnes);
+                            tAcc[i][h] = _mm256_add_epi32(tAcc[i][h], _mm256_add_epi32(tSumLow, _mm256_slli_epi32(tSumHigh, 7)));
+                        }
+                    }
+                }
+                for (std::size_t i = 0; i < tRows; i++)
+                    for (std::size_t h = 0; h < 2; h++)
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(xTile + (i0 + i) * gQgemmNR + 8 * h), tAcc[i][h]);
+            }
+        }
+
+        // vpdpbusd multiplies four unsigned by four signed bytes and adds them to an int32 lane
+        // exactly, so one instruction covers a group for all 16 columns.
+        MATRIX_TARGET_VNNI inline void qgemmKernelVnni(std::size_t xGroups, const std::uint8_t *xA, const std::int8_t *xB, std::int32_t *xTile) noexcept
+        {
+            __m512i tAcc[gQgemmMR];
+            for (auto &tRow : tAcc)
+                tRow = _mm512_setzero_si512();
+            for (std::size_t g = 0; g < xGroups; g++)
+            {
+                const __m512i tB = _mm512_loadu_si512(xB + g * gQgemmNR * 4);
+                for (std::size_t i = 0; i < gQgemmMR; i++)
+                {
+                    std::int32_t tGroup;
+                    std::memcpy(&tGroup, xA + (g * gQgemmMR + i) * 4, 4);
+                    tAcc[i] = _mm512_dpbusd_epi32(tAcc[i], _mm512_set1_epi32(tGroup), tB);
+                }
+            }
+            for (std::size_t i = 0; i < gQgemmMR; i++)
+                _mm512_storeu_si512(xTile + i * gQgemmNR, tAcc[i]);
+        }
+#endif
+
+        using QgemmKernel = void (*)(std::size_t, const std::uint8_t *, const std::int8_t *, std::int32_t *) noexcept;
+
+        inline QgemmKernel qgemmKernel() noexcept
+        {
+#if defined(MATRIX_SIMD_X86)
+            static const bool tVnni = detectVnni();
+            if (simdLevel() == SimdLevel::AVX512 && tVnni)
+                return &qgemmKernelVnni;
+            if (static_cast<int>(simdLevel()) >= static_cast<int>(SimdLevel::AVX2))
+                return &qgemmKernelAvx2;
+#endif
+            return &qgemmKernelScalar;
+        }
+    } // namespace Detail
+
+    // Single threaded C = A * B, see gemmInt8().
+    inline void gemmInt8Sequential(std::size_t xM, std::size_t xN, std::size_t xK,
+                                   const std::uint8_t *xA, std::size_t xLda, const std::int8_t *xB, std::size_t xLdb,
+                                   std::int32_t *xC, std::size_t xLdc)
+    {
+        if (xM == 0 || xN == 0)
+            return;
+        if (xK == 0)
+        {
+            for (std::size_t i = 0; i < xM; i++)
+                std::fill(xC + i * xLdc, xC + i * xLdc + xN, 0);
+            return;
+        }
+
+        const auto tKernel = Detail::qgemmKernel();
+        auto &tPackedA = Detail::packBufferA<std::uint8_t>();
+        auto &tPackedB = Detail::packBufferB<std::int8_t>();
+        const auto tRoundUp = [](std::size_t xValue, std::size_t xMultiple)
+        { return (xValue + xMultiple - 1) / xMultiple * xMultiple; };
+        const std::size_t tMaxDepth = tRoundUp(std::min(xK, gQgemmKC), 4);
+        tPackedA.resize(tRoundUp(std::min(xM, gQgemmMC), gQgemmMR) * tMaxDepth);
+        tPackedB.resize(tRoundUp(std::min(xN, gQgemmNC), gQgemmNR) * tMaxDepth);
+        alignas(64) std::int32_t tTile[gQgemmMR * gQgemmNR];
+
+        for (std::size_t jc = 0; jc < xN; jc += gQgemmNC)
+        {
+            const std::size_t tNc = std::min(gQgemmNC, xN - jc);
+            for (std::size_t pc = 0; pc < xK; pc += gQgemmKC)
+            {
+                const std::size_t tKc = std::min(gQgemmKC, xK - pc);
+                const std::size_t tGroups = (tKc + 3) / 4;
+                Detail::packQuantizedB(tKc, tNc, xB + pc * xLdb + jc, xLdb, tPackedB.data());
+
+                for (std::size_t ic = 0; ic < xM; ic += gQgemmMC)
+                {
+                    const std::size_t tMc = std::min(gQgemmMC, xM - ic);
+                    Detail::packQuantizedA(tMc, tKc, xA + ic * xLda + pc, xLda, tPackedA.data());
+                    for (std::size_t ir = 0; ir < tMc; ir += gQgemmMR)
+                    {
+                        for (std::size_t jr = 0; jr < tNc; jr += gQgemmNR)
+                        {
+                            tKernel(tGroups, tPackedA.data() + ir * tGroups * 4, tPackedB.data() + jr * tGroups * 4, tTile);
+                            const std::size_t tRows = std::min(gQgemmMR, tMc - ir), tCols = std::min(gQgemmNR, tNc - jr);
+                            for (std::size_t i = 0; i < tRows; i++)
+                            {
+                                std::int32_t *tC = xC + (ic + ir + i) * xLdc + jc + jr;
+                                for (std::size_t j = 0; j < tCols; j++)
+                                    tC[j] = (pc == 0 ? 0 : tC[j]) + tTile[i * gQgemmNR + j];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // C = A * B with int32 accumulation for row-major operands with leading dimensions lda,
+    // ldb, ldc: A is xM x xK unsigned bytes, B is xK x xN signed bytes, C is xM x xN. The
+    // result is exact for xK <= gQgemmMaxK. Uses AVX512-VNNI where available, an exact
+    // vpmaddubsw sequence on AVX2 and scalar loops otherwise. Tiles as gemm() does.
+    inline void gemmInt8(std::size_t xM, std::size_t xN, std::size_t xK,
+                         const std::uint8_t *xA, std::size_t xLda, const std::int8_t *xB, std::size_t xLdb,
+                         std::int32_t *xC, std::size_t xLdc, Parallel::Executor &xExecutor)
+    {
+        const std::size_t tThreads = xExecutor.concurrency();
+        if (tThreads <= 1 || xM * xN * xK < gGemmParallelProduct)
+        {
+            gemmInt8Sequential(xM, xN, xK, xA, xLda, xB, xLdb, xC, xLdc);
+            return;
+        }
+
+        std::size_t tTileRows = std::min(xM, gQgemmMC);
+        std::size_t tTileCols = std::min(xN, gQgemmNC);
+        const auto tTiles = [&]
+        { return ((xM + tTileRows - 1) / tTileRows) * ((xN + tTileCols - 1) / tTileCols); };
+        while (tTiles() < 4 * tThreads)
+        {
+            if (tTileCols >= tTileRows && tTileCols >= 2 * gQgemmNR)
+                tTileCols = (tTileCols / 2 + gQgemmNR - 1) / gQgemmNR * gQgemmNR;
+            else if (tTileRows >= 2 * gQgemmMR)
+                tTileRows = (tTileRows / 2 + gQgemmMR - 1) / gQgemmMR * gQgemmMR;
+            else
+                break;
+        }
+
+        const std::size_t tRowTiles = (xM + tTileRows - 1) / tTileRows;
+        const std::size_t tColTiles = (xN + tTileCols - 1) / tTileCols;
+        xExecutor.parallelFor(tRowTiles * tColTiles, [&](std::size_t xTile)
+                              {
+                                  const std::size_t i = (xTile / tColTiles) * tTileRows;
+                                  const std::size_t j = (xTile % tColTiles) * tTileCols;
+                                  gemmInt8Sequential(std::min(tTileRows, xM - i), std::min(tTileCols, xN - j), xK,
+                                                     xA + i * xLda, xLda, xB + j, xLdb, xC + i * xLdc + j, xLdc);
+                              });
+    }
+
+    inline void gemmInt8(std::size_t xM, std::size_t xN, std::size_t xK,
+                         const std::uint8_t *xA, std::size_t xLda, const std::int8_t *xB, std::size_t xLdb,
+                         std::int32_t *xC, std::size_t xLdc)
+    {
+        gemmInt8(xM, xN, xK, xA, xLda, xB, xLdb, xC, xLdc, Parallel::defaultExecutor());
+    }
+} // namespace Kernels
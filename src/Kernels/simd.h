@@ -0,0 +1,903 @@
+#pragma once
+
+#include "../Types/half.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(_MSC_VER)) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define MATRIX_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC allows every intrinsic in every function; GCC and Clang need the ISA on the function.
+#if defined(MATRIX_SIMD_X86) && defined(__GNUC__)
+#define MATRIX_TARGET_SSE2 __attribute__((target("sse2")))
+#define MATRIX_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define MATRIX_TARGET_AVX512 __attribute__((target("avx512f,avx512dq")))
+#define MATRIX_TARGET_F16C __attribute__((target("avx2,f16c")))
+#define MATRIX_TARGET_VNNI __attribute__((target("avx512f,avx512bw,avx512vnni")))
+#else
+#define MATRIX_TARGET_SSE2
+#define MATRIX_TARGET_AVX2
+#define MATRIX_TARGET_AVX512
+#define MATRIX_TARGET_F16C
+#define MATRIX_TARGET_VNNI
+#endif
+
+namespace Kernels
+{
+    enum class SimdLevel : int
+    {
+        Scalar = 0,
+        SSE2 = 1,
+        AVX2 = 2,
+        AVX512 = 3
+    };
+
+    // Element types with hand written kernels; every other T takes the scalar loops.
+    template <typename T>
+    constexpr bool gHasSimdKernels = std::is_same_v<T, float> || std::is_same_v<T, double> ||
+                                     std::is_same_v<T, std::int32_t> || std::is_same_v<T, std::int64_t>;
+
+    // Widest instruction set both the CPU and the operating system support.
+    inline SimdLevel detectSimdLevel() noexcept
+    {
+#if defined(MATRIX_SIMD_X86) && defined(__GNUC__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq"))
+            return SimdLevel::AVX512;
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return SimdLevel::AVX2;
+        if (__builtin_cpu_supports("sse2"))
+            return SimdLevel::SSE2;
+#elif defined(MATRIX_SIMD_X86) && defined(_MSC_VER)
+        int tInfo[4]{};
+        __cpuid(tInfo, 0);
+        const int tMaxLeaf = tInfo[0];
+        __cpuid(tInfo, 1);
+        const bool tSse2 = (tInfo[3] & (1 << 26)) != 0;
+        const bool tFma = (tInfo[2] & (1 << 12)) != 0;
+        const bool tOsXsave = (tInfo[2] & (1 << 27)) != 0;
+        const unsigned long long tXcr0 = tOsXsave ? _xgetbv(0) : 0;
+        if (tMaxLeaf >= 7 && (tXcr0 & 0x6) == 0x6)
+        {
+            __cpuidex(tInfo, 7, 0);
+            const bool tAvx2 = (tInfo[1] & (1 << 5)) != 0;
+            const bool tAvx512 = (tInfo[1] & (1 << 16)) != 0 && (tInfo[1] & (1 << 17)) != 0;
+            if (tAvx512 && (tXcr0 & 0xE6) == 0xE6)
+                return SimdLevel::AVX512;
+            if (tAvx2 && tFma)
+                return SimdLevel::AVX2;
+        }
+        if (tSse2)
+            return SimdLevel::SSE2;
+#endif
+        return SimdLevel::Scalar;
+    }
+
+    namespace Detail
+    {
+        inline std::atomic<SimdLevel> &activeSimdLevel() noexcept
+        {
+            static std::atomic<SimdLevel> tLevel{detectSimdLevel()};
+            return tLevel;
+        }
+    } // namespace Detail
+
+    // Kernel set in use; detected once on first use.
+    inline SimdLevel simdLevel() noexcept
+    {
+        return Detail::activeSimdLevel().load(std::memory_order_relaxed);
+    }
+
+    // Restricts the kernels to xLevel (or what the CPU supports, if that is lower),
+    // e.g. to compare code paths.
+    inline void setSimdLevel(SimdLevel xLevel) noexcept
+    {
+        const auto tSupported = detectSimdLevel();
+        Detail::activeSimdLevel().store(static_cast<int>(xLevel) < static_cast<int>(tSupported) ? xLevel : tSupported, std::memory_order_relaxed);
+    }
+
+    namespace Detail
+    {
+        enum class SimdOp
+        {
+            Add,
+            Sub,
+            Mul
+        };
+
+        template <SimdOp Op, typename T>
+        constexpr T applyScalar(const T &xLhs, const T &xRhs) noexcept
+        {
+            if constexpr (Op == SimdOp::Add)
+                return xLhs + xRhs;
+            else if constexpr (Op == SimdOp::Sub)
+                return xLhs - xRhs;
+            else
+                return xLhs * xRhs;
+        }
+
+        template <SimdOp Op, typename T>
+        void binaryScalar(const T *xLhs, const T *xRhs, T *xOut, std::size_t xCount) noexcept
+        {
+            for (std::size_t i = 0; i < xCount; i++)
+                xOut[i] = applyScalar<Op>(xLhs[i], xRhs[i]);
+        }
+
+        template <SimdOp Op, typename T>
+        void broadcastScalar(const T *xLhs, T xScalar, T *xOut, std::size_t xCount) noexcept
+        {
+            for (std::size_t i = 0; i < xCount; i++)
+                xOut[i] = applyScalar<Op>(xLhs[i], xScalar);
+        }
+
+        // xOut[i] += xLhs[i] * xRhs[i], or -= for Op == Sub.
+        template <SimdOp Op, typename T>
+        void accumulateScalar(const T *xLhs, const T *xRhs, T *xOut, std::size_t xCount) noexcept
+        {
+            for (std::size_t i = 0; i < xCount; i++)
+                xOut[i] = applyScalar<Op>(xOut[i], xLhs[i] * xRhs[i]);
+        }
+
+        template <typename T>
+        T dotScalar(const T *xLhs, const T *xRhs, std::size_t xCount) noexcept
+        {
+            T tResult{static_cast<T>(0)};
+            for (std::size_t i = 0; i < xCount; i++)
+                tResult += xLhs[i] * xRhs[i];
+            return tResult;
+        }
+
+#if defined(MATRIX_SIMD_X86)
+        // One trait per ISA and element type: register type, width and the intrinsics
+        // the generic loops below are written against.
+        template <typename T>
+        struct Sse2;
+        template <typename T>
+        struct Avx2;
+        template <typename T>
+        struct Avx512;
+
+        template <>
+        struct Sse2<float>
+        {
+            using Reg = __m128;
+            static constexpr std::size_t gWidth{4};
+            static constexpr bool gHasMul{true};
+            MATRIX_TARGET_SSE2 static Reg load(const float *x) { return _mm_loadu_ps(x); }
+            MATRIX_TARGET_SSE2 static void store(float *x, Reg v) { _mm_storeu_ps(x, v); }
+            MATRIX_TARGET_SSE2 static Reg set1(float x) { return _mm_set1_ps(x); }
+            MATRIX_TARGET_SSE2 static Reg zero() { return _mm_setzero_ps(); }
+            MATRIX_TARGET_SSE2 static Reg add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+            MATRIX_TARGET_SSE2 static Reg sub(Reg a, Reg b) { return _mm_sub_ps(a, b); }
+            MATRIX_TARGET_SSE2 static Reg mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+            MATRIX_TARGET_SSE2 static Reg fma(Reg a, Reg b, Reg c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+        };
+
+        template <>
+        struct Sse2<double>
+        {
+            using Reg = __m128d;
+            static constexpr std::size_t gWidth{2};
+            static constexpr bool gHasMul{true};
+            MATRIX_TARGET_SSE2 static Reg load(const double *x) { return _mm_loadu_pd(x); }
+            MATRIX_TARGET_SSE2 static void store(double *x, Reg v) { _mm_storeu_pd(x, v); }
+            MATRIX_TARGET_SSE2 static Reg set1(double x) { return _mm_set1_pd(x); }
+            MATRIX_TARGET_SSE2 static Reg zero() { return _mm_setzero_pd(); }
+            MATRIX_TARGET_SSE2 static Reg add(Reg a, Reg b) { return _mm_add_pd(a, b); }
+            MATRIX_TARGET_SSE2 static Reg sub(Reg a, Reg b) { return _mm_sub_pd(a, b); }
+            MATRIX_TARGET_SSE2 static Reg mul(Reg a, Reg b) { return _mm_mul_pd(a, b); }
+            MATRIX_TARGET_SSE2 static Reg fma(Reg a, Reg b, Reg c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+        };
+
+        template <>
+        struct Sse2<std::int32_t>
+        {
+            using Reg = __m128i;
+            static constexpr std::size_t gWidth{4};
+            static constexpr bool gHasMul{false}; // pmulld is SSE4.1
+            MATRIX_TARGET_SSE2 static Reg load(const std::int32_t *x) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(x)); }
+            MATRIX_TARGET_SSE2 static void store(std::int32_t *x, Reg v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(x), v); }
+            MATRIX_TARGET_SSE2 static Reg set1(std::int32_t x) { return _mm_set1_epi32(x); }
+            MATRIX_TARGET_SSE2 static Reg zero() { return _mm_setzero_si128(); }
+            MATRIX_TARGET_SSE2 static Reg add(Reg a, Reg b) { return _mm_add_epi32(a, b); }
+            MATRIX_TARGET_SSE2 static Reg sub(Reg a, Reg b) { return _mm_sub_epi32(a, b); }
+        };
+
+        template <>
+        struct Sse2<std::int64_t>
+        {
+            using Reg = __m128i;
+            static constexpr std::size_t gWidth{2};
+            static constexpr bool gHasMul{false};
+            MATRIX_TARGET_SSE2 static Reg load(const std::int64_t *x) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(x)); }
+            MATRIX_TARGET_SSE2 static void store(std::int64_t *x, Reg v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(x), v); }
+            MATRIX_TARGET_SSE2 static Reg set1(std::int64_t x) { return _mm_set1_epi64x(x); }
+            MATRIX_TARGET_SSE2 static Reg zero() { return _mm_setzero_si128(); }
+            MATRIX_TARGET_SSE2 static Reg add(Reg a, Reg b) { return _mm_add_epi64(a, b); }
+            MATRIX_TARGET_SSE2 static Reg sub(Reg a, Reg b) { return _mm_sub_epi64(a, b); }
+        };
+
+        template <>
+        struct Avx2<float>
+        {
+            using Reg = __m256;
+            static constexpr std::size_t gWidth{8};
+            static constexpr bool gHasMul{true};
+            MATRIX_TARGET_AVX2 static Reg load(const float *x) { return _mm256_loadu_ps(x); }
+            MATRIX_TARGET_AVX2 static void store(float *x, Reg v) { _mm256_storeu_ps(x, v); }
+            MATRIX_TARGET_AVX2 static Reg set1(float x) { return _mm256_set1_ps(x); }
+            MATRIX_TARGET_AVX2 static Reg zero() { return _mm256_setzero_ps(); }
+            MATRIX_TARGET_AVX2 static Reg add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+            MATRIX_TARGET_AVX2 static Reg sub(Reg a, Reg b) { return _mm256_sub_ps(a, b); }
+            MATRIX_TARGET_AVX2 static Reg mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+            MATRIX_TARGET_AVX2 static Reg fma(Reg a, Reg b, Reg c) { return _mm256_fmadd_ps(a, b, c); }
+        };
+
+        template <>
+        struct Avx2<double>
+        {
+            using Reg = __m256d;
+            static constexpr std::size_t gWidth{4};
+            static constexpr bool gHasMul{true};
+            MATRIX_TARGET_AVX2 static Reg load(const double *x) { return _mm256_loadu_pd(x); }
+            MATRIX_TARGET_AVX2 static void store(double *x, Reg v) { _mm256_storeu_pd(x, v); }
+            MATRIX_TARGET_AVX2 static Reg set1(double x) { return _mm256_set1_pd(x); }
+            MATRIX_TARGET_AVX2 static Reg zero() { return _mm256_setzero_pd(); }
+            MATRIX_TARGET_AVX2 static Reg add(Reg a, Reg b) { return _mm256_add_pd(a, b); }
+            MATRIX_TARGET_AVX2 static Reg sub(Reg a, Reg b) { return _mm256_sub_pd(a, b); }
+            MATRIX_TARGET_AVX2 static Reg mul(Reg a, Reg b) { return _mm256_mul_pd(a, b); }
+            MATRIX_TARGET_AVX2 static Reg fma(Reg a, Reg b, Reg c) { return _mm256_fmadd_pd(a, b, c); }
+        };
+
+        template <>
+        struct Avx2<std::int32_t>
+        {
+            using Reg = __m256i;
+            static constexpr std::size_t gWidth{8};
+            static constexpr bool gHasMul{true};
+            MATRIX_TARGET_AVX2 static Reg load(const std::int32_t *x) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x)); }
+            MATRIX_TARGET_AVX2 static void store(std::int32_t *x, Reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(x), v); }
+            MATRIX_TARGET_AVX2 static Reg set1(std::int32_t x) { return _mm256_set1_epi32(x); }
+            MATRIX_TARGET_AVX2 static Reg zero() { return _mm256_setzero_si256(); }
+            MATRIX_TARGET_AVX2 static Reg add(Reg a, Reg b) { return _mm256_add_epi32(a, b); }
+            MATRIX_TARGET_AVX2 static Reg sub(Reg a, Reg b) { return _mm256_sub_epi32(a, b); }
+            MATRIX_TARGET_AVX2 static Reg mul(Reg a, Reg b) { return _mm256_mullo_epi32(a, b); }
+            MATRIX_TARGET_AVX2 static Reg fma(Reg a, Reg b, Reg c) { return _mm256_add_epi32(_mm256_mullo_epi32(a, b), c); }
+        };
+
+        template <>
+        struct Avx2<std::int64_t>
+        {
+            using Reg = __m256i;
+            static constexpr std::size_t gWidth{4};
+            static constexpr bool gHasMul{false}; // vpmullq is AVX-512DQ
+            MATRIX_TARGET_AVX2 static Reg load(const std::int64_t *x) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x)); }
+            MATRIX_TARGET_AVX2 static void store(std::int64_t *x, Reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(x), v); }
+            MATRIX_TARGET_AVX2 static Reg set1(std::int64_t x) { return _mm256_set1_epi64x(x); }
+            MATRIX_TARGET_AVX2 static Reg zero() { return _mm256_setzero_si256(); }
+            MATRIX_TARGET_AVX2 static Reg add(Reg a, Reg b) { return _mm256_add_epi64(a, b); }
+            MATRIX_TARGET_AVX2 static Reg sub(Reg a, Reg b) { return _mm256_sub_epi64(a, b); }
+        };
+
+        template <>
+        struct Avx512<float>
+        {
+            using Reg = __m512;
+            static constexpr std::size_t gWidth{16};
+            static constexpr bool gHasMul{true};
+            MATRIX_TARGET_AVX512 static Reg load(const float *x) { return _mm512_loadu_ps(x); }
+            MATRIX_TARGET_AVX512 static void store(float *x, Reg v) { _mm512_storeu_ps(x, v); }
+            MATRIX_TARGET_AVX512 static Reg set1(float x) { return _mm512_set1_ps(x); }
+            MATRIX_TARGET_AVX512 static Reg zero() { return _mm512_setzero_ps(); }
+            MATRIX_TARGET_AVX512 static Reg add(Reg a, Reg b) { return _mm512_add_ps(a, b); }
+            MATRIX_TARGET_AVX512 static Reg sub(Reg a, Reg b) { return _mm512_sub_ps(a, b); }
+            MATRIX_TARGET_AVX512 static Reg mul(Reg a, Reg b) { return _mm512_mul_ps(a, b); }
+            MATRIX_TARGET_AVX512 static Reg fma(Reg a, Reg b, Reg c) { return _mm512_fmadd_ps(a, b, c); }
+        };
+
+        template <>
+        struct Avx512<double>
+        {
+            using Reg = __m512d;
+            static constexpr std::size_t gWidth{8};
+            static constexpr bool gHasMul{true};
+            MATRIX_TARGET_AVX512 static Reg load(const double *x) { return _mm512_loadu_pd(x); }
+            MATRIX_TARGET_AVX512 static void store(double *x, Reg v) { _mm512_storeu_pd(x, v); }
+            MATRIX_TARGET_AVX512 static Reg set1(double x) { return _mm512_set1_pd(x); }
+            MATRIX_TARGET_AVX512 static Reg zero() { return _mm512_setzero_pd(); }
+            MATRIX_TARGET_AVX512 static Reg add(Reg a, Reg b) { return _mm512_add_pd(a, b); }
+            MATRIX_TARGET_AVX512 static Reg sub(Reg a, Reg b) { return _mm512_sub_pd(a, b); }
+            MATRIX_TARGET_AVX512 static Reg mul(Reg a, Reg b) { return _mm512_mul_pd(a, b); }
+            MATRIX_TARGET_AVX512 static Reg fma(Reg a, Reg b, Reg c) { return _mm512_fmadd_pd(a, b, c); }
+        };
+
+        template <>
+        struct Avx512<std::int32_t>
+        {
+            using Reg = __m512i;
+            static constexpr std::size_t gWidth{16};
+            static constexpr bool gHasMul{true};
+            MATRIX_TARGET_AVX512 static Reg load(const std::int32_t *x) { return _mm512_loadu_si512(x); }
+            MATRIX_TARGET_AVX512 static void store(std::int32_t *x, Reg v) { _mm512_storeu_si512(x, v); }
+            MATRIX_TARGET_AVX512 static Reg set1(std::int32_t x) { return _mm512_set1_epi32(x); }
+            MATRIX_TARGET_AVX512 static Reg zero() { return _mm512_setzero_si512(); }
+            MATRIX_TARGET_AVX512 static Reg add(Reg a, Reg b) { return _mm512_add_epi32(a, b); }
+            MATRIX_TARGET_AVX512 static Reg sub(Reg a, Reg b) { return _mm512_sub_epi32(a, b); }
+            MATRIX_TARGET_AVX512 static Reg mul(Reg a, Reg b) { return _mm512_mullo_epi32(a, b); }
+            MATRIX_TARGET_AVX512 static Reg fma(Reg a, Reg b, Reg c) { return _mm512_add_epi32(_mm512_mullo_epi32(a, b), c); }
+        };
+
+        template <>
+        struct Avx512<std::int64_t>
+        {
+            using Reg = __m512i;
+            static constexpr std::size_t gWidth{8};
+            static constexpr bool gHasMul{true};
+            MATRIX_TARGET_AVX512 static Reg load(const std::int64_t *x) { return _mm512_loadu_si512(x); }
+            MATRIX_TARGET_AVX512 static void store(std::int64_t *x, Reg v) { _mm512_storeu_si512(x, v); }
+            MATRIX_TARGET_AVX512 static Reg set1(std::int64_t x) { return _mm512_set1_epi64(x); }
+            MATRIX_TARGET_AVX512 static Reg zero() { return _mm512_setzero_si512(); }
+            MATRIX_TARGET_AVX512 static Reg add(Reg a, Reg b) { return _mm512_add_epi64(a, b); }
+            MATRIX_TARGET_AVX512 static Reg sub(Reg a, Reg b) { return _mm512_sub_epi64(a, b); }
+            MATRIX_TARGET_AVX512 static Reg mul(Reg a, Reg b) { return _mm512_mullo_epi64(a, b); }
+            MATRIX_TARGET_AVX512 static Reg fma(Reg a, Reg b, Reg c) { return _mm512_add_epi64(_mm512_mullo_epi64(a, b), c); }
+        };
+
+        // The loops are spelled once per ISA because the target attribute cannot be a
+        // template parameter; the bodies are identical.
+#define MATRIX_SIMD_LOOPS(Isa, Target)                                                                   \
+    template <SimdOp Op, typename T>                                                                     \
+    Target void binary##Isa(const T *xLhs, const T *xRhs, T *xOut, std::size_t xCount) noexcept          \
+    {                                                                                                    \
+        using V = Isa<T>;                                                                                \
+        std::size_t i = 0;                                                                               \
+        if constexpr (Op != SimdOp::Mul || V::gHasMul)                                                   \
+        {                                                                                                \
+            for (; i + V::gWidth <= xCount; i += V::gWidth)                                              \
+            {                                                                                            \
+                const auto tLhs = V::load(xLhs + i);                                                     \
+                const auto tRhs = V::load(xRhs + i);                                                     \
+                if constexpr (Op == SimdOp::Add)                                                         \
+                    V::store(xOut + i, V::add(tLhs, tRhs));                                              \
+                else if constexpr (Op == SimdOp::Sub)                                                    \
+                    V::store(xOut + i, V::sub(tLhs, tRhs));                                              \
+                else                                                                                     \
+                    V::store(xOut + i, V::mul(tLhs, tRhs));                                              \
+            }                                                                                            \
+        }                                                                                                \
+        for (; i < xCount; i++)                                                                          \
+            xOut[i] = applyScalar<Op>(xLhs[i], xRhs[i]);                                                 \
+    }                                                                                                    \
+                                                                                                         \
+    template <SimdOp Op, typename T>                                                                     \
+    Target void broadcast##Isa(const T *xLhs, T xScalar, T *xOut, std::size_t xCount) noexcept           \
+    {                                                                                                    \
+        using V = Isa<T>;                                                                                \
+        std::size_t i = 0;                                                                               \
+        if constexpr (Op != SimdOp::Mul || V::gHasMul)                                                   \
+        {                                                                                                \
+            const auto tScalar = V::set1(xScalar);                                                       \
+            for (; i + V::gWidth <= xCount; i += V::gWidth)                                              \
+            {                                                                                            \
+                const auto tLhs = V::load(xLhs + i);                                                     \
+                if constexpr (Op == SimdOp::Add)                                                         \
+                    V::store(xOut + i, V::add(tLhs, tScalar));                                           \
+                else if constexpr (Op == SimdOp::Sub)                                                    \
+                    V::store(xOut + i, V::sub(tLhs, tScalar));                                           \
+                else                                                                                     \
+                    V::store(xOut + i, V::mul(tLhs, tScalar));                                           \
+            }                                                                                            \
+        }                                                                                                \
+        for (; i < xCount; i++)                                                                          \
+            xOut[i] = applyScalar<Op>(xLhs[i], xScalar);                                                 \
+    }                                                                                                    \
+                                                                                                         \
+    template <SimdOp Op, typename T>                                                                     \
+    Target void accumulate##Isa(const T *xLhs, const T *xRhs, T *xOut, std::size_t xCount) noexcept      \
+    {                                                                                                    \
+        using V = Isa<T>;                                                                                \
+        std::size_t i = 0;                                                                               \
+        if constexpr (V::gHasMul)                                                                        \
+        {                                                                                                \
+            for (; i + V::gWidth <= xCount; i += V::gWidth)                                              \
+            {                                                                                            \
+                const auto tOut = V::load(xOut + i);                                                     \
+                if constexpr (Op == SimdOp::Add)                                                         \
+                    V::store(xOut + i, V::fma(V::load(xLhs + i), V::load(xRhs + i), tOut));              \
+                else                                                                                     \
+                    V::store(xOut + i, V::sub(tOut, V::mul(V::load(xLhs + i), V::load(xRhs + i))));      \
+            }                                                                                            \
+        }                                                                                                \
+        for (; i < xCount; i++)                                                                          \
+            xOut[i] = applyScalar<Op>(xOut[i], xLhs[i] * xRhs[i]);                                       \
+    }                                                                                                    \
+                                                                                                         \
+    template <typename T>                                                                                \
+    Target T dot##Isa(const T *xLhs, const T *xRhs, std::size_t xCount) noexcept                         \
+    {                                                                                                    \
+        using V = Isa<T>;                                                                                \
+        if constexpr (!V::gHasMul)                                                                       \
+        {                                                                                                \
+            return dotScalar(xLhs, xRhs, xCount);                                                        \
+        }                                                                                                \
+        else                                                                                             \
+        {                                                                                                \
+            /* Four independent accumulators hide the add latency. */                                   \
+            auto tAcc0 = V::zero(), tAcc1 = V::zero(), tAcc2 = V::zero(), tAcc3 = V::zero();             \
+            std::size_t i = 0;                                                                           \
+            for (; i + 4 * V::gWidth <= xCount; i += 4 * V::gWidth)                                      \
+            {                                                                                            \
+                tAcc0 = V::fma(V::load(xLhs + i), V::load(xRhs + i), tAcc0);                             \
+                tAcc1 = V::fma(V::load(xLhs + i + V::gWidth), V::load(xRhs + i + V::gWidth), tAcc1);     \
+                tAcc2 = V::fma(V::load(xLhs + i + 2 * V::gWidth), V::load(xRhs + i + 2 * V::gWidth), tAcc2); \
+                tAcc3 = V::fma(V::load(xLhs + i + 3 * V::gWidth), V::load(xRhs + i + 3 * V::gWidth), tAcc3); \
+            }                                                                                            \
+            for (; i + V::gWidth <= xCount; i += V::gWidth)                                              \
+                tAcc0 = V::fma(V::load(xLhs + i), V::load(xRhs + i), tAcc0);                             \
+            T tLanes[V::gWidth];                                                                         \
+            V::store(tLanes, V::add(V::add(tAcc0, tAcc1), V::add(tAcc2, tAcc3)));                        \
+            T tResult{static_cast<T>(0)};                                                                \
+            for (std::size_t l = 0; l < V::gWidth; l++)                                                  \
+                tResult += tLanes[l];                                                                    \
+            for (; i < xCount; i++)                                                                      \
+                tResult += xLhs[i] * xRhs[i];                                                            \
+            return tResult;                                                                              \
+        }                                                                                                \
+    }
+
+        MATRIX_SIMD_LOOPS(Sse2, MATRIX_TARGET_SSE2)
+        MATRIX_SIMD_LOOPS(Avx2, MATRIX_TARGET_AVX2)
+        MATRIX_SIMD_LOOPS(Avx512, MATRIX_TARGET_AVX512)
+#undef MATRIX_SIMD_LOOPS
+#endif
+
+        template <typename T>
+        struct SimdTable
+        {
+            void (*m_Add)(const T *, const T *, T *, std::size_t) noexcept;
+            void (*m_Sub)(const T *, const T *, T *, std::size_t) noexcept;
+            void (*m_Mul)(const T *, const T *, T *, std::size_t) noexcept;
+            void (*m_AddScalar)(const T *, T, T *, std::size_t) noexcept;
+            void (*m_SubScalar)(const T *, T, T *, std::size_t) noexcept;
+            void (*m_MulScalar)(const T *, T, T *, std::size_t) noexcept;
+            void (*m_MulAdd)(const T *, const T *, T *, std::size_t) noexcept;
+            void (*m_MulSub)(const T *, const T *, T *, std::size_t) noexcept;
+            T (*m_Dot)(const T *, const T *, std::size_t) noexcept;
+        };
+
+        template <typename T>
+        const SimdTable<T> &simdTable() noexcept
+        {
+            static const SimdTable<T> tTables[] = {
+                {&binaryScalar<SimdOp::Add, T>, &binaryScalar<SimdOp::Sub, T>, &binaryScalar<SimdOp::Mul, T>,
+                 &broadcastScalar<SimdOp::Add, T>, &broadcastScalar<SimdOp::Sub, T>, &broadcastScalar<SimdOp::Mul, T>,
+                 &accumulateScalar<SimdOp::Add, T>, &accumulateScalar<SimdOp::Sub, T>, &dotScalar<T>},
+#if defined(MATRIX_SIMD_X86)
+                {&binarySse2<SimdOp::Add, T>, &binarySse2<SimdOp::Sub, T>, &binarySse2<SimdOp::Mul, T>,
+                 &broadcastSse2<SimdOp::Add, T>, &broadcastSse2<SimdOp::Sub, T>, &broadcastSse2<SimdOp::Mul, T>,
+                 &accumulateSse2<SimdOp::Add, T>, &accumulateSse2<SimdOp::Sub, T>, &dotSse2<T>},
+                {&binaryAvx2<SimdOp::Add, T>, &binaryAvx2<SimdOp::Sub, T>, &binaryAvx2<SimdOp::Mul, T>,
+                 &broadcastAvx2<SimdOp::Add, T>, &broadcastAvx2<SimdOp::Sub, T>, &broadcastAvx2<SimdOp::Mul, T>,
+                 &accumulateAvx2<SimdOp::Add, T>, &accumulateAvx2<SimdOp::Sub, T>, &dotAvx2<T>},
+                {&binaryAvx512<SimdOp::Add, T>, &binaryAvx512<SimdOp::Sub, T>, &binaryAvx512<SimdOp::Mul, T>,
+                 &broadcastAvx512<SimdOp::Add, T>, &broadcastAvx512<SimdOp::Sub, T>, &broadcastAvx512<SimdOp::Mul, T>,
+                 &accumulateAvx512<SimdOp::Add, T>, &accumulateAvx512<SimdOp::Sub, T>, &dotAvx512<T>},
+#endif
+            };
+            return tTables[static_cast<int>(simdLevel())];
+        }
+    } // namespace Detail
+
+    namespace Detail
+    {
+        // F16C is separate from AVX2 in CPUID, although every AVX2 CPU so far has it.
+        inline bool detectF16c() noexcept
+        {
+#if defined(MATRIX_SIMD_X86) && defined(__GNUC__)
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("f16c");
+#elif defined(MATRIX_SIMD_X86) && defined(_MSC_VER)
+            int tInfo[4]{};
+            __cpuid(tInfo, 1);
+            return (tInfo[2] & (1 << 29)) != 0;
+#else
+            return false;
+#endif
+        }
+
+        // AVX512-VNNI (vpdpbusd) for the int8 GEMM, see Kernels/qgemm.h.
+        inline bool detectVnni() noexcept
+        {
+#if defined(MATRIX_SIMD_X86) && defined(__GNUC__)
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512vnni") && __builtin_cpu_supports("avx512bw");
+#elif defined(MATRIX_SIMD_X86) && defined(_MSC_VER)
+            int tInfo[4]{};
+            __cpuidex(tInfo, 7, 0);
+            return (tInfo[2] & (1 << 11)) != 0 && (tInfo[1] & (1 << 30)) != 0;
+#else
+            return false;
+#endif
+        }
+
+        template <typename T>
+        void widenScalar(const T *xIn, float *xOut, std::size_t xCount) noexcept
+        {
+            for (std::size_t i = 0; i < xCount; i++)
+                xOut[i] = static_cast<float>(xIn[i]);
+        }
+
+        template <typename T>
+        void narrowScalar(const float *xIn, T *xOut, std::size_t xCount) noexcept
+        {
+            for (std::size_t i = 0; i < xCount; i++)
+                xOut[i] = T{xIn[i]};
+        }
+
+#if defined(MATRIX_SIMD_X86)
+        MATRIX_TARGET_F16C inline void widenF16c(const Half *xIn, float *xOut, std::size_t xCount) noexcept
+        {
+            std::size_t i = 0;
+            for (; i + 8 <= xCount; i += 8)
+                _mm256_storeu_ps(xOut + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(xIn + i))));
+            widenScalar(xIn + i, xOut + i, xCount - i);
+        }
+
+        MATRIX_TARGET_F16C inline void narrowF16c(const float *xIn, Half *xOut, std::size_t xCount) noexcept
+        {
+            std::size_t i = 0;
+            for (; i + 8 <= xCount; i += 8)
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(xOut + i), _mm256_cvtps_ph(_mm256_loadu_ps(xIn + i), _MM_FROUND_TO_NEAREST_INT));
+            narrowScalar(xIn + i, xOut + i, xCount - i);
+        }
+
+        // The AVX-512 conversions below use the zero-masking forms with every lane selected.
+        // They compute the same as the unmasked forms, whose GCC implementations start from an
+        // undefined register and trip -Wmaybe-uninitialized.
+        constexpr __mmask16 gAllLanes{0xFFFF};
+
+        MATRIX_TARGET_AVX512 inline void widenAvx512(const Half *xIn, float *xOut, std::size_t xCount) noexcept
+        {
+            std::size_t i = 0;
+            for (; i + 16 <= xCount; i += 16)
+                _mm512_storeu_ps(xOut + i, _mm512_maskz_cvtph_ps(gAllLanes, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(xIn + i))));
+            widenScalar(xIn + i, xOut + i, xCount - i);
+        }
+
+        MATRIX_TARGET_AVX512 inline void narrowAvx512(const float *xIn, Half *xOut, std::size_t xCount) noexcept
+        {
+            std::size_t i = 0;
+            for (; i + 16 <= xCount; i += 16)
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(xOut + i),
+                                    _mm512_maskz_cvtps_ph(gAllLanes, _mm512_loadu_ps(xIn + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+            narrowScalar(xIn + i, xOut + i, xCount - i);
+        }
+
+        // bfloat16 is the upper half of a float: widening is a shift, narrowing adds the
+        // round-to-nearest-even bias before the shift and keeps NaNs quiet.
+        MATRIX_TARGET_AVX2 inline void widenAvx2(const BFloat16 *xIn, float *xOut, std::size_t xCount) noexcept
+        {
+            std::size_t i = 0;
+            for (; i + 8 <= xCount; i += 8)
+            {
+                const __m256i tWide = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(xIn + i)));
+                _mm256_storeu_ps(xOut + i, _mm256_castsi256_ps(_mm256_slli_epi32(tWide, 16)));
+            }
+            widenScalar(xIn + i, xOut + i, xCount - i);
+        }
+
+        MATRIX_TARGET_AVX2 inline void narrowAvx2(const float *xIn, BFloat16 *xOut, std::size_t xCount) noexcept
+        {
+            const __m256i tOne = _mm256_set1_epi32(1), tBias = _mm256_set1_epi32(0x7FFF), tQuiet = _mm256_set1_epi32(0x40);
+            std::size_t i = 0;
+            for (; i + 8 <= xCount; i += 8)
+            {
+                const __m256 tValue = _mm256_loadu_ps(xIn + i);
+                const __m256i tBits = _mm256_castps_si256(tValue);
+                const __m256i tUpper = _mm256_srli_epi32(tBits, 16);
+                __m256i tRounded = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(tBits, tBias), _mm256_and_si256(tUpper, tOne)), 16);
+                const __m256i tNaN = _mm256_castps_si256(_mm256_cmp_ps(tValue, tValue, _CMP_UNORD_Q));
+                tRounded = _mm256_blendv_epi8(tRounded, _mm256_or_si256(tUpper, tQuiet), tNaN);
+                // packus works per 128-bit lane; gather the two low quadwords afterwards.
+                const __m256i tPacked = _mm256_permute4x64_epi64(_mm256_packus_epi32(tRounded, tRounded), 0x08);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(xOut + i), _mm256_castsi256_si128(tPacked));
+            }
+            narrowScalar(xIn + i, xOut + i, xCount - i);
+        }
+
+        MATRIX_TARGET_AVX512 inline void widenAvx512(const BFloat16 *xIn, float *xOut, std::size_t xCount) noexcept
+        {
+            std::size_t i = 0;
+            for (; i + 16 <= xCount; i += 16)
+            {
+                const __m512i tWide = _mm512_maskz_cvtepu16_epi32(gAllLanes, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(xIn + i)));
+                _mm512_storeu_ps(xOut + i, _mm512_castsi512_ps(_mm512_maskz_slli_epi32(gAllLanes, tWide, 16)));
+            }
+            widenScalar(xIn + i, xOut + i, xCount - i);
+        }
+
+        MATRIX_TARGET_AVX512 inline void narrowAvx512(const float *xIn, BFloat16 *xOut, std::size_t xCount) noexcept
+        {
+            const __m512i tOne = _mm512_set1_epi32(1), tBias = _mm512_set1_epi32(0x7FFF), tQuiet = _mm512_set1_epi32(0x40);
+            std::size_t i = 0;
+            for (; i + 16 <= xCount; i += 16)
+            {
+                const __m512 tValue = _mm512_loadu_ps(xIn + i);
+                const __m512i tBits = _mm512_castps_si512(tValue);
+                const __m512i tUpper = _mm512_maskz_srli_epi32(gAllLanes, tBits, 16);
+                __m512i tRounded = _mm512_maskz_srli_epi32(gAllLanes, _mm512_add_epi32(_mm512_add_epi32(tBits, tBias), _mm512_and_si512(tUpper, tOne)), 16);
+                tRounded = _mm512_mask_or_epi32(tRounded, _mm512_cmp_ps_mask(tValue, tValue, _CMP_UNORD_Q), tUpper, tQuiet);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(xOut + i), _mm512_maskz_cvtepi32_epi16(gAllLanes, tRounded));
+            }
+            narrowScalar(xIn + i, xOut + i, xCount - i);
+        }
+#endif
+    } // namespace Detail
+
+    // Float16 <-> float, rounding to nearest even. F16C or AVX-512 for Half and AVX2 or
+    // AVX-512 for BFloat16 where the active SIMD level allows.
+    inline void widen(const Half *xIn, float *xOut, std::size_t xCount) noexcept
+    {
+#if defined(MATRIX_SIMD_X86)
+        static const bool tF16c = Detail::detectF16c();
+        if (simdLevel() == SimdLevel::AVX512)
+            return Detail::widenAvx512(xIn, xOut, xCount);
+        if (simdLevel() == SimdLevel::AVX2 && tF16c)
+            return Detail::widenF16c(xIn, xOut, xCount);
+#endif
+        Detail::widenScalar(xIn, xOut, xCount);
+    }
+
+    inline void narrow(const float *xIn, Half *xOut, std::size_t xCount) noexcept
+    {
+#if defined(MATRIX_SIMD_X86)
+        static const bool tF16c = Detail::detectF16c();
+        if (simdLevel() == SimdLevel::AVX512)
+            return Detail::narrowAvx512(xIn, xOut, xCount);
+        if (simdLevel() == SimdLevel::AVX2 && tF16c)
+            return Detail::narrowF16c(xIn, xOut, xCount);
+#endif
+        Detail::narrowScalar(xIn, xOut, xCount);
+    }
+
+    inline void widen(const BFloat16 *xIn, float *xOut, std::size_t xCount) noexcept
+    {
+#if defined(MATRIX_SIMD_X86)
+        if (simdLevel() == SimdLevel::AVX512)
+            return Detail::widenAvx512(xIn, xOut, xCount);
+        if (simdLevel() == SimdLevel::AVX2)
+            return Detail::widenAvx2(xIn, xOut, xCount);
+#endif
+        Detail::widenScalar(xIn, xOut, xCount);
+    }
+
+    inline void narrow(const float *xIn, BFloat16 *xOut, std::size_t xCount) noexcept
+    {
+#if defined(MATRIX_SIMD_X86)
+        if (simdLevel() == SimdLevel::AVX512)
+            return Detail::narrowAvx512(xIn, xOut, xCount);
+        if (simdLevel() == SimdLevel::AVX2)
+            return Detail::narrowAvx2(xIn, xOut, xCount);
+#endif
+        Detail::narrowScalar(xIn, xOut, xCount);
+    }
+
+    namespace Detail
+    {
+        // Float16 kernels run the float kernels on stack blocks of this many elements.
+        constexpr std::size_t gWidenBlock{256};
+
+        template <SimdOp Op, typename T>
+        void binaryWidened(const T *xLhs, const T *xRhs, T *xOut, std::size_t xCount) noexcept
+        {
+            alignas(64) float tLhs[gWidenBlock], tRhs[gWidenBlock];
+            const auto &tTable = simdTable<float>();
+            const auto tKernel = Op == SimdOp::Add ? tTable.m_Add : Op == SimdOp::Sub ? tTable.m_Sub : tTable.m_Mul;
+            for (std::size_t i = 0; i < xCount; i += gWidenBlock)
+            {
+                const std::size_t tCount = std::min(gWidenBlock, xCount - i);
+                widen(xLhs + i, tLhs, tCount);
+                widen(xRhs + i, tRhs, tCount);
+                tKernel(tLhs, tRhs, tLhs, tCount);
+                narrow(tLhs, xOut + i, tCount);
+            }
+        }
+
+        template <SimdOp Op, typename T>
+        void broadcastWidened(const T *xLhs, T xScalar, T *xOut, std::size_t xCount) noexcept
+        {
+            alignas(64) float tLhs[gWidenBlock];
+            const auto &tTable = simdTable<float>();
+            const auto tKernel = Op == SimdOp::Add ? tTable.m_AddScalar : Op == SimdOp::Sub ? tTable.m_SubScalar : tTable.m_MulScalar;
+            for (std::size_t i = 0; i < xCount; i += gWidenBlock)
+            {
+                const std::size_t tCount = std::min(gWidenBlock, xCount - i);
+                widen(xLhs + i, tLhs, tCount);
+                tKernel(tLhs, static_cast<float>(xScalar), tLhs, tCount);
+                narrow(tLhs, xOut + i, tCount);
+            }
+        }
+
+        template <SimdOp Op, typename T>
+        void accumulateWidened(const T *xLhs, const T *xRhs, T *xOut, std::size_t xCount) noexcept
+        {
+            alignas(64) float tLhs[gWidenBlock], tRhs[gWidenBlock], tOut[gWidenBlock];
+            const auto &tTable = simdTable<float>();
+            const auto tKernel = Op == SimdOp::Add ? tTable.m_MulAdd : tTable.m_MulSub;
+            for (std::size_t i = 0; i < xCount; i += gWidenBlock)
+            {
+                const std::size_t tCount = std::min(gWidenBlock, xCount - i);
+                widen(xLhs + i, tLhs, tCount);
+                widen(xRhs + i, tRhs, tCount);
+                widen(xOut + i, tOut, tCount);
+                tKernel(tLhs, tRhs, tOut, tCount);
+                narrow(tOut, xOut + i, tCount);
+            }
+        }
+
+        // Accumulates in float and rounds once at the end.
+        template <typename T>
+        T dotWidened(const T *xLhs, const T *xRhs, std::size_t xCount) noexcept
+        {
+            alignas(64) float tLhs[gWidenBlock], tRhs[gWidenBlock];
+            const auto tKernel = simdTable<float>().m_Dot;
+            float tResult{0.0f};
+            for (std::size_t i = 0; i < xCount; i += gWidenBlock)
+            {
+                const std::size_t tCount = std::min(gWidenBlock, xCount - i);
+                widen(xLhs + i, tLhs, tCount);
+                widen(xRhs + i, tRhs, tCount);
+                tResult += tKernel(tLhs, tRhs, tCount);
+            }
+            return T{tResult};
+        }
+    } // namespace Detail
+
+    // xOut[i] = xLhs[i] op xRhs[i]. xOut may be xLhs or xRhs.
+    template <typename T>
+    inline void add(const T *xLhs, const T *xRhs, T *xOut, std::size_t xCount) noexcept
+    {
+        if constexpr (gHasSimdKernels<T>)
+            Detail::simdTable<T>().m_Add(xLhs, xRhs, xOut, xCount);
+        else if constexpr (gIsFloat16<T>)
+            Detail::binaryWidened<Detail::SimdOp::Add>(xLhs, xRhs, xOut, xCount);
+        else
+            Detail::binaryScalar<Detail::SimdOp::Add>(xLhs, xRhs, xOut, xCount);
+    }
+
+    template <typename T>
+    inline void subtract(const T *xLhs, const T *xRhs, T *xOut, std::size_t xCount) noexcept
+    {
+        if constexpr (gHasSimdKernels<T>)
+            Detail::simdTable<T>().m_Sub(xLhs, xRhs, xOut, xCount);
+        else if constexpr (gIsFloat16<T>)
+            Detail::binaryWidened<Detail::SimdOp::Sub>(xLhs, xRhs, xOut, xCount);
+        else
+            Detail::binaryScalar<Detail::SimdOp::Sub>(xLhs, xRhs, xOut, xCount);
+    }
+
+    template <typename T>
+    inline void multiply(const T *xLhs, const T *xRhs, T *xOut, std::size_t xCount) noexcept
+    {
+        if constexpr (gHasSimdKernels<T>)
+            Detail::simdTable<T>().m_Mul(xLhs, xRhs, xOut, xCount);
+        else if constexpr (gIsFloat16<T>)
+            Detail::binaryWidened<Detail::SimdOp::Mul>(xLhs, xRhs, xOut, xCount);
+        else
+            Detail::binaryScalar<Detail::SimdOp::Mul>(xLhs, xRhs, xOut, xCount);
+    }
+
+    // xOut[i] = xLhs[i] op xScalar. xOut may be xLhs.
+    template <typename T>
+    inline void addScalar(const T *xLhs, const T &xScalar, T *xOut, std::size_t xCount) noexcept
+    {
+        if constexpr (gHasSimdKernels<T>)
+            Detail::simdTable<T>().m_AddScalar(xLhs, xScalar, xOut, xCount);
+        else if constexpr (gIsFloat16<T>)
+            Detail::broadcastWidened<Detail::SimdOp::Add>(xLhs, xScalar, xOut, xCount);
+        else
+            Detail::broadcastScalar<Detail::SimdOp::Add>(xLhs, xScalar, xOut, xCount);
+    }
+
+    template <typename T>
+    inline void subtractScalar(const T *xLhs, const T &xScalar, T *xOut, std::size_t xCount) noexcept
+    {
+        if constexpr (gHasSimdKernels<T>)
+            Detail::simdTable<T>().m_SubScalar(xLhs, xScalar, xOut, xCount);
+        else if constexpr (gIsFloat16<T>)
+            Detail::broadcastWidened<Detail::SimdOp::Sub>(xLhs, xScalar, xOut, xCount);
+        else
+            Detail::broadcastScalar<Detail::SimdOp::Sub>(xLhs, xScalar, xOut, xCount);
+    }
+
+    template <typename T>
+    inline void multiplyScalar(const T *xLhs, const T &xScalar, T *xOut, std::size_t xCount) noexcept
+    {
+        if constexpr (gHasSimdKernels<T>)
+            Detail::simdTable<T>().m_MulScalar(xLhs, xScalar, xOut, xCount);
+        else if constexpr (gIsFloat16<T>)
+            Detail::broadcastWidened<Detail::SimdOp::Mul>(xLhs, xScalar, xOut, xCount);
+        else
+            Detail::broadcastScalar<Detail::SimdOp::Mul>(xLhs, xScalar, xOut, xCount);
+    }
+
+    // xOut[i] += xLhs[i] * xRhs[i]. xOut must not alias the inputs.
+    template <typename T>
+    inline void multiplyAdd(const T *xLhs, const T *xRhs, T *xOut, std::size_t xCount) noexcept
+    {
+        if constexpr (gHasSimdKernels<T>)
+            Detail::simdTable<T>().m_MulAdd(xLhs, xRhs, xOut, xCount);
+        else if constexpr (gIsFloat16<T>)
+            Detail::accumulateWidened<Detail::SimdOp::Add>(xLhs, xRhs, xOut, xCount);
+        else
+            Detail::accumulateScalar<Detail::SimdOp::Add>(xLhs, xRhs, xOut, xCount);
+    }
+
+    // xOut[i] -= xLhs[i] * xRhs[i]. xOut must not alias the inputs.
+    template <typename T>
+    inline void multiplySubtract(const T *xLhs, const T *xRhs, T *xOut, std::size_t xCount) noexcept
+    {
+        if constexpr (gHasSimdKernels<T>)
+            Detail::simdTable<T>().m_MulSub(xLhs, xRhs, xOut, xCount);
+        else if constexpr (gIsFloat16<T>)
+            Detail::accumulateWidened<Detail::SimdOp::Sub>(xLhs, xRhs, xOut, xCount);
+        else
+            Detail::accumulateScalar<Detail::SimdOp::Sub>(xLhs, xRhs, xOut, xCount);
+    }
+
+    template <typename T>
+    inline T dot(const T *xLhs, const T *xRhs, std::size_t xCount) noexcept
+    {
+        if constexpr (gHasSimdKernels<T>)
+            return Detail::simdTable<T>().m_Dot(xLhs, xRhs, xCount);
+        else if constexpr (gIsFloat16<T>)
+            return Detail::dotWidened(xLhs, xRhs, xCount);
+        else
+            return Detail::dotScalar(xLhs, xRhs, xCount);
+    }
+
+    // Kernels for the std functors the Matrix expressions are built from.
+    template <typename Operation>
+    constexpr bool gHasElementwiseKernel = std::is_same_v<Operation, std::plus<>> || std::is_same_v<Operation, std::minus<>> ||
+                                           std::is_same_v<Operation, std::multiplies<>>;
+
+    template <typename Operation, typename T>
+    inline void elementwise(const T *xLhs, const T *xRhs, T *xOut, std::size_t xCount) noexcept
+    {
+        static_assert(gHasElementwiseKernel<Operation>);
+        if constexpr (std::is_same_v<Operation, std::plus<>>)
+            add(xLhs, xRhs, xOut, xCount);
+        else if constexpr (std::is_same_v<Operation, std::minus<>>)
+            subtract(xLhs, xRhs, xOut, xCount);
+        else
+            multiply(xLhs, xRhs, xOut, xCount);
+    }
+
+    template <typename Operation, typename T>
+    inline void elementwiseScalar(const T *xLhs, const T &xScalar, T *xOut, std::size_t xCount) noexcept
+    {
+        static_assert(gHasElementwiseKernel<Operation>);
+        if constexpr (std::is_same_v<Operation, std::plus<>>)
+            addScalar(xLhs, xScalar, xOut, xCount);
+        else if constexpr (std::is_same_v<Operation, std::minus<>>)
+            subtractScalar(xLhs, xScalar, xOut, xCount);
+        else
+            multiplyScalar(xLhs, xScalar, xOut, xCount);
+    }
+
+    template <typename T>
+    inline T sumOfSquares(const T *xData, std::size_t xCount) noexcept
+    {
+        return dot(xData, xData, xCount);
+    }
+} // namespace Kernels
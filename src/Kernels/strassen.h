@@ -0,0 +1,138 @@
+#pragma once
+
+#include "gemm.h"
+#include "simd.h"
+#include "../Parallel/threadPool.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace Kernels
+{
+    // Products whose smallest dimension is at or below this go to gemm(). 256 and 512 time
+    // within a few percent of each other (about 1.5x over gemm() at n = 4096); the larger one
+    // saves a level of error growth.
+    constexpr std::size_t gStrassenCutoff{512};
+
+    // Strassen-Winograd (7 products, 15 additions per level) versus the classic kernel.
+    // With u the unit roundoff and ||X|| = max |x_ij|:
+    //   classic:   |C - C^| <= k u |A| |B| componentwise, so ||C - C^|| <= k^2 u ||A|| ||B||;
+    //   Winograd:  ||C - C^|| <= [(n / n0)^log2(18) (n0^2 + 6 n0) - 6 n] u ||A|| ||B||
+    // to first order, for n x n operands and a cutoff n0 (Higham, Accuracy and Stability of
+    // Numerical Algorithms, 2nd ed., ch. 23). Each level multiplies the bound by about 4.5, so
+    // the error stays normwise but not componentwise: small entries of C can lose all their
+    // relative accuracy. Integer valued inputs whose intermediate sums fit the mantissa are
+    // still exact.
+
+    namespace Detail
+    {
+        // xOut = xLhs + xRhs (or -) on xRows x xCols blocks; xOut may alias an operand.
+        template <bool Subtract, typename T>
+        void combineBlocks(std::size_t xRows, std::size_t xCols, const T *xLhs, std::size_t xLdl,
+                           const T *xRhs, std::size_t xLdr, T *xOut, std::size_t xLdo) noexcept
+        {
+            for (std::size_t i = 0; i < xRows; i++)
+            {
+                if constexpr (Subtract)
+                    subtract(xLhs + i * xLdl, xRhs + i * xLdr, xOut + i * xLdo, xCols);
+                else
+                    add(xLhs + i * xLdl, xRhs + i * xLdr, xOut + i * xLdo, xCols);
+            }
+        }
+
+        inline bool strassenLeaf(std::size_t xM, std::size_t xN, std::size_t xK, std::size_t xCutoff) noexcept
+        {
+            return std::min({xM, xN, xK}) <= std::max<std::size_t>(xCutoff, 1);
+        }
+
+        template <typename T>
+        void strassenRecursive(std::size_t xM, std::size_t xN, std::size_t xK, const T *xA, std::size_t xLda,
+                               const T *xB, std::size_t xLdb, T *xC, std::size_t xLdc, T *xWork,
+                               std::size_t xCutoff, Parallel::Executor &xExecutor)
+        {
+            if (strassenLeaf(xM, xN, xK, xCutoff))
+            {
+                gemm(xM, xN, xK, static_cast<T>(1), xA, xLda, xB, xLdb, static_cast<T>(0), xC, xLdc, xExecutor);
+                return;
+            }
+
+            // Recurse on the even part, the odd row, column and inner index are peeled off below.
+            const std::size_t m = xM / 2, n = xN / 2, k = xK / 2;
+            const T *A11 = xA, *A12 = xA + k, *A21 = xA + m * xLda, *A22 = A21 + k;
+            const T *B11 = xB, *B12 = xB + n, *B21 = xB + k * xLdb, *B22 = B21 + n;
+            T *C11 = xC, *C12 = xC + n, *C21 = xC + m * xLdc, *C22 = C21 + n;
+
+            // Level temporaries; deeper levels use the rest of the workspace.
+            T *X = xWork, *Y = X + m * k, *Z = Y + k * n, *tRest = Z + m * n;
+            const auto tProduct = [&](const T *xL, std::size_t xLdl, const T *xR, std::size_t xLdr, T *xOut, std::size_t xLdo)
+            { strassenRecursive(m, n, k, xL, xLdl, xR, xLdr, xOut, xLdo, tRest, xCutoff, xExecutor); };
+
+            combineBlocks<true>(m, k, A11, xLda, A21, xLda, X, k); // S3 = A11 - A21
+            combineBlocks<true>(k, n, B22, xLdb, B12, xLdb, Y, n); // T3 = B22 - B12
+            tProduct(X, k, Y, n, C21, xLdc);           // P7 = S3 T3
+            combineBlocks<false>(m, k, A21, xLda, A22, xLda, X, k); // S1 = A21 + A22
+            combineBlocks<true>(k, n, B12, xLdb, B11, xLdb, Y, n);  // T1 = B12 - B11
+            tProduct(X, k, Y, n, C22, xLdc);           // P5 = S1 T1
+            combineBlocks<true>(m, k, X, k, A11, xLda, X, k);       // S2 = S1 - A11
+            combineBlocks<true>(k, n, B22, xLdb, Y, n, Y, n);       // T2 = B22 - T1
+            tProduct(X, k, Y, n, C12, xLdc);           // P6 = S2 T2
+            combineBlocks<true>(m, k, A12, xLda, X, k, X, k);       // S4 = A12 - S2
+            tProduct(X, k, B22, xLdb, C11, xLdc);      // P3 = S4 B22
+            tProduct(A11, xLda, B11, xLdb, Z, n);      // P1 = A11 B11
+            combineBlocks<false>(m, n, Z, n, C12, xLdc, C12, xLdc);     // U2 = P1 + P6
+            combineBlocks<false>(m, n, C12, xLdc, C21, xLdc, C21, xLdc); // U3 = U2 + P7
+            combineBlocks<false>(m, n, C12, xLdc, C22, xLdc, C12, xLdc); // U4 = U2 + P5
+            combineBlocks<false>(m, n, C21, xLdc, C22, xLdc, C22, xLdc); // C22 = U3 + P5
+            combineBlocks<false>(m, n, C12, xLdc, C11, xLdc, C12, xLdc); // C12 = U4 + P3
+            combineBlocks<true>(k, n, Y, n, B21, xLdb, Y, n);            // T4 = T2 - B21
+            tProduct(A22, xLda, Y, n, C11, xLdc);      // P4 = A22 T4
+            combineBlocks<true>(m, n, C21, xLdc, C11, xLdc, C21, xLdc);  // C21 = U3 - P4
+            tProduct(A12, xLda, B21, xLdb, C11, xLdc); // P2 = A12 B21
+            combineBlocks<false>(m, n, C11, xLdc, Z, n, C11, xLdc);      // C11 = P1 + P2
+
+            // Dynamic peeling of the odd dimensions.
+            if (xK > 2 * k)
+                gemm(2 * m, 2 * n, std::size_t{1}, static_cast<T>(1), xA + 2 * k, xLda, xB + 2 * k * xLdb, xLdb,
+                     static_cast<T>(1), xC, xLdc, xExecutor);
+            if (xN > 2 * n)
+                gemm(xM, std::size_t{1}, xK, static_cast<T>(1), xA, xLda, xB + 2 * n, xLdb, static_cast<T>(0), xC + 2 * n, xLdc, xExecutor);
+            if (xM > 2 * m)
+                gemm(std::size_t{1}, 2 * n, xK, static_cast<T>(1), xA + 2 * m * xLda, xLda, xB, xLdb, static_cast<T>(0),
+                     xC + 2 * m * xLdc, xLdc, xExecutor);
+        }
+    } // namespace Detail
+
+    // Elements of workspace strassen() needs for an xM x xK times xK x xN product:
+    // about (mk + kn + mn) / 3 in total over all levels.
+    inline std::size_t strassenWorkspace(std::size_t xM, std::size_t xN, std::size_t xK, std::size_t xCutoff = gStrassenCutoff) noexcept
+    {
+        std::size_t tSize{0};
+        while (!Detail::strassenLeaf(xM, xN, xK, xCutoff))
+        {
+            xM /= 2, xN /= 2, xK /= 2;
+            tSize += xM * xK + xK * xN + xM * xN;
+        }
+        return tSize;
+    }
+
+    // C = A * B by Strassen-Winograd recursion down to gemm() at xCutoff. xWork must hold
+    // strassenWorkspace(xM, xN, xK, xCutoff) elements; nothing is allocated per level. C must
+    // not alias A or B.
+    template <typename T>
+    void strassen(std::size_t xM, std::size_t xN, std::size_t xK, const T *xA, std::size_t xLda, const T *xB, std::size_t xLdb,
+                  T *xC, std::size_t xLdc, T *xWork, std::size_t xCutoff, Parallel::Executor &xExecutor)
+    {
+        if (xM == 0 || xN == 0)
+            return;
+        Detail::strassenRecursive(xM, xN, xK, xA, xLda, xB, xLdb, xC, xLdc, xWork, xCutoff, xExecutor);
+    }
+
+    // As above with a workspace allocated once for the whole recursion.
+    template <typename T>
+    void strassen(std::size_t xM, std::size_t xN, std::size_t xK, const T *xA, std::size_t xLda, const T *xB, std::size_t xLdb,
+                  T *xC, std::size_t xLdc, std::size_t xCutoff, Parallel::Executor &xExecutor)
+    {
+        Detail::PackBuffer<T> tWorkspace(strassenWorkspace(xM, xN, xK, xCutoff));
+        strassen(xM, xN, xK, xA, xLda, xB, xLdb, xC, xLdc, tWorkspace.data(), xCutoff, xExecutor);
+    }
+} // namespace Kernels
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Kernels
+{
+    // Side length of the tiles the recursive transposes bottom out in; 32 x 32 doubles
+    // for source and destination fit in L1 together.
+    constexpr std::size_t gTransposeTile{32};
+
+    // Out-of-place: dst (xCols x xRows, leading dimension xLdd) = transpose of src (xRows x xCols, xLds).
+    // Recursively halves the longer side, which is cache-oblivious down to gTransposeTile.
+    template <typename T>
+    void transpose(std::size_t xRows, std::size_t xCols, const T *xSrc, std::size_t xLds, T *xDst, std::size_t xLdd) noexcept
+    {
+        if (xRows <= gTransposeTile && xCols <= gTransposeTile)
+        {
+            for (std::size_t i = 0; i < xRows; i++)
+                for (std::size_t j = 0; j < xCols; j++)
+                    xDst[j * xLdd + i] = xSrc[i * xLds + j];
+            return;
+        }
+
+        if (xRows >= xCols)
+        {
+            const std::size_t tHalf = xRows / 2;
+            transpose(tHalf, xCols, xSrc, xLds, xDst, xLdd);
+            transpose(xRows - tHalf, xCols, xSrc + tHalf * xLds, xLds, xDst + tHalf, xLdd);
+        }
+        else
+        {
+            const std::size_t tHalf = xCols / 2;
+            transpose(xRows, tHalf, xSrc, xLds, xDst, xLdd);
+            transpose(xRows, xCols - tHalf, xSrc + tHalf, xLds, xDst + tHalf * xLdd, xLdd);
+        }
+    }
+
+    // In-place transpose of a square xN x xN matrix: tiles on the diagonal are
+    // transposed in place, every other tile is swapped with its mirror.
+    template <typename T>
+    void transposeSquareInPlace(std::size_t xN, T *xData, std::size_t xLd) noexcept
+    {
+        using std::swap;
+        for (std::size_t ib = 0; ib < xN; ib += gTransposeTile)
+        {
+            const std::size_t tRowEnd = std::min(ib + gTransposeTile, xN);
+            for (std::size_t jb = ib; jb < xN; jb += gTransposeTile)
+            {
+                const std::size_t tColEnd = std::min(jb + gTransposeTile, xN);
+                for (std::size_t i = ib; i < tRowEnd; i++)
+                    for (std::size_t j = std::max(jb, i + 1); j < tColEnd; j++)
+                        swap(xData[i * xLd + j], xData[j * xLd + i]);
+            }
+        }
+    }
+
+    // In-place transpose of a dense xRows x xCols row-major buffer by following the
+    // permutation cycles p -> p * xRows mod (xRows * xCols - 1). Needs one bit per element.
+    template <typename T>
+    void transposeInPlace(std::size_t xRows, std::size_t xCols, T *xData)
+    {
+        if (xRows == xCols)
+        {
+            transposeSquareInPlace(xRows, xData, xCols);
+            return;
+        }
+
+        const std::size_t tSize = xRows * xCols;
+        if (tSize < 3 || xRows == 1 || xCols == 1)
+            return; // a vector has the same layout either way
+
+        const std::size_t tModulus = tSize - 1;
+        std::vector<bool> tVisited(tSize, false);
+        for (std::size_t tStart = 1; tStart < tModulus; tStart++)
+        {
+            if (tVisited[tStart])
+                continue;
+
+            // Walk the cycle backwards: the element that ends up in tPos comes from
+            // tPos * xCols mod (size - 1).
+            T tCarry = std::move(xData[tStart]);
+            std::size_t tPos = tStart;
+            while (true)
+            {
+                tVisited[tPos] = true;
+                const std::size_t tFrom = static_cast<std::size_t>((static_cast<unsigned long long>(tPos) * xCols) % tModulus);
+                if (tFrom == tStart)
+                {
+                    xData[tPos] = std::move(tCarry);
+                    break;
+                }
+                xData[tPos] = std::move(xData[tFrom]);
+                tPos = tFrom;
+            }
+        }
+    }
+} // namespace Kernels
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "gemm.h"
+#include "../Parallel/threadPool.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace Kernels
+{
+    // Triangular blocks at or below this size are solved by substitution; larger ones are
+    // halved and the off-diagonal part is updated with gemm.
+    constexpr std::size_t gTrsmBlock{32};
+
+    namespace Detail
+    {
+        template <bool Unit, typename T>
+        void trsmLowerSmall(std::size_t xN, std::size_t xM, const T *xL, std::size_t xLdl, T *xB, std::size_t xLdb) noexcept
+        {
+            for (std::size_t i = 0; i < xN; i++)
+            {
+                T *tRow = xB + i * xLdb;
+                for (std::size_t p = 0; p < i; p++)
+                {
+                    const T tFactor = xL[i * xLdl + p];
+                    const T *tSolved = xB + p * xLdb;
+                    for (std::size_t c = 0; c < xM; c++)
+                        tRow[c] -= tFactor * tSolved[c];
+                }
+                if constexpr (!Unit)
+                {
+                    const T tInverse = static_cast<T>(1) / xL[i * xLdl + i];
+                    for (std::size_t c = 0; c < xM; c++)
+                        tRow[c] *= tInverse;
+                }
+            }
+        }
+
+        template <bool Unit, typename T>
+        void trsmUpperSmall(std::size_t xN, std::size_t xM, const T *xU, std::size_t xLdu, T *xB, std::size_t xLdb) noexcept
+        {
+            for (std::size_t i = xN; i-- > 0;)
+            {
+                T *tRow = xB + i * xLdb;
+                for (std::size_t p = i + 1; p < xN; p++)
+                {
+                    const T tFactor = xU[i * xLdu + p];
+                    const T *tSolved = xB + p * xLdb;
+                    for (std::size_t c = 0; c < xM; c++)
+                        tRow[c] -= tFactor * tSolved[c];
+                }
+                if constexpr (!Unit)
+                {
+                    const T tInverse = static_cast<T>(1) / xU[i * xLdu + i];
+                    for (std::size_t c = 0; c < xM; c++)
+                        tRow[c] *= tInverse;
+                }
+            }
+        }
+
+        template <bool Unit, typename T>
+        void trsmLowerSequential(std::size_t xN, std::size_t xM, const T *xL, std::size_t xLdl, T *xB, std::size_t xLdb)
+        {
+            if (xN <= gTrsmBlock)
+            {
+                trsmLowerSmall<Unit>(xN, xM, xL, xLdl, xB, xLdb);
+                return;
+            }
+            const std::size_t tTop = xN / 2;
+            trsmLowerSequential<Unit>(tTop, xM, xL, xLdl, xB, xLdb);
+            gemmSequential(xN - tTop, xM, tTop, static_cast<T>(-1), xL + tTop * xLdl, xLdl, xB, xLdb, static_cast<T>(1),
+                           xB + tTop * xLdb, xLdb);
+            trsmLowerSequential<Unit>(xN - tTop, xM, xL + tTop * xLdl + tTop, xLdl, xB + tTop * xLdb, xLdb);
+        }
+
+        template <bool Unit, typename T>
+        void trsmUpperSequential(std::size_t xN, std::size_t xM, const T *xU, std::size_t xLdu, T *xB, std::size_t xLdb)
+        {
+            if (xN <= gTrsmBlock)
+            {
+                trsmUpperSmall<Unit>(xN, xM, xU, xLdu, xB, xLdb);
+                return;
+            }
+            const std::size_t tTop = xN / 2;
+            trsmUpperSequential<Unit>(xN - tTop, xM, xU + tTop * xLdu + tTop, xLdu, xB + tTop * xLdb, xLdb);
+            gemmSequential(tTop, xM, xN - tTop, static_cast<T>(-1), xU + tTop, xLdu, xB + tTop * xLdb, xLdb, static_cast<T>(1),
+                           xB, xLdb);
+            trsmUpperSequential<Unit>(tTop, xM, xU, xLdu, xB, xLdb);
+        }
+
+        // The columns of B are independent right-hand sides, so large solves split them.
+        template <typename Solve>
+        void trsmColumns(std::size_t xN, std::size_t xM, Parallel::Executor &xExecutor, const Solve &xSolve)
+        {
+            constexpr std::size_t tAlign{16};
+            const std::size_t tParts = xN * xN * xM < gGemmParallelProduct ? 1 : std::min(xExecutor.concurrency(), (xM + tAlign - 1) / tAlign);
+            if (tParts <= 1)
+            {
+                xSolve(0, xM);
+                return;
+            }
+            xExecutor.parallelFor(tParts, [&](std::size_t xPart)
+                                  {
+                                      const std::size_t tFirst = xM * xPart / tParts / tAlign * tAlign;
+                                      const std::size_t tLast = xPart + 1 == tParts ? xM : xM * (xPart + 1) / tParts / tAlign * tAlign;
+                                      xSolve(tFirst, tLast);
+                                  });
+        }
+    } // namespace Detail
+
+    // Solves L X = B in place for the xN x xN lower triangle of L and the xN x xM matrix B.
+    // Unit skips the division by a diagonal that is implicitly one.
+    template <bool Unit, typename T>
+    void trsmLower(std::size_t xN, std::size_t xM, const T *xL, std::size_t xLdl, T *xB, std::size_t xLdb, Parallel::Executor &xExecutor)
+    {
+        Detail::trsmColumns(xN, xM, xExecutor, [&](std::size_t xFirst, std::size_t xLast)
+                            { Detail::trsmLowerSequential<Unit>(xN, xLast - xFirst, xL, xLdl, xB + xFirst, xLdb); });
+    }
+
+    // Solves U X = B in place for the xN x xN upper triangle of U.
+    template <bool Unit, typename T>
+    void trsmUpper(std::size_t xN, std::size_t xM, const T *xU, std::size_t xLdu, T *xB, std::size_t xLdb, Parallel::Executor &xExecutor)
+    {
+        Detail::trsmColumns(xN, xM, xExecutor, [&](std::size_t xFirst, std::size_t xLast)
+                            { Detail::trsmUpperSequential<Unit>(xN, xLast - xFirst, xU, xLdu, xB + xFirst, xLdb); });
+    }
+} // namespace Kernels
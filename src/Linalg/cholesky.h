@@ -0,0 +1,296 @@
+#pragma once
+
+#include "../matrix.h"
+#include "../vector.h"
+#include "../Kernels/gemm.h"
+#include "../Kernels/simd.h"
+#include "../Kernels/transpose.h"
+#include "../Kernels/trsm.h"
+#include "../Parallel/threadPool.h"
+#include "../Types/column.h"
+#include "../Types/row.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Linalg
+{
+    // Columns per panel of the blocked factorization, and rows per block of the trailing update.
+    constexpr std::size_t gCholeskyBlock{128};
+
+    namespace Detail
+    {
+        // Row-oriented Cholesky of the xSize x xSize diagonal block; false if it is not
+        // positive definite.
+        template <typename T>
+        bool factorDiagonal(std::size_t xSize, T *xA, std::size_t xLda) noexcept
+        {
+            for (std::size_t i = 0; i < xSize; i++)
+            {
+                T *tRow = xA + i * xLda;
+                for (std::size_t k = 0; k <= i; k++)
+                {
+                    const T *tPivotRow = xA + k * xLda;
+                    const T tValue = tRow[k] - Kernels::dot(tRow, tPivotRow, k);
+                    if (k < i)
+                    {
+                        tRow[k] = tValue / tPivotRow[k];
+                    }
+                    else
+                    {
+                        if (!(tValue > static_cast<T>(0)))
+                            return false;
+                        tRow[i] = std::sqrt(tValue);
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Rows [xFirst, xLast) of the panel below the diagonal block: x L11^T = a, row by row.
+        template <typename T>
+        void solvePanelRows(std::size_t xSize, const T *xL, std::size_t xLdl, T *xRows, std::size_t xLda, std::size_t xFirst,
+                            std::size_t xLast) noexcept
+        {
+            for (std::size_t r = xFirst; r < xLast; r++)
+            {
+                T *tRow = xRows + r * xLda;
+                for (std::size_t k = 0; k < xSize; k++)
+                    tRow[k] = (tRow[k] - Kernels::dot(tRow, xL + k * xLdl, k)) / xL[k * xLdl + k];
+            }
+        }
+    } // namespace Detail
+
+    // A = L L^T of a symmetric positive definite matrix, L lower triangular with a positive
+    // diagonal (the strict upper triangle of getL() is zero).
+    template <typename T>
+    class CholeskyDecomposition
+    {
+        static_assert(std::is_floating_point_v<T>, "CholeskyDecomposition needs a floating point type");
+
+    private:
+        Matrix<T> m_L{Matrix<T>::create()};
+
+        T *row(std::size_t xRow) noexcept { return m_L.getData().data() + xRow * m_L.getLeadingDimension(); }
+        const T *row(std::size_t xRow) const noexcept { return m_L.getData().data() + xRow * m_L.getLeadingDimension(); }
+
+    public:
+        explicit CholeskyDecomposition(Matrix<T> xL) noexcept : m_L{std::move(xL)} {}
+
+        std::size_t size() const noexcept { return m_L.getRows().get(); }
+        const Matrix<T> &getL() const noexcept { return m_L; }
+
+        T det() const noexcept;
+        // log(det(A)), which does not overflow for large matrices.
+        T logDet() const noexcept;
+
+        // std::nullopt if the sizes differ.
+        std::optional<Vector<T>> solve(const Vector<T> &xRhs) const;
+        std::optional<Matrix<T>> solve(const Matrix<T> &xRhs, Parallel::Executor &xExecutor) const;
+        std::optional<Matrix<T>> solve(const Matrix<T> &xRhs) const { return solve(xRhs, Parallel::defaultExecutor()); }
+
+        // Refactors A + x x^T (update) or A - x x^T (downdate) in O(n^2) with Givens
+        // rotations. Return false, leaving the factor unchanged, if the sizes differ or, for
+        // the downdate, if the result would not be positive definite.
+        bool update(const Vector<T> &xVector);
+        bool downdate(const Vector<T> &xVector);
+    };
+
+    // Right-looking blocked Cholesky that reads only the lower triangle of xMatrix. The panel
+    // below each diagonal block is solved row by row in parallel, the trailing lower triangle
+    // is updated with gemm on xExecutor, block row by block row. std::nullopt if xMatrix is not
+    // square or not positive definite.
+    template <typename T, typename Allocator>
+    std::optional<CholeskyDecomposition<T>> cholesky(const Matrix<T, Allocator> &xMatrix, Parallel::Executor &xExecutor)
+    {
+        const std::size_t n = xMatrix.getRows().get();
+        if (n != xMatrix.getCols().get())
+            return std::nullopt;
+
+        auto tL = Matrix<T>::create(xMatrix.getRows(), xMatrix.getCols());
+        for (std::size_t i = 0; i < n; i++)
+            for (std::size_t j = 0; j <= i; j++)
+                tL(i, j) = xMatrix(i, j);
+
+        T *A = tL.getData().data();
+        const std::size_t tLda = tL.getLeadingDimension();
+        Kernels::Detail::PackBuffer<T> tPanelTransposed(std::min(n, gCholeskyBlock) * n);
+        for (std::size_t j = 0; j < n; j += gCholeskyBlock)
+        {
+            const std::size_t tWidth = std::min(gCholeskyBlock, n - j), tNext = j + tWidth, tBelow = n - tNext;
+            T *tDiagonal = A + j * tLda + j;
+            if (!Detail::factorDiagonal(tWidth, tDiagonal, tLda))
+                return std::nullopt;
+            if (tBelow == 0)
+                break;
+
+            T *tPanel = A + tNext * tLda + j;
+            const std::size_t tParts = tBelow * tWidth * tWidth < Kernels::gGemmParallelProduct ? 1 : std::min(xExecutor.concurrency(), tBelow);
+            xExecutor.parallelFor(tParts, [&](std::size_t xPart)
+                                  { Detail::solvePanelRows(tWidth, tDiagonal, tLda, tPanel, tLda, tBelow * xPart / tParts, tBelow * (xPart + 1) / tParts); });
+
+            // A22 -= L21 L21^T on the lower triangle; the diagonal blocks are computed in full
+            // and their upper part cleared at the end.
+            Kernels::transpose(tBelow, tWidth, tPanel, tLda, tPanelTransposed.data(), tBelow);
+            for (std::size_t i = 0; i < tBelow; i += gCholeskyBlock)
+            {
+                const std::size_t tRows = std::min(gCholeskyBlock, tBelow - i);
+                Kernels::gemm(tRows, i + tRows, tWidth, static_cast<T>(-1), tPanel + i * tLda, tLda, tPanelTransposed.data(), tBelow,
+                              static_cast<T>(1), A + (tNext + i) * tLda + tNext, tLda, xExecutor);
+            }
+        }
+
+        for (std::size_t i = 0; i < n; i++)
+            std::fill(A + i * tLda + i + 1, A + i * tLda + n, static_cast<T>(0));
+        return CholeskyDecomposition<T>{std::move(tL)};
+    }
+
+    template <typename T, typename Allocator>
+    std::optional<CholeskyDecomposition<T>> cholesky(const Matrix<T, Allocator> &xMatrix)
+    {
+        return cholesky(xMatrix, Parallel::defaultExecutor());
+    }
+
+    // Solves A X = B for symmetric positive definite A; std::nullopt if A is not square or
+    // not positive definite, or the sizes differ.
+    template <typename T, typename Allocator>
+    std::optional<Matrix<T>> choleskySolve(const Matrix<T, Allocator> &xMatrix, const Matrix<T> &xRhs)
+    {
+        const auto tCholesky = cholesky(xMatrix);
+        return tCholesky ? tCholesky->solve(xRhs) : std::nullopt;
+    }
+
+    template <typename T, typename Allocator>
+    std::optional<Vector<T>> choleskySolve(const Matrix<T, Allocator> &xMatrix, const Vector<T> &xRhs)
+    {
+        const auto tCholesky = cholesky(xMatrix);
+        return tCholesky ? tCholesky->solve(xRhs) : std::nullopt;
+    }
+
+    template <typename T>
+    inline T CholeskyDecomposition<T>::det() const noexcept
+    {
+        T tResult{static_cast<T>(1)};
+        for (std::size_t i = 0; i < size(); i++)
+            tResult *= m_L(i, i) * m_L(i, i);
+        return tResult;
+    }
+
+    template <typename T>
+    inline T CholeskyDecomposition<T>::logDet() const noexcept
+    {
+        T tResult{static_cast<T>(0)};
+        for (std::size_t i = 0; i < size(); i++)
+            tResult += std::log(m_L(i, i));
+        return 2 * tResult;
+    }
+
+    template <typename T>
+    inline std::optional<Vector<T>> CholeskyDecomposition<T>::solve(const Vector<T> &xRhs) const
+    {
+        const std::size_t n = size();
+        if (xRhs.size() != n)
+            return std::nullopt;
+
+        auto tResult = Vector<T>::create(xRhs.getData());
+        T *x = tResult.getData().data();
+        // L y = b by dot products along the rows of L, then L^T x = y by axpys along them.
+        for (std::size_t i = 0; i < n; i++)
+            x[i] = (x[i] - Kernels::dot(row(i), x, i)) / row(i)[i];
+        for (std::size_t i = n; i-- > 0;)
+        {
+            const T *tRow = row(i);
+            x[i] /= tRow[i];
+            for (std::size_t p = 0; p < i; p++)
+                x[p] -= tRow[p] * x[i];
+        }
+        return tResult;
+    }
+
+    template <typename T>
+    inline std::optional<Matrix<T>> CholeskyDecomposition<T>::solve(const Matrix<T> &xRhs, Parallel::Executor &xExecutor) const
+    {
+        const std::size_t n = size();
+        if (xRhs.getRows().get() != n)
+            return std::nullopt;
+
+        auto tResult = Matrix<T>::create(xRhs);
+        T *tData = tResult.getData().data();
+        const std::size_t tLdb = tResult.getLeadingDimension(), tCols = tResult.getCols().get();
+        Kernels::trsmLower<false>(n, tCols, m_L.getData().data(), m_L.getLeadingDimension(), tData, tLdb, xExecutor);
+        // One O(n^2) transpose lets the second solve run on rows of L^T, amortized over the
+        // right-hand sides.
+        const auto tUpper = m_L.transposed();
+        Kernels::trsmUpper<false>(n, tCols, tUpper.getData().data(), tUpper.getLeadingDimension(), tData, tLdb, xExecutor);
+        return tResult;
+    }
+
+    template <typename T>
+    inline bool CholeskyDecomposition<T>::update(const Vector<T> &xVector)
+    {
+        const std::size_t n = size();
+        if (xVector.size() != n)
+            return false;
+
+        // The rotation of column k mixes L(:, k) with the running x; applying them row by row
+        // keeps every access on a contiguous row of L.
+        std::vector<T> tCos(n), tSin(n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            T *tRow = row(i);
+            T x = xVector[i];
+            for (std::size_t k = 0; k < i; k++)
+            {
+                tRow[k] = (tRow[k] + tSin[k] * x) / tCos[k];
+                x = tCos[k] * x - tSin[k] * tRow[k];
+            }
+            const T r = std::hypot(tRow[i], x);
+            tCos[i] = r / tRow[i];
+            tSin[i] = x / tRow[i];
+            tRow[i] = r;
+        }
+        return true;
+    }
+
+    template <typename T>
+    inline bool CholeskyDecomposition<T>::downdate(const Vector<T> &xVector)
+    {
+        const std::size_t n = size();
+        if (xVector.size() != n)
+            return false;
+
+        // A - x x^T stays positive definite iff ||L^-1 x|| < 1; checking first keeps the
+        // factor intact on failure.
+        std::vector<T> p(xVector.getData().begin(), xVector.getData().end());
+        T tNorm{static_cast<T>(0)};
+        for (std::size_t i = 0; i < n; i++)
+        {
+            p[i] = (p[i] - Kernels::dot(row(i), p.data(), i)) / row(i)[i];
+            tNorm += p[i] * p[i];
+        }
+        if (!(tNorm < static_cast<T>(1)))
+            return false;
+
+        std::vector<T> tCos(n), tSin(n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            T *tRow = row(i);
+            T x = xVector[i];
+            for (std::size_t k = 0; k < i; k++)
+            {
+                tRow[k] = (tRow[k] - tSin[k] * x) / tCos[k];
+                x = tCos[k] * x - tSin[k] * tRow[k];
+            }
+            const T r = std::sqrt((tRow[i] - x) * (tRow[i] + x));
+            tCos[i] = r / tRow[i];
+            tSin[i] = x / tRow[i];
+            tRow[i] = r;
+        }
+        return true;
+    }
+} // namespace Linalg
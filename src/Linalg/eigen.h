@@ -0,0 +1,321 @@
+#pragma once
+
+#include "qr.h"
+#include "../matrix.h"
+#include "../Kernels/gemm.h"
+#include "../Kernels/simd.h"
+#include "../Kernels/transpose.h"
+#include "../Parallel/threadPool.h"
+#include "../Types/column.h"
+#include "../Types/row.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Linalg
+{
+    // Implicit QL sweeps allowed per eigenvalue before giving up.
+    constexpr std::size_t gEigenMaxSweeps{60};
+
+    namespace Detail
+    {
+        // Runs xBody(first, last) over row ranges, on xExecutor once the trailing matrix has
+        // about as many entries as a small gemm does multiply-adds.
+        template <typename Body>
+        void forRowRanges(std::size_t xRows, std::size_t xWork, Parallel::Executor &xExecutor, const Body &xBody)
+        {
+            const std::size_t tParts = xWork < Kernels::gGemmSmallProduct ? 1 : std::min(xExecutor.concurrency(), xRows);
+            if (tParts <= 1)
+            {
+                xBody(0, xRows);
+                return;
+            }
+            xExecutor.parallelFor(tParts, [&](std::size_t xPart)
+                                  { xBody(xRows * xPart / tParts, xRows * (xPart + 1) / tParts); });
+        }
+
+        // Householder reduction of the full symmetric xA to tridiagonal form Q^T A Q, diagonal
+        // in xDiagonal, subdiagonal in xOffDiagonal. Reflector k acts on rows k + 1 ...; its
+        // tail is stored below the subdiagonal of column k, which is the geqrf layout of
+        // A(1:, :), so QrDecomposition can apply Q later.
+        template <typename T>
+        void tridiagonalize(Matrix<T> &xA, std::vector<T> &xTau, std::vector<T> &xDiagonal, std::vector<T> &xOffDiagonal,
+                            Parallel::Executor &xExecutor)
+        {
+            const std::size_t n = xA.getRows().get(), tLda = xA.getLeadingDimension();
+            T *A = xA.getData().data();
+            std::vector<T> v(n), p(n);
+
+            for (std::size_t k = 0; k + 2 < n; k++)
+            {
+                // x = A(k + 1:, k), read from row k by symmetry.
+                const std::size_t m = n - k - 1;
+                const T *x = A + k * tLda + k + 1;
+                const T tAlpha = x[0];
+                const T tTail = Kernels::dot(x + 1, x + 1, m - 1);
+                T tTau{static_cast<T>(0)};
+                T tBeta = tAlpha;
+                v[0] = static_cast<T>(1);
+                std::fill(v.begin() + 1, v.begin() + m, static_cast<T>(0));
+                if (tTail != static_cast<T>(0))
+                {
+                    tBeta = tAlpha >= static_cast<T>(0) ? -std::sqrt(tAlpha * tAlpha + tTail) : std::sqrt(tAlpha * tAlpha + tTail);
+                    tTau = (tBeta - tAlpha) / tBeta;
+                    const T tScale = static_cast<T>(1) / (tAlpha - tBeta);
+                    for (std::size_t i = 1; i < m; i++)
+                        v[i] = x[i] * tScale;
+                }
+                xTau[k] = tTau;
+                xDiagonal[k] = A[k * tLda + k];
+                xOffDiagonal[k] = tBeta;
+                for (std::size_t i = 1; i < m; i++)
+                    A[(k + 1 + i) * tLda + k] = v[i];
+                if (tTau == static_cast<T>(0))
+                    continue;
+
+                // A22 = H A22 H with p = tau A22 v, w = p - (tau / 2)(p^T v) v and
+                // A22 -= v w^T + w v^T.
+                T *A22 = A + (k + 1) * tLda + k + 1;
+                forRowRanges(m, m * m, xExecutor, [&](std::size_t xFirst, std::size_t xLast)
+                             {
+                                 for (std::size_t r = xFirst; r < xLast; r++)
+                                     p[r] = tTau * Kernels::dot(A22 + r * tLda, v.data(), m);
+                             });
+                const T tK = tTau / 2 * Kernels::dot(p.data(), v.data(), m);
+                for (std::size_t i = 0; i < m; i++)
+                    p[i] -= tK * v[i];
+                forRowRanges(m, m * m, xExecutor, [&](std::size_t xFirst, std::size_t xLast)
+                             {
+                                 for (std::size_t r = xFirst; r < xLast; r++)
+                                 {
+                                     T *tRow = A22 + r * tLda;
+                                     const T tV = v[r], tW = p[r];
+                                     for (std::size_t c = 0; c < m; c++)
+                                         tRow[c] -= tV * p[c] + tW * v[c];
+                                 }
+                             });
+            }
+            if (n >= 2)
+            {
+                xDiagonal[n - 2] = A[(n - 2) * tLda + n - 2];
+                xOffDiagonal[n - 2] = A[(n - 1) * tLda + n - 2];
+            }
+            if (n >= 1)
+                xDiagonal[n - 1] = A[(n - 1) * tLda + n - 1];
+        }
+
+        template <typename T>
+        struct Rotation
+        {
+            std::size_t m_Index;
+            T m_Cos, m_Sin;
+        };
+
+        // Applies the rotations of one sweep to rows (i, i + 1) of the xN x xN matrix xZt.
+        // Column strips stay in cache while all rotations of the sweep pass over them.
+        template <typename T>
+        void applyRotations(const std::vector<Rotation<T>> &xRotations, Matrix<T> &xZt, Parallel::Executor &xExecutor)
+        {
+            constexpr std::size_t tStrip{64};
+            const std::size_t n = xZt.getCols().get(), tLdz = xZt.getLeadingDimension();
+            const std::size_t tStrips = (n + tStrip - 1) / tStrip;
+            T *Z = xZt.getData().data();
+            forRowRanges(tStrips, xRotations.size() * n, xExecutor, [&](std::size_t xFirst, std::size_t xLast)
+                         {
+                             const std::size_t tBegin = xFirst * tStrip, tEnd = std::min(n, xLast * tStrip);
+                             for (const auto &tRotation : xRotations)
+                             {
+                                 T *tUpper = Z + tRotation.m_Index * tLdz, *tLower = tUpper + tLdz;
+                                 for (std::size_t c = tBegin; c < tEnd; c++)
+                                 {
+                                     const T f = tLower[c];
+                                     tLower[c] = tRotation.m_Sin * tUpper[c] + tRotation.m_Cos * f;
+                                     tUpper[c] = tRotation.m_Cos * tUpper[c] - tRotation.m_Sin * f;
+                                 }
+                             }
+                         });
+        }
+
+        // Implicit QL with Wilkinson-type shifts on the symmetric tridiagonal (d, e). If xZt is
+        // given, its rows are rotated along (row i ends up as the eigenvector of d[i]). False if
+        // an eigenvalue does not converge.
+        template <typename T>
+        bool tridiagonalQl(std::vector<T> &d, std::vector<T> &e, Matrix<T> *xZt, Parallel::Executor &xExecutor)
+        {
+            const std::size_t n = d.size();
+            if (n == 0)
+                return true;
+            e.resize(n);
+            e[n - 1] = static_cast<T>(0);
+
+            std::vector<Rotation<T>> tRotations;
+            for (std::size_t l = 0; l < n; l++)
+            {
+                std::size_t tSweeps{0};
+                for (;;)
+                {
+                    std::size_t m = l;
+                    for (; m + 1 < n; m++)
+                        if (std::abs(e[m]) <= std::numeric_limits<T>::epsilon() * (std::abs(d[m]) + std::abs(d[m + 1])))
+                            break;
+                    if (m == l)
+                        break;
+                    if (tSweeps++ == gEigenMaxSweeps)
+                        return false;
+
+                    T g = (d[l + 1] - d[l]) / (2 * e[l]);
+                    T r = std::hypot(g, static_cast<T>(1));
+                    g = d[m] - d[l] + e[l] / (g + std::copysign(r, g));
+                    T s{static_cast<T>(1)}, c{static_cast<T>(1)}, p{static_cast<T>(0)};
+                    bool tDeflated{false};
+                    tRotations.clear();
+                    for (std::size_t i = m; i-- > l;)
+                    {
+                        const T f = s * e[i], b = c * e[i];
+                        r = std::hypot(f, g);
+                        e[i + 1] = r;
+                        if (r == static_cast<T>(0))
+                        {
+                            d[i + 1] -= p;
+                            e[m] = static_cast<T>(0);
+                            tDeflated = true;
+                            break;
+                        }
+                        s = f / r;
+                        c = g / r;
+                        g = d[i + 1] - p;
+                        r = (d[i] - g) * s + 2 * c * b;
+                        p = s * r;
+                        d[i + 1] = g + p;
+                        g = c * r - b;
+                        if (xZt)
+                            tRotations.push_back({i, c, s});
+                    }
+                    if (xZt)
+                        applyRotations(tRotations, *xZt, xExecutor);
+                    if (tDeflated)
+                        continue;
+                    d[l] -= p;
+                    e[l] = g;
+                    e[m] = static_cast<T>(0);
+                }
+            }
+            return true;
+        }
+
+        // Lower triangle of xMatrix mirrored into a full symmetric copy.
+        template <typename T, typename Allocator>
+        Matrix<T> symmetricCopy(const Matrix<T, Allocator> &xMatrix)
+        {
+            const std::size_t n = xMatrix.getRows().get();
+            auto tResult = Matrix<T>::create(Row{n}, Column{n});
+            for (std::size_t i = 0; i < n; i++)
+                for (std::size_t j = 0; j <= i; j++)
+                    tResult(i, j) = tResult(j, i) = xMatrix(i, j);
+            return tResult;
+        }
+    } // namespace Detail
+
+    // A = V diag(eigenvalues) V^T with the eigenvalues ascending and the eigenvectors as the
+    // orthonormal columns of V.
+    template <typename T>
+    struct SymmetricEigenDecomposition
+    {
+        std::vector<T> m_Eigenvalues;
+        Matrix<T> m_Eigenvectors;
+    };
+
+    // Eigenvalues of a symmetric matrix, ascending; reads the lower triangle only. Householder
+    // tridiagonalization (matrix-vector work split over xExecutor) and implicit QL.
+    // std::nullopt if xMatrix is not square or QL does not converge.
+    template <typename T, typename Allocator>
+    std::optional<std::vector<T>> symmetricEigenvalues(const Matrix<T, Allocator> &xMatrix, Parallel::Executor &xExecutor)
+    {
+        static_assert(std::is_floating_point_v<T>, "symmetricEigenvalues needs a floating point type");
+        const std::size_t n = xMatrix.getRows().get();
+        if (n != xMatrix.getCols().get())
+            return std::nullopt;
+
+        auto tA = Detail::symmetricCopy(xMatrix);
+        std::vector<T> tTau(n), tDiagonal(n), tOffDiagonal(n);
+        Detail::tridiagonalize(tA, tTau, tDiagonal, tOffDiagonal, xExecutor);
+        if (!Detail::tridiagonalQl<T>(tDiagonal, tOffDiagonal, nullptr, xExecutor))
+            return std::nullopt;
+        std::sort(tDiagonal.begin(), tDiagonal.end());
+        return tDiagonal;
+    }
+
+    template <typename T, typename Allocator>
+    std::optional<std::vector<T>> symmetricEigenvalues(const Matrix<T, Allocator> &xMatrix)
+    {
+        return symmetricEigenvalues(xMatrix, Parallel::defaultExecutor());
+    }
+
+    // Eigenvalues and eigenvectors. The QL rotations are applied to the eigenvector matrix in
+    // parallel column strips, and Q is applied back as blocked reflectors on gemm.
+    template <typename T, typename Allocator>
+    std::optional<SymmetricEigenDecomposition<T>> symmetricEigen(const Matrix<T, Allocator> &xMatrix, Parallel::Executor &xExecutor)
+    {
+        static_assert(std::is_floating_point_v<T>, "symmetricEigen needs a floating point type");
+        const std::size_t n = xMatrix.getRows().get();
+        if (n != xMatrix.getCols().get())
+            return std::nullopt;
+
+        auto tA = Detail::symmetricCopy(xMatrix);
+        std::vector<T> tTau(n), tDiagonal(n), tOffDiagonal(n);
+        Detail::tridiagonalize(tA, tTau, tDiagonal, tOffDiagonal, xExecutor);
+
+        auto tZt = Matrix<T>::create(Row{n}, Column{n});
+        for (std::size_t i = 0; i < n; i++)
+            tZt(i, i) = static_cast<T>(1);
+        if (!Detail::tridiagonalQl(tDiagonal, tOffDiagonal, &tZt, xExecutor))
+            return std::nullopt;
+
+        std::vector<std::size_t> tOrder(n);
+        std::iota(tOrder.begin(), tOrder.end(), std::size_t{0});
+        std::sort(tOrder.begin(), tOrder.end(), [&](std::size_t xLhs, std::size_t xRhs) { return tDiagonal[xLhs] < tDiagonal[xRhs]; });
+
+        SymmetricEigenDecomposition<T> tResult{std::vector<T>(n), Matrix<T>::create(Row{n}, Column{n})};
+        auto tZ = Matrix<T>::create(Row{n}, Column{n});
+        for (std::size_t j = 0; j < n; j++)
+        {
+            tResult.m_Eigenvalues[j] = tDiagonal[tOrder[j]];
+            for (std::size_t i = 0; i < n; i++)
+                tZ(i, j) = tZt(tOrder[j], i);
+        }
+        if (n < 3)
+        {
+            tResult.m_Eigenvectors = std::move(tZ);
+            return tResult;
+        }
+
+        // V = Q Z; Q only touches rows 1 ... n - 1.
+        auto tReflectors = Matrix<T>::create(Row{n - 1}, Column{n - 2});
+        for (std::size_t i = 1; i < n; i++)
+            for (std::size_t j = 0; j + 1 < i && j < n - 2; j++)
+                tReflectors(i - 1, j) = tA(i, j);
+        tTau.resize(n - 2);
+        const QrDecomposition<T> tQ{std::move(tReflectors), std::move(tTau)};
+        auto tLower = Detail::copyRows(tZ, 1, n);
+        tQ.applyQ(tLower, xExecutor);
+        for (std::size_t j = 0; j < n; j++)
+            tResult.m_Eigenvectors(0, j) = tZ(0, j);
+        for (std::size_t i = 1; i < n; i++)
+            for (std::size_t j = 0; j < n; j++)
+                tResult.m_Eigenvectors(i, j) = tLower(i - 1, j);
+        return tResult;
+    }
+
+    template <typename T, typename Allocator>
+    std::optional<SymmetricEigenDecomposition<T>> symmetricEigen(const Matrix<T, Allocator> &xMatrix)
+    {
+        return symmetricEigen(xMatrix, Parallel::defaultExecutor());
+    }
+} // namespace Linalg
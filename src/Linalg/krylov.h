@@ -0,0 +1,458 @@
+#pragma once
+
+#include "linearOperator.h"
+#include "../vector.h"
+#include "../Kernels/gemm.h"
+#include "../Kernels/simd.h"
+#include "../Parallel/threadPool.h"
+#include "../Types/row.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace Linalg
+{
+    // Elements per step of the fused vector passes: the updated slices of every vector
+    // involved still sit in L1 when their dot products are taken.
+    constexpr std::size_t gKrylovChunk{512};
+    // Vectors at least this long split their fused passes over Parallel::defaultExecutor().
+    constexpr std::size_t gKrylovParallelSize{1UL << 16};
+
+    template <typename T>
+    struct KrylovSettings
+    {
+        // Stop once ||b - A x|| <= m_Tolerance ||b||.
+        T m_Tolerance{std::sqrt(std::numeric_limits<T>::epsilon())};
+        // Matrix-vector products with A, counting each GMRES inner step and each BiCGSTAB
+        // step (two products) as one.
+        std::size_t m_MaxIterations{1000};
+        // Basis vectors kept between GMRES restarts.
+        std::size_t m_Restart{30};
+    };
+
+    template <typename T>
+    struct KrylovResult
+    {
+        Vector<T> m_Solution{Vector<T>::create()};
+        std::size_t m_Iterations{0};
+        // ||b - A x|| / ||b|| of m_Solution, recomputed after the iteration stopped.
+        T m_Residual{};
+        // The solver's own residual estimate met the tolerance.
+        bool m_Converged{false};
+    };
+
+    namespace Detail
+    {
+        // Runs xBody(first, last) over gKrylovChunk slices of [0, xSize) and sums the
+        // std::array<T, N> each slice returns, so an update and the dot products of its result
+        // share one pass over memory. Parts are summed in order, which keeps the result
+        // independent of scheduling.
+        template <std::size_t N, typename T, typename Body>
+        std::array<T, N> fusedPass(std::size_t xSize, const Body &xBody)
+        {
+            Parallel::Executor &tExecutor = Parallel::defaultExecutor();
+            const std::size_t tParts = xSize < gKrylovParallelSize ? 1 : std::min(tExecutor.concurrency(), xSize / gKrylovChunk);
+            std::vector<std::array<T, N>> tPartial(tParts, std::array<T, N>{});
+            auto tRun = [&](std::size_t xPart)
+            {
+                const std::size_t tEnd = xSize * (xPart + 1) / tParts;
+                for (std::size_t i = xSize * xPart / tParts; i < tEnd; i += gKrylovChunk)
+                {
+                    const std::array<T, N> tSums = xBody(i, std::min(tEnd, i + gKrylovChunk));
+                    for (std::size_t k = 0; k < N; k++)
+                        tPartial[xPart][k] += tSums[k];
+                }
+            };
+            if (tParts > 1)
+                tExecutor.parallelFor(tParts, tRun);
+            else
+                tRun(0);
+
+            std::array<T, N> tResult{};
+            for (const auto &tSums : tPartial)
+                for (std::size_t k = 0; k < N; k++)
+                    tResult[k] += tSums[k];
+            return tResult;
+        }
+
+        template <typename T>
+        T dot(const T *xLhs, const T *xRhs, std::size_t xSize)
+        {
+            return fusedPass<1, T>(xSize, [&](std::size_t xFirst, std::size_t xLast)
+                                   { return std::array<T, 1>{Kernels::dot(xLhs + xFirst, xRhs + xFirst, xLast - xFirst)}; })[0];
+        }
+
+        // Fills in the true residual of xResult; xScratch holds size() elements.
+        template <typename T>
+        void finish(const LinearOperator<T> &xOperator, const T *xRhs, T xNormRhs, KrylovResult<T> &xResult, T *xScratch)
+        {
+            const std::size_t n = xOperator.size();
+            xOperator.apply(xResult.m_Solution.getData().data(), xScratch);
+            const T tSquares = fusedPass<1, T>(n, [&](std::size_t xFirst, std::size_t xLast)
+                                               {
+                                                   for (std::size_t i = xFirst; i < xLast; i++)
+                                                       xScratch[i] = xRhs[i] - xScratch[i];
+                                                   return std::array<T, 1>{Kernels::dot(xScratch + xFirst, xScratch + xFirst, xLast - xFirst)};
+                                               })[0];
+            xResult.m_Residual = std::sqrt(tSquares) / xNormRhs;
+        }
+
+        // The right-hand side and the preconditioner match the operator.
+        template <typename T>
+        bool validSizes(const LinearOperator<T> &xOperator, const Vector<T> &xRhs, const LinearOperator<T> *xPreconditioner) noexcept
+        {
+            return xRhs.size() == xOperator.size() && (!xPreconditioner || xPreconditioner->size() == xOperator.size());
+        }
+
+        template <typename T>
+        std::optional<KrylovResult<T>> conjugateGradient(const LinearOperator<T> &xOperator, const Vector<T> &xRhs,
+                                                         const LinearOperator<T> *xPreconditioner, const KrylovSettings<T> &xSettings)
+        {
+            if (!validSizes(xOperator, xRhs, xPreconditioner))
+                return std::nullopt;
+            const std::size_t n = xRhs.size();
+            const T *b = xRhs.getData().data();
+            KrylovResult<T> tResult{Vector<T>::create(Row{n})};
+            T *x = tResult.m_Solution.getData().data();
+            const T tNormRhs = std::sqrt(dot(b, b, n));
+            if (tNormRhs == static_cast<T>(0))
+            {
+                tResult.m_Converged = true;
+                return tResult;
+            }
+            const T tTarget = xSettings.m_Tolerance * tNormRhs;
+
+            std::vector<T> r(b, b + n), p(n), q(n), tZ(xPreconditioner ? n : 0);
+            const T *z = r.data();
+            if (xPreconditioner)
+            {
+                xPreconditioner->apply(r.data(), tZ.data());
+                z = tZ.data();
+            }
+            std::copy(z, z + n, p.begin());
+            T rz = dot(r.data(), z, n);
+
+            while (tResult.m_Iterations < xSettings.m_MaxIterations)
+            {
+                xOperator.apply(p.data(), q.data());
+                const T pq = dot(p.data(), q.data(), n);
+                // Only a matrix that is not positive definite gets here with pq <= 0.
+                if (!(pq > static_cast<T>(0)))
+                    break;
+                const T tAlpha = rz / pq;
+                const T rr = fusedPass<1, T>(n, [&](std::size_t xFirst, std::size_t xLast)
+                                             {
+                                                 for (std::size_t i = xFirst; i < xLast; i++)
+                                                 {
+                                                     x[i] += tAlpha * p[i];
+                                                     r[i] -= tAlpha * q[i];
+                                                 }
+                                                 return std::array<T, 1>{Kernels::dot(r.data() + xFirst, r.data() + xFirst, xLast - xFirst)};
+                                             })[0];
+                tResult.m_Iterations++;
+                if (std::sqrt(rr) <= tTarget)
+                {
+                    tResult.m_Converged = true;
+                    break;
+                }
+
+                T rzNext = rr;
+                if (xPreconditioner)
+                {
+                    xPreconditioner->apply(r.data(), tZ.data());
+                    rzNext = dot(r.data(), z, n);
+                }
+                const T tBeta = rzNext / rz;
+                rz = rzNext;
+                fusedPass<0, T>(n, [&](std::size_t xFirst, std::size_t xLast)
+                                {
+                                    for (std::size_t i = xFirst; i < xLast; i++)
+                                        p[i] = z[i] + tBeta * p[i];
+                                    return std::array<T, 0>{};
+                                });
+            }
+            finish(xOperator, b, tNormRhs, tResult, q.data());
+            return tResult;
+        }
+
+        template <typename T>
+        std::optional<KrylovResult<T>> biCgStab(const LinearOperator<T> &xOperator, const Vector<T> &xRhs,
+                                                const LinearOperator<T> *xPreconditioner, const KrylovSettings<T> &xSettings)
+        {
+            if (!validSizes(xOperator, xRhs, xPreconditioner))
+                return std::nullopt;
+            const std::size_t n = xRhs.size();
+            const T *b = xRhs.getData().data();
+            KrylovResult<T> tResult{Vector<T>::create(Row{n})};
+            T *x = tResult.m_Solution.getData().data();
+            const T tNormRhs = std::sqrt(dot(b, b, n));
+            if (tNormRhs == static_cast<T>(0))
+            {
+                tResult.m_Converged = true;
+                return tResult;
+            }
+            const T tTarget = xSettings.m_Tolerance * tNormRhs;
+
+            // x0 = 0, so r0 = b serves as the shadow residual as well.
+            std::vector<T> r(b, b + n), p(n), v(n), s(n), t(n);
+            std::vector<T> tPHat(xPreconditioner ? n : 0), tSHat(xPreconditioner ? n : 0);
+            const T *pHat = xPreconditioner ? tPHat.data() : p.data();
+            const T *sHat = xPreconditioner ? tSHat.data() : s.data();
+            T rho{static_cast<T>(1)}, tAlpha{static_cast<T>(1)}, tOmega{static_cast<T>(1)};
+            T rhoNext = tNormRhs * tNormRhs;
+
+            while (tResult.m_Iterations < xSettings.m_MaxIterations)
+            {
+                if (rhoNext == static_cast<T>(0))
+                    break;
+                const T tBeta = rhoNext / rho * (tAlpha / tOmega);
+                const bool tFirst = tResult.m_Iterations == 0;
+                rho = rhoNext;
+                fusedPass<0, T>(n, [&](std::size_t xFirst, std::size_t xLast)
+                                {
+                                    for (std::size_t i = xFirst; i < xLast; i++)
+                                        p[i] = tFirst ? r[i] : r[i] + tBeta * (p[i] - tOmega * v[i]);
+                                    return std::array<T, 0>{};
+                                });
+                if (xPreconditioner)
+                    xPreconditioner->apply(p.data(), tPHat.data());
+                xOperator.apply(pHat, v.data());
+                const T rv = dot(b, v.data(), n);
+                if (rv == static_cast<T>(0))
+                    break;
+                tAlpha = rho / rv;
+                const T ss = fusedPass<1, T>(n, [&](std::size_t xFirst, std::size_t xLast)
+                                             {
+                                                 for (std::size_t i = xFirst; i < xLast; i++)
+                                                     s[i] = r[i] - tAlpha * v[i];
+                                                 return std::array<T, 1>{Kernels::dot(s.data() + xFirst, s.data() + xFirst, xLast - xFirst)};
+                                             })[0];
+                tResult.m_Iterations++;
+                if (std::sqrt(ss) <= tTarget)
+                {
+                    for (std::size_t i = 0; i < n; i++)
+                        x[i] += tAlpha * pHat[i];
+                    tResult.m_Converged = true;
+                    break;
+                }
+
+                if (xPreconditioner)
+                    xPreconditioner->apply(s.data(), tSHat.data());
+                xOperator.apply(sHat, t.data());
+                const auto tDots = fusedPass<2, T>(n, [&](std::size_t xFirst, std::size_t xLast)
+                                                   {
+                                                       const std::size_t tCount = xLast - xFirst;
+                                                       return std::array<T, 2>{Kernels::dot(t.data() + xFirst, s.data() + xFirst, tCount),
+                                                                               Kernels::dot(t.data() + xFirst, t.data() + xFirst, tCount)};
+                                                   });
+                if (tDots[1] == static_cast<T>(0))
+                    break;
+                tOmega = tDots[0] / tDots[1];
+                // x += alpha p^ + omega s^, r = s - omega t, and the two dots the next step
+                // needs, in one pass.
+                const auto tNext = fusedPass<2, T>(n, [&](std::size_t xFirst, std::size_t xLast)
+                                                   {
+                                                       for (std::size_t i = xFirst; i < xLast; i++)
+                                                       {
+                                                           x[i] += tAlpha * pHat[i] + tOmega * sHat[i];
+                                                           r[i] = s[i] - tOmega * t[i];
+                                                       }
+                                                       const std::size_t tCount = xLast - xFirst;
+                                                       return std::array<T, 2>{Kernels::dot(r.data() + xFirst, r.data() + xFirst, tCount),
+                                                                               Kernels::dot(b + xFirst, r.data() + xFirst, tCount)};
+                                                   });
+                if (std::sqrt(tNext[0]) <= tTarget)
+                {
+                    tResult.m_Converged = true;
+                    break;
+                }
+                if (tOmega == static_cast<T>(0))
+                    break;
+                rhoNext = tNext[1];
+            }
+            finish(xOperator, b, tNormRhs, tResult, t.data());
+            return tResult;
+        }
+
+        template <typename T>
+        std::optional<KrylovResult<T>> gmres(const LinearOperator<T> &xOperator, const Vector<T> &xRhs,
+                                             const LinearOperator<T> *xPreconditioner, const KrylovSettings<T> &xSettings)
+        {
+            if (!validSizes(xOperator, xRhs, xPreconditioner))
+                return std::nullopt;
+            const std::size_t n = xRhs.size();
+            const T *b = xRhs.getData().data();
+            KrylovResult<T> tResult{Vector<T>::create(Row{n})};
+            T *x = tResult.m_Solution.getData().data();
+            const T tNormRhs = std::sqrt(dot(b, b, n));
+            if (tNormRhs == static_cast<T>(0))
+            {
+                tResult.m_Converged = true;
+                return tResult;
+            }
+            const T tTarget = xSettings.m_Tolerance * tNormRhs;
+            const std::size_t m = std::clamp<std::size_t>(xSettings.m_Restart, 1, n);
+
+            // The basis vectors are the rows of V, so projections onto all of them are gemms.
+            std::vector<T> V((m + 1) * n), w(n), z(n), r(b, b + n);
+            std::vector<T> H((m + 1) * m), tCos(m), tSin(m), g(m + 1), c(m + 1);
+            auto h = [&](std::size_t i, std::size_t j) -> T & { return H[i * m + j]; };
+            T tBeta = tNormRhs;
+
+            while (tResult.m_Iterations < xSettings.m_MaxIterations)
+            {
+                std::fill(H.begin(), H.end(), static_cast<T>(0));
+                std::fill(g.begin(), g.end(), static_cast<T>(0));
+                g[0] = tBeta;
+                for (std::size_t i = 0; i < n; i++)
+                    V[i] = r[i] / tBeta;
+
+                std::size_t k{0};
+                bool tConverged{false};
+                for (std::size_t j = 0; j < m && tResult.m_Iterations < xSettings.m_MaxIterations; j++)
+                {
+                    tResult.m_Iterations++;
+                    const T *vj = V.data() + j * n;
+                    if (xPreconditioner)
+                    {
+                        xPreconditioner->apply(vj, z.data());
+                        xOperator.apply(z.data(), w.data());
+                    }
+                    else
+                    {
+                        xOperator.apply(vj, w.data());
+                    }
+
+                    // Classical Gram-Schmidt, twice: two passes over the basis per step
+                    // instead of 2 (j + 1) with the modified variant, and as stable.
+                    for (std::size_t tPass = 0; tPass < 2; tPass++)
+                    {
+                        Kernels::gemm(j + 1, 1, n, static_cast<T>(1), V.data(), n, w.data(), 1, static_cast<T>(0), c.data(), 1);
+                        Kernels::gemm(1, n, j + 1, static_cast<T>(-1), c.data(), j + 1, V.data(), n, static_cast<T>(1), w.data(), n);
+                        for (std::size_t i = 0; i <= j; i++)
+                            h(i, j) += c[i];
+                    }
+                    const T tNext = std::sqrt(dot(w.data(), w.data(), n));
+                    h(j + 1, j) = tNext;
+                    if (tNext > static_cast<T>(0))
+                        for (std::size_t i = 0; i < n; i++)
+                            V[(j + 1) * n + i] = w[i] / tNext;
+
+                    // Keep H upper triangular with Givens rotations; g tracks the residual.
+                    for (std::size_t i = 0; i < j; i++)
+                    {
+                        const T tUpper = h(i, j), tLower = h(i + 1, j);
+                        h(i, j) = tCos[i] * tUpper + tSin[i] * tLower;
+                        h(i + 1, j) = tCos[i] * tLower - tSin[i] * tUpper;
+                    }
+                    const T tRadius = std::hypot(h(j, j), h(j + 1, j));
+                    if (tRadius == static_cast<T>(0))
+                        break;
+                    tCos[j] = h(j, j) / tRadius;
+                    tSin[j] = h(j + 1, j) / tRadius;
+                    h(j, j) = tRadius;
+                    h(j + 1, j) = static_cast<T>(0);
+                    g[j + 1] = -tSin[j] * g[j];
+                    g[j] = tCos[j] * g[j];
+                    k = j + 1;
+                    if (std::abs(g[j + 1]) <= tTarget || tNext == static_cast<T>(0))
+                    {
+                        tConverged = true;
+                        break;
+                    }
+                }
+                if (k == 0)
+                    break;
+
+                // y = H^-1 g, then x += M^-1 V^T y.
+                for (std::size_t i = k; i-- > 0;)
+                {
+                    T tSum = g[i];
+                    for (std::size_t l = i + 1; l < k; l++)
+                        tSum -= h(i, l) * c[l];
+                    c[i] = tSum / h(i, i);
+                }
+                Kernels::gemm(1, n, k, static_cast<T>(1), c.data(), k, V.data(), n, static_cast<T>(0), w.data(), n);
+                const T *u = w.data();
+                if (xPreconditioner)
+                {
+                    xPreconditioner->apply(w.data(), z.data());
+                    u = z.data();
+                }
+                for (std::size_t i = 0; i < n; i++)
+                    x[i] += u[i];
+                if (tConverged)
+                {
+                    tResult.m_Converged = true;
+                    break;
+                }
+
+                // Restart from the true residual.
+                xOperator.apply(x, w.data());
+                tBeta = std::sqrt(fusedPass<1, T>(n, [&](std::size_t xFirst, std::size_t xLast)
+                                                  {
+                                                      for (std::size_t i = xFirst; i < xLast; i++)
+                                                          r[i] = b[i] - w[i];
+                                                      return std::array<T, 1>{Kernels::dot(r.data() + xFirst, r.data() + xFirst, xLast - xFirst)};
+                                                  })[0]);
+                if (tBeta <= tTarget)
+                {
+                    tResult.m_Converged = true;
+                    break;
+                }
+            }
+            finish(xOperator, b, tNormRhs, tResult, w.data());
+            return tResult;
+        }
+    } // namespace Detail
+
+    // Preconditioned conjugate gradient for symmetric positive definite A, starting from
+    // x = 0. std::nullopt if the sizes differ.
+    template <typename T>
+    std::optional<KrylovResult<T>> conjugateGradient(const LinearOperator<T> &xOperator, const Vector<T> &xRhs,
+                                                     const LinearOperator<T> &xPreconditioner, const KrylovSettings<T> &xSettings = {})
+    {
+        return Detail::conjugateGradient(xOperator, xRhs, &xPreconditioner, xSettings);
+    }
+
+    template <typename T>
+    std::optional<KrylovResult<T>> conjugateGradient(const LinearOperator<T> &xOperator, const Vector<T> &xRhs, const KrylovSettings<T> &xSettings = {})
+    {
+        return Detail::conjugateGradient<T>(xOperator, xRhs, nullptr, xSettings);
+    }
+
+    // Right-preconditioned BiCGSTAB for general square A, starting from x = 0.
+    template <typename T>
+    std::optional<KrylovResult<T>> biCgStab(const LinearOperator<T> &xOperator, const Vector<T> &xRhs, const LinearOperator<T> &xPreconditioner,
+                                            const KrylovSettings<T> &xSettings = {})
+    {
+        return Detail::biCgStab(xOperator, xRhs, &xPreconditioner, xSettings);
+    }
+
+    template <typename T>
+    std::optional<KrylovResult<T>> biCgStab(const LinearOperator<T> &xOperator, const Vector<T> &xRhs, const KrylovSettings<T> &xSettings = {})
+    {
+        return Detail::biCgStab<T>(xOperator, xRhs, nullptr, xSettings);
+    }
+
+    // Right-preconditioned GMRES restarted every KrylovSettings::m_Restart steps, starting
+    // from x = 0. The residual it minimizes is that of the unpreconditioned system.
+    template <typename T>
+    std::optional<KrylovResult<T>> gmres(const LinearOperator<T> &xOperator, const Vector<T> &xRhs, const LinearOperator<T> &xPreconditioner,
+                                         const KrylovSettings<T> &xSettings = {})
+    {
+        return Detail::gmres(xOperator, xRhs, &xPreconditioner, xSettings);
+    }
+
+    template <typename T>
+    std::optional<KrylovResult<T>> gmres(const LinearOperator<T> &xOperator, const Vector<T> &xRhs, const KrylovSettings<T> &xSettings = {})
+    {
+        return Detail::gmres<T>(xOperator, xRhs, nullptr, xSettings);
+    }
+} // namespace Linalg
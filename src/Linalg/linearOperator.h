@@ -0,0 +1,243 @@
+#pragma once
+
+#include "../matrix.h"
+#include "../sparseMatrix.h"
+#include "../Kernels/gemm.h"
+#include "../Kernels/simd.h"
+#include "../Parallel/threadPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Linalg
+{
+    // A square linear map y = A x that the iterative solvers only ever see through apply().
+    // Preconditioners are linear operators too: apply() computes z = M^-1 r.
+    template <typename T>
+    class LinearOperator
+    {
+    public:
+        virtual ~LinearOperator() = default;
+
+        virtual std::size_t size() const noexcept = 0;
+        // xIn and xOut hold size() elements and do not alias.
+        virtual void apply(const T *xIn, T *xOut) const = 0;
+    };
+
+    // A dense square Matrix<T>; rows are split over xExecutor once the matrix is large. The
+    // matrix must outlive the operator.
+    template <typename T, typename Allocator = AlignedAllocator<T>>
+    class DenseOperator final : public LinearOperator<T>
+    {
+    private:
+        const Matrix<T, Allocator> &m_Matrix;
+        Parallel::Executor &m_Executor;
+
+    public:
+        explicit DenseOperator(const Matrix<T, Allocator> &xMatrix, Parallel::Executor &xExecutor = Parallel::defaultExecutor()) noexcept
+            : m_Matrix{xMatrix}, m_Executor{xExecutor}
+        {
+        }
+
+        std::size_t size() const noexcept override { return m_Matrix.getRows().get(); }
+
+        void apply(const T *xIn, T *xOut) const override
+        {
+            const std::size_t n = size(), tLda = m_Matrix.getLeadingDimension();
+            const T *A = m_Matrix.getData().data();
+            const std::size_t tParts = n * n < Kernels::gGemmSmallProduct ? 1 : std::min(m_Executor.concurrency(), n);
+            auto tRows = [&](std::size_t xPart)
+            {
+                for (std::size_t i = n * xPart / tParts; i < n * (xPart + 1) / tParts; i++)
+                    xOut[i] = Kernels::dot(A + i * tLda, xIn, n);
+            };
+            if (tParts > 1)
+                m_Executor.parallelFor(tParts, tRows);
+            else
+                tRows(0);
+        }
+    };
+
+    // A square CSR matrix; large matrices split their rows by non-zeros over
+    // Parallel::defaultExecutor(), like SparseMatrix * Vector. A CSC matrix can be wrapped
+    // after toFormat<SparseFormat::CSR>(). The matrix must outlive the operator.
+    template <typename T>
+    class SparseOperator final : public LinearOperator<T>
+    {
+    private:
+        const CsrMatrix<T> &m_Matrix;
+        std::vector<std::size_t> m_Split;
+
+    public:
+        explicit SparseOperator(const CsrMatrix<T> &xMatrix)
+            : m_Matrix{xMatrix}
+        {
+            const auto tOffsets = xMatrix.getOffsets();
+            const bool tParallel = xMatrix.nonZeros() >= ::Detail::gSparseParallelNonZeros && Parallel::defaultExecutor().concurrency() > 1;
+            const std::size_t tParts = tParallel ? Parallel::defaultExecutor().concurrency() : 1;
+            m_Split = ::Detail::balancedSplit(std::vector<std::size_t>(tOffsets.begin(), tOffsets.end()), tParts);
+        }
+
+        std::size_t size() const noexcept override { return m_Matrix.getRows().get(); }
+
+        void apply(const T *xIn, T *xOut) const override
+        {
+            const std::size_t *tOffsets = m_Matrix.getOffsets().data(), *tIndices = m_Matrix.getIndices().data();
+            const T *tValues = m_Matrix.getValues().data();
+            auto tRows = [&](std::size_t xPart)
+            {
+                for (std::size_t i = m_Split[xPart]; i < m_Split[xPart + 1]; i++)
+                {
+                    T tSum{};
+                    for (std::size_t k = tOffsets[i]; k < tOffsets[i + 1]; k++)
+                        tSum += tValues[k] * xIn[tIndices[k]];
+                    xOut[i] = tSum;
+                }
+            };
+            if (m_Split.size() > 2)
+                Parallel::defaultExecutor().parallelFor(m_Split.size() - 1, tRows);
+            else
+                tRows(0);
+        }
+    };
+
+    // z = D^-1 r with D the diagonal of A.
+    template <typename T>
+    class JacobiPreconditioner final : public LinearOperator<T>
+    {
+    private:
+        std::vector<T> m_InverseDiagonal;
+
+        explicit JacobiPreconditioner(std::vector<T> xInverseDiagonal) noexcept : m_InverseDiagonal{std::move(xInverseDiagonal)} {}
+
+        static std::optional<JacobiPreconditioner> invert(std::vector<T> xDiagonal)
+        {
+            for (auto &tValue : xDiagonal)
+            {
+                if (tValue == static_cast<T>(0))
+                    return std::nullopt;
+                tValue = static_cast<T>(1) / tValue;
+            }
+            return JacobiPreconditioner{std::move(xDiagonal)};
+        }
+
+    public:
+        // std::nullopt if the matrix is not square or has a zero on its diagonal.
+        template <typename Allocator>
+        static std::optional<JacobiPreconditioner> create(const Matrix<T, Allocator> &xMatrix)
+        {
+            const std::size_t n = xMatrix.getRows().get();
+            if (n != xMatrix.getCols().get())
+                return std::nullopt;
+            std::vector<T> tDiagonal(n);
+            for (std::size_t i = 0; i < n; i++)
+                tDiagonal[i] = xMatrix(i, i);
+            return invert(std::move(tDiagonal));
+        }
+
+        template <SparseFormat Format>
+        static std::optional<JacobiPreconditioner> create(const SparseMatrix<T, Format> &xMatrix)
+        {
+            const std::size_t n = xMatrix.getRows().get();
+            if (n != xMatrix.getCols().get())
+                return std::nullopt;
+            std::vector<T> tDiagonal(n);
+            for (std::size_t i = 0; i < n; i++)
+                tDiagonal[i] = xMatrix(i, i);
+            return invert(std::move(tDiagonal));
+        }
+
+        std::size_t size() const noexcept override { return m_InverseDiagonal.size(); }
+
+        void apply(const T *xIn, T *xOut) const override { Kernels::multiply(m_InverseDiagonal.data(), xIn, xOut, size()); }
+    };
+
+    // ILU(0): L U restricted to the sparsity pattern of A, z = U^-1 L^-1 r. The factors share
+    // one CSR pattern, L unit lower below the diagonal and U on and above it.
+    template <typename T>
+    class IncompleteLu final : public LinearOperator<T>
+    {
+    private:
+        std::vector<std::size_t> m_Offsets;
+        std::vector<std::size_t> m_Indices;
+        std::vector<T> m_Values;
+        std::vector<std::size_t> m_Diagonal;
+
+        IncompleteLu() noexcept = default;
+
+    public:
+        // IKJ elimination that drops every fill-in. std::nullopt if the matrix is not square,
+        // a diagonal entry is missing from the pattern or a pivot becomes zero.
+        static std::optional<IncompleteLu> create(const CsrMatrix<T> &xMatrix)
+        {
+            const std::size_t n = xMatrix.getRows().get();
+            if (n != xMatrix.getCols().get())
+                return std::nullopt;
+
+            IncompleteLu tResult;
+            const auto tOffsets = xMatrix.getOffsets();
+            const auto tIndices = xMatrix.getIndices();
+            const auto tValues = xMatrix.getValues();
+            tResult.m_Offsets.assign(tOffsets.begin(), tOffsets.end());
+            tResult.m_Indices.assign(tIndices.begin(), tIndices.end());
+            tResult.m_Values.assign(tValues.begin(), tValues.end());
+            tResult.m_Diagonal.resize(n);
+            auto &tOffset = tResult.m_Offsets;
+            auto &tIndex = tResult.m_Indices;
+            auto &tValue = tResult.m_Values;
+
+            // Position of each column within the current row, or tNone outside the pattern.
+            constexpr std::size_t tNone{std::numeric_limits<std::size_t>::max()};
+            std::vector<std::size_t> tPosition(n, tNone);
+            for (std::size_t i = 0; i < n; i++)
+            {
+                for (std::size_t p = tOffset[i]; p < tOffset[i + 1]; p++)
+                    tPosition[tIndex[p]] = p;
+                if (tPosition[i] == tNone)
+                    return std::nullopt;
+                tResult.m_Diagonal[i] = tPosition[i];
+
+                for (std::size_t p = tOffset[i]; p < tOffset[i + 1] && tIndex[p] < i; p++)
+                {
+                    const std::size_t k = tIndex[p];
+                    tValue[p] /= tValue[tResult.m_Diagonal[k]];
+                    for (std::size_t q = tResult.m_Diagonal[k] + 1; q < tOffset[k + 1]; q++)
+                        if (tPosition[tIndex[q]] != tNone)
+                            tValue[tPosition[tIndex[q]]] -= tValue[p] * tValue[q];
+                }
+                if (tValue[tResult.m_Diagonal[i]] == static_cast<T>(0))
+                    return std::nullopt;
+                for (std::size_t p = tOffset[i]; p < tOffset[i + 1]; p++)
+                    tPosition[tIndex[p]] = tNone;
+            }
+            return tResult;
+        }
+
+        std::size_t size() const noexcept override { return m_Diagonal.size(); }
+
+        // The two triangular sweeps are inherently sequential.
+        void apply(const T *xIn, T *xOut) const override
+        {
+            const std::size_t n = size();
+            for (std::size_t i = 0; i < n; i++)
+            {
+                T tSum = xIn[i];
+                for (std::size_t p = m_Offsets[i]; p < m_Diagonal[i]; p++)
+                    tSum -= m_Values[p] * xOut[m_Indices[p]];
+                xOut[i] = tSum;
+            }
+            for (std::size_t i = n; i-- > 0;)
+            {
+                T tSum = xOut[i];
+                for (std::size_t p = m_Diagonal[i] + 1; p < m_Offsets[i + 1]; p++)
+                    tSum -= m_Values[p] * xOut[m_Indices[p]];
+                xOut[i] = tSum / m_Values[m_Diagonal[i]];
+            }
+        }
+    };
+} // namespace Linalg
@@ -0,0 +1,337 @@
+#pragma once
+
+#include "../matrix.h"
+#include "../vector.h"
+#include "../Kernels/gemm.h"
+#include "../Kernels/transpose.h"
+#include "../Kernels/trsm.h"
+#include "../Parallel/threadPool.h"
+#include "../Types/column.h"
+#include "../Types/row.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Linalg
+{
+    // Columns per panel of the blocked factorization; the trailing update is a gemm with
+    // this inner dimension.
+    constexpr std::size_t gLuBlock{128};
+
+    namespace Detail
+    {
+        // Swaps row i with row xPivots[i] for i in [xFirst, xLast), in order, over xCols columns.
+        template <typename T>
+        void swapRows(T *xA, std::size_t xLda, std::size_t xCols, const std::size_t *xPivots, std::size_t xFirst, std::size_t xLast) noexcept
+        {
+            if (xCols == 0)
+                return;
+            for (std::size_t i = xFirst; i < xLast; i++)
+                if (xPivots[i] != i)
+                    std::swap_ranges(xA + i * xLda, xA + i * xLda + xCols, xA + xPivots[i] * xLda);
+        }
+
+        // Recursive LU with partial pivoting of a tall xRows x xCols panel stored transposed:
+        // column c of the panel is the contiguous row c of xP. Pivot searches, scaling and row
+        // swaps then run over contiguous memory, and halving the columns turns most of the work
+        // into gemm. xPivots are relative to the top of the panel.
+        template <typename T>
+        void factorPanelTransposed(std::size_t xRows, std::size_t xCols, T *xP, std::size_t xLdp, std::size_t *xPivots)
+        {
+            if (xCols == 1)
+            {
+                std::size_t tPivot{0};
+                for (std::size_t i = 1; i < xRows; i++)
+                    if (std::abs(xP[i]) > std::abs(xP[tPivot]))
+                        tPivot = i;
+                xPivots[0] = tPivot;
+                std::swap(xP[0], xP[tPivot]);
+
+                // A zero pivot leaves the column as is; the factorization is still valid and
+                // isSingular() reports it.
+                if (xP[0] != static_cast<T>(0))
+                {
+                    const T tInverse = static_cast<T>(1) / xP[0];
+                    for (std::size_t i = 1; i < xRows; i++)
+                        xP[i] *= tInverse;
+                }
+                return;
+            }
+
+            const std::size_t tLeft = xCols / 2, tRight = xCols - tLeft;
+            T *tRightColumns = xP + tLeft * xLdp;
+            factorPanelTransposed(xRows, tLeft, xP, xLdp, xPivots);
+            for (std::size_t c = 0; c < tRight; c++)
+            {
+                T *tColumn = tRightColumns + c * xLdp;
+                for (std::size_t i = 0; i < tLeft; i++)
+                    std::swap(tColumn[i], tColumn[xPivots[i]]);
+                // Forward substitution with the unit lower triangle of the left half.
+                for (std::size_t k = 0; k < tLeft; k++)
+                {
+                    const T tSolved = tColumn[k];
+                    const T *tL = xP + k * xLdp;
+                    for (std::size_t i = k + 1; i < tLeft; i++)
+                        tColumn[i] -= tSolved * tL[i];
+                }
+            }
+            // Transposed, A22 -= A21 A12 is A22^T -= A12^T A21^T.
+            Kernels::gemmSequential(tRight, xRows - tLeft, tLeft, static_cast<T>(-1), tRightColumns, xLdp, xP + tLeft, xLdp,
+                                    static_cast<T>(1), tRightColumns + tLeft, xLdp);
+            factorPanelTransposed(xRows - tLeft, tRight, tRightColumns + tLeft, xLdp, xPivots + tLeft);
+            for (std::size_t i = tLeft; i < xCols; i++)
+                xPivots[i] += tLeft;
+            for (std::size_t c = 0; c < tLeft; c++)
+            {
+                T *tColumn = xP + c * xLdp;
+                for (std::size_t i = tLeft; i < xCols; i++)
+                    std::swap(tColumn[i], tColumn[xPivots[i]]);
+            }
+        }
+
+        // Factors the xRows x xCols panel at xA in place. It is transposed into xWorkspace, which
+        // holds xRows * xCols elements, for the factorization and transposed back.
+        template <typename T>
+        void factorPanel(std::size_t xRows, std::size_t xCols, T *xA, std::size_t xLda, std::size_t *xPivots, T *xWorkspace)
+        {
+            Kernels::transpose(xRows, xCols, xA, xLda, xWorkspace, xRows);
+            factorPanelTransposed(xRows, xCols, xWorkspace, xRows, xPivots);
+            Kernels::transpose(xCols, xRows, xWorkspace, xRows, xA, xLda);
+        }
+    } // namespace Detail
+
+    // P A = L U of a square matrix, stored packed: U on and above the diagonal, the unit lower
+    // triangle of L below it. Row i was swapped with row getPivots()[i], for i = 0, 1, ...
+    template <typename T>
+    class LuDecomposition
+    {
+        static_assert(std::is_floating_point_v<T>, "LuDecomposition needs a floating point type");
+
+    private:
+        Matrix<T> m_Factors{Matrix<T>::create()};
+        std::vector<std::size_t> m_Pivots{};
+
+    public:
+        LuDecomposition(Matrix<T> xFactors, std::vector<std::size_t> xPivots) noexcept
+            : m_Factors{std::move(xFactors)}, m_Pivots{std::move(xPivots)}
+        {
+        }
+
+        std::size_t size() const noexcept { return m_Pivots.size(); }
+        const Matrix<T> &getFactors() const noexcept { return m_Factors; }
+        const std::vector<std::size_t> &getPivots() const noexcept { return m_Pivots; }
+        Matrix<T> getL() const;
+        Matrix<T> getU() const;
+        // Row i of P A is row getPermutation()[i] of A.
+        std::vector<std::size_t> getPermutation() const;
+
+        // True if U has a zero on its diagonal; solve() and inverse() then fail.
+        bool isSingular() const noexcept;
+        T det() const noexcept;
+
+        // std::nullopt if the factorization is singular or the sizes differ.
+        std::optional<Vector<T>> solve(const Vector<T> &xRhs) const;
+        std::optional<Matrix<T>> solve(const Matrix<T> &xRhs, Parallel::Executor &xExecutor) const;
+        std::optional<Matrix<T>> solve(const Matrix<T> &xRhs) const { return solve(xRhs, Parallel::defaultExecutor()); }
+        std::optional<Matrix<T>> inverse(Parallel::Executor &xExecutor) const;
+        std::optional<Matrix<T>> inverse() const { return inverse(Parallel::defaultExecutor()); }
+    };
+
+    // Right-looking blocked LU with partial pivoting. Each gLuBlock wide panel is factored
+    // recursively, then the block row of U is solved and the trailing matrix updated with gemm
+    // on xExecutor, which is where nearly all of the 2n^3/3 flops go. With more than one thread
+    // the columns of the next panel are updated first, and that panel is factored while the
+    // rest of the trailing matrix is updated (one panel lookahead). std::nullopt if xMatrix is
+    // not square.
+    template <typename T, typename Allocator>
+    std::optional<LuDecomposition<T>> lu(const Matrix<T, Allocator> &xMatrix, Parallel::Executor &xExecutor)
+    {
+        const std::size_t n = xMatrix.getRows().get();
+        if (n != xMatrix.getCols().get())
+            return std::nullopt;
+
+        auto tFactors = Matrix<T>::create(xMatrix.getRows(), xMatrix.getCols());
+        for (std::size_t i = 0; i < n; i++)
+            for (std::size_t j = 0; j < n; j++)
+                tFactors(i, j) = xMatrix(i, j);
+        std::vector<std::size_t> tPivots(n);
+        if (n == 0)
+            return LuDecomposition<T>{std::move(tFactors), std::move(tPivots)};
+
+        T *A = tFactors.getData().data();
+        const std::size_t tLda = tFactors.getLeadingDimension();
+        std::vector<T> tWorkspace(n * std::min(n, gLuBlock));
+        const auto tFactorPanel = [&](std::size_t xColumn)
+        {
+            const std::size_t tWidth = std::min(gLuBlock, n - xColumn);
+            Detail::factorPanel(n - xColumn, tWidth, A + xColumn * tLda + xColumn, tLda, tPivots.data() + xColumn, tWorkspace.data());
+            for (std::size_t i = xColumn; i < xColumn + tWidth; i++)
+                tPivots[i] += xColumn;
+        };
+        const bool tLookahead = xExecutor.concurrency() > 1;
+
+        tFactorPanel(0);
+        for (std::size_t j = 0; j < n; j += gLuBlock)
+        {
+            const std::size_t tWidth = std::min(gLuBlock, n - j), tNext = j + tWidth;
+            Detail::swapRows(A, tLda, j, tPivots.data(), j, tNext);
+            Detail::swapRows(A + tNext, tLda, n - tNext, tPivots.data(), j, tNext);
+            if (tNext == n)
+                break;
+
+            Kernels::trsmLower<true>(tWidth, n - tNext, A + j * tLda + j, tLda, A + j * tLda + tNext, tLda, xExecutor);
+            // Trailing update of columns [xFirst, xLast).
+            const auto tUpdate = [&](std::size_t xFirst, std::size_t xLast)
+            {
+                Kernels::gemm(n - tNext, xLast - xFirst, tWidth, static_cast<T>(-1), A + tNext * tLda + j, tLda, A + j * tLda + xFirst, tLda,
+                              static_cast<T>(1), A + tNext * tLda + xFirst, tLda, xExecutor);
+            };
+
+            const std::size_t tAhead = std::min(n, tNext + gLuBlock);
+            if (!tLookahead || tAhead == n)
+            {
+                tUpdate(tNext, n);
+                tFactorPanel(tNext);
+                continue;
+            }
+            // The next panel only needs its own columns updated; the other columns do not
+            // depend on its factorization until its row swaps, which come afterwards.
+            tUpdate(tNext, tAhead);
+            xExecutor.parallelFor(2, [&](std::size_t xTask)
+                                  {
+                                      if (xTask == 0)
+                                          tFactorPanel(tNext);
+                                      else
+                                          tUpdate(tAhead, n); });
+        }
+        return LuDecomposition<T>{std::move(tFactors), std::move(tPivots)};
+    }
+
+    template <typename T, typename Allocator>
+    std::optional<LuDecomposition<T>> lu(const Matrix<T, Allocator> &xMatrix)
+    {
+        return lu(xMatrix, Parallel::defaultExecutor());
+    }
+
+    // Shortcuts through lu(); std::nullopt if xMatrix is not square or singular.
+    template <typename T, typename Allocator>
+    std::optional<Vector<T>> solve(const Matrix<T, Allocator> &xMatrix, const Vector<T> &xRhs)
+    {
+        const auto tLu = lu(xMatrix);
+        return tLu ? tLu->solve(xRhs) : std::nullopt;
+    }
+
+    template <typename T, typename Allocator>
+    std::optional<Matrix<T>> inverse(const Matrix<T, Allocator> &xMatrix)
+    {
+        const auto tLu = lu(xMatrix);
+        return tLu ? tLu->inverse() : std::nullopt;
+    }
+
+    // std::nullopt if xMatrix is not square.
+    template <typename T, typename Allocator>
+    std::optional<T> det(const Matrix<T, Allocator> &xMatrix)
+    {
+        const auto tLu = lu(xMatrix);
+        return tLu ? std::optional<T>{tLu->det()} : std::nullopt;
+    }
+
+    template <typename T>
+    inline Matrix<T> LuDecomposition<T>::getL() const
+    {
+        auto tResult = Matrix<T>::create(Row{size()}, Column{size()});
+        for (std::size_t i = 0; i < size(); i++)
+        {
+            for (std::size_t j = 0; j < i; j++)
+                tResult(i, j) = m_Factors(i, j);
+            tResult(i, i) = static_cast<T>(1);
+        }
+        return tResult;
+    }
+
+    template <typename T>
+    inline Matrix<T> LuDecomposition<T>::getU() const
+    {
+        auto tResult = Matrix<T>::create(Row{size()}, Column{size()});
+        for (std::size_t i = 0; i < size(); i++)
+            for (std::size_t j = i; j < size(); j++)
+                tResult(i, j) = m_Factors(i, j);
+        return tResult;
+    }
+
+    template <typename T>
+    inline std::vector<std::size_t> LuDecomposition<T>::getPermutation() const
+    {
+        std::vector<std::size_t> tResult(size());
+        for (std::size_t i = 0; i < size(); i++)
+            tResult[i] = i;
+        for (std::size_t i = 0; i < size(); i++)
+            std::swap(tResult[i], tResult[m_Pivots[i]]);
+        return tResult;
+    }
+
+    template <typename T>
+    inline bool LuDecomposition<T>::isSingular() const noexcept
+    {
+        for (std::size_t i = 0; i < size(); i++)
+            if (m_Factors(i, i) == static_cast<T>(0))
+                return true;
+        return false;
+    }
+
+    template <typename T>
+    inline T LuDecomposition<T>::det() const noexcept
+    {
+        T tResult{static_cast<T>(1)};
+        for (std::size_t i = 0; i < size(); i++)
+        {
+            tResult *= m_Factors(i, i);
+            if (m_Pivots[i] != i)
+                tResult = -tResult;
+        }
+        return tResult;
+    }
+
+    template <typename T>
+    inline std::optional<Vector<T>> LuDecomposition<T>::solve(const Vector<T> &xRhs) const
+    {
+        if (xRhs.size() != size() || isSingular())
+            return std::nullopt;
+
+        auto tResult = Vector<T>::create(xRhs.getData());
+        T *tData = tResult.getData().data();
+        Detail::swapRows(tData, 1, 1, m_Pivots.data(), 0, size());
+        Kernels::Detail::trsmLowerSequential<true>(size(), 1, m_Factors.getData().data(), m_Factors.getLeadingDimension(), tData, 1);
+        Kernels::Detail::trsmUpperSequential<false>(size(), 1, m_Factors.getData().data(), m_Factors.getLeadingDimension(), tData, 1);
+        return tResult;
+    }
+
+    template <typename T>
+    inline std::optional<Matrix<T>> LuDecomposition<T>::solve(const Matrix<T> &xRhs, Parallel::Executor &xExecutor) const
+    {
+        if (xRhs.getRows().get() != size() || isSingular())
+            return std::nullopt;
+
+        auto tResult = Matrix<T>::create(xRhs);
+        T *tData = tResult.getData().data();
+        const std::size_t tLdb = tResult.getLeadingDimension(), tCols = tResult.getCols().get();
+        Detail::swapRows(tData, tLdb, tCols, m_Pivots.data(), 0, size());
+        Kernels::trsmLower<true>(size(), tCols, m_Factors.getData().data(), m_Factors.getLeadingDimension(), tData, tLdb, xExecutor);
+        Kernels::trsmUpper<false>(size(), tCols, m_Factors.getData().data(), m_Factors.getLeadingDimension(), tData, tLdb, xExecutor);
+        return tResult;
+    }
+
+    template <typename T>
+    inline std::optional<Matrix<T>> LuDecomposition<T>::inverse(Parallel::Executor &xExecutor) const
+    {
+        auto tIdentity = Matrix<T>::create(Row{size()}, Column{size()});
+        for (std::size_t i = 0; i < size(); i++)
+            tIdentity(i, i) = static_cast<T>(1);
+        return solve(tIdentity, xExecutor);
+    }
+} // namespace Linalg
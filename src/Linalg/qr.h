@@ -0,0 +1,531 @@
+#pragma once
+
+#include "../matrix.h"
+#include "../vector.h"
+#include "../Kernels/gemm.h"
+#include "../Kernels/transpose.h"
+#include "../Kernels/trsm.h"
+#include "../Parallel/threadPool.h"
+#include "../Types/column.h"
+#include "../Types/row.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Linalg
+{
+    // Reflectors per block of the compact WY representation Q_j = I - V T V^T.
+    constexpr std::size_t gQrBlock{64};
+    // Panels at most this wide are factored column by column.
+    constexpr std::size_t gQrPanelLeaf{8};
+
+    enum class QrMode
+    {
+        // TallSkinny once there are several threads and at least twice as many rows as
+        // columns per thread, Blocked otherwise.
+        Auto,
+        Blocked,
+        TallSkinny
+    };
+
+    namespace Detail
+    {
+        template <typename T>
+        using QrBuffer = Kernels::Detail::PackBuffer<T>;
+
+        // Unblocked Householder QR of an xRows x xWidth panel; the reflectors v (v_0 = 1
+        // implicit) end up below the diagonal, R on and above it. Only row segments of the
+        // panel are touched in the inner loops.
+        template <typename T>
+        void factorColumns(std::size_t xRows, std::size_t xWidth, T *xA, std::size_t xLda, T *xTau, T *xWork) noexcept
+        {
+            for (std::size_t c = 0; c < xWidth && c < xRows; c++)
+            {
+                T *tPivot = xA + c * xLda + c;
+                T tTail{static_cast<T>(0)};
+                for (std::size_t r = c + 1; r < xRows; r++)
+                    tTail += xA[r * xLda + c] * xA[r * xLda + c];
+                if (tTail == static_cast<T>(0))
+                {
+                    xTau[c] = static_cast<T>(0);
+                    continue;
+                }
+
+                const T tAlpha = *tPivot;
+                const T tBeta = tAlpha >= static_cast<T>(0) ? -std::sqrt(tAlpha * tAlpha + tTail) : std::sqrt(tAlpha * tAlpha + tTail);
+                xTau[c] = (tBeta - tAlpha) / tBeta;
+                const T tScale = static_cast<T>(1) / (tAlpha - tBeta);
+                for (std::size_t r = c + 1; r < xRows; r++)
+                    xA[r * xLda + c] *= tScale;
+                *tPivot = tBeta;
+
+                // Remaining panel columns: w = v^T A, A -= tau v w.
+                const std::size_t tRest = xWidth - c - 1;
+                if (tRest == 0)
+                    continue;
+                std::copy_n(tPivot + 1, tRest, xWork);
+                for (std::size_t r = c + 1; r < xRows; r++)
+                {
+                    const T v = xA[r * xLda + c];
+                    const T *tRow = xA + r * xLda + c + 1;
+                    for (std::size_t q = 0; q < tRest; q++)
+                        xWork[q] += v * tRow[q];
+                }
+                for (std::size_t q = 0; q < tRest; q++)
+                    xWork[q] *= xTau[c];
+                for (std::size_t q = 0; q < tRest; q++)
+                    tPivot[1 + q] -= xWork[q];
+                for (std::size_t r = c + 1; r < xRows; r++)
+                {
+                    const T v = xA[r * xLda + c];
+                    T *tRow = xA + r * xLda + c + 1;
+                    for (std::size_t q = 0; q < tRest; q++)
+                        tRow[q] -= v * xWork[q];
+                }
+            }
+        }
+
+        // Work buffers for one block reflector, sized for the largest block.
+        template <typename T>
+        struct BlockReflector
+        {
+            QrBuffer<T> m_V, m_Vt, m_T, m_W, m_Wt;
+
+            BlockReflector(std::size_t xRows, std::size_t xCols)
+                : m_V(xRows * gQrBlock), m_Vt(xRows * gQrBlock), m_T(gQrBlock * gQrBlock), m_W(gQrBlock * xCols), m_Wt(gQrBlock * xCols)
+            {
+            }
+
+            // Explicit V (xRows x xWidth) from the factored panel, and the upper triangular T
+            // with H_0 ... H_(w-1) = I - V T V^T, from S = V^T V.
+            void form(std::size_t xRows, std::size_t xWidth, const T *xPanel, std::size_t xLda, const T *xTau, Parallel::Executor &xExecutor)
+            {
+                for (std::size_t r = 0; r < xRows; r++)
+                    for (std::size_t c = 0; c < xWidth; c++)
+                        m_V[r * xWidth + c] = r < c ? static_cast<T>(0) : r == c ? static_cast<T>(1) : xPanel[r * xLda + c];
+                Kernels::transpose(xRows, xWidth, m_V.data(), xWidth, m_Vt.data(), xRows);
+                Kernels::gemm(xWidth, xWidth, xRows, static_cast<T>(1), m_Vt.data(), xRows, m_V.data(), xWidth, static_cast<T>(0),
+                              m_T.data(), xWidth, xExecutor);
+
+                // T(0:i, i) = -tau_i T(0:i, 0:i) S(0:i, i), in place over S: row r only reads
+                // S(p, i) for p >= r.
+                for (std::size_t i = 0; i < xWidth; i++)
+                {
+                    for (std::size_t r = 0; r < i; r++)
+                    {
+                        T tSum{static_cast<T>(0)};
+                        for (std::size_t p = r; p < i; p++)
+                            tSum += m_T[r * xWidth + p] * m_T[p * xWidth + i];
+                        m_T[r * xWidth + i] = -xTau[i] * tSum;
+                    }
+                    m_T[i * xWidth + i] = xTau[i];
+                    for (std::size_t r = i + 1; r < xWidth; r++)
+                        m_T[r * xWidth + i] = static_cast<T>(0);
+                }
+            }
+
+            // B = (I - V op(T) V^T) B for the xRows x xCols matrix B, op(T) = T^T applies
+            // Q_j^T and T applies Q_j. Two gemms carry all but O(w^2 cols) of the work.
+            void apply(std::size_t xRows, std::size_t xWidth, std::size_t xCols, bool xTransposed, T *xB, std::size_t xLdb,
+                       Parallel::Executor &xExecutor)
+            {
+                if (xCols == 0)
+                    return;
+                Kernels::gemm(xWidth, xCols, xRows, static_cast<T>(1), m_Vt.data(), xRows, xB, xLdb, static_cast<T>(0), m_W.data(), xCols,
+                              xExecutor);
+                std::fill_n(m_Wt.data(), xWidth * xCols, static_cast<T>(0));
+                for (std::size_t r = 0; r < xWidth; r++)
+                {
+                    T *tOut = m_Wt.data() + r * xCols;
+                    const std::size_t tFirst = xTransposed ? 0 : r, tLast = xTransposed ? r + 1 : xWidth;
+                    for (std::size_t p = tFirst; p < tLast; p++)
+                    {
+                        const T tCoefficient = xTransposed ? m_T[p * xWidth + r] : m_T[r * xWidth + p];
+                        const T *tIn = m_W.data() + p * xCols;
+                        for (std::size_t c = 0; c < xCols; c++)
+                            tOut[c] += tCoefficient * tIn[c];
+                    }
+                }
+                Kernels::gemm(xRows, xCols, xWidth, static_cast<T>(-1), m_V.data(), xWidth, m_Wt.data(), xCols, static_cast<T>(1), xB, xLdb,
+                              xExecutor);
+            }
+        };
+
+        // Column by column, a tall panel is streamed from memory once per column. Halving it
+        // and applying the left half as a block reflector keeps that to a few passes and turns
+        // the rest into gemm. xBlock only holds buffers between the recursive calls.
+        template <typename T>
+        void factorPanel(std::size_t xRows, std::size_t xWidth, T *xA, std::size_t xLda, T *xTau, BlockReflector<T> &xBlock, T *xWork,
+                         Parallel::Executor &xExecutor)
+        {
+            if (xWidth <= gQrPanelLeaf)
+            {
+                factorColumns(xRows, xWidth, xA, xLda, xTau, xWork);
+                return;
+            }
+            const std::size_t tLeft = xWidth / 2;
+            factorPanel(xRows, tLeft, xA, xLda, xTau, xBlock, xWork, xExecutor);
+            xBlock.form(xRows, tLeft, xA, xLda, xTau, xExecutor);
+            xBlock.apply(xRows, tLeft, xWidth - tLeft, true, xA + tLeft, xLda, xExecutor);
+            factorPanel(xRows - tLeft, xWidth - tLeft, xA + tLeft * xLda + tLeft, xLda, xTau + tLeft, xBlock, xWork, xExecutor);
+        }
+
+        // Blocked Householder QR in place: each gQrBlock wide panel is factored recursively,
+        // then applied to the trailing columns as one block reflector.
+        template <typename T>
+        void householderQr(std::size_t xRows, std::size_t xCols, T *xA, std::size_t xLda, T *xTau, Parallel::Executor &xExecutor)
+        {
+            const std::size_t tReflectors = std::min(xRows, xCols);
+            BlockReflector<T> tBlock{xRows, xCols};
+            std::vector<T> tWork(gQrBlock);
+            for (std::size_t j = 0; j < tReflectors; j += gQrBlock)
+            {
+                const std::size_t tWidth = std::min(gQrBlock, tReflectors - j), tRows = xRows - j;
+                T *tPanel = xA + j * xLda + j;
+                factorPanel(tRows, tWidth, tPanel, xLda, xTau + j, tBlock, tWork.data(), xExecutor);
+                if (j + tWidth == xCols)
+                    continue;
+                tBlock.form(tRows, tWidth, tPanel, xLda, xTau + j, xExecutor);
+                tBlock.apply(tRows, tWidth, xCols - j - tWidth, true, tPanel + tWidth, xLda, xExecutor);
+            }
+        }
+
+        template <typename T, typename Allocator>
+        Matrix<T> copyRows(const Matrix<T, Allocator> &xMatrix, std::size_t xFirst, std::size_t xLast)
+        {
+            auto tResult = Matrix<T>::create(Row{xLast - xFirst}, xMatrix.getCols());
+            for (std::size_t i = xFirst; i < xLast; i++)
+                for (std::size_t j = 0; j < xMatrix.getCols().get(); j++)
+                    tResult(i - xFirst, j) = xMatrix(i, j);
+            return tResult;
+        }
+
+        template <typename T>
+        Matrix<T> toColumn(const Vector<T> &xVector)
+        {
+            auto tResult = Matrix<T>::create(Row{xVector.size()}, Column{1});
+            for (std::size_t i = 0; i < xVector.size(); i++)
+                tResult(i, 0) = xVector[i];
+            return tResult;
+        }
+
+        template <typename T>
+        Vector<T> fromColumn(const Matrix<T> &xMatrix)
+        {
+            auto tResult = Vector<T>::create(Row{xMatrix.getRows().get()});
+            for (std::size_t i = 0; i < xMatrix.getRows().get(); i++)
+                tResult[i] = xMatrix(i, 0);
+            return tResult;
+        }
+
+        // x = R^-1 (first n rows of xQtB); std::nullopt if R has a zero on its diagonal.
+        template <typename T>
+        std::optional<Matrix<T>> solveR(const Matrix<T> &xR, const Matrix<T> &xQtB, Parallel::Executor &xExecutor)
+        {
+            const std::size_t n = xR.getCols().get();
+            for (std::size_t i = 0; i < n; i++)
+                if (xR(i, i) == static_cast<T>(0))
+                    return std::nullopt;
+
+            auto tResult = copyRows(xQtB, 0, n);
+            Kernels::trsmUpper<false>(n, tResult.getCols().get(), xR.getData().data(), xR.getLeadingDimension(), tResult.getData().data(),
+                                      tResult.getLeadingDimension(), xExecutor);
+            return tResult;
+        }
+    } // namespace Detail
+
+    // A = Q R of an m x n matrix by Householder reflections, stored packed like LAPACK's
+    // geqrf: R on and above the diagonal, the essential part of each reflector below it.
+    template <typename T>
+    class QrDecomposition
+    {
+        static_assert(std::is_floating_point_v<T>, "QrDecomposition needs a floating point type");
+
+    private:
+        Matrix<T> m_Factors{Matrix<T>::create()};
+        std::vector<T> m_Tau{};
+
+        // B = Q^T B (xTransposed) or Q B, block by block.
+        void apply(Matrix<T> &xB, bool xTransposed, Parallel::Executor &xExecutor) const;
+
+    public:
+        QrDecomposition(Matrix<T> xFactors, std::vector<T> xTau) noexcept : m_Factors{std::move(xFactors)}, m_Tau{std::move(xTau)} {}
+
+        std::size_t getRows() const noexcept { return m_Factors.getRows().get(); }
+        std::size_t getCols() const noexcept { return m_Factors.getCols().get(); }
+        const Matrix<T> &getFactors() const noexcept { return m_Factors; }
+        const std::vector<T> &getTau() const noexcept { return m_Tau; }
+
+        // min(m, n) x n upper triangle.
+        Matrix<T> getR() const;
+        // Thin m x min(m, n) factor with orthonormal columns.
+        Matrix<T> getQ(Parallel::Executor &xExecutor) const;
+        Matrix<T> getQ() const { return getQ(Parallel::defaultExecutor()); }
+
+        // xB = Q^T xB or Q xB; false, leaving xB unchanged, if it does not have m rows.
+        bool applyQt(Matrix<T> &xB, Parallel::Executor &xExecutor) const;
+        bool applyQt(Matrix<T> &xB) const { return applyQt(xB, Parallel::defaultExecutor()); }
+        bool applyQ(Matrix<T> &xB, Parallel::Executor &xExecutor) const;
+        bool applyQ(Matrix<T> &xB) const { return applyQ(xB, Parallel::defaultExecutor()); }
+
+        // min ||A x - b||; std::nullopt if m < n, R is singular or the sizes differ.
+        std::optional<Vector<T>> leastSquares(const Vector<T> &xRhs) const;
+        std::optional<Matrix<T>> leastSquares(const Matrix<T> &xRhs, Parallel::Executor &xExecutor) const;
+        std::optional<Matrix<T>> leastSquares(const Matrix<T> &xRhs) const { return leastSquares(xRhs, Parallel::defaultExecutor()); }
+    };
+
+    // Tall-skinny QR: the rows are split into blocks that are factored in parallel, and their
+    // stacked R factors are factored once more. Q = diag(Q_1, ..., Q_p) Q_top stays implicit.
+    template <typename T>
+    class TsqrDecomposition
+    {
+    private:
+        std::vector<std::size_t> m_Offsets{};
+        std::vector<QrDecomposition<T>> m_Leaves{};
+        QrDecomposition<T> m_Top;
+
+        // First n rows of Q^T xB.
+        Matrix<T> reduce(const Matrix<T> &xB, Parallel::Executor &xExecutor) const;
+
+    public:
+        TsqrDecomposition(std::vector<std::size_t> xOffsets, std::vector<QrDecomposition<T>> xLeaves, QrDecomposition<T> xTop) noexcept
+            : m_Offsets{std::move(xOffsets)}, m_Leaves{std::move(xLeaves)}, m_Top{std::move(xTop)}
+        {
+        }
+
+        std::size_t getRows() const noexcept { return m_Offsets.back(); }
+        std::size_t getCols() const noexcept { return m_Top.getCols(); }
+        std::size_t getBlocks() const noexcept { return m_Leaves.size(); }
+
+        Matrix<T> getR() const { return m_Top.getR(); }
+        Matrix<T> getQ(Parallel::Executor &xExecutor) const;
+        Matrix<T> getQ() const { return getQ(Parallel::defaultExecutor()); }
+
+        std::optional<Vector<T>> leastSquares(const Vector<T> &xRhs) const;
+        std::optional<Matrix<T>> leastSquares(const Matrix<T> &xRhs, Parallel::Executor &xExecutor) const;
+        std::optional<Matrix<T>> leastSquares(const Matrix<T> &xRhs) const { return leastSquares(xRhs, Parallel::defaultExecutor()); }
+    };
+
+    // Blocked Householder QR; the trailing updates are gemms on xExecutor.
+    template <typename T, typename Allocator>
+    QrDecomposition<T> qr(const Matrix<T, Allocator> &xMatrix, Parallel::Executor &xExecutor)
+    {
+        auto tFactors = Detail::copyRows(xMatrix, 0, xMatrix.getRows().get());
+        std::vector<T> tTau(std::min(xMatrix.getRows().get(), xMatrix.getCols().get()));
+        Detail::householderQr(tFactors.getRows().get(), tFactors.getCols().get(), tFactors.getData().data(), tFactors.getLeadingDimension(),
+                              tTau.data(), xExecutor);
+        return QrDecomposition<T>{std::move(tFactors), std::move(tTau)};
+    }
+
+    template <typename T, typename Allocator>
+    QrDecomposition<T> qr(const Matrix<T, Allocator> &xMatrix)
+    {
+        return qr(xMatrix, Parallel::defaultExecutor());
+    }
+
+    // One row block per thread of xExecutor, each with at least twice as many rows as columns;
+    // std::nullopt if xMatrix has fewer rows than columns.
+    template <typename T, typename Allocator>
+    std::optional<TsqrDecomposition<T>> tsqr(const Matrix<T, Allocator> &xMatrix, Parallel::Executor &xExecutor)
+    {
+        const std::size_t m = xMatrix.getRows().get(), n = xMatrix.getCols().get();
+        if (m < n)
+            return std::nullopt;
+
+        const std::size_t tBlocks = std::max<std::size_t>(1, std::min(xExecutor.concurrency(), m / std::max<std::size_t>(2 * n, 1)));
+        std::vector<std::size_t> tOffsets(tBlocks + 1);
+        for (std::size_t b = 0; b <= tBlocks; b++)
+            tOffsets[b] = m * b / tBlocks;
+
+        std::vector<std::optional<QrDecomposition<T>>> tLeaves(tBlocks);
+        xExecutor.parallelFor(tBlocks, [&](std::size_t xBlock)
+                              {
+                                  Parallel::SequentialExecutor tSequential;
+                                  tLeaves[xBlock].emplace(qr(Detail::copyRows(xMatrix, tOffsets[xBlock], tOffsets[xBlock + 1]), tSequential));
+                              });
+
+        auto tStacked = Matrix<T>::create(Row{tBlocks * n}, Column{n});
+        std::vector<QrDecomposition<T>> tFactored;
+        for (std::size_t b = 0; b < tBlocks; b++)
+        {
+            const auto tR = tLeaves[b]->getR();
+            for (std::size_t i = 0; i < n; i++)
+                for (std::size_t j = i; j < n; j++)
+                    tStacked(b * n + i, j) = tR(i, j);
+            tFactored.push_back(std::move(*tLeaves[b]));
+        }
+        return TsqrDecomposition<T>{std::move(tOffsets), std::move(tFactored), qr(tStacked, xExecutor)};
+    }
+
+    template <typename T, typename Allocator>
+    std::optional<TsqrDecomposition<T>> tsqr(const Matrix<T, Allocator> &xMatrix)
+    {
+        return tsqr(xMatrix, Parallel::defaultExecutor());
+    }
+
+    namespace Detail
+    {
+        inline bool useTsqr(QrMode xMode, std::size_t xRows, std::size_t xCols, std::size_t xThreads) noexcept
+        {
+            if (xMode != QrMode::Auto)
+                return xMode == QrMode::TallSkinny;
+            return xThreads > 1 && xRows >= 2 * xCols * xThreads;
+        }
+    } // namespace Detail
+
+    // min ||A x - b|| through QR, never through the normal equations; std::nullopt if A has
+    // fewer rows than columns, is rank deficient or the sizes differ.
+    template <typename T, typename Allocator>
+    std::optional<Matrix<T>> leastSquares(const Matrix<T, Allocator> &xMatrix, const Matrix<T> &xRhs, QrMode xMode = QrMode::Auto)
+    {
+        auto &tExecutor = Parallel::defaultExecutor();
+        if (Detail::useTsqr(xMode, xMatrix.getRows().get(), xMatrix.getCols().get(), tExecutor.concurrency()))
+        {
+            const auto tTsqr = tsqr(xMatrix, tExecutor);
+            return tTsqr ? tTsqr->leastSquares(xRhs, tExecutor) : std::nullopt;
+        }
+        return qr(xMatrix, tExecutor).leastSquares(xRhs, tExecutor);
+    }
+
+    template <typename T, typename Allocator>
+    std::optional<Vector<T>> leastSquares(const Matrix<T, Allocator> &xMatrix, const Vector<T> &xRhs, QrMode xMode = QrMode::Auto)
+    {
+        const auto tResult = leastSquares(xMatrix, Detail::toColumn(xRhs), xMode);
+        return tResult ? std::optional<Vector<T>>{Detail::fromColumn(*tResult)} : std::nullopt;
+    }
+
+    template <typename T>
+    inline void QrDecomposition<T>::apply(Matrix<T> &xB, bool xTransposed, Parallel::Executor &xExecutor) const
+    {
+        const std::size_t m = getRows(), tReflectors = m_Tau.size(), tCols = xB.getCols().get();
+        const T *A = m_Factors.getData().data();
+        const std::size_t tLda = m_Factors.getLeadingDimension(), tLdb = xB.getLeadingDimension();
+        const std::size_t tBlocks = (tReflectors + gQrBlock - 1) / gQrBlock;
+
+        // Q^T = Q_last^T ... Q_0^T runs the blocks forwards, Q backwards.
+        Detail::BlockReflector<T> tBlock{m, tCols};
+        for (std::size_t b = 0; b < tBlocks; b++)
+        {
+            const std::size_t j = (xTransposed ? b : tBlocks - 1 - b) * gQrBlock;
+            const std::size_t tWidth = std::min(gQrBlock, tReflectors - j);
+            tBlock.form(m - j, tWidth, A + j * tLda + j, tLda, m_Tau.data() + j, xExecutor);
+            tBlock.apply(m - j, tWidth, tCols, xTransposed, xB.getData().data() + j * tLdb, tLdb, xExecutor);
+        }
+    }
+
+    template <typename T>
+    inline Matrix<T> QrDecomposition<T>::getR() const
+    {
+        const std::size_t k = m_Tau.size();
+        auto tResult = Matrix<T>::create(Row{k}, Column{getCols()});
+        for (std::size_t i = 0; i < k; i++)
+            for (std::size_t j = i; j < getCols(); j++)
+                tResult(i, j) = m_Factors(i, j);
+        return tResult;
+    }
+
+    template <typename T>
+    inline Matrix<T> QrDecomposition<T>::getQ(Parallel::Executor &xExecutor) const
+    {
+        auto tResult = Matrix<T>::create(Row{getRows()}, Column{m_Tau.size()});
+        for (std::size_t i = 0; i < m_Tau.size(); i++)
+            tResult(i, i) = static_cast<T>(1);
+        apply(tResult, false, xExecutor);
+        return tResult;
+    }
+
+    template <typename T>
+    inline bool QrDecomposition<T>::applyQt(Matrix<T> &xB, Parallel::Executor &xExecutor) const
+    {
+        if (xB.getRows().get() != getRows())
+            return false;
+        apply(xB, true, xExecutor);
+        return true;
+    }
+
+    template <typename T>
+    inline bool QrDecomposition<T>::applyQ(Matrix<T> &xB, Parallel::Executor &xExecutor) const
+    {
+        if (xB.getRows().get() != getRows())
+            return false;
+        apply(xB, false, xExecutor);
+        return true;
+    }
+
+    template <typename T>
+    inline std::optional<Vector<T>> QrDecomposition<T>::leastSquares(const Vector<T> &xRhs) const
+    {
+        const auto tResult = leastSquares(Detail::toColumn(xRhs));
+        return tResult ? std::optional<Vector<T>>{Detail::fromColumn(*tResult)} : std::nullopt;
+    }
+
+    template <typename T>
+    inline std::optional<Matrix<T>> QrDecomposition<T>::leastSquares(const Matrix<T> &xRhs, Parallel::Executor &xExecutor) const
+    {
+        if (getRows() < getCols() || xRhs.getRows().get() != getRows())
+            return std::nullopt;
+
+        auto tQtB = Matrix<T>::create(xRhs);
+        apply(tQtB, true, xExecutor);
+        return Detail::solveR(getR(), tQtB, xExecutor);
+    }
+
+    template <typename T>
+    inline Matrix<T> TsqrDecomposition<T>::reduce(const Matrix<T> &xB, Parallel::Executor &xExecutor) const
+    {
+        const std::size_t n = getCols(), tCols = xB.getCols().get();
+        auto tStacked = Matrix<T>::create(Row{getBlocks() * n}, Column{tCols});
+        xExecutor.parallelFor(getBlocks(), [&](std::size_t xBlock)
+                              {
+                                  Parallel::SequentialExecutor tSequential;
+                                  auto tPart = Detail::copyRows(xB, m_Offsets[xBlock], m_Offsets[xBlock + 1]);
+                                  m_Leaves[xBlock].applyQt(tPart, tSequential);
+                                  for (std::size_t i = 0; i < n; i++)
+                                      for (std::size_t j = 0; j < tCols; j++)
+                                          tStacked(xBlock * n + i, j) = tPart(i, j);
+                              });
+        m_Top.applyQt(tStacked, xExecutor);
+        return tStacked;
+    }
+
+    template <typename T>
+    inline Matrix<T> TsqrDecomposition<T>::getQ(Parallel::Executor &xExecutor) const
+    {
+        const std::size_t n = getCols();
+        const auto tTopQ = m_Top.getQ(xExecutor);
+        auto tResult = Matrix<T>::create(Row{getRows()}, Column{n});
+        xExecutor.parallelFor(getBlocks(), [&](std::size_t xBlock)
+                              {
+                                  Parallel::SequentialExecutor tSequential;
+                                  auto tPart = Matrix<T>::create(Row{m_Offsets[xBlock + 1] - m_Offsets[xBlock]}, Column{n});
+                                  for (std::size_t i = 0; i < n; i++)
+                                      for (std::size_t j = 0; j < n; j++)
+                                          tPart(i, j) = tTopQ(xBlock * n + i, j);
+                                  m_Leaves[xBlock].applyQ(tPart, tSequential);
+                                  for (std::size_t i = 0; i < tPart.getRows().get(); i++)
+                                      for (std::size_t j = 0; j < n; j++)
+                                          tResult(m_Offsets[xBlock] + i, j) = tPart(i, j);
+                              });
+        return tResult;
+    }
+
+    template <typename T>
+    inline std::optional<Vector<T>> TsqrDecomposition<T>::leastSquares(const Vector<T> &xRhs) const
+    {
+        const auto tResult = leastSquares(Detail::toColumn(xRhs));
+        return tResult ? std::optional<Vector<T>>{Detail::fromColumn(*tResult)} : std::nullopt;
+    }
+
+    template <typename T>
+    inline std::optional<Matrix<T>> TsqrDecomposition<T>::leastSquares(const Matrix<T> &xRhs, Parallel::Executor &xExecutor) const
+    {
+        if (xRhs.getRows().get() != getRows())
+            return std::nullopt;
+        return Detail::solveR(getR(), reduce(xRhs, xExecutor), xExecutor);
+    }
+} // namespace Linalg
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "qr.h"
+#include "../matrix.h"
+#include "../Kernels/simd.h"
+#include "../Parallel/threadPool.h"
+#include "../Types/column.h"
+#include "../Types/row.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Linalg
+{
+    // Jacobi sweeps allowed for the small SVD of the projected matrix.
+    constexpr std::size_t gSvdMaxSweeps{60};
+
+    namespace Detail
+    {
+        // One-sided Jacobi on the rows of xB (l x n, l small): rotates row pairs until they are
+        // orthogonal and records the rotations in xJ, so xJ B_in = B_out. False if the sweeps
+        // run out.
+        template <typename T>
+        bool orthogonalizeRows(Matrix<T> &xB, Matrix<T> &xJ)
+        {
+            const std::size_t l = xB.getRows().get(), n = xB.getCols().get();
+            auto tRow = [](Matrix<T> &xMatrix, std::size_t xRow) { return xMatrix.getData().data() + xRow * xMatrix.getLeadingDimension(); };
+            auto tRotate = [](T *xUpper, T *xLower, std::size_t xCount, T xCos, T xSin)
+            {
+                for (std::size_t c = 0; c < xCount; c++)
+                {
+                    const T tUpper = xUpper[c], tLower = xLower[c];
+                    xUpper[c] = xCos * tUpper - xSin * tLower;
+                    xLower[c] = xSin * tUpper + xCos * tLower;
+                }
+            };
+
+            for (std::size_t tSweep = 0; tSweep < gSvdMaxSweeps; tSweep++)
+            {
+                bool tRotated{false};
+                for (std::size_t i = 0; i + 1 < l; i++)
+                {
+                    for (std::size_t j = i + 1; j < l; j++)
+                    {
+                        T *bi = tRow(xB, i), *bj = tRow(xB, j);
+                        const T tAlpha = Kernels::dot(bi, bi, n), tBeta = Kernels::dot(bj, bj, n), tGamma = Kernels::dot(bi, bj, n);
+                        if (std::abs(tGamma) <= std::numeric_limits<T>::epsilon() * std::sqrt(tAlpha * tBeta))
+                            continue;
+                        tRotated = true;
+                        const T tZeta = (tBeta - tAlpha) / (2 * tGamma);
+                        const T t = std::copysign(static_cast<T>(1), tZeta) / (std::abs(tZeta) + std::hypot(static_cast<T>(1), tZeta));
+                        const T c = static_cast<T>(1) / std::hypot(static_cast<T>(1), t), s = c * t;
+                        tRotate(bi, bj, n, c, s);
+                        tRotate(tRow(xJ, i), tRow(xJ, j), l, c, s);
+                    }
+                }
+                if (!tRotated)
+                    return true;
+            }
+            return false;
+        }
+    } // namespace Detail
+
+    // A ~ U diag(singular values) V^T for the leading singular triplets, singular values
+    // descending; U and V have orthonormal columns. Singular values below the rank tolerance
+    // max(m, n) * epsilon * largest are returned as zero, and their columns of V only complete
+    // the basis.
+    template <typename T>
+    struct TruncatedSvd
+    {
+        Matrix<T> m_U;
+        std::vector<T> m_SingularValues;
+        Matrix<T> m_V;
+    };
+
+    // Randomized SVD (Halko, Martinsson, Tropp) of the top xRank singular triplets: the range
+    // of A is sampled with a Gaussian sketch of xRank + xOversampling columns, sharpened by
+    // xPowerIterations rounds of A A^T (re-orthonormalized by QR each time), and the small
+    // projected matrix Q^T A is decomposed by one-sided Jacobi. The products with A are gemms
+    // on xExecutor. xSeed makes the sketch reproducible. std::nullopt if xRank is zero or
+    // exceeds the smaller dimension of xMatrix.
+    template <typename T, typename Allocator>
+    std::optional<TruncatedSvd<T>> randomizedSvd(const Matrix<T, Allocator> &xMatrix, std::size_t xRank, std::size_t xOversampling,
+                                                 std::size_t xPowerIterations, std::uint64_t xSeed, Parallel::Executor &xExecutor)
+    {
+        static_assert(std::is_floating_point_v<T>, "randomizedSvd needs a floating point type");
+        const std::size_t m = xMatrix.getRows().get(), n = xMatrix.getCols().get();
+        if (xRank == 0 || xRank > std::min(m, n))
+            return std::nullopt;
+        const std::size_t l = std::min(xRank + xOversampling, std::min(m, n));
+
+        auto tA = Detail::copyRows(xMatrix, 0, m);
+        const auto tAt = tA.transposed();
+        auto tProduct = [&](const Matrix<T> &xLhs, const Matrix<T> &xRhs)
+        {
+            auto tResult = Matrix<T>::create(xLhs.getRows(), xRhs.getCols());
+            Kernels::gemm(xLhs.getRows().get(), xRhs.getCols().get(), xLhs.getCols().get(), static_cast<T>(1), xLhs.getData().data(),
+                          xLhs.getLeadingDimension(), xRhs.getData().data(), xRhs.getLeadingDimension(), static_cast<T>(0),
+                          tResult.getData().data(), tResult.getLeadingDimension(), xExecutor);
+            return tResult;
+        };
+        auto tOrthonormalize = [&](const Matrix<T> &xMatrix) { return qr(xMatrix, xExecutor).getQ(xExecutor); };
+
+        std::mt19937_64 tEngine{xSeed};
+        std::normal_distribution<T> tNormal{};
+        auto tSketch = Matrix<T>::create(Row{n}, Column{l});
+        for (std::size_t i = 0; i < n; i++)
+            for (std::size_t j = 0; j < l; j++)
+                tSketch(i, j) = tNormal(tEngine);
+
+        auto tQ = tOrthonormalize(tProduct(tA, tSketch));
+        for (std::size_t i = 0; i < xPowerIterations; i++)
+            tQ = tOrthonormalize(tProduct(tA, tOrthonormalize(tProduct(tAt, tQ))));
+
+        // B = Q^T A = (A^T Q)^T, l x n.
+        auto tB = tProduct(tAt, tQ).transposed();
+        auto tJ = Matrix<T>::create(Row{l}, Column{l});
+        for (std::size_t i = 0; i < l; i++)
+            tJ(i, i) = static_cast<T>(1);
+        if (!Detail::orthogonalizeRows(tB, tJ))
+            return std::nullopt;
+
+        // J B = diag(s) W^T, so A ~ (Q J^T) diag(s) W^T.
+        std::vector<T> tNorms(l);
+        for (std::size_t i = 0; i < l; i++)
+        {
+            const T *tRow = tB.getData().data() + i * tB.getLeadingDimension();
+            tNorms[i] = std::sqrt(Kernels::dot(tRow, tRow, n));
+        }
+        std::vector<std::size_t> tOrder(l);
+        std::iota(tOrder.begin(), tOrder.end(), std::size_t{0});
+        std::sort(tOrder.begin(), tOrder.end(), [&](std::size_t xLhs, std::size_t xRhs) { return tNorms[xLhs] > tNorms[xRhs]; });
+
+        // Rows of B at the rounding level carry no direction; they count as zero.
+        const T tTolerance = static_cast<T>(std::max(m, n)) * std::numeric_limits<T>::epsilon() * tNorms[tOrder[0]];
+        auto tJt = Matrix<T>::create(Row{l}, Column{xRank});
+        TruncatedSvd<T> tResult{Matrix<T>::create(), std::vector<T>(xRank), Matrix<T>::create(Row{n}, Column{xRank})};
+        std::size_t tNumericalRank{0};
+        for (std::size_t k = 0; k < xRank; k++)
+        {
+            const std::size_t tSource = tOrder[k];
+            const T tNorm = tNorms[tSource];
+            for (std::size_t i = 0; i < l; i++)
+                tJt(i, k) = tJ(tSource, i);
+            if (tNorm <= tTolerance)
+                continue;
+            tResult.m_SingularValues[k] = tNorm;
+            tNumericalRank = k + 1;
+            for (std::size_t j = 0; j < n; j++)
+                tResult.m_V(j, k) = tB(tSource, j) / tNorm;
+        }
+        tResult.m_U = tProduct(tQ, tJt);
+
+        // U = Q J^T is orthonormal as it is. The trailing columns of V are completed by the QR
+        // of V with random columns appended: Householder Q keeps the span of the leading
+        // columns, so its remaining columns are orthogonal to them.
+        if (tNumericalRank < xRank)
+        {
+            auto tFilled = tResult.m_V;
+            for (std::size_t j = 0; j < n; j++)
+                for (std::size_t k = tNumericalRank; k < xRank; k++)
+                    tFilled(j, k) = tNormal(tEngine);
+            const auto tBasis = tOrthonormalize(tFilled);
+            for (std::size_t j = 0; j < n; j++)
+                for (std::size_t k = tNumericalRank; k < xRank; k++)
+                    tResult.m_V(j, k) = tBasis(j, k);
+        }
+        return tResult;
+    }
+
+    template <typename T, typename Allocator>
+    std::optional<TruncatedSvd<T>> randomizedSvd(const Matrix<T, Allocator> &xMatrix, std::size_t xRank, std::size_t xOversampling = 10,
+                                                 std::size_t xPowerIterations = 2, std::uint64_t xSeed = 0x5eed)
+    {
+        return randomizedSvd(xMatrix, xRank, xOversampling, xPowerIterations, xSeed, Parallel::defaultExecutor());
+    }
+} // namespace Linalg
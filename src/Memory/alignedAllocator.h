@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+constexpr std::size_t gMatrixAlignment{64};
+
+template <typename T, std::size_t Alignment = gMatrixAlignment>
+class AlignedAllocator
+{
+    static_assert(Alignment >= alignof(T), "Alignment must not be weaker than the alignment of T");
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using is_always_equal = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    constexpr AlignedAllocator() noexcept = default;
+    template <typename U>
+    constexpr AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {}
+
+    T *allocate(std::size_t xCount)
+    {
+        if (xCount > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_array_new_length();
+
+        return static_cast<T *>(::operator new(xCount * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T *xPtr, std::size_t) noexcept
+    {
+        ::operator delete(xPtr, std::align_val_t{Alignment});
+    }
+
+    template <typename U>
+    constexpr bool operator==(const AlignedAllocator<U, Alignment> &) const noexcept { return true; }
+    template <typename U>
+    constexpr bool operator!=(const AlignedAllocator<U, Alignment> &) const noexcept { return false; }
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "alignedAllocator.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+
+// Bump allocator for request-scoped work. Every allocation is at least gMatrixAlignment
+// aligned, deallocate() is a no-op and reset() frees everything at once. Not thread safe.
+class MonotonicArena : public std::pmr::memory_resource
+{
+private:
+    struct Chunk
+    {
+        Chunk *m_Next;
+        std::size_t m_Size;
+    };
+    // Payload starts one alignment unit after the chunk header.
+    static constexpr std::size_t gHeaderSize{gMatrixAlignment};
+
+    std::pmr::memory_resource *m_Upstream;
+    Chunk *m_Chunks{nullptr}; // Newest (and largest) first
+    std::byte *m_Cursor{nullptr};
+    std::byte *m_End{nullptr};
+    std::size_t m_NextChunkSize;
+    std::size_t m_Used{0};
+
+    void grow(std::size_t xBytes, std::size_t xAlignment)
+    {
+        const std::size_t tSize = std::max(m_NextChunkSize, gHeaderSize + xBytes + xAlignment);
+        auto *tMemory = static_cast<std::byte *>(m_Upstream->allocate(tSize, gMatrixAlignment));
+        m_Chunks = ::new (tMemory) Chunk{m_Chunks, tSize};
+        m_Cursor = tMemory + gHeaderSize;
+        m_End = tMemory + tSize;
+        m_NextChunkSize = tSize * 2;
+    }
+
+    void freeChunks(Chunk *xChunk) noexcept
+    {
+        while (xChunk != nullptr)
+        {
+            Chunk *tNext = xChunk->m_Next;
+            m_Upstream->deallocate(xChunk, xChunk->m_Size, gMatrixAlignment);
+            xChunk = tNext;
+        }
+    }
+
+protected:
+    void *do_allocate(std::size_t xBytes, std::size_t xAlignment) override
+    {
+        xAlignment = std::max(xAlignment, gMatrixAlignment);
+        auto tAligned = [&]
+        { return reinterpret_cast<std::byte *>((reinterpret_cast<std::uintptr_t>(m_Cursor) + xAlignment - 1) & ~(xAlignment - 1)); };
+
+        if (m_Cursor == nullptr || tAligned() + xBytes > m_End)
+            grow(xBytes, xAlignment);
+
+        std::byte *tResult = tAligned();
+        m_Cursor = tResult + xBytes;
+        m_Used += xBytes;
+        return tResult;
+    }
+
+    void do_deallocate(void *, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource &xOther) const noexcept override
+    {
+        return this == &xOther;
+    }
+
+public:
+    explicit MonotonicArena(std::size_t xInitialSize = std::size_t{1} << 20,
+                            std::pmr::memory_resource *xUpstream = std::pmr::new_delete_resource()) noexcept
+        : m_Upstream{xUpstream}, m_NextChunkSize{std::max(xInitialSize, 2 * gHeaderSize)}
+    {
+    }
+    MonotonicArena(const MonotonicArena &) = delete;
+    MonotonicArena &operator=(const MonotonicArena &) = delete;
+    ~MonotonicArena() override { release(); }
+
+    // Invalidates all allocations but keeps the largest chunk, so a repeated request of
+    // the same size runs without touching the upstream resource.
+    void reset() noexcept
+    {
+        if (m_Chunks == nullptr)
+            return;
+
+        freeChunks(m_Chunks->m_Next);
+        m_Chunks->m_Next = nullptr;
+        m_Cursor = reinterpret_cast<std::byte *>(m_Chunks) + gHeaderSize;
+        m_End = reinterpret_cast<std::byte *>(m_Chunks) + m_Chunks->m_Size;
+        m_Used = 0;
+    }
+
+    // Invalidates all allocations and returns every chunk to the upstream resource.
+    void release() noexcept
+    {
+        freeChunks(m_Chunks);
+        m_Chunks = nullptr;
+        m_Cursor = nullptr;
+        m_End = nullptr;
+        m_Used = 0;
+    }
+
+    // Bytes handed out since the last reset, without alignment padding.
+    std::size_t used() const noexcept { return m_Used; }
+
+    // Bytes held from the upstream resource.
+    std::size_t capacity() const noexcept
+    {
+        std::size_t tResult{0};
+        for (const Chunk *tChunk = m_Chunks; tChunk != nullptr; tChunk = tChunk->m_Next)
+            tResult += tChunk->m_Size;
+        return tResult;
+    }
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "alignedAllocator.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Thread-safe pool of recycled buffers. Requests are rounded up to size classes spaced
+// at 1x and 1.5x powers of two (at most a third wasted), starting at gMatrixAlignment,
+// and every block is gMatrixAlignment aligned. Requests above gPoolLargestClass go
+// straight to the upstream resource.
+class PoolResource : public std::pmr::memory_resource
+{
+public:
+    static constexpr std::size_t gPoolLargestClass{std::size_t{1} << 26};
+
+private:
+    static constexpr std::size_t gMinimumShift{6}; // log2(gMatrixAlignment)
+    static constexpr std::size_t gLargestShift{26};
+    static constexpr std::size_t gClassCount{2 * (gLargestShift - 1 - gMinimumShift) + 3};
+    static_assert(std::size_t{1} << gMinimumShift == gMatrixAlignment);
+
+    struct FreeBlock
+    {
+        FreeBlock *m_Next;
+    };
+
+    std::pmr::memory_resource *m_Upstream;
+    mutable std::mutex m_Mutex;
+    std::array<FreeBlock *, gClassCount> m_Free{};
+    std::vector<std::pair<void *, std::size_t>> m_Blocks; // Every block obtained from upstream
+    std::size_t m_Cached{0};
+
+    // (index, size) of the smallest class holding xBytes.
+    static std::pair<std::size_t, std::size_t> sizeClass(std::size_t xBytes) noexcept
+    {
+        if (xBytes <= gMatrixAlignment)
+            return {0, gMatrixAlignment};
+
+        std::size_t tShift{0}; // 2^tShift < xBytes <= 2^(tShift + 1)
+        for (std::size_t tValue = xBytes - 1; tValue > 1; tValue >>= 1)
+            tShift++;
+
+        const std::size_t tMiddle = std::size_t{3} << (tShift - 1);
+        if (xBytes <= tMiddle)
+            return {2 * (tShift - gMinimumShift) + 1, tMiddle};
+        return {2 * (tShift - gMinimumShift) + 2, std::size_t{1} << (tShift + 1)};
+    }
+
+    static bool pooled(std::size_t xBytes, std::size_t xAlignment) noexcept
+    {
+        return xBytes <= gPoolLargestClass && xAlignment <= gMatrixAlignment;
+    }
+
+protected:
+    void *do_allocate(std::size_t xBytes, std::size_t xAlignment) override
+    {
+        if (!pooled(xBytes, xAlignment))
+            return m_Upstream->allocate(xBytes, std::max(xAlignment, gMatrixAlignment));
+
+        const auto [tIndex, tSize] = sizeClass(xBytes);
+        std::lock_guard tLock{m_Mutex};
+        if (FreeBlock *tBlock = m_Free[tIndex])
+        {
+            m_Free[tIndex] = tBlock->m_Next;
+            m_Cached -= tSize;
+            return tBlock;
+        }
+
+        m_Blocks.reserve(m_Blocks.size() + 1);
+        void *tResult = m_Upstream->allocate(tSize, gMatrixAlignment);
+        m_Blocks.emplace_back(tResult, tSize);
+        return tResult;
+    }
+
+    void do_deallocate(void *xPtr, std::size_t xBytes, std::size_t xAlignment) override
+    {
+        if (!pooled(xBytes, xAlignment))
+        {
+            m_Upstream->deallocate(xPtr, xBytes, std::max(xAlignment, gMatrixAlignment));
+            return;
+        }
+
+        const auto [tIndex, tSize] = sizeClass(xBytes);
+        std::lock_guard tLock{m_Mutex};
+        m_Free[tIndex] = ::new (xPtr) FreeBlock{m_Free[tIndex]};
+        m_Cached += tSize;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &xOther) const noexcept override
+    {
+        return this == &xOther;
+    }
+
+public:
+    explicit PoolResource(std::pmr::memory_resource *xUpstream = std::pmr::new_delete_resource()) noexcept
+        : m_Upstream{xUpstream}
+    {
+    }
+    PoolResource(const PoolResource &) = delete;
+    PoolResource &operator=(const PoolResource &) = delete;
+    ~PoolResource() override { release(); }
+
+    // Returns every pooled block to the upstream resource, including ones still in use.
+    void release() noexcept
+    {
+        std::lock_guard tLock{m_Mutex};
+        for (const auto &[tPtr, tSize] : m_Blocks)
+            m_Upstream->deallocate(tPtr, tSize, gMatrixAlignment);
+        m_Blocks.clear();
+        m_Free.fill(nullptr);
+        m_Cached = 0;
+    }
+
+    // Bytes in freed blocks waiting for reuse.
+    std::size_t cached() const noexcept
+    {
+        std::lock_guard tLock{m_Mutex};
+        return m_Cached;
+    }
+
+    static std::size_t classSize(std::size_t xBytes) noexcept { return sizeClass(xBytes).second; }
+};
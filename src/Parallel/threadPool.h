@@ -0,0 +1,303 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Parallel
+{
+    // Anything that can run a batch of independent tasks. Implement this to plug an
+    // existing scheduler into the library.
+    class Executor
+    {
+    public:
+        virtual ~Executor() = default;
+
+        // Number of threads that execute tasks, including the calling thread.
+        virtual std::size_t concurrency() const noexcept = 0;
+        // Runs xTask(0) ... xTask(xCount - 1) and returns once all of them finished.
+        // May be called from inside a running task. Every task runs even if others throw;
+        // the first exception is rethrown once the whole batch finished.
+        virtual void parallelFor(std::size_t xCount, const std::function<void(std::size_t)> &xTask) = 0;
+    };
+
+    namespace Detail
+    {
+        // Runs the whole batch on the calling thread with the same exception rule as the pool.
+        inline void runInline(std::size_t xCount, const std::function<void(std::size_t)> &xTask)
+        {
+            std::exception_ptr tError;
+            for (std::size_t i = 0; i < xCount; i++)
+            {
+                try
+                {
+                    xTask(i);
+                }
+                catch (...)
+                {
+                    if (!tError)
+                        tError = std::current_exception();
+                }
+            }
+            if (tError)
+                std::rethrow_exception(tError);
+        }
+    } // namespace Detail
+
+    class SequentialExecutor final : public Executor
+    {
+    public:
+        std::size_t concurrency() const noexcept override { return 1; }
+        void parallelFor(std::size_t xCount, const std::function<void(std::size_t)> &xTask) override
+        {
+            Detail::runInline(xCount, xTask);
+        }
+    };
+
+    // Work-stealing pool: every worker owns a deque, pops its own work from the back (most
+    // recent first) and steals the oldest work from the front of the others. A thread
+    // waiting in parallelFor only runs queued tasks of its own batch, so a nested call
+    // waits for its own work and never for an unrelated task it picked up.
+    class ThreadPool final : public Executor
+    {
+    private:
+        // One parallelFor call. It lives on the caller's stack until every task finished.
+        struct Batch
+        {
+            const std::function<void(std::size_t)> *m_Body{nullptr};
+            std::atomic<std::size_t> m_Remaining{0};
+            std::atomic<bool> m_Failed{false};
+            std::exception_ptr m_Error{};
+        };
+
+        struct Task
+        {
+            Batch *m_Batch{nullptr};
+            std::size_t m_Index{0};
+        };
+
+        struct Worker
+        {
+            std::mutex m_Mutex;
+            std::deque<Task> m_Tasks;
+        };
+
+        std::vector<std::unique_ptr<Worker>> m_Workers;
+        std::vector<std::thread> m_Threads;
+        std::mutex m_SleepMutex;
+        std::condition_variable m_Wakeup;
+        std::atomic<std::size_t> m_Pending{0};
+        std::atomic<std::size_t> m_NextQueue{0};
+        bool m_Stop{false};
+
+        static ThreadPool *&currentPool() noexcept
+        {
+            thread_local ThreadPool *tPool{nullptr};
+            return tPool;
+        }
+        static std::size_t &currentWorker() noexcept
+        {
+            thread_local std::size_t tWorker{0};
+            return tWorker;
+        }
+
+        bool popLocal(std::size_t xWorker, Task &xTask)
+        {
+            auto &tWorker = *m_Workers[xWorker];
+            std::lock_guard<std::mutex> tLock{tWorker.m_Mutex};
+            if (tWorker.m_Tasks.empty())
+                return false;
+            xTask = tWorker.m_Tasks.back();
+            tWorker.m_Tasks.pop_back();
+            return true;
+        }
+
+        bool steal(std::size_t xStart, Task &xTask)
+        {
+            for (std::size_t i = 0; i < m_Workers.size(); i++)
+            {
+                auto &tVictim = *m_Workers[(xStart + i) % m_Workers.size()];
+                std::lock_guard<std::mutex> tLock{tVictim.m_Mutex};
+                if (tVictim.m_Tasks.empty())
+                    continue;
+                xTask = tVictim.m_Tasks.front();
+                tVictim.m_Tasks.pop_front();
+                return true;
+            }
+            return false;
+        }
+
+        // Takes a queued task of xBatch, searching from the back where the newest work is.
+        bool popBatch(std::size_t xStart, const Batch &xBatch, Task &xTask)
+        {
+            for (std::size_t i = 0; i < m_Workers.size(); i++)
+            {
+                auto &tWorker = *m_Workers[(xStart + i) % m_Workers.size()];
+                std::lock_guard<std::mutex> tLock{tWorker.m_Mutex};
+                const auto tFound = std::find_if(tWorker.m_Tasks.rbegin(), tWorker.m_Tasks.rend(), [&](const Task &xQueued)
+                                                 { return xQueued.m_Batch == &xBatch; });
+                if (tFound == tWorker.m_Tasks.rend())
+                    continue;
+                xTask = *tFound;
+                tWorker.m_Tasks.erase(std::next(tFound).base());
+                return true;
+            }
+            return false;
+        }
+
+        // The first exception of a batch is kept for the caller; the other tasks still run.
+        void run(const Task &xTask)
+        {
+            m_Pending.fetch_sub(1, std::memory_order_relaxed);
+            auto &tBatch = *xTask.m_Batch;
+            try
+            {
+                (*tBatch.m_Body)(xTask.m_Index);
+            }
+            catch (...)
+            {
+                if (!tBatch.m_Failed.exchange(true, std::memory_order_relaxed))
+                    tBatch.m_Error = std::current_exception();
+            }
+            tBatch.m_Remaining.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        void workerLoop(std::size_t xWorker)
+        {
+            currentPool() = this;
+            currentWorker() = xWorker;
+
+            while (true)
+            {
+                Task tTask;
+                if (popLocal(xWorker, tTask) || steal(xWorker + 1, tTask))
+                {
+                    run(tTask);
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> tLock{m_SleepMutex};
+                m_Wakeup.wait(tLock, [this]
+                              { return m_Stop || m_Pending.load(std::memory_order_relaxed) > 0; });
+                if (m_Stop && m_Pending.load(std::memory_order_relaxed) == 0)
+                    return;
+            }
+        }
+
+    public:
+        // xThreads counts the calling thread, which helps while it waits.
+        explicit ThreadPool(std::size_t xThreads = std::max(1U, std::thread::hardware_concurrency()))
+        {
+            const std::size_t tWorkers = xThreads > 1 ? xThreads - 1 : 0;
+            for (std::size_t i = 0; i < tWorkers; i++)
+                m_Workers.emplace_back(std::make_unique<Worker>());
+            for (std::size_t i = 0; i < tWorkers; i++)
+                m_Threads.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+
+        ~ThreadPool() override
+        {
+            {
+                std::lock_guard<std::mutex> tLock{m_SleepMutex};
+                m_Stop = true;
+            }
+            m_Wakeup.notify_all();
+            for (auto &tThread : m_Threads)
+                tThread.join();
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        std::size_t concurrency() const noexcept override { return m_Workers.size() + 1; }
+
+        void parallelFor(std::size_t xCount, const std::function<void(std::size_t)> &xTask) override
+        {
+            if (xCount == 0)
+                return;
+            if (m_Workers.empty() || xCount == 1)
+            {
+                Detail::runInline(xCount, xTask);
+                return;
+            }
+
+            Batch tBatch;
+            tBatch.m_Body = &xTask;
+            tBatch.m_Remaining.store(xCount, std::memory_order_relaxed);
+            const bool tIsWorker = currentPool() == this;
+            const std::size_t tSelf = tIsWorker ? currentWorker() : m_NextQueue.load(std::memory_order_relaxed) % m_Workers.size();
+
+            {
+                std::lock_guard<std::mutex> tLock{m_SleepMutex};
+                m_Pending.fetch_add(xCount, std::memory_order_relaxed);
+            }
+            // Workers keep nested work local so it is stolen only by idle threads;
+            // external callers spread the tasks over all deques.
+            for (std::size_t i = 0; i < xCount; i++)
+            {
+                const std::size_t tQueue = tIsWorker ? tSelf : m_NextQueue.fetch_add(1, std::memory_order_relaxed) % m_Workers.size();
+                auto &tWorker = *m_Workers[tQueue];
+                std::lock_guard<std::mutex> tLock{tWorker.m_Mutex};
+                tWorker.m_Tasks.push_back(Task{&tBatch, i});
+            }
+            m_Wakeup.notify_all();
+
+            // Tasks of this batch that are still queued run here; the others are already
+            // running elsewhere, so only their completion is awaited.
+            Task tTask;
+            while (popBatch(tSelf, tBatch, tTask))
+                run(tTask);
+            while (tBatch.m_Remaining.load(std::memory_order_acquire) > 0)
+                std::this_thread::yield();
+
+            if (tBatch.m_Error)
+                std::rethrow_exception(tBatch.m_Error);
+        }
+    };
+
+    namespace Detail
+    {
+        inline std::unique_ptr<ThreadPool> &libraryPool()
+        {
+            static std::unique_ptr<ThreadPool> tPool{std::make_unique<ThreadPool>()};
+            return tPool;
+        }
+
+        inline std::atomic<Executor *> &userExecutor()
+        {
+            static std::atomic<Executor *> tExecutor{nullptr};
+            return tExecutor;
+        }
+    } // namespace Detail
+
+    // Executor used by all library kernels: the one set with setDefaultExecutor(),
+    // otherwise the library-owned thread pool.
+    inline Executor &defaultExecutor()
+    {
+        if (auto *tExecutor = Detail::userExecutor().load(std::memory_order_acquire))
+            return *tExecutor;
+        return *Detail::libraryPool();
+    }
+
+    // Routes library kernels to xExecutor, which must outlive its use. nullptr restores the library pool.
+    inline void setDefaultExecutor(Executor *xExecutor) noexcept
+    {
+        Detail::userExecutor().store(xExecutor, std::memory_order_release);
+    }
+
+    // Recreates the library-owned pool. Must not be called while library kernels are running.
+    inline void setThreadCount(std::size_t xThreads)
+    {
+        auto &tPool = Detail::libraryPool();
+        tPool.reset();
+        tPool = std::make_unique<ThreadPool>(std::max<std::size_t>(1, xThreads));
+    }
+} // namespace Parallel
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+namespace Float16Encoding
+{
+    // IEEE 754 binary16: 1 sign, 5 exponent and 10 mantissa bits, largest finite value 65504.
+    struct Ieee
+    {
+        static std::uint16_t fromFloat(float xValue) noexcept
+        {
+            std::uint32_t tBits;
+            std::memcpy(&tBits, &xValue, sizeof(tBits));
+            const auto tSign = static_cast<std::uint16_t>((tBits >> 16) & 0x8000u);
+            std::uint32_t tAbs = tBits & 0x7FFFFFFFu;
+
+            // Infinity, NaN (kept quiet) and everything that rounds past 65504.
+            if (tAbs >= 0x47800000u)
+                return tSign | (tAbs > 0x7F800000u ? 0x7E00u : 0x7C00u);
+            // Below 2^-14 the result is subnormal: adding 0.5f lines the half ulp up with the
+            // float ulp, so the FPU does the round to nearest even.
+            if (tAbs < 0x38800000u)
+            {
+                float tAligned;
+                std::memcpy(&tAligned, &tAbs, sizeof(tAligned));
+                tAligned += 0.5f;
+                std::memcpy(&tAbs, &tAligned, sizeof(tAbs));
+                return tSign | static_cast<std::uint16_t>(tAbs - 0x3F000000u);
+            }
+            // Rebias the exponent and round the 13 dropped mantissa bits to nearest even.
+            const std::uint32_t tOdd = (tAbs >> 13) & 1u;
+            tAbs += 0xC8000FFFu + tOdd;
+            return tSign | static_cast<std::uint16_t>(tAbs >> 13);
+        }
+
+        static float toFloat(std::uint16_t xBits) noexcept
+        {
+            const std::uint32_t tSign = static_cast<std::uint32_t>(xBits & 0x8000u) << 16;
+            const std::uint32_t tExponent = (xBits >> 10) & 0x1Fu;
+            const std::uint32_t tMantissa = xBits & 0x3FFu;
+            std::uint32_t tBits;
+            if (tExponent == 0x1Fu)
+            {
+                tBits = tSign | 0x7F800000u | (tMantissa << 13);
+            }
+            else if (tExponent == 0)
+            {
+                // Zero or subnormal: mantissa * 2^-24 is exact in float.
+                const float tValue = static_cast<float>(tMantissa) * 5.9604644775390625e-8f;
+                return tSign ? -tValue : tValue;
+            }
+            else
+            {
+                tBits = tSign | ((tExponent + 112) << 23) | (tMantissa << 13);
+            }
+            float tResult;
+            std::memcpy(&tResult, &tBits, sizeof(tResult));
+            return tResult;
+        }
+    };
+
+    // bfloat16: the upper half of a float, so the range of float with 8 mantissa bits.
+    struct Brain
+    {
+        static std::uint16_t fromFloat(float xValue) noexcept
+        {
+            std::uint32_t tBits;
+            std::memcpy(&tBits, &xValue, sizeof(tBits));
+            if ((tBits & 0x7FFFFFFFu) > 0x7F800000u)
+                return static_cast<std::uint16_t>((tBits >> 16) | 0x40u);
+            tBits += 0x7FFFu + ((tBits >> 16) & 1u);
+            return static_cast<std::uint16_t>(tBits >> 16);
+        }
+
+        static float toFloat(std::uint16_t xBits) noexcept
+        {
+            const std::uint32_t tBits = static_cast<std::uint32_t>(xBits) << 16;
+            float tResult;
+            std::memcpy(&tResult, &tBits, sizeof(tResult));
+            return tResult;
+        }
+    };
+} // namespace Float16Encoding
+
+// 16-bit floating point storage type. Every operation widens to float, computes there and
+// rounds the result back to nearest even; the bulk kernels in Kernels/ widen whole blocks
+// instead and accumulate in float. Converting to float is explicit, so mixed expressions
+// such as x * 2.0f stay in Float16.
+template <typename Encoding>
+class Float16
+{
+private:
+    std::uint16_t m_Bits{0};
+
+public:
+    constexpr Float16() noexcept = default;
+    Float16(float xValue) noexcept : m_Bits{Encoding::fromFloat(xValue)} {}
+
+    static constexpr Float16 fromBits(std::uint16_t xBits) noexcept
+    {
+        Float16 tResult;
+        tResult.m_Bits = xBits;
+        return tResult;
+    }
+    constexpr std::uint16_t bits() const noexcept { return m_Bits; }
+
+    explicit operator float() const noexcept { return Encoding::toFloat(m_Bits); }
+
+    Float16 operator-() const noexcept { return fromBits(static_cast<std::uint16_t>(m_Bits ^ 0x8000u)); }
+    Float16 operator+() const noexcept { return *this; }
+
+    friend Float16 operator+(Float16 xLhs, Float16 xRhs) noexcept { return Float16{static_cast<float>(xLhs) + static_cast<float>(xRhs)}; }
+    friend Float16 operator-(Float16 xLhs, Float16 xRhs) noexcept { return Float16{static_cast<float>(xLhs) - static_cast<float>(xRhs)}; }
+    friend Float16 operator*(Float16 xLhs, Float16 xRhs) noexcept { return Float16{static_cast<float>(xLhs) * static_cast<float>(xRhs)}; }
+    friend Float16 operator/(Float16 xLhs, Float16 xRhs) noexcept { return Float16{static_cast<float>(xLhs) / static_cast<float>(xRhs)}; }
+
+    Float16 &operator+=(Float16 xOther) noexcept { return *this = *this + xOther; }
+    Float16 &operator-=(Float16 xOther) noexcept { return *this = *this - xOther; }
+    Float16 &operator*=(Float16 xOther) noexcept { return *this = *this * xOther; }
+    Float16 &operator/=(Float16 xOther) noexcept { return *this = *this / xOther; }
+
+    // IEEE comparisons: NaN is unordered and +0 == -0.
+    friend bool operator==(Float16 xLhs, Float16 xRhs) noexcept { return static_cast<float>(xLhs) == static_cast<float>(xRhs); }
+    friend bool operator!=(Float16 xLhs, Float16 xRhs) noexcept { return static_cast<float>(xLhs) != static_cast<float>(xRhs); }
+    friend bool operator<(Float16 xLhs, Float16 xRhs) noexcept { return static_cast<float>(xLhs) < static_cast<float>(xRhs); }
+    friend bool operator<=(Float16 xLhs, Float16 xRhs) noexcept { return static_cast<float>(xLhs) <= static_cast<float>(xRhs); }
+    friend bool operator>(Float16 xLhs, Float16 xRhs) noexcept { return static_cast<float>(xLhs) > static_cast<float>(xRhs); }
+    friend bool operator>=(Float16 xLhs, Float16 xRhs) noexcept { return static_cast<float>(xLhs) >= static_cast<float>(xRhs); }
+
+    // Found by argument dependent lookup next to std::to_string, see Matrix::toString().
+    friend std::string to_string(Float16 xValue) { return std::to_string(static_cast<float>(xValue)); }
+    friend std::ostream &operator<<(std::ostream &xStream, Float16 xValue) { return xStream << static_cast<float>(xValue); }
+};
+
+using Half = Float16<Float16Encoding::Ieee>;
+using BFloat16 = Float16<Float16Encoding::Brain>;
+
+static_assert(sizeof(Half) == 2 && sizeof(BFloat16) == 2, "Float16 must be stored in two bytes");
+
+// 16-bit element types that the kernels widen to float.
+template <typename T>
+constexpr bool gIsFloat16 = std::is_same_v<T, Half> || std::is_same_v<T, BFloat16>;
+
+namespace std
+{
+    template <typename Encoding>
+    class numeric_limits<Float16<Encoding>>
+    {
+        static constexpr bool gIeee = std::is_same_v<Encoding, Float16Encoding::Ieee>;
+        using Type = Float16<Encoding>;
+
+    public:
+        static constexpr bool is_specialized{true};
+        static constexpr bool is_signed{true};
+        static constexpr bool is_integer{false};
+        static constexpr bool is_exact{false};
+        static constexpr bool has_infinity{true};
+        static constexpr bool has_quiet_NaN{true};
+        static constexpr bool is_iec559{gIeee};
+        static constexpr int digits{gIeee ? 11 : 8};
+        static constexpr int radix{2};
+        static constexpr float_round_style round_style{round_to_nearest};
+
+        static constexpr Type min() noexcept { return Type::fromBits(gIeee ? 0x0400 : 0x0080); }
+        static constexpr Type max() noexcept { return Type::fromBits(gIeee ? 0x7BFF : 0x7F7F); }
+        static constexpr Type lowest() noexcept { return Type::fromBits(gIeee ? 0xFBFF : 0xFF7F); }
+        static constexpr Type epsilon() noexcept { return Type::fromBits(gIeee ? 0x1400 : 0x3C00); }
+        static constexpr Type infinity() noexcept { return Type::fromBits(gIeee ? 0x7C00 : 0x7F80); }
+        static constexpr Type quiet_NaN() noexcept { return Type::fromBits(gIeee ? 0x7E00 : 0x7FC0); }
+    };
+} // namespace std
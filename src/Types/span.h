@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Non owning view over a contiguous range.
+template <typename T>
+class Span
+{
+private:
+    T *m_Data{nullptr};
+    std::size_t m_Size{0};
+
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T *;
+
+    constexpr Span() noexcept = default;
+    constexpr Span(T *xData, std::size_t xSize) noexcept
+        : m_Data{xData}, m_Size{xSize}
+    {
+    }
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(const Span<U> &xOther) noexcept
+        : m_Data{xOther.data()}, m_Size{xOther.size()}
+    {
+    }
+
+    constexpr T *data() const noexcept { return m_Data; }
+    constexpr std::size_t size() const noexcept { return m_Size; }
+    constexpr bool empty() const noexcept { return m_Size == 0; }
+
+    constexpr T &operator[](std::size_t xPos) const noexcept { return m_Data[xPos]; }
+    T &at(std::size_t xPos) const noexcept(false)
+    {
+        if (xPos >= m_Size)
+            throw std::out_of_range("Span::at: " + std::to_string(xPos) + " >= " + std::to_string(m_Size));
+        return m_Data[xPos];
+    }
+
+    constexpr iterator begin() const noexcept { return m_Data; }
+    constexpr iterator end() const noexcept { return m_Data + m_Size; }
+};
+
+// Non owning view over equally spaced elements, e.g. a column of a row-major buffer.
+template <typename T>
+class StridedSpan
+{
+private:
+    T *m_Data{nullptr};
+    std::size_t m_Size{0};
+    std::size_t m_Stride{1};
+
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+
+    class Iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::remove_cv_t<T>;
+        using pointer = T *;
+        using reference = T &;
+
+        constexpr Iterator(pointer xBase, std::size_t xIndex, std::size_t xStride) noexcept
+            : m_Base{xBase}, m_Index{static_cast<difference_type>(xIndex)}, m_Stride{static_cast<difference_type>(xStride)} {}
+
+        constexpr reference operator*() const noexcept { return m_Base[m_Index * m_Stride]; }
+        constexpr pointer operator->() const noexcept { return m_Base + m_Index * m_Stride; }
+        constexpr reference operator[](difference_type xOffset) const noexcept { return m_Base[(m_Index + xOffset) * m_Stride]; }
+        constexpr Iterator &operator++() noexcept
+        {
+            ++m_Index;
+            return *this;
+        }
+        constexpr Iterator operator++(int) noexcept
+        {
+            Iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+        constexpr Iterator &operator--() noexcept
+        {
+            --m_Index;
+            return *this;
+        }
+        constexpr Iterator operator--(int) noexcept
+        {
+            Iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+        constexpr Iterator &operator+=(difference_type xOffset) noexcept
+        {
+            m_Index += xOffset;
+            return *this;
+        }
+        constexpr Iterator &operator-=(difference_type xOffset) noexcept
+        {
+            m_Index -= xOffset;
+            return *this;
+        }
+        friend constexpr Iterator operator+(Iterator a, difference_type xOffset) noexcept { return a += xOffset; }
+        friend constexpr Iterator operator-(Iterator a, difference_type xOffset) noexcept { return a -= xOffset; }
+        friend constexpr difference_type operator-(const Iterator &a, const Iterator &b) noexcept { return a.m_Index - b.m_Index; }
+        friend constexpr bool operator==(const Iterator &a, const Iterator &b) noexcept { return a.m_Index == b.m_Index; }
+        friend constexpr bool operator!=(const Iterator &a, const Iterator &b) noexcept { return a.m_Index != b.m_Index; }
+        friend constexpr bool operator<(const Iterator &a, const Iterator &b) noexcept { return a.m_Index < b.m_Index; }
+
+    private:
+        pointer m_Base;
+        difference_type m_Index;
+        difference_type m_Stride;
+    };
+
+    constexpr StridedSpan() noexcept = default;
+    constexpr StridedSpan(T *xData, std::size_t xSize, std::size_t xStride) noexcept
+        : m_Data{xData}, m_Size{xSize}, m_Stride{xStride}
+    {
+    }
+
+    constexpr T *data() const noexcept { return m_Data; }
+    constexpr std::size_t size() const noexcept { return m_Size; }
+    constexpr std::size_t stride() const noexcept { return m_Stride; }
+    constexpr bool empty() const noexcept { return m_Size == 0; }
+
+    constexpr T &operator[](std::size_t xPos) const noexcept { return m_Data[xPos * m_Stride]; }
+    T &at(std::size_t xPos) const noexcept(false)
+    {
+        if (xPos >= m_Size)
+            throw std::out_of_range("StridedSpan::at: " + std::to_string(xPos) + " >= " + std::to_string(m_Size));
+        return m_Data[xPos * m_Stride];
+    }
+
+    constexpr Iterator begin() const noexcept { return Iterator(m_Data, 0, m_Stride); }
+    constexpr Iterator end() const noexcept { return Iterator(m_Data, m_Size, m_Stride); }
+};
@@ -0,0 +1,263 @@
+#pragma once
+
+#include "matrix.h"
+#include "vector.h"
+#include "Kernels/simd.h"
+#include "Parallel/threadPool.h"
+#include "Types/column.h"
+#include "Types/row.h"
+#include "Types/span.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// n x n matrix that is zero outside the band -lower <= j - i <= upper. Each row stores
+// lower + upper + 1 slots, (i, j) at i * width + (j - i + lower); slots that fall outside
+// the matrix in the first and last rows stay zero. Products cost O(n * width).
+template <typename T>
+class BandedMatrix
+{
+private:
+    std::size_t m_Size{0};
+    std::size_t m_Lower{0};
+    std::size_t m_Upper{0};
+    std::vector<T> m_Data{};
+
+    BandedMatrix(std::size_t xSize, std::size_t xLower, std::size_t xUpper)
+        : m_Size{xSize}, m_Lower{std::min(xLower, xSize ? xSize - 1 : 0)}, m_Upper{std::min(xUpper, xSize ? xSize - 1 : 0)},
+          m_Data(xSize * (m_Lower + m_Upper + 1))
+    {
+    }
+
+    std::size_t width() const noexcept { return m_Lower + m_Upper + 1; }
+    // Columns of row i inside the band: [first, last).
+    std::size_t firstColumn(std::size_t xRow) const noexcept { return xRow > m_Lower ? xRow - m_Lower : 0; }
+    std::size_t lastColumn(std::size_t xRow) const noexcept { return std::min(m_Size, xRow + m_Upper + 1); }
+    bool inBand(std::size_t xRow, std::size_t xCol) const noexcept { return xCol + m_Lower >= xRow && xCol <= xRow + m_Upper; }
+    // Slot of (i, j) for j inside the band.
+    std::size_t slot(std::size_t xRow, std::size_t xCol) const noexcept { return xRow * width() + xCol + m_Lower - xRow; }
+
+    // Runs xBody(first, last) over row ranges, in parallel once there is enough work.
+    template <typename Body>
+    void forRows(std::size_t xWork, const Body &xBody) const;
+
+public:
+    using value_type = T;
+
+    BandedMatrix() noexcept = default;
+
+    // Bandwidths are capped at xSize - 1.
+    static BandedMatrix create(std::size_t xSize, std::size_t xLower, std::size_t xUpper) { return BandedMatrix{xSize, xLower, xUpper}; }
+    // Band of a square matrix, the rest is ignored; std::nullopt if xMatrix is not square.
+    template <typename Allocator>
+    static std::optional<BandedMatrix> create(const Matrix<T, Allocator> &xMatrix, std::size_t xLower, std::size_t xUpper);
+
+    std::size_t size() const noexcept { return m_Size; }
+    std::size_t getLower() const noexcept { return m_Lower; }
+    std::size_t getUpper() const noexcept { return m_Upper; }
+    Row getRows() const noexcept { return Row{m_Size}; }
+    Column getCols() const noexcept { return Column{m_Size}; }
+    // Band storage, width() slots per row.
+    Span<const T> getData() const noexcept { return {m_Data.data(), m_Data.size()}; }
+
+    // Zero outside the band.
+    T operator()(const std::size_t &xRow, const std::size_t &xCol) const noexcept
+    {
+        return inBand(xRow, xCol) ? m_Data[slot(xRow, xCol)] : T{};
+    }
+    // Only elements inside the band are writable; throws std::out_of_range otherwise.
+    T &at(const std::size_t &xRow, const std::size_t &xCol) noexcept(false)
+    {
+        if (xRow >= m_Size || xCol >= m_Size || !inBand(xRow, xCol))
+            throw std::out_of_range("BandedMatrix::at: (" + std::to_string(xRow) + ", " + std::to_string(xCol) + ") is outside of the band of " + std::to_string(m_Size) + "x" + std::to_string(m_Size));
+        return m_Data[slot(xRow, xCol)];
+    }
+
+    Matrix<T> toMatrix() const;
+    // Swaps the lower and upper bandwidths.
+    BandedMatrix transposed() const;
+
+    // The result band covers both operands. A size mismatch returns *this.
+    BandedMatrix operator+(const BandedMatrix &xOther) const;
+    BandedMatrix operator-(const BandedMatrix &xOther) const;
+    BandedMatrix &operator*=(const T &xScalar) noexcept;
+    BandedMatrix operator*(const T &xScalar) const { return BandedMatrix{*this} *= xScalar; }
+
+    // Empty result if the sizes differ.
+    template <typename Allocator>
+    Vector<T, Allocator> operator*(const Vector<T, Allocator> &xVector) const;
+    template <typename Allocator>
+    Matrix<T, Allocator> operator*(const Matrix<T, Allocator> &xMatrix) const;
+    // Bandwidths add up.
+    BandedMatrix operator*(const BandedMatrix &xOther) const;
+
+    bool operator==(const BandedMatrix &xOther) const noexcept
+    {
+        return m_Size == xOther.m_Size && m_Lower == xOther.m_Lower && m_Upper == xOther.m_Upper && m_Data == xOther.m_Data;
+    }
+    bool operator!=(const BandedMatrix &xOther) const noexcept { return !(*this == xOther); }
+};
+
+template <typename T>
+template <typename Body>
+inline void BandedMatrix<T>::forRows(std::size_t xWork, const Body &xBody) const
+{
+    auto &tExecutor = Parallel::defaultExecutor();
+    const std::size_t tParts = xWork >= Kernels::gGemmParallelProduct ? std::min(tExecutor.concurrency(), m_Size) : 1;
+    if (tParts <= 1)
+    {
+        xBody(0, m_Size);
+        return;
+    }
+    tExecutor.parallelFor(tParts, [&](std::size_t xPart)
+                          { xBody(m_Size * xPart / tParts, m_Size * (xPart + 1) / tParts); });
+}
+
+template <typename T>
+template <typename Allocator>
+inline std::optional<BandedMatrix<T>> BandedMatrix<T>::create(const Matrix<T, Allocator> &xMatrix, std::size_t xLower, std::size_t xUpper)
+{
+    if (xMatrix.getRows().get() != xMatrix.getCols().get())
+        return std::nullopt;
+
+    BandedMatrix tResult{xMatrix.getRows().get(), xLower, xUpper};
+    for (std::size_t i = 0; i < tResult.m_Size; i++)
+        for (std::size_t j = tResult.firstColumn(i); j < tResult.lastColumn(i); j++)
+            tResult.m_Data[tResult.slot(i, j)] = xMatrix(i, j);
+    return tResult;
+}
+
+template <typename T>
+inline Matrix<T> BandedMatrix<T>::toMatrix() const
+{
+    auto tResult = Matrix<T>::create(Row{m_Size}, Column{m_Size});
+    for (std::size_t i = 0; i < m_Size; i++)
+        for (std::size_t j = firstColumn(i); j < lastColumn(i); j++)
+            tResult(i, j) = m_Data[slot(i, j)];
+    return tResult;
+}
+
+template <typename T>
+inline BandedMatrix<T> BandedMatrix<T>::transposed() const
+{
+    BandedMatrix tResult{m_Size, m_Upper, m_Lower};
+    for (std::size_t i = 0; i < m_Size; i++)
+        for (std::size_t j = firstColumn(i); j < lastColumn(i); j++)
+            tResult.m_Data[tResult.slot(j, i)] = m_Data[slot(i, j)];
+    return tResult;
+}
+
+template <typename T>
+inline BandedMatrix<T> BandedMatrix<T>::operator+(const BandedMatrix &xOther) const
+{
+    if (m_Size != xOther.m_Size)
+        return *this;
+    if (m_Lower == xOther.m_Lower && m_Upper == xOther.m_Upper)
+    {
+        BandedMatrix tResult{*this};
+        Kernels::add(m_Data.data(), xOther.m_Data.data(), tResult.m_Data.data(), m_Data.size());
+        return tResult;
+    }
+
+    BandedMatrix tResult{m_Size, std::max(m_Lower, xOther.m_Lower), std::max(m_Upper, xOther.m_Upper)};
+    for (std::size_t i = 0; i < m_Size; i++)
+        for (std::size_t j = tResult.firstColumn(i); j < tResult.lastColumn(i); j++)
+            tResult.m_Data[tResult.slot(i, j)] = (*this)(i, j) + xOther(i, j);
+    return tResult;
+}
+
+template <typename T>
+inline BandedMatrix<T> BandedMatrix<T>::operator-(const BandedMatrix &xOther) const
+{
+    if (m_Size != xOther.m_Size)
+        return *this;
+    if (m_Lower == xOther.m_Lower && m_Upper == xOther.m_Upper)
+    {
+        BandedMatrix tResult{*this};
+        Kernels::subtract(m_Data.data(), xOther.m_Data.data(), tResult.m_Data.data(), m_Data.size());
+        return tResult;
+    }
+
+    BandedMatrix tResult{m_Size, std::max(m_Lower, xOther.m_Lower), std::max(m_Upper, xOther.m_Upper)};
+    for (std::size_t i = 0; i < m_Size; i++)
+        for (std::size_t j = tResult.firstColumn(i); j < tResult.lastColumn(i); j++)
+            tResult.m_Data[tResult.slot(i, j)] = (*this)(i, j) - xOther(i, j);
+    return tResult;
+}
+
+template <typename T>
+inline BandedMatrix<T> &BandedMatrix<T>::operator*=(const T &xScalar) noexcept
+{
+    Kernels::multiplyScalar(m_Data.data(), xScalar, m_Data.data(), m_Data.size());
+    return *this;
+}
+
+template <typename T>
+template <typename Allocator>
+inline Vector<T, Allocator> BandedMatrix<T>::operator*(const Vector<T, Allocator> &xVector) const
+{
+    if (xVector.size() != m_Size)
+        return Vector<T, Allocator>::create();
+
+    auto tResult = Vector<T, Allocator>::create(Row{m_Size}, xVector.get_allocator());
+    const T *tX = xVector.getData().data();
+    T *tY = tResult.getData().data();
+    forRows(m_Size * width(), [&](std::size_t xFirst, std::size_t xLast)
+            {
+                for (std::size_t i = xFirst; i < xLast; i++)
+                {
+                    const std::size_t tFirst = firstColumn(i);
+                    tY[i] = Kernels::dot(m_Data.data() + slot(i, tFirst), tX + tFirst, lastColumn(i) - tFirst);
+                } });
+    return tResult;
+}
+
+template <typename T>
+template <typename Allocator>
+inline Matrix<T, Allocator> BandedMatrix<T>::operator*(const Matrix<T, Allocator> &xMatrix) const
+{
+    if (xMatrix.getRows().get() != m_Size)
+        return Matrix<T, Allocator>::create(xMatrix.get_allocator());
+
+    const std::size_t tCols = xMatrix.getCols().get();
+    auto tResult = Matrix<T, Allocator>::create(Row{m_Size}, xMatrix.getCols(), xMatrix.get_allocator());
+    forRows(m_Size * width() * tCols, [&](std::size_t xFirst, std::size_t xLast)
+            {
+                for (std::size_t i = xFirst; i < xLast; i++)
+                {
+                    T *tOut = tResult.getRow(i).data();
+                    for (std::size_t k = firstColumn(i); k < lastColumn(i); k++)
+                    {
+                        const T tA = m_Data[slot(i, k)];
+                        const T *tB = xMatrix.getRow(k).data();
+                        for (std::size_t c = 0; c < tCols; c++)
+                            tOut[c] += tA * tB[c];
+                    }
+                } });
+    return tResult;
+}
+
+template <typename T>
+inline BandedMatrix<T> BandedMatrix<T>::operator*(const BandedMatrix &xOther) const
+{
+    if (xOther.m_Size != m_Size)
+        return BandedMatrix{};
+
+    BandedMatrix tResult{m_Size, m_Lower + xOther.m_Lower, m_Upper + xOther.m_Upper};
+    forRows(m_Size * width() * xOther.width(), [&](std::size_t xFirst, std::size_t xLast)
+            {
+                for (std::size_t i = xFirst; i < xLast; i++)
+                {
+                    for (std::size_t k = firstColumn(i); k < lastColumn(i); k++)
+                    {
+                        const T tA = m_Data[slot(i, k)];
+                        for (std::size_t j = xOther.firstColumn(k); j < xOther.lastColumn(k); j++)
+                            tResult.m_Data[tResult.slot(i, j)] += tA * xOther.m_Data[xOther.slot(k, j)];
+                    }
+                } });
+    return tResult;
+}
@@ -2,224 +2,445 @@
 
 #include "Types/column.h"
 #include "Types/row.h"
-
+#include "Types/span.h"
+#include "matrixExpression.h"
+#include "matrixView.h"
+#include "Memory/alignedAllocator.h"
+#include "Kernels/gemm.h"
+#include "Kernels/simd.h"
+#include "Kernels/strassen.h"
+#include "Kernels/transpose.h"
+#include "Io/format.h"
+#include "Io/matrixFile.h"
+
+#include <memory_resource>
+#include <optional>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
 #include <type_traits>
 
-template <typename T>
-class Matrix;
-
-template <typename T>
-std::ostream &operator<<(std::ostream &os, const Matrix<T> &matrix);
+template <typename T, typename Allocator>
+std::ostream &operator<<(std::ostream &os, const Matrix<T, Allocator> &matrix);
 
-template <typename T>
-class Matrix
+// Allocator defaults to AlignedAllocator<T> (declared in matrixExpression.h). Products and
+// transposes allocate their result with the allocator of the left operand.
+template <typename T, typename Allocator>
+class Matrix : public MatrixExpression<Matrix<T, Allocator>>
 {
 private:
     Column m_Columns{}; // Colums
     Row m_Rows{};       // Rows
-    std::vector<std::vector<T>> m_Matrix{};
+    std::size_t m_LeadingDimension{0};
+    std::vector<T, Allocator> m_Data{}; // Row-major, element (i, j) at i * m_LeadingDimension + j
 
     Matrix() noexcept = default;
-    explicit Matrix(const Row &rows, const Column &cols);
+    explicit Matrix(const Allocator &xAllocator) noexcept;
+    explicit Matrix(const Row &rows, const Column &cols, const Allocator &xAllocator = Allocator());
     explicit Matrix(const std::vector<T> &array);
     explicit Matrix(const std::vector<std::vector<T>> &input_matrix);
 
+    template <typename E>
+    void assign(const MatrixExpression<E> &xExpression);
+    template <typename E, typename Operation>
+    void update(const MatrixExpression<E> &xExpression, Operation xOperation);
+    template <typename Operation>
+    void update(const T &xScalar, Operation xOperation);
+
 public:
-    Matrix(const Matrix<T> &) noexcept = default;
-    Matrix(Matrix<T> &&) noexcept = default;
-    Matrix &operator=(const Matrix<T> &) noexcept = default;
-    Matrix &operator=(Matrix<T> &&) noexcept = default;
-
-    static Matrix<T> create();
-    static Matrix<T> create(const Row &rows, const Column &cols);
-    static Matrix<T> create(const std::vector<T> &array);
-    static Matrix<T> create(const std::vector<std::vector<T>> &input_matrix);
-    static Matrix<T> create(const Matrix<T> &org);
-
-    const std::vector<std::vector<T>> &getMatrix() const noexcept;
-    std::vector<std::vector<T>> &getMatrix() noexcept;
+    using value_type = T;
+    using allocator_type = Allocator;
+
+    Matrix(const Matrix<T, Allocator> &) noexcept = default;
+    Matrix(Matrix<T, Allocator> &&) noexcept = default;
+    Matrix &operator=(const Matrix<T, Allocator> &) noexcept = default;
+    Matrix &operator=(Matrix<T, Allocator> &&) noexcept = default;
+
+    // Evaluates an elementwise expression in one pass, without temporaries.
+    template <typename E>
+    Matrix(const MatrixExpression<E> &xExpression);
+    template <typename E>
+    Matrix(const MatrixExpression<E> &xExpression, const Allocator &xAllocator);
+    template <typename E>
+    Matrix &operator=(const MatrixExpression<E> &xExpression);
+
+    static Matrix<T, Allocator> create();
+    static Matrix<T, Allocator> create(const Row &rows, const Column &cols);
+    static Matrix<T, Allocator> create(const std::vector<T> &array);
+    static Matrix<T, Allocator> create(const std::vector<std::vector<T>> &input_matrix);
+    static Matrix<T, Allocator> create(const Matrix<T, Allocator> &org);
+    static Matrix<T, Allocator> create(const Allocator &xAllocator);
+    static Matrix<T, Allocator> create(const Row &rows, const Column &cols, const Allocator &xAllocator);
+    static Matrix<T, Allocator> create(const Matrix<T, Allocator> &org, const Allocator &xAllocator);
+
+    Allocator get_allocator() const noexcept { return m_Data.get_allocator(); }
+
+    Span<const T> getData() const noexcept;
+    Span<T> getData() noexcept;
+    Span<const T> getRow(const std::size_t &xRow) const noexcept;
+    Span<T> getRow(const std::size_t &xRow) noexcept;
+    StridedSpan<const T> getColumn(const std::size_t &xCol) const noexcept;
+    StridedSpan<T> getColumn(const std::size_t &xCol) noexcept;
     constexpr const Row &getRows() const noexcept;
     constexpr const Column &getCols() const noexcept;
+    constexpr std::size_t getLeadingDimension() const noexcept;
+
+    // Zero-copy views; block() throws std::out_of_range if the block does not fit.
+    MatrixView<T> view() noexcept { return MatrixView<T>{m_Data.data(), m_Rows.get(), m_Columns.get(), m_LeadingDimension}; }
+    ConstMatrixView<T> view() const noexcept { return ConstMatrixView<T>{m_Data.data(), m_Rows.get(), m_Columns.get(), m_LeadingDimension}; }
+    MatrixView<T> block(std::size_t xRow, std::size_t xCol, std::size_t xRows, std::size_t xCols) noexcept(false) { return view().block(xRow, xCol, xRows, xCols); }
+    ConstMatrixView<T> block(std::size_t xRow, std::size_t xCol, std::size_t xRows, std::size_t xCols) const noexcept(false) { return view().block(xRow, xCol, xRows, xCols); }
+    MatrixView<T> row(std::size_t xRow) noexcept(false) { return view().row(xRow); }
+    ConstMatrixView<T> row(std::size_t xRow) const noexcept(false) { return view().row(xRow); }
+    MatrixView<T> col(std::size_t xCol) noexcept(false) { return view().col(xCol); }
+    ConstMatrixView<T> col(std::size_t xCol) const noexcept(false) { return view().col(xCol); }
+
+    const T &operator()(const std::size_t &xRow, const std::size_t &xCol) const noexcept { return m_Data[xRow * m_LeadingDimension + xCol]; }
+    T &operator()(const std::size_t &xRow, const std::size_t &xCol) noexcept { return m_Data[xRow * m_LeadingDimension + xCol]; }
+    const T &at(const std::size_t &xRow, const std::size_t &xCol) const noexcept(false);
+    T &at(const std::size_t &xRow, const std::size_t &xCol) noexcept(false);
+    // Six fixed decimals per element, as std::to_string prints them.
     std::string toString() const noexcept;
+    // Shortest round-trip floats by default; see Io::FormatSettings. Large matrices format
+    // their rows in parallel on xExecutor.
+    std::string toString(const Io::FormatSettings &xSettings, Parallel::Executor &xExecutor = Parallel::defaultExecutor()) const;
+
+    // Binary matrix files, see Io/matrixFile.h. save() returns false if the file cannot be
+    // written. load() returns std::nullopt if the file is missing or truncated, stores another
+    // element type or fails its checksum; files in the other byte order are converted.
+    bool save(const std::string &xPath) const;
+    static std::optional<Matrix<T, Allocator>> load(const std::string &xPath);
+    // Maps the file instead of reading it, see MappedMatrix.
+    static std::optional<MappedMatrix<T>> mapFile(const std::string &xPath) { return MappedMatrix<T>::open(xPath); }
 
     void erase() noexcept;
 
+    // In place: tiled swaps for square matrices, cycle following (one bit per element of extra memory) otherwise.
     bool transpose();
-
-    friend std::ostream &operator<< <>(std::ostream &os, const Matrix<T> &matrix);
-
-    Matrix<T> &operator+=(const Matrix<T> &org);
-    Matrix<T> &operator+=(const T &n);
-    Matrix<T> &operator-=(const Matrix<T> &org);
-    Matrix<T> &operator-=(const T &n);
-    Matrix<T> &operator*=(const Matrix<T> &org);
-    Matrix<T> &operator*=(const T &n);
-
-    Matrix<T> operator+(const Matrix<T> &org);
-    Matrix<T> operator+(const T &n);
-    Matrix<T> operator-(const Matrix<T> &org);
-    Matrix<T> operator-(const T &n);
-    Matrix<T> operator*(const Matrix<T> &org);
-    Matrix<T> operator*(const T &n);
-
-    bool operator==(const Matrix<T> &org);
-    bool operator!=(const Matrix<T> &org);
+    // Out of place, cache-oblivious blocked copy into a new matrix.
+    Matrix<T, Allocator> transposed() const;
+
+    friend std::ostream &operator<< <>(std::ostream &os, const Matrix<T, Allocator> &matrix);
+
+    // Compound assignments update the existing buffer; a shape mismatch leaves *this unchanged.
+    template <typename E>
+    Matrix<T, Allocator> &operator+=(const MatrixExpression<E> &org);
+    Matrix<T, Allocator> &operator+=(const T &n);
+    template <typename E>
+    Matrix<T, Allocator> &operator-=(const MatrixExpression<E> &org);
+    Matrix<T, Allocator> &operator-=(const T &n);
+    Matrix<T, Allocator> &operator*=(const Matrix<T, Allocator> &org);
+    Matrix<T, Allocator> &operator*=(const T &n);
+
+    // +, - and scalar * are lazy, see matrixExpression.h.
+    Matrix<T, Allocator> operator*(const Matrix<T, Allocator> &org) const;
+    // Views are multiplied in place, other expressions are materialized first.
+    template <typename E>
+    Matrix<T, Allocator> operator*(const MatrixExpression<E> &org) const;
+
+    bool operator==(const Matrix<T, Allocator> &org) const;
+    bool operator!=(const Matrix<T, Allocator> &org) const;
 };
 
-template <typename T>
-Matrix<T>::Matrix(const Row &rows, const Column &cols)
+template <typename T, typename Allocator>
+Matrix<T, Allocator>::Matrix(const Allocator &xAllocator) noexcept
+    : m_Data(xAllocator)
+{
+}
+
+template <typename T, typename Allocator>
+Matrix<T, Allocator>::Matrix(const Row &rows, const Column &cols, const Allocator &xAllocator)
+    : m_Data(xAllocator)
 {
     this->m_Columns = cols;
     this->m_Rows = rows;
-    if (this->m_Rows > 0UL)
-    {
-        this->m_Matrix.resize(m_Rows.get());
-        if (this->m_Columns > 0UL)
-        {
-            for (auto &&column : this->m_Matrix)
-            {
-                column.resize(cols.get());
-            }
-        }
-    }
+    this->m_LeadingDimension = cols.get();
+    this->m_Data.resize(rows.get() * cols.get());
 }
 
-template <typename T>
-Matrix<T>::Matrix(const std::vector<T> &array)
+template <typename T, typename Allocator>
+Matrix<T, Allocator>::Matrix(const std::vector<T> &array)
 {
     this->m_Columns = 1;
     this->m_Rows = array.size();
+    this->m_LeadingDimension = 1;
 
-    this->m_Matrix.resize(this->m_Rows.get());
-    for (size_t i = 0; i < this->m_Rows; i++)
-    {
-        this->m_Matrix.at(i).push_back(array.at(i));
-    }
+    this->m_Data.assign(array.cbegin(), array.cend());
 }
 
-template <typename T>
-Matrix<T>::Matrix(const std::vector<std::vector<T>> &input_matrix)
+template <typename T, typename Allocator>
+Matrix<T, Allocator>::Matrix(const std::vector<std::vector<T>> &input_matrix)
 {
     this->m_Rows = input_matrix.size();
     if (this->m_Rows > 0UL)
         this->m_Columns = input_matrix.at(0).size();
     else
         this->m_Columns = 0;
+    this->m_LeadingDimension = this->m_Columns.get();
 
-    this->m_Matrix = input_matrix;
+    // Rows shorter than the first one are padded with T{}, longer ones are cut.
+    this->m_Data.resize(this->m_Rows.get() * this->m_Columns.get());
+    for (size_t i = 0; i < this->m_Rows; i++)
+    {
+        const auto &tRow = input_matrix[i];
+        const auto tCount = std::min(tRow.size(), this->m_Columns.get());
+        std::copy(tRow.cbegin(), tRow.cbegin() + tCount, this->m_Data.begin() + i * this->m_LeadingDimension);
+    }
 }
 
-template <typename T>
-inline Matrix<T> Matrix<T>::create()
+template <typename T, typename Allocator>
+template <typename E>
+Matrix<T, Allocator>::Matrix(const MatrixExpression<E> &xExpression)
+    : Matrix(xExpression.derived().getRows(), xExpression.derived().getCols())
 {
-    return Matrix<T>();
+    this->assign(xExpression);
 }
-template <typename T>
-inline Matrix<T> Matrix<T>::create(const Row &rows, const Column &cols)
+
+template <typename T, typename Allocator>
+template <typename E>
+Matrix<T, Allocator>::Matrix(const MatrixExpression<E> &xExpression, const Allocator &xAllocator)
+    : Matrix(xExpression.derived().getRows(), xExpression.derived().getCols(), xAllocator)
 {
-    return Matrix<T>(rows, cols);
+    this->assign(xExpression);
 }
 
-template <typename T>
-inline Matrix<T> Matrix<T>::create(const std::vector<T> &array)
+template <typename T, typename Allocator>
+template <typename E>
+inline Matrix<T, Allocator> &Matrix<T, Allocator>::operator=(const MatrixExpression<E> &xExpression)
 {
-    return Matrix<T>(array);
+    const auto &tExpression = xExpression.derived();
+    if (this->m_Rows.get() == tExpression.getRows().get() && this->m_Columns.get() == tExpression.getCols().get())
+    {
+        // Elementwise expressions read (i, j) only to write (i, j), so *this may appear in them.
+        this->assign(xExpression);
+    }
+    else
+    {
+        Matrix<T, Allocator> tResult{xExpression};
+        *this = std::move(tResult);
+    }
+    return *this;
 }
 
-template <typename T>
-inline Matrix<T> Matrix<T>::create(const std::vector<std::vector<T>> &input_matrix)
+template <typename T, typename Allocator>
+template <typename E>
+inline void Matrix<T, Allocator>::assign(const MatrixExpression<E> &xExpression)
 {
-    return Matrix<T>(input_matrix);
+    Detail::assignExpression(this->m_Data.data(), this->m_LeadingDimension, this->m_Rows.get(), this->m_Columns.get(), xExpression.derived());
 }
 
-template <typename T>
-inline Matrix<T> Matrix<T>::create(const Matrix<T> &org)
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> Matrix<T, Allocator>::create()
+{
+    return Matrix<T, Allocator>();
+}
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> Matrix<T, Allocator>::create(const Row &rows, const Column &cols)
 {
-    return Matrix<T>(org);
+    return Matrix<T, Allocator>(rows, cols);
 }
 
-template <typename T>
-inline const std::vector<std::vector<T>> &Matrix<T>::getMatrix(void) const noexcept
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> Matrix<T, Allocator>::create(const std::vector<T> &array)
 {
-    return this->m_Matrix;
+    return Matrix<T, Allocator>(array);
 }
 
-template <typename T>
-inline std::vector<std::vector<T>> &Matrix<T>::getMatrix() noexcept
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> Matrix<T, Allocator>::create(const std::vector<std::vector<T>> &input_matrix)
 {
-    return this->m_Matrix;
+    return Matrix<T, Allocator>(input_matrix);
 }
 
-template <typename T>
-constexpr const Row &Matrix<T>::getRows() const noexcept
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> Matrix<T, Allocator>::create(const Matrix<T, Allocator> &org)
+{
+    return Matrix<T, Allocator>(org);
+}
+
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> Matrix<T, Allocator>::create(const Allocator &xAllocator)
+{
+    return Matrix<T, Allocator>(xAllocator);
+}
+
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> Matrix<T, Allocator>::create(const Row &rows, const Column &cols, const Allocator &xAllocator)
+{
+    return Matrix<T, Allocator>(rows, cols, xAllocator);
+}
+
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> Matrix<T, Allocator>::create(const Matrix<T, Allocator> &org, const Allocator &xAllocator)
+{
+    Matrix<T, Allocator> tResult(org.m_Rows, org.m_Columns, xAllocator);
+    tResult.assign(org);
+    return tResult;
+}
+
+template <typename T, typename Allocator>
+inline Span<const T> Matrix<T, Allocator>::getData() const noexcept
+{
+    return Span<const T>{this->m_Data.data(), this->m_Data.size()};
+}
+
+template <typename T, typename Allocator>
+inline Span<T> Matrix<T, Allocator>::getData() noexcept
+{
+    return Span<T>{this->m_Data.data(), this->m_Data.size()};
+}
+
+template <typename T, typename Allocator>
+inline Span<const T> Matrix<T, Allocator>::getRow(const std::size_t &xRow) const noexcept
+{
+    return Span<const T>{this->m_Data.data() + xRow * this->m_LeadingDimension, this->m_Columns.get()};
+}
+
+template <typename T, typename Allocator>
+inline Span<T> Matrix<T, Allocator>::getRow(const std::size_t &xRow) noexcept
+{
+    return Span<T>{this->m_Data.data() + xRow * this->m_LeadingDimension, this->m_Columns.get()};
+}
+
+template <typename T, typename Allocator>
+inline StridedSpan<const T> Matrix<T, Allocator>::getColumn(const std::size_t &xCol) const noexcept
+{
+    return StridedSpan<const T>{this->m_Data.data() + xCol, this->m_Rows.get(), this->m_LeadingDimension};
+}
+
+template <typename T, typename Allocator>
+inline StridedSpan<T> Matrix<T, Allocator>::getColumn(const std::size_t &xCol) noexcept
+{
+    return StridedSpan<T>{this->m_Data.data() + xCol, this->m_Rows.get(), this->m_LeadingDimension};
+}
+
+template <typename T, typename Allocator>
+constexpr const Row &Matrix<T, Allocator>::getRows() const noexcept
 {
     return this->m_Rows;
 }
 
-template <typename T>
-constexpr const Column &Matrix<T>::getCols() const noexcept
+template <typename T, typename Allocator>
+constexpr const Column &Matrix<T, Allocator>::getCols() const noexcept
 {
     return this->m_Columns;
 }
 
-template <typename T>
-inline std::string Matrix<T>::toString() const noexcept
+template <typename T, typename Allocator>
+constexpr std::size_t Matrix<T, Allocator>::getLeadingDimension() const noexcept
+{
+    return this->m_LeadingDimension;
+}
+
+template <typename T, typename Allocator>
+inline const T &Matrix<T, Allocator>::at(const std::size_t &xRow, const std::size_t &xCol) const noexcept(false)
+{
+    if (xRow >= this->m_Rows.get() || xCol >= this->m_Columns.get())
+        throw std::out_of_range("Matrix::at: (" + std::to_string(xRow) + ", " + std::to_string(xCol) + ") is outside of " + this->m_Rows.to_string() + "x" + this->m_Columns.to_string());
+
+    return (*this)(xRow, xCol);
+}
+
+template <typename T, typename Allocator>
+inline T &Matrix<T, Allocator>::at(const std::size_t &xRow, const std::size_t &xCol) noexcept(false)
 {
-    std::string result = "";
-    for (auto &&column : this->m_Matrix)
+    return const_cast<T &>(static_cast<const Matrix<T, Allocator> &>(*this).at(xRow, xCol));
+}
+
+template <typename T, typename Allocator>
+inline std::string Matrix<T, Allocator>::toString() const noexcept
+{
+    // Rows without elements keep their old " | \n", not prefix plus suffix.
+    if (this->m_Columns.get() == 0)
     {
-        result += " | ";
-        for (auto &&element : column)
-        {
-            result += std::to_string(element);
-            result += " | ";
-        }
-        result += "\n";
+        std::string tResult;
+        for (std::size_t i = 0; i < this->m_Rows.get(); i++)
+            tResult += " | \n";
+        return tResult;
     }
-    return result;
+    return toString(Io::toStringFormat());
 }
 
-template <typename T>
-inline bool Matrix<T>::transpose()
+template <typename T, typename Allocator>
+inline std::string Matrix<T, Allocator>::toString(const Io::FormatSettings &xSettings, Parallel::Executor &xExecutor) const
 {
-    std::vector<std::vector<T>> result = this->getMatrix();
+    return Io::format(this->m_Data.data(), this->m_Rows.get(), this->m_Columns.get(), this->m_LeadingDimension, xSettings, xExecutor);
+}
 
-    Matrix<T> newMatrix = create(Row{this->m_Columns.get()}, Column{this->m_Rows.get()});
-    this->m_Matrix = newMatrix.m_Matrix;
+template <typename T, typename Allocator>
+inline bool Matrix<T, Allocator>::save(const std::string &xPath) const
+{
+    return Io::Detail::writeFile(xPath, this->m_Data.data(), this->m_Rows.get(), this->m_Columns.get(), this->m_LeadingDimension);
+}
 
-    for (size_t i = 0; i < this->m_Columns; i++)
+template <typename T, typename Allocator>
+inline std::optional<Matrix<T, Allocator>> Matrix<T, Allocator>::load(const std::string &xPath)
+{
+    Matrix<T, Allocator> tResult;
+    const bool tRead = Io::Detail::readFile<T>(xPath, [&](std::size_t xRows, std::size_t xCols)
+                                               {
+                                                   tResult = Matrix<T, Allocator>{Row{xRows}, Column{xCols}};
+                                                   return std::pair{tResult.m_Data.data(), tResult.m_LeadingDimension};
+                                               });
+    if (!tRead)
+        return std::nullopt;
+    return tResult;
+}
+
+template <typename T, typename Allocator>
+inline bool Matrix<T, Allocator>::transpose()
+{
+    if (this->m_LeadingDimension != this->m_Columns.get())
     {
-        for (size_t j = 0; j < this->m_Rows; j++)
-        {
-            this->m_Matrix.at(i).at(j) = result.at(j).at(i);
-        }
+        *this = this->transposed();
+        return true;
     }
 
+    Kernels::transposeInPlace(this->m_Rows.get(), this->m_Columns.get(), this->m_Data.data());
+
     Row temp{this->m_Rows};
     this->m_Rows = this->m_Columns.get();
     this->m_Columns = temp.get();
+    this->m_LeadingDimension = this->m_Columns.get();
 
     return true;
 }
 
-template <typename T>
-inline void Matrix<T>::erase() noexcept
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> Matrix<T, Allocator>::transposed() const
+{
+    Matrix<T, Allocator> result = create(Row{this->m_Columns.get()}, Column{this->m_Rows.get()}, this->get_allocator());
+    Kernels::transpose(this->m_Rows.get(), this->m_Columns.get(), this->m_Data.data(), this->m_LeadingDimension,
+                       result.m_Data.data(), result.m_LeadingDimension);
+    return result;
+}
+
+template <typename T, typename Allocator>
+inline void Matrix<T, Allocator>::erase() noexcept
 {
-    this->m_Matrix.clear();
+    this->m_Data.clear();
     this->m_Columns = 0UL;
     this->m_Rows = 0UL;
+    this->m_LeadingDimension = 0UL;
 }
 
-template <typename T>
-inline std::ostream &operator<<(std::ostream &os, const Matrix<T> &matrix)
+template <typename T, typename Allocator>
+inline std::ostream &operator<<(std::ostream &os, const Matrix<T, Allocator> &matrix)
 {
-    for (const auto &column : matrix.getMatrix())
+    // Formats in bulk unless the stream flags or locale, a character element type or a
+    // matrix without columns need the loop below.
+    Io::FormatSettings tSettings;
+    if (((std::is_arithmetic_v<T> && sizeof(T) > 1) || gIsFloat16<T>) && matrix.getCols().get() > 0 && Io::streamFormat(os, tSettings))
+    {
+        const auto tText = matrix.toString(tSettings);
+        return os.write(tText.data(), static_cast<std::streamsize>(tText.size()));
+    }
+    for (size_t i = 0; i < matrix.getRows(); i++)
     {
         os << " | ";
-        for (const auto &element : column)
+        for (const auto &element : matrix.getRow(i))
         {
             os << element << " | ";
         }
@@ -228,192 +449,288 @@ inline std::ostream &operator<<(std::ostream &os, const Matrix<T> &matrix)
     return os;
 }
 
-template <typename T>
-inline Matrix<T> &Matrix<T>::operator+=(const Matrix<T> &org)
+template <typename T, typename Allocator>
+template <typename E, typename Operation>
+inline void Matrix<T, Allocator>::update(const MatrixExpression<E> &xExpression, Operation xOperation)
 {
-    auto tResult = *this + org;
-    *this = std::move(tResult);
+    const auto &tExpression = xExpression.derived();
+    if (this->m_Rows.get() != tExpression.getRows().get() || this->m_Columns.get() != tExpression.getCols().get())
+        return;
 
-    return *this;
+    Detail::updateExpression(this->m_Data.data(), this->m_LeadingDimension, this->m_Rows.get(), this->m_Columns.get(), tExpression, xOperation);
 }
-template <typename T>
-inline Matrix<T> &Matrix<T>::operator+=(const T &n)
-{
-    auto tResult = *this + n;
-    *this = std::move(tResult);
 
-    return *this;
+template <typename T, typename Allocator>
+template <typename Operation>
+inline void Matrix<T, Allocator>::update(const T &xScalar, Operation xOperation)
+{
+    Detail::updateScalar(this->m_Data.data(), this->m_LeadingDimension, this->m_Rows.get(), this->m_Columns.get(), xScalar, xOperation);
 }
 
-template <typename T>
-inline Matrix<T> &Matrix<T>::operator-=(const Matrix<T> &org)
+template <typename T, typename Allocator>
+template <typename E>
+inline Matrix<T, Allocator> &Matrix<T, Allocator>::operator+=(const MatrixExpression<E> &org)
 {
-    auto tResult = *this - org;
-    *this = std::move(tResult);
-
+    this->update(org, std::plus<>{});
     return *this;
 }
 
-template <typename T>
-inline Matrix<T> &Matrix<T>::operator-=(const T &n)
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> &Matrix<T, Allocator>::operator+=(const T &n)
 {
-    auto tResult = *this - n;
-    *this = std::move(tResult);
-
+    this->update(n, std::plus<>{});
     return *this;
 }
 
-template <typename T>
-inline Matrix<T> &Matrix<T>::operator*=(const Matrix<T> &org)
+template <typename T, typename Allocator>
+template <typename E>
+inline Matrix<T, Allocator> &Matrix<T, Allocator>::operator-=(const MatrixExpression<E> &org)
 {
-    auto tResult = *this * org;
-    *this = std::move(tResult);
-
+    this->update(org, std::minus<>{});
     return *this;
 }
 
-template <typename T>
-inline Matrix<T> &Matrix<T>::operator*=(const T &n)
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> &Matrix<T, Allocator>::operator-=(const T &n)
 {
-    auto tResult = *this * n;
-    *this = std::move(tResult);
-
+    this->update(n, std::minus<>{});
     return *this;
 }
 
-template <typename T>
-inline Matrix<T> Matrix<T>::operator+(const Matrix<T> &org)
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> &Matrix<T, Allocator>::operator*=(const Matrix<T, Allocator> &org)
 {
-    if (this->m_Rows.get() == org.m_Rows.get() || this->m_Columns.get() == org.m_Columns.get())
+    const bool tKeepsShape = this->m_Columns.get() == org.m_Rows.get() && org.m_Rows.get() == org.m_Columns.get();
+    if (!tKeepsShape || &org == this)
     {
-        Matrix<T> result = create(this->m_Rows, this->m_Columns);
+        auto tResult = *this * org;
+        *this = std::move(tResult);
+        return *this;
+    }
 
-        for (size_t i = 0; i < this->m_Matrix.size(); i++)
+    // Row i of the product only needs row i of *this, so the product is formed in
+    // strips of rows in one scratch strip and copied back. The strip belongs to this call:
+    // the product may run on the thread pool, and a buffer shared per thread could be
+    // reused by another *= on the same thread in the meantime.
+    constexpr std::size_t tStripRows{256};
+    const std::size_t tCols = this->m_Columns.get();
+    std::vector<T, Allocator> tScratch(std::min(tStripRows, this->m_Rows.get()) * tCols, this->get_allocator());
+
+    for (std::size_t i = 0; i < this->m_Rows; i += tStripRows)
+    {
+        const std::size_t tRows = std::min(tStripRows, this->m_Rows.get() - i);
+        T *tStrip = this->m_Data.data() + i * this->m_LeadingDimension;
+        Kernels::gemm(tRows, tCols, tCols, static_cast<T>(1), tStrip, this->m_LeadingDimension,
+                      org.m_Data.data(), org.m_LeadingDimension, static_cast<T>(0), tScratch.data(), tCols);
+        for (std::size_t r = 0; r < tRows; r++)
         {
-            for (size_t j = 0; j < this->m_Matrix.at(i).size(); j++)
-            {
-                result.m_Matrix.at(i).at(j) = this->m_Matrix.at(i).at(j) + org.m_Matrix.at(i).at(j);
-            }
+            std::copy(tScratch.cbegin() + r * tCols, tScratch.cbegin() + (r + 1) * tCols, tStrip + r * this->m_LeadingDimension);
         }
-        return result;
     }
 
     return *this;
 }
 
-template <typename T>
-inline Matrix<T> Matrix<T>::operator+(const T &n)
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> &Matrix<T, Allocator>::operator*=(const T &n)
 {
-    Matrix<T> result = create(this->m_Rows, this->m_Columns);
-    for (size_t i = 0; i < this->m_Rows; i++)
-    {
-
-        for (size_t j = 0; j < this->m_Columns; j++)
-        {
-            result.m_Matrix.at(i).at(j) = this->m_Matrix.at(i).at(j) + n;
-        }
-    }
-
-    return result;
+    this->update(n, std::multiplies<>{});
+    return *this;
 }
 
-template <typename T>
-inline Matrix<T> Matrix<T>::operator-(const Matrix<T> &org)
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> Matrix<T, Allocator>::operator*(const Matrix<T, Allocator> &org) const
 {
-    if (this->m_Rows.get() == org.m_Rows.get() || this->m_Columns.get() == org.m_Columns.get())
+    if (this->m_Columns.get() == org.m_Rows.get())
     {
-        Matrix<T> result = create(this->m_Rows, this->m_Columns);
-
-        for (size_t i = 0; i < this->m_Matrix.size(); i++)
+        Matrix<T, Allocator> result = create(this->m_Rows, org.m_Columns, this->get_allocator());
+        Kernels::gemm(this->m_Rows.get(), org.m_Columns.get(), this->m_Columns.get(), static_cast<T>(1),
+                      this->m_Data.data(), this->m_LeadingDimension, org.m_Data.data(), org.m_LeadingDimension,
+                      static_cast<T>(0), result.m_Data.data(), result.m_LeadingDimension);
+        return result;
+    }
+    else if (*this == org)
+    {
+        Matrix<T, Allocator> result = create(this->m_Rows, this->m_Columns, this->get_allocator());
+        for (size_t i = 0; i < this->m_Rows; i++)
         {
-            for (size_t j = 0; j < this->m_Matrix.at(i).size(); j++)
+            const T *tLhs = this->m_Data.data() + i * this->m_LeadingDimension;
+            T *tResult = result.m_Data.data() + i * result.m_LeadingDimension;
+            for (size_t j = 0; j < this->m_Columns; j++)
             {
-                result.m_Matrix.at(i).at(j) = this->m_Matrix.at(i).at(j) - org.m_Matrix.at(i).at(j);
+                tResult[j] = tLhs[j] * tLhs[j];
             }
         }
         return result;
     }
-
-    return *this;
+    return create(this->get_allocator());
 }
 
-template <typename T>
-inline Matrix<T> Matrix<T>::operator-(const T &n)
+template <typename T, typename Allocator>
+template <typename E>
+inline Matrix<T, Allocator> Matrix<T, Allocator>::operator*(const MatrixExpression<E> &org) const
 {
-    Matrix<T> result = create(this->m_Rows, this->m_Columns);
-    for (size_t i = 0; i < this->m_Rows; i++)
+    const auto &tRhs = org.derived();
+    if constexpr (gIsDenseExpression<E>)
     {
-
-        for (size_t j = 0; j < this->m_Columns; j++)
-        {
-            result.m_Matrix.at(i).at(j) = this->m_Matrix.at(i).at(j) - n;
-        }
+        if (this->m_Columns.get() != tRhs.getRows().get())
+            return create(this->get_allocator());
+
+        const auto tView = tRhs.view();
+        Matrix<T, Allocator> result = create(this->m_Rows, tRhs.getCols(), this->get_allocator());
+        Kernels::gemm(this->m_Rows.get(), tView.getCols().get(), this->m_Columns.get(), static_cast<T>(1),
+                      this->m_Data.data(), this->m_LeadingDimension, tView.data(), tView.getLeadingDimension(),
+                      static_cast<T>(0), result.m_Data.data(), result.m_LeadingDimension);
+        return result;
+    }
+    else
+    {
+        return *this * Matrix<T, Allocator>{tRhs, this->get_allocator()};
     }
+}
 
-    return result;
+// Matrix product scheduled on xExecutor instead of Parallel::defaultExecutor().
+// Returns an empty matrix if the inner dimensions differ.
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> multiply(const Matrix<T, Allocator> &xLhs, const Matrix<T, Allocator> &xRhs, Parallel::Executor &xExecutor)
+{
+    if (xLhs.getCols().get() != xRhs.getRows().get())
+        return Matrix<T, Allocator>::create(xLhs.get_allocator());
+
+    Matrix<T, Allocator> tResult = Matrix<T, Allocator>::create(xLhs.getRows(), xRhs.getCols(), xLhs.get_allocator());
+    Kernels::gemm(xLhs.getRows().get(), xRhs.getCols().get(), xLhs.getCols().get(), static_cast<T>(1),
+                  xLhs.getData().data(), xLhs.getLeadingDimension(), xRhs.getData().data(), xRhs.getLeadingDimension(),
+                  static_cast<T>(0), tResult.getData().data(), tResult.getLeadingDimension(), xExecutor);
+    return tResult;
+}
+
+enum class MultiplyAlgorithm
+{
+    Classic,
+    // Strassen-Winograd above Kernels::gStrassenCutoff; faster for large products but with
+    // a weaker, normwise error bound, see Kernels/strassen.h.
+    Strassen
+};
+
+// Matrix product with an explicit algorithm. Returns an empty matrix if the inner dimensions
+// differ.
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> multiply(const Matrix<T, Allocator> &xLhs, const Matrix<T, Allocator> &xRhs, MultiplyAlgorithm xAlgorithm,
+                                     Parallel::Executor &xExecutor)
+{
+    if (xAlgorithm == MultiplyAlgorithm::Classic || xLhs.getCols().get() != xRhs.getRows().get())
+        return multiply(xLhs, xRhs, xExecutor);
+
+    Matrix<T, Allocator> tResult = Matrix<T, Allocator>::create(xLhs.getRows(), xRhs.getCols(), xLhs.get_allocator());
+    Kernels::strassen(xLhs.getRows().get(), xRhs.getCols().get(), xLhs.getCols().get(), xLhs.getData().data(), xLhs.getLeadingDimension(),
+                      xRhs.getData().data(), xRhs.getLeadingDimension(), tResult.getData().data(), tResult.getLeadingDimension(),
+                      Kernels::gStrassenCutoff, xExecutor);
+    return tResult;
 }
 
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> multiply(const Matrix<T, Allocator> &xLhs, const Matrix<T, Allocator> &xRhs, MultiplyAlgorithm xAlgorithm)
+{
+    return multiply(xLhs, xRhs, xAlgorithm, Parallel::defaultExecutor());
+}
+
+// Product of views (or any dense operands, see operator* in matrixExpression.h) without
+// copying them. Returns an empty matrix if the inner dimensions differ.
 template <typename T>
-inline Matrix<T> Matrix<T>::operator*(const Matrix<T> &org)
+inline Matrix<T> multiply(const ConstMatrixView<T> &xLhs, const ConstMatrixView<T> &xRhs, Parallel::Executor &xExecutor)
 {
-    std::vector<std::vector<T>> result;
-    if (this->m_Columns.get() == org.m_Rows.get())
-    {
-        result.resize(this->m_Rows.get());
-        for (size_t i = 0; i < this->m_Rows.get(); i++)
-        {
-            result.at(i).resize(org.m_Columns.get());
-            for (size_t j = 0; j < org.m_Columns.get(); j++)
-            {
-                T sum = 0;
-                for (size_t k = 0; k < this->m_Columns.get(); k++)
-                {
-                    sum += this->m_Matrix.at(i).at(k) * org.m_Matrix.at(k).at(j);
-                }
-                result.at(i).at(j) = sum;
-            }
-        }
-    }
-    else if (*this == org)
-    {
-        result.resize(this->m_Rows.get());
-        for (size_t i = 0; i < result.size(); i++)
-        {
-            result.at(i).resize(this->m_Columns.get());
-            for (size_t j = 0; j < result.at(i).size(); j++)
-            {
-                result.at(i).at(j) = this->m_Matrix.at(i).at(j) * this->m_Matrix.at(i).at(j);
-            }
-        }
-    }
-    return Matrix<T>{result};
+    if (xLhs.getCols().get() != xRhs.getRows().get())
+        return Matrix<T>::create();
+
+    Matrix<T> tResult = Matrix<T>::create(xLhs.getRows(), xRhs.getCols());
+    Kernels::gemm(xLhs.getRows().get(), xRhs.getCols().get(), xLhs.getCols().get(), static_cast<T>(1),
+                  xLhs.data(), xLhs.getLeadingDimension(), xRhs.data(), xRhs.getLeadingDimension(),
+                  static_cast<T>(0), tResult.getData().data(), tResult.getLeadingDimension(), xExecutor);
+    return tResult;
 }
 
 template <typename T>
-inline Matrix<T> Matrix<T>::operator*(const T &n)
+inline Matrix<T> multiply(const ConstMatrixView<T> &xLhs, const ConstMatrixView<T> &xRhs)
 {
-    Matrix<T> result = create(this->m_Rows, this->m_Columns);
-    for (size_t i = 0; i < this->m_Rows; i++)
-    {
-        for (size_t j = 0; j < this->m_Columns; j++)
-        {
-            result.m_Matrix.at(i).at(j) = this->m_Matrix.at(i).at(j) * n;
-        }
-    }
+    return multiply(xLhs, xRhs, Parallel::defaultExecutor());
+}
 
-    return result;
+// Overloads for expiring operands reuse their buffer instead of allocating the result.
+template <typename T, typename Allocator, typename E>
+inline Matrix<T, Allocator> operator+(Matrix<T, Allocator> &&xLhs, const MatrixExpression<E> &xRhs)
+{
+    xLhs += xRhs;
+    return std::move(xLhs);
 }
 
-template <typename T>
-inline bool Matrix<T>::operator==(const Matrix<T> &org)
+template <typename T, typename Allocator, typename E>
+inline Matrix<T, Allocator> operator+(const MatrixExpression<E> &xLhs, Matrix<T, Allocator> &&xRhs)
+{
+    xRhs = xLhs + xRhs;
+    return std::move(xRhs);
+}
+
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> operator+(Matrix<T, Allocator> &&xLhs, Matrix<T, Allocator> &&xRhs)
+{
+    xLhs += xRhs;
+    return std::move(xLhs);
+}
+
+template <typename T, typename Allocator, typename E>
+inline Matrix<T, Allocator> operator-(Matrix<T, Allocator> &&xLhs, const MatrixExpression<E> &xRhs)
+{
+    xLhs -= xRhs;
+    return std::move(xLhs);
+}
+
+template <typename T, typename Allocator, typename E>
+inline Matrix<T, Allocator> operator-(const MatrixExpression<E> &xLhs, Matrix<T, Allocator> &&xRhs)
+{
+    xRhs = xLhs - xRhs;
+    return std::move(xRhs);
+}
+
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> operator-(Matrix<T, Allocator> &&xLhs, Matrix<T, Allocator> &&xRhs)
+{
+    xLhs -= xRhs;
+    return std::move(xLhs);
+}
+
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> operator+(Matrix<T, Allocator> &&xLhs, const typename Matrix<T, Allocator>::value_type &xScalar)
+{
+    xLhs += xScalar;
+    return std::move(xLhs);
+}
+
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> operator-(Matrix<T, Allocator> &&xLhs, const typename Matrix<T, Allocator>::value_type &xScalar)
+{
+    xLhs -= xScalar;
+    return std::move(xLhs);
+}
+
+template <typename T, typename Allocator>
+inline Matrix<T, Allocator> operator*(Matrix<T, Allocator> &&xLhs, const typename Matrix<T, Allocator>::value_type &xScalar)
+{
+    xLhs *= xScalar;
+    return std::move(xLhs);
+}
+
+template <typename T, typename Allocator>
+inline bool Matrix<T, Allocator>::operator==(const Matrix<T, Allocator> &org) const
 {
     if (this->m_Columns.get() == org.m_Columns.get() && this->m_Rows.get() == org.m_Rows.get())
     {
         for (size_t i = 0; i < this->m_Rows; i++)
         {
+            const T *tLhs = this->m_Data.data() + i * this->m_LeadingDimension;
+            const T *tRhs = org.m_Data.data() + i * org.m_LeadingDimension;
             for (size_t j = 0; j < this->m_Columns; j++)
             {
-                if (this->m_Matrix.at(i).at(j) != org.m_Matrix.at(i).at(j))
+                if (tLhs[j] != tRhs[j])
                     return false;
             }
         }
@@ -425,8 +742,15 @@ inline bool Matrix<T>::operator==(const Matrix<T> &org)
     }
 }
 
-template <typename T>
-inline bool Matrix<T>::operator!=(const Matrix<T> &org)
+template <typename T, typename Allocator>
+inline bool Matrix<T, Allocator>::operator!=(const Matrix<T, Allocator> &org) const
 {
     return !(*this == org);
-}
\ No newline at end of file
+}
+
+namespace Pmr
+{
+    // Matrix whose buffer comes from a std::pmr::memory_resource, e.g. Memory/monotonicArena.h.
+    template <typename T>
+    using Matrix = ::Matrix<T, std::pmr::polymorphic_allocator<T>>;
+} // namespace Pmr
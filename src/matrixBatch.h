@@ -0,0 +1,371 @@
+#pragma once
+
+#include "matrix.h"
+#include "Kernels/simd.h"
+#include "Memory/alignedAllocator.h"
+#include "Parallel/threadPool.h"
+#include "Types/column.h"
+#include "Types/row.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Detail
+{
+    // Matrices per inner tile: a 6x6 double gemm touches 108 lanes of this length, which
+    // stays in L2.
+    constexpr std::size_t gBatchTile{128};
+} // namespace Detail
+
+// xCount matrices of the same rows x cols shape, stored interleaved (structure of arrays):
+// entry (i, j) of matrix b lives at (i * cols + j) * stride + b. Every entry therefore forms a
+// contiguous lane across the batch, and the kernels vectorize over the batch instead of over
+// the tiny matrices. The stride is padded to a whole 64-byte line, so the padding stays zero.
+template <typename T>
+class MatrixBatch
+{
+private:
+    Row m_Rows{};
+    Column m_Columns{};
+    std::size_t m_Count{0};
+    std::size_t m_Stride{0};
+    std::vector<T, AlignedAllocator<T>> m_Data{};
+
+    MatrixBatch(const Row &xRows, const Column &xCols, std::size_t xCount)
+        : m_Rows{xRows}, m_Columns{xCols}, m_Count{xCount}, m_Stride{paddedStride(xCount)},
+          m_Data(xRows.get() * xCols.get() * m_Stride)
+    {
+    }
+
+    static std::size_t paddedStride(std::size_t xCount) noexcept
+    {
+        constexpr std::size_t tLine = std::max<std::size_t>(1, gMatrixAlignment / sizeof(T));
+        return (xCount + tLine - 1) / tLine * tLine;
+    }
+
+    std::size_t entries() const noexcept { return m_Rows.get() * m_Columns.get(); }
+    bool sameShape(const MatrixBatch &xOther) const noexcept
+    {
+        return m_Rows.get() == xOther.m_Rows.get() && m_Columns.get() == xOther.m_Columns.get() && m_Count == xOther.m_Count;
+    }
+
+    // Runs xBody(first, last) over tiles of the batch, spread over the default executor once
+    // xWork (flops per matrix) times the batch size is worth it.
+    template <typename Body>
+    void forTiles(std::size_t xWork, const Body &xBody) const;
+
+    template <typename Operation>
+    MatrixBatch &update(const MatrixBatch &xOther, Operation xOperation);
+
+public:
+    using value_type = T;
+
+    MatrixBatch() noexcept = default;
+
+    static MatrixBatch create(const Row &xRows, const Column &xCols, std::size_t xCount) { return MatrixBatch{xRows, xCols, xCount}; }
+    // Interleaves the matrices; std::nullopt if their shapes differ.
+    template <typename Allocator>
+    static std::optional<MatrixBatch> create(const std::vector<Matrix<T, Allocator>> &xMatrices);
+    // xCount copies of xMatrix.
+    template <typename Allocator>
+    static MatrixBatch broadcast(const Matrix<T, Allocator> &xMatrix, std::size_t xCount);
+
+    std::size_t size() const noexcept { return m_Count; }
+    const Row &getRows() const noexcept { return m_Rows; }
+    const Column &getCols() const noexcept { return m_Columns; }
+    std::size_t getStride() const noexcept { return m_Stride; }
+    const std::vector<T, AlignedAllocator<T>> &getData() const noexcept { return m_Data; }
+
+    // Contiguous lane of entry (i, j) across the batch, size() values long.
+    T *lane(std::size_t xRow, std::size_t xCol) noexcept { return m_Data.data() + (xRow * m_Columns.get() + xCol) * m_Stride; }
+    const T *lane(std::size_t xRow, std::size_t xCol) const noexcept { return m_Data.data() + (xRow * m_Columns.get() + xCol) * m_Stride; }
+
+    // Entry (i, j) of matrix xIndex.
+    T &operator()(std::size_t xIndex, std::size_t xRow, std::size_t xCol) noexcept { return lane(xRow, xCol)[xIndex]; }
+    const T &operator()(std::size_t xIndex, std::size_t xRow, std::size_t xCol) const noexcept { return lane(xRow, xCol)[xIndex]; }
+    T &at(std::size_t xIndex, std::size_t xRow, std::size_t xCol);
+    const T &at(std::size_t xIndex, std::size_t xRow, std::size_t xCol) const;
+
+    // Gathers matrix xIndex; throws std::out_of_range for xIndex >= size().
+    Matrix<T> get(std::size_t xIndex) const;
+    // Scatters xMatrix into slot xIndex; throws std::out_of_range for xIndex >= size() and
+    // returns false, leaving the batch unchanged, if the shape differs.
+    template <typename Allocator>
+    bool set(std::size_t xIndex, const Matrix<T, Allocator> &xMatrix);
+
+    MatrixBatch transposed() const;
+    // Gauss-Jordan with partial pivoting, lane by lane; std::nullopt if the matrices are not
+    // square or any of them is singular.
+    std::optional<MatrixBatch> inverse() const;
+
+    // Elementwise over matched batches; an empty batch if the shapes or sizes differ.
+    MatrixBatch operator+(const MatrixBatch &xOther) const;
+    MatrixBatch operator-(const MatrixBatch &xOther) const;
+    // Leave *this unchanged if the shapes or sizes differ.
+    MatrixBatch &operator+=(const MatrixBatch &xOther) { return update(xOther, &Kernels::add<T>); }
+    MatrixBatch &operator-=(const MatrixBatch &xOther) { return update(xOther, &Kernels::subtract<T>); }
+    MatrixBatch &operator*=(const T &xScalar);
+    MatrixBatch operator*(const T &xScalar) const;
+    // Matrix b of the result is (*this)[b] * xOther[b]; an empty batch if the inner dimensions
+    // or the batch sizes differ.
+    MatrixBatch operator*(const MatrixBatch &xOther) const;
+
+    bool operator==(const MatrixBatch &xOther) const noexcept { return sameShape(xOther) && m_Data == xOther.m_Data; }
+    bool operator!=(const MatrixBatch &xOther) const noexcept { return !(*this == xOther); }
+};
+
+template <typename T>
+template <typename Body>
+inline void MatrixBatch<T>::forTiles(std::size_t xWork, const Body &xBody) const
+{
+    const std::size_t tTiles = (m_Count + Detail::gBatchTile - 1) / Detail::gBatchTile;
+    auto &tExecutor = Parallel::defaultExecutor();
+    const std::size_t tParts = xWork * m_Count >= Kernels::gGemmParallelProduct ? std::min(tExecutor.concurrency(), tTiles) : 1;
+    const auto tRun = [&](std::size_t xFirstTile, std::size_t xLastTile)
+    {
+        for (std::size_t t = xFirstTile; t < xLastTile; t++)
+            xBody(t * Detail::gBatchTile, std::min(m_Count, (t + 1) * Detail::gBatchTile));
+    };
+    if (tParts <= 1)
+    {
+        tRun(0, tTiles);
+        return;
+    }
+    tExecutor.parallelFor(tParts, [&](std::size_t xPart)
+                          { tRun(tTiles * xPart / tParts, tTiles * (xPart + 1) / tParts); });
+}
+
+template <typename T>
+template <typename Allocator>
+inline std::optional<MatrixBatch<T>> MatrixBatch<T>::create(const std::vector<Matrix<T, Allocator>> &xMatrices)
+{
+    if (xMatrices.empty())
+        return MatrixBatch{};
+
+    MatrixBatch tResult{xMatrices.front().getRows(), xMatrices.front().getCols(), xMatrices.size()};
+    for (std::size_t b = 0; b < xMatrices.size(); b++)
+        if (!tResult.set(b, xMatrices[b]))
+            return std::nullopt;
+    return tResult;
+}
+
+template <typename T>
+template <typename Allocator>
+inline MatrixBatch<T> MatrixBatch<T>::broadcast(const Matrix<T, Allocator> &xMatrix, std::size_t xCount)
+{
+    MatrixBatch tResult{xMatrix.getRows(), xMatrix.getCols(), xCount};
+    for (std::size_t i = 0; i < tResult.m_Rows.get(); i++)
+        for (std::size_t j = 0; j < tResult.m_Columns.get(); j++)
+            std::fill_n(tResult.lane(i, j), xCount, xMatrix(i, j));
+    return tResult;
+}
+
+template <typename T>
+inline T &MatrixBatch<T>::at(std::size_t xIndex, std::size_t xRow, std::size_t xCol)
+{
+    if (xIndex >= m_Count || xRow >= m_Rows.get() || xCol >= m_Columns.get())
+        throw std::out_of_range("MatrixBatch::at: (" + std::to_string(xIndex) + ", " + std::to_string(xRow) + ", " +
+                                std::to_string(xCol) + ") is out of range");
+    return (*this)(xIndex, xRow, xCol);
+}
+
+template <typename T>
+inline const T &MatrixBatch<T>::at(std::size_t xIndex, std::size_t xRow, std::size_t xCol) const
+{
+    return const_cast<MatrixBatch &>(*this).at(xIndex, xRow, xCol);
+}
+
+template <typename T>
+inline Matrix<T> MatrixBatch<T>::get(std::size_t xIndex) const
+{
+    if (xIndex >= m_Count)
+        throw std::out_of_range("MatrixBatch::get: index " + std::to_string(xIndex) + " is out of range");
+
+    auto tResult = Matrix<T>::create(m_Rows, m_Columns);
+    for (std::size_t i = 0; i < m_Rows.get(); i++)
+        for (std::size_t j = 0; j < m_Columns.get(); j++)
+            tResult(i, j) = (*this)(xIndex, i, j);
+    return tResult;
+}
+
+template <typename T>
+template <typename Allocator>
+inline bool MatrixBatch<T>::set(std::size_t xIndex, const Matrix<T, Allocator> &xMatrix)
+{
+    if (xIndex >= m_Count)
+        throw std::out_of_range("MatrixBatch::set: index " + std::to_string(xIndex) + " is out of range");
+    if (xMatrix.getRows().get() != m_Rows.get() || xMatrix.getCols().get() != m_Columns.get())
+        return false;
+
+    for (std::size_t i = 0; i < m_Rows.get(); i++)
+        for (std::size_t j = 0; j < m_Columns.get(); j++)
+            (*this)(xIndex, i, j) = xMatrix(i, j);
+    return true;
+}
+
+template <typename T>
+inline MatrixBatch<T> MatrixBatch<T>::transposed() const
+{
+    // Transposing permutes whole lanes.
+    MatrixBatch tResult{Row{m_Columns.get()}, Column{m_Rows.get()}, m_Count};
+    for (std::size_t i = 0; i < m_Rows.get(); i++)
+        for (std::size_t j = 0; j < m_Columns.get(); j++)
+            std::copy_n(lane(i, j), m_Stride, tResult.lane(j, i));
+    return tResult;
+}
+
+template <typename T>
+inline std::optional<MatrixBatch<T>> MatrixBatch<T>::inverse() const
+{
+    static_assert(std::is_floating_point_v<T>, "MatrixBatch::inverse needs a floating point type");
+    const std::size_t n = m_Rows.get();
+    if (n != m_Columns.get())
+        return std::nullopt;
+
+    MatrixBatch tResult{m_Rows, m_Columns, m_Count};
+    std::atomic<bool> tSingular{false};
+    const std::size_t tWidth = 2 * n;
+    forTiles(2 * n * n * n, [&](std::size_t xFirst, std::size_t xLast)
+             {
+                 const std::size_t tLanes = xLast - xFirst;
+                 // Augmented [A | I] of the tile, one lane of tLanes values per entry.
+                 std::vector<T, AlignedAllocator<T>> tWork(n * tWidth * Detail::gBatchTile);
+                 std::vector<T, AlignedAllocator<T>> tFactor(Detail::gBatchTile);
+                 const auto tEntry = [&](std::size_t xRow, std::size_t xCol) { return tWork.data() + (xRow * tWidth + xCol) * Detail::gBatchTile; };
+
+                 for (std::size_t i = 0; i < n; i++)
+                 {
+                     for (std::size_t j = 0; j < n; j++)
+                     {
+                         std::copy_n(lane(i, j) + xFirst, tLanes, tEntry(i, j));
+                         std::fill_n(tEntry(i, n + j), tLanes, static_cast<T>(i == j ? 1 : 0));
+                     }
+                 }
+
+                 for (std::size_t k = 0; k < n; k++)
+                 {
+                     // Pivot search and row swap differ per lane; they are O(n) per lane
+                     // and column, the O(n^2) elimination below runs on full lanes.
+                     for (std::size_t b = 0; b < tLanes; b++)
+                     {
+                         std::size_t tPivot = k;
+                         for (std::size_t r = k + 1; r < n; r++)
+                             if (std::abs(tEntry(r, k)[b]) > std::abs(tEntry(tPivot, k)[b]))
+                                 tPivot = r;
+                         if (tPivot != k)
+                             for (std::size_t c = k; c < tWidth; c++)
+                                 std::swap(tEntry(k, c)[b], tEntry(tPivot, c)[b]);
+
+                         const T tDiagonal = tEntry(k, k)[b];
+                         if (tDiagonal == static_cast<T>(0))
+                         {
+                             tSingular.store(true, std::memory_order_relaxed);
+                             tFactor[b] = static_cast<T>(0);
+                         }
+                         else
+                         {
+                             tFactor[b] = static_cast<T>(1) / tDiagonal;
+                         }
+                     }
+
+                     for (std::size_t c = k; c < tWidth; c++)
+                         Kernels::multiply(tEntry(k, c), tFactor.data(), tEntry(k, c), tLanes);
+                     for (std::size_t r = 0; r < n; r++)
+                     {
+                         if (r == k)
+                             continue;
+                         std::copy_n(tEntry(r, k), tLanes, tFactor.data());
+                         for (std::size_t c = k; c < tWidth; c++)
+                             Kernels::multiplySubtract(tFactor.data(), tEntry(k, c), tEntry(r, c), tLanes);
+                     }
+                 }
+
+                 for (std::size_t i = 0; i < n; i++)
+                     for (std::size_t j = 0; j < n; j++)
+                         std::copy_n(tEntry(i, n + j), tLanes, tResult.lane(i, j) + xFirst);
+             });
+
+    if (tSingular.load())
+        return std::nullopt;
+    return tResult;
+}
+
+template <typename T>
+template <typename Operation>
+inline MatrixBatch<T> &MatrixBatch<T>::update(const MatrixBatch &xOther, Operation xOperation)
+{
+    if (!sameShape(xOther))
+        return *this;
+
+    forTiles(entries(), [&](std::size_t xFirst, std::size_t xLast)
+             {
+                 for (std::size_t e = 0; e < entries(); e++)
+                 {
+                     T *tLane = m_Data.data() + e * m_Stride + xFirst;
+                     xOperation(tLane, xOther.m_Data.data() + e * m_Stride + xFirst, tLane, xLast - xFirst);
+                 }
+             });
+    return *this;
+}
+
+template <typename T>
+inline MatrixBatch<T> MatrixBatch<T>::operator+(const MatrixBatch &xOther) const
+{
+    if (!sameShape(xOther))
+        return MatrixBatch{};
+    MatrixBatch tResult{*this};
+    tResult += xOther;
+    return tResult;
+}
+
+template <typename T>
+inline MatrixBatch<T> MatrixBatch<T>::operator-(const MatrixBatch &xOther) const
+{
+    if (!sameShape(xOther))
+        return MatrixBatch{};
+    MatrixBatch tResult{*this};
+    tResult -= xOther;
+    return tResult;
+}
+
+template <typename T>
+inline MatrixBatch<T> &MatrixBatch<T>::operator*=(const T &xScalar)
+{
+    Kernels::multiplyScalar(m_Data.data(), xScalar, m_Data.data(), m_Data.size());
+    return *this;
+}
+
+template <typename T>
+inline MatrixBatch<T> MatrixBatch<T>::operator*(const T &xScalar) const
+{
+    MatrixBatch tResult{*this};
+    tResult *= xScalar;
+    return tResult;
+}
+
+template <typename T>
+inline MatrixBatch<T> MatrixBatch<T>::operator*(const MatrixBatch &xOther) const
+{
+    if (m_Columns.get() != xOther.m_Rows.get() || m_Count != xOther.m_Count)
+        return MatrixBatch{};
+
+    const std::size_t tInner = m_Columns.get();
+    MatrixBatch tResult{m_Rows, xOther.m_Columns, m_Count};
+    forTiles(m_Rows.get() * xOther.m_Columns.get() * tInner, [&](std::size_t xFirst, std::size_t xLast)
+             {
+                 for (std::size_t i = 0; i < tResult.m_Rows.get(); i++)
+                     for (std::size_t j = 0; j < tResult.m_Columns.get(); j++)
+                         for (std::size_t k = 0; k < tInner; k++)
+                             Kernels::multiplyAdd(lane(i, k) + xFirst, xOther.lane(k, j) + xFirst, tResult.lane(i, j) + xFirst,
+                                                  xLast - xFirst);
+             });
+    return tResult;
+}
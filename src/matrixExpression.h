@@ -0,0 +1,279 @@
+#pragma once
+
+#include "Types/column.h"
+#include "Types/row.h"
+#include "Memory/alignedAllocator.h"
+#include "Kernels/simd.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+template <typename T, typename Allocator = AlignedAllocator<T>>
+class Matrix;
+template <typename T>
+class MatrixView;
+
+// CRTP base of everything that can appear in an elementwise Matrix expression.
+// Derived types provide value_type, getRows(), getCols() and operator()(row, col).
+template <typename Derived>
+class MatrixExpression
+{
+public:
+    constexpr const Derived &derived() const noexcept { return static_cast<const Derived &>(*this); }
+};
+
+template <typename E>
+constexpr bool gIsMatrixExpression = std::is_base_of_v<MatrixExpression<E>, E>;
+
+// Operands backed by strided memory: getRow(i) returns a Span and getLeadingDimension() exists.
+template <typename E>
+constexpr bool gIsDenseExpression = false;
+template <typename T, typename Allocator>
+constexpr bool gIsDenseExpression<Matrix<T, Allocator>> = true;
+template <typename T>
+constexpr bool gIsDenseExpression<MatrixView<T>> = true;
+
+namespace Detail
+{
+    // Matrices are held by reference, expression nodes are small and held by value.
+    template <typename E>
+    struct ExpressionOperand
+    {
+        using type = const E;
+    };
+
+    template <typename T, typename Allocator>
+    struct ExpressionOperand<Matrix<T, Allocator>>
+    {
+        using type = const Matrix<T, Allocator> &;
+    };
+
+    template <typename E>
+    using ExpressionOperand_t = typename ExpressionOperand<E>::type;
+} // namespace Detail
+
+// Elementwise xOperation(lhs, rhs). Operands with different shapes leave lhs unchanged,
+// like the eager operators did.
+template <typename Lhs, typename Rhs, typename Operation>
+class MatrixBinaryExpression : public MatrixExpression<MatrixBinaryExpression<Lhs, Rhs, Operation>>
+{
+private:
+    Detail::ExpressionOperand_t<Lhs> m_Lhs;
+    Detail::ExpressionOperand_t<Rhs> m_Rhs;
+    bool m_Compatible;
+
+public:
+    using value_type = typename Lhs::value_type;
+
+    MatrixBinaryExpression(const Lhs &xLhs, const Rhs &xRhs) noexcept
+        : m_Lhs{xLhs}, m_Rhs{xRhs},
+          m_Compatible{xLhs.getRows().get() == xRhs.getRows().get() && xLhs.getCols().get() == xRhs.getCols().get()}
+    {
+    }
+
+    Row getRows() const noexcept { return Row{m_Lhs.getRows().get()}; }
+    Column getCols() const noexcept { return Column{m_Lhs.getCols().get()}; }
+
+    const Lhs &lhs() const noexcept { return m_Lhs; }
+    const Rhs &rhs() const noexcept { return m_Rhs; }
+    bool compatible() const noexcept { return m_Compatible; }
+
+    value_type operator()(const std::size_t &xRow, const std::size_t &xCol) const
+    {
+        if (m_Compatible)
+            return Operation{}(m_Lhs(xRow, xCol), m_Rhs(xRow, xCol));
+        return m_Lhs(xRow, xCol);
+    }
+};
+
+// Elementwise xOperation(element, scalar).
+template <typename E, typename Operation>
+class MatrixScalarExpression : public MatrixExpression<MatrixScalarExpression<E, Operation>>
+{
+public:
+    using value_type = typename E::value_type;
+
+private:
+    Detail::ExpressionOperand_t<E> m_Expression;
+    value_type m_Scalar;
+
+public:
+    MatrixScalarExpression(const E &xExpression, const value_type &xScalar) noexcept
+        : m_Expression{xExpression}, m_Scalar{xScalar}
+    {
+    }
+
+    Row getRows() const noexcept { return Row{m_Expression.getRows().get()}; }
+    Column getCols() const noexcept { return Column{m_Expression.getCols().get()}; }
+
+    const E &expression() const noexcept { return m_Expression; }
+    const value_type &scalar() const noexcept { return m_Scalar; }
+
+    value_type operator()(const std::size_t &xRow, const std::size_t &xCol) const
+    {
+        return Operation{}(m_Expression(xRow, xCol), m_Scalar);
+    }
+};
+
+template <typename Lhs, typename Rhs>
+inline MatrixBinaryExpression<Lhs, Rhs, std::plus<>> operator+(const MatrixExpression<Lhs> &xLhs, const MatrixExpression<Rhs> &xRhs)
+{
+    return {xLhs.derived(), xRhs.derived()};
+}
+
+template <typename Lhs, typename Rhs>
+inline MatrixBinaryExpression<Lhs, Rhs, std::minus<>> operator-(const MatrixExpression<Lhs> &xLhs, const MatrixExpression<Rhs> &xRhs)
+{
+    return {xLhs.derived(), xRhs.derived()};
+}
+
+template <typename E>
+inline MatrixScalarExpression<E, std::plus<>> operator+(const MatrixExpression<E> &xExpression, const typename E::value_type &xScalar)
+{
+    return {xExpression.derived(), xScalar};
+}
+
+template <typename E>
+inline MatrixScalarExpression<E, std::minus<>> operator-(const MatrixExpression<E> &xExpression, const typename E::value_type &xScalar)
+{
+    return {xExpression.derived(), xScalar};
+}
+
+template <typename E>
+inline MatrixScalarExpression<E, std::multiplies<>> operator*(const MatrixExpression<E> &xExpression, const typename E::value_type &xScalar)
+{
+    return {xExpression.derived(), xScalar};
+}
+
+// Materializes an expression, e.g. to keep it beyond the lifetime of its operands.
+template <typename E>
+inline Matrix<typename E::value_type> evaluate(const MatrixExpression<E> &xExpression)
+{
+    return Matrix<typename E::value_type>(xExpression);
+}
+
+// Matrix products are not elementwise: dense operands go straight to the GEMM kernel,
+// anything else is materialized first.
+template <typename Lhs, typename Rhs>
+inline Matrix<typename Lhs::value_type> operator*(const MatrixExpression<Lhs> &xLhs, const MatrixExpression<Rhs> &xRhs)
+{
+    if constexpr (gIsDenseExpression<Lhs> && gIsDenseExpression<Rhs>)
+        return multiply(xLhs.derived().view(), xRhs.derived().view());
+    else
+        return evaluate(xLhs) * evaluate(xRhs);
+}
+
+namespace Detail
+{
+    // Expressions over dense operands that map onto one of the Kernels/simd.h loops.
+    template <typename E>
+    struct HasElementwiseKernel : std::false_type
+    {
+    };
+
+    template <typename Lhs, typename Rhs, typename Operation>
+    struct HasElementwiseKernel<MatrixBinaryExpression<Lhs, Rhs, Operation>>
+        : std::bool_constant<gIsDenseExpression<Lhs> && gIsDenseExpression<Rhs> &&
+                             std::is_same_v<typename Lhs::value_type, typename Rhs::value_type> &&
+                             Kernels::gHasElementwiseKernel<Operation>>
+    {
+    };
+
+    template <typename E, typename Operation>
+    struct HasElementwiseKernel<MatrixScalarExpression<E, Operation>>
+        : std::bool_constant<gIsDenseExpression<E> && Kernels::gHasElementwiseKernel<Operation>>
+    {
+    };
+
+    template <typename T, typename Lhs, typename Rhs, typename Operation>
+    void assignKernel(T *xData, std::size_t xLd, std::size_t xRows, std::size_t xCols, const MatrixBinaryExpression<Lhs, Rhs, Operation> &xExpression)
+    {
+        for (std::size_t i = 0; i < xRows; i++)
+        {
+            const T *tLhs = xExpression.lhs().getRow(i).data();
+            if (xExpression.compatible())
+                Kernels::elementwise<Operation>(tLhs, xExpression.rhs().getRow(i).data(), xData + i * xLd, xCols);
+            else if (tLhs != xData + i * xLd)
+                std::copy(tLhs, tLhs + xCols, xData + i * xLd);
+        }
+    }
+
+    template <typename T, typename E, typename Operation>
+    void assignKernel(T *xData, std::size_t xLd, std::size_t xRows, std::size_t xCols, const MatrixScalarExpression<E, Operation> &xExpression)
+    {
+        for (std::size_t i = 0; i < xRows; i++)
+            Kernels::elementwiseScalar<Operation>(xExpression.expression().getRow(i).data(), xExpression.scalar(), xData + i * xLd, xCols);
+    }
+
+    // Writes xExpression into the xRows x xCols block at xData with row stride xLd. Shapes
+    // are checked by the caller; the expression may read (i, j) of the destination only
+    // to produce (i, j).
+    template <typename T, typename E>
+    void assignExpression(T *xData, std::size_t xLd, std::size_t xRows, std::size_t xCols, const E &xExpression)
+    {
+        if constexpr (HasElementwiseKernel<E>::value)
+        {
+            assignKernel(xData, xLd, xRows, xCols, xExpression);
+        }
+        else if constexpr (gIsDenseExpression<E>)
+        {
+            for (std::size_t i = 0; i < xRows; i++)
+            {
+                const T *tSource = xExpression.getRow(i).data();
+                if (tSource != xData + i * xLd)
+                    std::copy(tSource, tSource + xCols, xData + i * xLd);
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < xRows; i++)
+            {
+                T *tResult = xData + i * xLd;
+                for (std::size_t j = 0; j < xCols; j++)
+                    tResult[j] = xExpression(i, j);
+            }
+        }
+    }
+
+    // xData(i, j) = xOperation(xData(i, j), xExpression(i, j)).
+    template <typename T, typename E, typename Operation>
+    void updateExpression(T *xData, std::size_t xLd, std::size_t xRows, std::size_t xCols, const E &xExpression, Operation xOperation)
+    {
+        if constexpr (gIsDenseExpression<E> && Kernels::gHasElementwiseKernel<Operation>)
+        {
+            for (std::size_t i = 0; i < xRows; i++)
+                Kernels::elementwise<Operation>(xData + i * xLd, xExpression.getRow(i).data(), xData + i * xLd, xCols);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < xRows; i++)
+            {
+                T *tResult = xData + i * xLd;
+                for (std::size_t j = 0; j < xCols; j++)
+                    tResult[j] = xOperation(tResult[j], xExpression(i, j));
+            }
+        }
+    }
+
+    // xData(i, j) = xOperation(xData(i, j), xScalar).
+    template <typename T, typename Operation>
+    void updateScalar(T *xData, std::size_t xLd, std::size_t xRows, std::size_t xCols, const T &xScalar, Operation xOperation)
+    {
+        for (std::size_t i = 0; i < xRows; i++)
+        {
+            T *tResult = xData + i * xLd;
+            if constexpr (Kernels::gHasElementwiseKernel<Operation>)
+            {
+                Kernels::elementwiseScalar<Operation>(tResult, xScalar, tResult, xCols);
+            }
+            else
+            {
+                for (std::size_t j = 0; j < xCols; j++)
+                    tResult[j] = xOperation(tResult[j], xScalar);
+            }
+        }
+    }
+} // namespace Detail
+
@@ -0,0 +1,218 @@
+#pragma once
+
+#include "Types/column.h"
+#include "Types/row.h"
+#include "Types/span.h"
+#include "matrixExpression.h"
+#include "Kernels/transpose.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Non owning rows x cols window into row-major memory with row stride m_LeadingDimension,
+// e.g. Matrix::block(). MatrixView<const T> (ConstMatrixView<T>) is read only.
+// Views are used like a Matrix in expressions and products; assigning to a view writes
+// through to the viewed elements.
+template <typename T>
+class MatrixView : public MatrixExpression<MatrixView<T>>
+{
+private:
+    T *m_Data{nullptr};
+    std::size_t m_Rows{0};
+    std::size_t m_Columns{0};
+    std::size_t m_LeadingDimension{0};
+
+    void checkBlock(std::size_t xRow, std::size_t xCol, std::size_t xRows, std::size_t xCols) const noexcept(false)
+    {
+        if (xRow > m_Rows || xCol > m_Columns || xRows > m_Rows - xRow || xCols > m_Columns - xCol)
+            throw std::out_of_range("MatrixView::block: " + std::to_string(xRows) + "x" + std::to_string(xCols) + " at (" + std::to_string(xRow) + ", " + std::to_string(xCol) + ") is outside of " + std::to_string(m_Rows) + "x" + std::to_string(m_Columns));
+    }
+
+    // True if the dense operand xOther shares memory with this view at a different origin,
+    // so writing row by row would overwrite elements before they are read.
+    template <typename E>
+    bool overlapsShifted(const E &xOther) const noexcept
+    {
+        if (m_Rows == 0 || m_Columns == 0)
+            return false;
+
+        const auto *tOther = xOther.getRow(0).data();
+        const auto *tOtherEnd = tOther + (m_Rows - 1) * xOther.getLeadingDimension() + m_Columns;
+        const auto *tEnd = m_Data + (m_Rows - 1) * m_LeadingDimension + m_Columns;
+        return tOther != m_Data && tOther < tEnd && m_Data < tOtherEnd;
+    }
+
+public:
+    using value_type = std::remove_cv_t<T>;
+    using element_type = T;
+
+    constexpr MatrixView() noexcept = default;
+    constexpr MatrixView(T *xData, std::size_t xRows, std::size_t xCols, std::size_t xLeadingDimension) noexcept
+        : m_Data{xData}, m_Rows{xRows}, m_Columns{xCols}, m_LeadingDimension{xLeadingDimension}
+    {
+    }
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr MatrixView(const MatrixView<U> &xOther) noexcept
+        : m_Data{xOther.data()}, m_Rows{xOther.getRows().get()}, m_Columns{xOther.getCols().get()}, m_LeadingDimension{xOther.getLeadingDimension()}
+    {
+    }
+    MatrixView(const MatrixView &) noexcept = default;
+
+    // Copies the elements of xOther; views do not rebind. Not available on read only views.
+    MatrixView &operator=(const MatrixView &xOther)
+    {
+        return *this = static_cast<const MatrixExpression<MatrixView> &>(xOther);
+    }
+    // Writes xExpression into the viewed elements; a shape mismatch leaves them unchanged.
+    // Dense operands may overlap the view; other expressions may only read element (i, j)
+    // of the view to produce (i, j). The same holds for += and -=.
+    template <typename E>
+    MatrixView &operator=(const MatrixExpression<E> &xExpression);
+
+    template <typename E>
+    MatrixView &operator+=(const MatrixExpression<E> &xExpression);
+    template <typename E>
+    MatrixView &operator-=(const MatrixExpression<E> &xExpression);
+    MatrixView &operator+=(const value_type &xScalar);
+    MatrixView &operator-=(const value_type &xScalar);
+    MatrixView &operator*=(const value_type &xScalar);
+
+    constexpr T *data() const noexcept { return m_Data; }
+    Row getRows() const noexcept { return Row{m_Rows}; }
+    Column getCols() const noexcept { return Column{m_Columns}; }
+    constexpr std::size_t getLeadingDimension() const noexcept { return m_LeadingDimension; }
+    constexpr bool empty() const noexcept { return m_Rows == 0 || m_Columns == 0; }
+
+    constexpr T &operator()(const std::size_t &xRow, const std::size_t &xCol) const noexcept { return m_Data[xRow * m_LeadingDimension + xCol]; }
+    T &at(const std::size_t &xRow, const std::size_t &xCol) const noexcept(false)
+    {
+        if (xRow >= m_Rows || xCol >= m_Columns)
+            throw std::out_of_range("MatrixView::at: (" + std::to_string(xRow) + ", " + std::to_string(xCol) + ") is outside of " + std::to_string(m_Rows) + "x" + std::to_string(m_Columns));
+        return (*this)(xRow, xCol);
+    }
+
+    Span<T> getRow(const std::size_t &xRow) const noexcept { return Span<T>{m_Data + xRow * m_LeadingDimension, m_Columns}; }
+    StridedSpan<T> getColumn(const std::size_t &xCol) const noexcept { return StridedSpan<T>{m_Data + xCol, m_Rows, m_LeadingDimension}; }
+
+    // Sub-views; throw std::out_of_range if they do not fit.
+    MatrixView block(std::size_t xRow, std::size_t xCol, std::size_t xRows, std::size_t xCols) const noexcept(false)
+    {
+        checkBlock(xRow, xCol, xRows, xCols);
+        return MatrixView{m_Data + xRow * m_LeadingDimension + xCol, xRows, xCols, m_LeadingDimension};
+    }
+    MatrixView row(std::size_t xRow) const noexcept(false) { return block(xRow, 0, 1, m_Columns); }
+    MatrixView col(std::size_t xCol) const noexcept(false) { return block(0, xCol, m_Rows, 1); }
+    MatrixView<const T> view() const noexcept { return *this; }
+
+    // Out of place copy with the blocked transpose kernel.
+    Matrix<value_type> transposed() const;
+};
+
+template <typename T>
+using ConstMatrixView = MatrixView<const T>;
+
+template <typename T>
+template <typename E>
+inline MatrixView<T> &MatrixView<T>::operator=(const MatrixExpression<E> &xExpression)
+{
+    static_assert(!std::is_const_v<T>, "Cannot assign through a read only view");
+
+    const auto &tExpression = xExpression.derived();
+    if (m_Rows != tExpression.getRows().get() || m_Columns != tExpression.getCols().get())
+        return *this;
+
+    if constexpr (gIsDenseExpression<E>)
+    {
+        if (overlapsShifted(tExpression))
+        {
+            const Matrix<value_type> tCopy{tExpression};
+            Detail::assignExpression(m_Data, m_LeadingDimension, m_Rows, m_Columns, tCopy);
+            return *this;
+        }
+    }
+
+    Detail::assignExpression(m_Data, m_LeadingDimension, m_Rows, m_Columns, tExpression);
+    return *this;
+}
+
+template <typename T>
+template <typename E>
+inline MatrixView<T> &MatrixView<T>::operator+=(const MatrixExpression<E> &xExpression)
+{
+    static_assert(!std::is_const_v<T>, "Cannot assign through a read only view");
+
+    const auto &tExpression = xExpression.derived();
+    if (m_Rows != tExpression.getRows().get() || m_Columns != tExpression.getCols().get())
+        return *this;
+
+    if constexpr (gIsDenseExpression<E>)
+    {
+        if (overlapsShifted(tExpression))
+        {
+            const Matrix<value_type> tCopy{tExpression};
+            Detail::updateExpression(m_Data, m_LeadingDimension, m_Rows, m_Columns, tCopy, std::plus<>{});
+            return *this;
+        }
+    }
+
+    Detail::updateExpression(m_Data, m_LeadingDimension, m_Rows, m_Columns, tExpression, std::plus<>{});
+    return *this;
+}
+
+template <typename T>
+template <typename E>
+inline MatrixView<T> &MatrixView<T>::operator-=(const MatrixExpression<E> &xExpression)
+{
+    static_assert(!std::is_const_v<T>, "Cannot assign through a read only view");
+
+    const auto &tExpression = xExpression.derived();
+    if (m_Rows != tExpression.getRows().get() || m_Columns != tExpression.getCols().get())
+        return *this;
+
+    if constexpr (gIsDenseExpression<E>)
+    {
+        if (overlapsShifted(tExpression))
+        {
+            const Matrix<value_type> tCopy{tExpression};
+            Detail::updateExpression(m_Data, m_LeadingDimension, m_Rows, m_Columns, tCopy, std::minus<>{});
+            return *this;
+        }
+    }
+
+    Detail::updateExpression(m_Data, m_LeadingDimension, m_Rows, m_Columns, tExpression, std::minus<>{});
+    return *this;
+}
+
+template <typename T>
+inline MatrixView<T> &MatrixView<T>::operator+=(const value_type &xScalar)
+{
+    static_assert(!std::is_const_v<T>, "Cannot assign through a read only view");
+    Detail::updateScalar(m_Data, m_LeadingDimension, m_Rows, m_Columns, xScalar, std::plus<>{});
+    return *this;
+}
+
+template <typename T>
+inline MatrixView<T> &MatrixView<T>::operator-=(const value_type &xScalar)
+{
+    static_assert(!std::is_const_v<T>, "Cannot assign through a read only view");
+    Detail::updateScalar(m_Data, m_LeadingDimension, m_Rows, m_Columns, xScalar, std::minus<>{});
+    return *this;
+}
+
+template <typename T>
+inline MatrixView<T> &MatrixView<T>::operator*=(const value_type &xScalar)
+{
+    static_assert(!std::is_const_v<T>, "Cannot assign through a read only view");
+    Detail::updateScalar(m_Data, m_LeadingDimension, m_Rows, m_Columns, xScalar, std::multiplies<>{});
+    return *this;
+}
+
+template <typename T>
+inline Matrix<typename MatrixView<T>::value_type> MatrixView<T>::transposed() const
+{
+    auto tResult = Matrix<value_type>::create(Row{m_Columns}, Column{m_Rows});
+    Kernels::transpose(m_Rows, m_Columns, m_Data, m_LeadingDimension, tResult.getData().data(), tResult.getLeadingDimension());
+    return tResult;
+}
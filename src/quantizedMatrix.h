@@ -0,0 +1,246 @@
+#pragma once
+
+#include "matrix.h"
+#include "Kernels/qgemm.h"
+#include "Parallel/threadPool.h"
+#include "Types/column.h"
+#include "Types/row.h"
+#include "Types/span.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+// Which elements of a QuantizedMatrix share one scale and zero point.
+enum class Quantization
+{
+    PerTensor,
+    PerRow,
+    PerColumn
+};
+
+// Affine 8-bit quantization of a float matrix: element (i, j) stands for
+// scale * (q(i, j) - zeroPoint), with one scale and zero point per tensor, row or column.
+// T is std::int8_t or std::uint8_t. The data is stored row by row without padding.
+template <typename T>
+class QuantizedMatrix
+{
+    static_assert(std::is_same_v<T, std::int8_t> || std::is_same_v<T, std::uint8_t>, "QuantizedMatrix stores int8 or uint8 elements");
+
+private:
+    std::size_t m_Rows{0};
+    std::size_t m_Cols{0};
+    Quantization m_Quantization{Quantization::PerTensor};
+    std::vector<T> m_Data{};
+    std::vector<float> m_Scales{};
+    std::vector<std::int32_t> m_ZeroPoints{};
+
+    static constexpr std::int32_t gMin{std::numeric_limits<T>::min()};
+    static constexpr std::int32_t gMax{std::numeric_limits<T>::max()};
+
+    static std::size_t groups(std::size_t xRows, std::size_t xCols, Quantization xQuantization) noexcept
+    {
+        return xQuantization == Quantization::PerRow ? xRows : xQuantization == Quantization::PerColumn ? xCols
+                                                                                                          : 1;
+    }
+
+    std::size_t group(std::size_t xRow, std::size_t xCol) const noexcept
+    {
+        return m_Quantization == Quantization::PerRow ? xRow : m_Quantization == Quantization::PerColumn ? xCol
+                                                                                                         : 0;
+    }
+
+public:
+    using value_type = T;
+
+    QuantizedMatrix() noexcept = default;
+
+    // Min/max calibration: every group maps [min(x, 0), max(x, 0)] onto the full range of T,
+    // so 0 is represented exactly. Elements round to nearest even. xMatrix must be finite.
+    template <typename Allocator>
+    static QuantizedMatrix quantize(const Matrix<float, Allocator> &xMatrix, Quantization xQuantization = Quantization::PerTensor);
+    // Wraps quantized data, one scale and zero point per group. std::nullopt if a size does not
+    // match the shape, a scale is not positive and finite or a zero point is outside T.
+    static std::optional<QuantizedMatrix> create(const Row &xRows, const Column &xCols, std::vector<T> xData,
+                                                 std::vector<float> xScales, std::vector<std::int32_t> xZeroPoints,
+                                                 Quantization xQuantization = Quantization::PerTensor);
+
+    Matrix<float> dequantize() const;
+
+    Row getRows() const noexcept { return Row{m_Rows}; }
+    Column getCols() const noexcept { return Column{m_Cols}; }
+    Quantization getQuantization() const noexcept { return m_Quantization; }
+    Span<const T> getData() const noexcept { return {m_Data.data(), m_Data.size()}; }
+    Span<const float> getScales() const noexcept { return {m_Scales.data(), m_Scales.size()}; }
+    Span<const std::int32_t> getZeroPoints() const noexcept { return {m_ZeroPoints.data(), m_ZeroPoints.size()}; }
+
+    // Quantized value.
+    const T &operator()(const std::size_t &xRow, const std::size_t &xCol) const noexcept { return m_Data[xRow * m_Cols + xCol]; }
+    float scale(std::size_t xRow, std::size_t xCol) const noexcept { return m_Scales[group(xRow, xCol)]; }
+    std::int32_t zeroPoint(std::size_t xRow, std::size_t xCol) const noexcept { return m_ZeroPoints[group(xRow, xCol)]; }
+    // Dequantized value.
+    float value(std::size_t xRow, std::size_t xCol) const noexcept
+    {
+        return scale(xRow, xCol) * static_cast<float>(std::int32_t{(*this)(xRow, xCol)} - zeroPoint(xRow, xCol));
+    }
+};
+
+template <typename T>
+template <typename Allocator>
+inline QuantizedMatrix<T> QuantizedMatrix<T>::quantize(const Matrix<float, Allocator> &xMatrix, Quantization xQuantization)
+{
+    QuantizedMatrix tResult;
+    tResult.m_Rows = xMatrix.getRows().get();
+    tResult.m_Cols = xMatrix.getCols().get();
+    tResult.m_Quantization = xQuantization;
+    tResult.m_Data.resize(tResult.m_Rows * tResult.m_Cols);
+
+    const std::size_t tGroups = groups(tResult.m_Rows, tResult.m_Cols, xQuantization);
+    std::vector<float> tLow(tGroups, 0.0f), tHigh(tGroups, 0.0f);
+    for (std::size_t i = 0; i < tResult.m_Rows; i++)
+    {
+        for (std::size_t j = 0; j < tResult.m_Cols; j++)
+        {
+            const std::size_t g = tResult.group(i, j);
+            tLow[g] = std::min(tLow[g], xMatrix(i, j));
+            tHigh[g] = std::max(tHigh[g], xMatrix(i, j));
+        }
+    }
+
+    tResult.m_Scales.resize(tGroups);
+    tResult.m_ZeroPoints.resize(tGroups);
+    for (std::size_t g = 0; g < tGroups; g++)
+    {
+        float tScale = (tHigh[g] - tLow[g]) / static_cast<float>(gMax - gMin);
+        if (!(tScale > 0.0f))
+            tScale = 1.0f;
+        tResult.m_Scales[g] = tScale;
+        tResult.m_ZeroPoints[g] = std::clamp(static_cast<std::int32_t>(std::nearbyint(static_cast<float>(gMin) - tLow[g] / tScale)), gMin, gMax);
+    }
+
+    for (std::size_t i = 0; i < tResult.m_Rows; i++)
+    {
+        for (std::size_t j = 0; j < tResult.m_Cols; j++)
+        {
+            const std::size_t g = tResult.group(i, j);
+            const auto tQuantized = static_cast<std::int32_t>(std::nearbyint(xMatrix(i, j) / tResult.m_Scales[g])) + tResult.m_ZeroPoints[g];
+            tResult.m_Data[i * tResult.m_Cols + j] = static_cast<T>(std::clamp(tQuantized, gMin, gMax));
+        }
+    }
+    return tResult;
+}
+
+template <typename T>
+inline std::optional<QuantizedMatrix<T>> QuantizedMatrix<T>::create(const Row &xRows, const Column &xCols, std::vector<T> xData,
+                                                                    std::vector<float> xScales, std::vector<std::int32_t> xZeroPoints,
+                                                                    Quantization xQuantization)
+{
+    const std::size_t tGroups = groups(xRows.get(), xCols.get(), xQuantization);
+    if (xData.size() != xRows.get() * xCols.get() || xScales.size() != tGroups || xZeroPoints.size() != tGroups)
+        return std::nullopt;
+    for (std::size_t g = 0; g < tGroups; g++)
+        if (!(xScales[g] > 0.0f) || !std::isfinite(xScales[g]) || xZeroPoints[g] < gMin || xZeroPoints[g] > gMax)
+            return std::nullopt;
+
+    QuantizedMatrix tResult;
+    tResult.m_Rows = xRows.get();
+    tResult.m_Cols = xCols.get();
+    tResult.m_Quantization = xQuantization;
+    tResult.m_Data = std::move(xData);
+    tResult.m_Scales = std::move(xScales);
+    tResult.m_ZeroPoints = std::move(xZeroPoints);
+    return tResult;
+}
+
+template <typename T>
+inline Matrix<float> QuantizedMatrix<T>::dequantize() const
+{
+    auto tResult = Matrix<float>::create(Row{m_Rows}, Column{m_Cols});
+    for (std::size_t i = 0; i < m_Rows; i++)
+        for (std::size_t j = 0; j < m_Cols; j++)
+            tResult(i, j) = value(i, j);
+    return tResult;
+}
+
+// Product of two quantized matrices, dequantized into float. The bytes are multiplied with
+// int32 accumulation by Kernels::gemmInt8 on xExecutor; the zero points are then folded in
+// from the row sums of A and the column sums of B:
+//   sum (a - za)(b - zb) = sum ab - zb sum a - za sum b + k za zb.
+// The scales must be constant along the inner dimension, so the left operand is quantized
+// per tensor or per row and the right one per tensor or per column. Returns an empty matrix
+// if that does not hold, if the inner dimensions differ or if they exceed
+// Kernels::gQgemmMaxK.
+template <typename TA, typename TB>
+inline Matrix<float> multiply(const QuantizedMatrix<TA> &xLhs, const QuantizedMatrix<TB> &xRhs, Parallel::Executor &xExecutor)
+{
+    const std::size_t m = xLhs.getRows().get(), k = xLhs.getCols().get(), n = xRhs.getCols().get();
+    if (k != xRhs.getRows().get() || k > Kernels::gQgemmMaxK ||
+        xLhs.getQuantization() == Quantization::PerColumn || xRhs.getQuantization() == Quantization::PerRow)
+        return Matrix<float>::create();
+
+    // The kernel multiplies unsigned by signed bytes. Flipping the top bit turns an int8
+    // operand into uint8 (or the reverse) and moves its zero point by 128, which leaves the
+    // represented values unchanged.
+    std::vector<std::uint8_t> tFlippedA;
+    const std::uint8_t *A = reinterpret_cast<const std::uint8_t *>(xLhs.getData().data());
+    std::int32_t tShiftA{0};
+    if constexpr (std::is_same_v<TA, std::int8_t>)
+    {
+        tFlippedA.resize(m * k);
+        for (std::size_t p = 0; p < m * k; p++)
+            tFlippedA[p] = static_cast<std::uint8_t>(A[p] ^ 0x80u);
+        A = tFlippedA.data();
+        tShiftA = 128;
+    }
+    std::vector<std::int8_t> tFlippedB;
+    const std::int8_t *B = reinterpret_cast<const std::int8_t *>(xRhs.getData().data());
+    std::int32_t tShiftB{0};
+    if constexpr (std::is_same_v<TB, std::uint8_t>)
+    {
+        const auto *tBytes = reinterpret_cast<const std::uint8_t *>(B);
+        tFlippedB.resize(k * n);
+        for (std::size_t p = 0; p < k * n; p++)
+            tFlippedB[p] = static_cast<std::int8_t>(tBytes[p] ^ 0x80u);
+        B = tFlippedB.data();
+        tShiftB = -128;
+    }
+
+    std::vector<std::int32_t> tProduct(m * n);
+    Kernels::gemmInt8(m, n, k, A, k, B, n, tProduct.data(), n, xExecutor);
+
+    std::vector<std::int64_t> tRowSums(m, 0), tColSums(n, 0);
+    for (std::size_t i = 0; i < m; i++)
+        for (std::size_t p = 0; p < k; p++)
+            tRowSums[i] += A[i * k + p];
+    for (std::size_t p = 0; p < k; p++)
+        for (std::size_t j = 0; j < n; j++)
+            tColSums[j] += B[p * n + j];
+
+    auto tResult = Matrix<float>::create(Row{m}, Column{n});
+    float *C = tResult.getData().data();
+    const std::size_t tLdc = tResult.getLeadingDimension();
+    for (std::size_t i = 0; i < m; i++)
+    {
+        const std::int64_t tZeroA = std::int64_t{xLhs.zeroPoint(i, 0)} + tShiftA;
+        const float tScaleA = xLhs.scale(i, 0);
+        for (std::size_t j = 0; j < n; j++)
+        {
+            const std::int64_t tZeroB = std::int64_t{xRhs.zeroPoint(0, j)} + tShiftB;
+            const std::int64_t tSum = tProduct[i * n + j] - tZeroB * tRowSums[i] - tZeroA * tColSums[j] +
+                                      static_cast<std::int64_t>(k) * tZeroA * tZeroB;
+            C[i * tLdc + j] = tScaleA * xRhs.scale(0, j) * static_cast<float>(tSum);
+        }
+    }
+    return tResult;
+}
+
+template <typename TA, typename TB>
+inline Matrix<float> multiply(const QuantizedMatrix<TA> &xLhs, const QuantizedMatrix<TB> &xRhs)
+{
+    return multiply(xLhs, xRhs, Parallel::defaultExecutor());
+}
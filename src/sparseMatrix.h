@@ -0,0 +1,513 @@
+#pragma once
+
+#include "Types/column.h"
+#include "Types/row.h"
+#include "Types/span.h"
+#include "Parallel/threadPool.h"
+#include "matrix.h"
+#include "vector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+enum class SparseFormat
+{
+    CSR, // Compressed rows: offsets per row, column indices
+    CSC  // Compressed columns: offsets per column, row indices
+};
+
+// One (row, column, value) entry used to build a SparseMatrix.
+template <typename T>
+struct Triplet
+{
+    std::size_t m_Row{0};
+    std::size_t m_Col{0};
+    T m_Value{};
+};
+
+namespace Detail
+{
+    // Below this many stored elements the kernels stay on the calling thread.
+    constexpr std::size_t gSparseParallelNonZeros{1UL << 15};
+
+    // Splits [0, xLines) into xParts ranges holding roughly the same number of non-zeros.
+    inline std::vector<std::size_t> balancedSplit(const std::vector<std::size_t> &xOffsets, std::size_t xParts)
+    {
+        const std::size_t tLines = xOffsets.size() - 1;
+        std::vector<std::size_t> tResult{0};
+        for (std::size_t p = 1; p < xParts; p++)
+        {
+            const std::size_t tTarget = xOffsets.back() * p / xParts;
+            const auto tLine = static_cast<std::size_t>(std::lower_bound(xOffsets.cbegin(), xOffsets.cend(), tTarget) - xOffsets.cbegin());
+            tResult.push_back(std::clamp(tLine, tResult.back(), tLines));
+        }
+        tResult.push_back(tLines);
+        return tResult;
+    }
+} // namespace Detail
+
+// Compressed sparse matrix. Within each row (CSR) or column (CSC) the indices are sorted
+// and unique. Products and sums run on Parallel::defaultExecutor() once the matrix is
+// large enough to pay for it.
+template <typename T, SparseFormat Format = SparseFormat::CSR>
+class SparseMatrix
+{
+private:
+    Row m_Rows{};
+    Column m_Columns{};
+    std::vector<std::size_t> m_Offsets{0}; // Size major + 1
+    std::vector<std::size_t> m_Indices{};  // Minor index of every stored element
+    std::vector<T> m_Values{};
+
+    SparseMatrix() noexcept = default;
+    SparseMatrix(const Row &xRows, const Column &xCols);
+
+    std::size_t majorCount() const noexcept { return Format == SparseFormat::CSR ? m_Rows.get() : m_Columns.get(); }
+    std::size_t minorCount() const noexcept { return Format == SparseFormat::CSR ? m_Columns.get() : m_Rows.get(); }
+    static bool parallel(std::size_t xNonZeros) noexcept
+    {
+        return xNonZeros >= Detail::gSparseParallelNonZeros && Parallel::defaultExecutor().concurrency() > 1;
+    }
+
+    template <typename Operation>
+    SparseMatrix combine(const SparseMatrix &xOther, Operation xOperation) const;
+
+public:
+    using value_type = T;
+    static constexpr SparseFormat gFormat{Format};
+
+    static SparseMatrix create();
+    static SparseMatrix create(const Row &xRows, const Column &xCols);
+    // Duplicate positions are summed; throws std::out_of_range for positions outside the shape.
+    static SparseMatrix create(const Row &xRows, const Column &xCols, const std::vector<Triplet<T>> &xTriplets) noexcept(false);
+    // Keeps the elements with |value| > xThreshold.
+    template <typename Allocator>
+    static SparseMatrix create(const Matrix<T, Allocator> &xDense, const T &xThreshold = T{});
+
+    const Row &getRows() const noexcept { return m_Rows; }
+    const Column &getCols() const noexcept { return m_Columns; }
+    std::size_t nonZeros() const noexcept { return m_Values.size(); }
+    Span<const std::size_t> getOffsets() const noexcept { return {m_Offsets.data(), m_Offsets.size()}; }
+    Span<const std::size_t> getIndices() const noexcept { return {m_Indices.data(), m_Indices.size()}; }
+    Span<const T> getValues() const noexcept { return {m_Values.data(), m_Values.size()}; }
+    Span<T> getValues() noexcept { return {m_Values.data(), m_Values.size()}; }
+
+    // Element (i, j), T{} if it is not stored. O(log of the non-zeros in the row/column).
+    T operator()(const std::size_t &xRow, const std::size_t &xCol) const noexcept;
+    T at(const std::size_t &xRow, const std::size_t &xCol) const noexcept(false);
+
+    Matrix<T> toMatrix() const;
+    // Same matrix in the other layout, O(nonZeros).
+    template <SparseFormat Other>
+    SparseMatrix<T, Other> toFormat() const;
+    // The CSR arrays of A are the CSC arrays of its transpose, so this only swaps the shape.
+    SparseMatrix<T, Format == SparseFormat::CSR ? SparseFormat::CSC : SparseFormat::CSR> transposed() const;
+
+    // Sparse x dense vector; an empty Vector if the sizes differ.
+    template <typename Allocator>
+    Vector<T, Allocator> operator*(const Vector<T, Allocator> &xVector) const;
+    // Sparse x dense matrix; an empty Matrix if the inner dimensions differ.
+    template <typename Allocator>
+    Matrix<T, Allocator> operator*(const Matrix<T, Allocator> &xMatrix) const;
+    // Elementwise; a shape mismatch returns *this, like the dense operators.
+    SparseMatrix operator+(const SparseMatrix &xOther) const;
+    SparseMatrix operator-(const SparseMatrix &xOther) const;
+    SparseMatrix &operator*=(const T &xScalar) noexcept;
+
+    bool operator==(const SparseMatrix &xOther) const noexcept;
+    bool operator!=(const SparseMatrix &xOther) const noexcept { return !(*this == xOther); }
+
+    template <typename, SparseFormat>
+    friend class SparseMatrix;
+};
+
+template <typename T>
+using CsrMatrix = SparseMatrix<T, SparseFormat::CSR>;
+template <typename T>
+using CscMatrix = SparseMatrix<T, SparseFormat::CSC>;
+
+template <typename T, SparseFormat Format>
+SparseMatrix<T, Format>::SparseMatrix(const Row &xRows, const Column &xCols)
+    : m_Rows{xRows}, m_Columns{xCols}
+{
+    m_Offsets.assign(majorCount() + 1, 0);
+}
+
+template <typename T, SparseFormat Format>
+inline SparseMatrix<T, Format> SparseMatrix<T, Format>::create()
+{
+    return SparseMatrix{};
+}
+
+template <typename T, SparseFormat Format>
+inline SparseMatrix<T, Format> SparseMatrix<T, Format>::create(const Row &xRows, const Column &xCols)
+{
+    return SparseMatrix{xRows, xCols};
+}
+
+template <typename T, SparseFormat Format>
+inline SparseMatrix<T, Format> SparseMatrix<T, Format>::create(const Row &xRows, const Column &xCols, const std::vector<Triplet<T>> &xTriplets) noexcept(false)
+{
+    SparseMatrix tResult{xRows, xCols};
+    auto tMajor = [](const Triplet<T> &x)
+    { return Format == SparseFormat::CSR ? x.m_Row : x.m_Col; };
+    auto tMinor = [](const Triplet<T> &x)
+    { return Format == SparseFormat::CSR ? x.m_Col : x.m_Row; };
+
+    // Counting sort by major index, then sort and merge each line.
+    for (const auto &tTriplet : xTriplets)
+    {
+        if (tTriplet.m_Row >= xRows.get() || tTriplet.m_Col >= xCols.get())
+            throw std::out_of_range("SparseMatrix::create: (" + std::to_string(tTriplet.m_Row) + ", " + std::to_string(tTriplet.m_Col) + ") is outside of " + xRows.to_string() + "x" + xCols.to_string());
+        tResult.m_Offsets[tMajor(tTriplet) + 1]++;
+    }
+    std::partial_sum(tResult.m_Offsets.cbegin(), tResult.m_Offsets.cend(), tResult.m_Offsets.begin());
+
+    std::vector<std::size_t> tOrder(xTriplets.size());
+    std::vector<std::size_t> tNext(tResult.m_Offsets.cbegin(), tResult.m_Offsets.cend() - 1);
+    for (std::size_t i = 0; i < xTriplets.size(); i++)
+        tOrder[tNext[tMajor(xTriplets[i])]++] = i;
+
+    std::vector<std::size_t> tOffsets(tResult.m_Offsets.size(), 0);
+    tResult.m_Indices.reserve(xTriplets.size());
+    tResult.m_Values.reserve(xTriplets.size());
+    for (std::size_t l = 0; l < tResult.majorCount(); l++)
+    {
+        const auto tBegin = tOrder.begin() + tResult.m_Offsets[l];
+        const auto tEnd = tOrder.begin() + tResult.m_Offsets[l + 1];
+        std::sort(tBegin, tEnd, [&](std::size_t a, std::size_t b)
+                  { return tMinor(xTriplets[a]) < tMinor(xTriplets[b]); });
+        for (auto it = tBegin; it != tEnd; ++it)
+        {
+            const auto &tTriplet = xTriplets[*it];
+            if (tResult.m_Indices.size() > tOffsets[l] && tResult.m_Indices.back() == tMinor(tTriplet))
+            {
+                tResult.m_Values.back() += tTriplet.m_Value;
+            }
+            else
+            {
+                tResult.m_Indices.push_back(tMinor(tTriplet));
+                tResult.m_Values.push_back(tTriplet.m_Value);
+            }
+        }
+        tOffsets[l + 1] = tResult.m_Indices.size();
+    }
+    tResult.m_Offsets = std::move(tOffsets);
+    return tResult;
+}
+
+template <typename T, SparseFormat Format>
+template <typename Allocator>
+inline SparseMatrix<T, Format> SparseMatrix<T, Format>::create(const Matrix<T, Allocator> &xDense, const T &xThreshold)
+{
+    SparseMatrix tResult{xDense.getRows(), xDense.getCols()};
+    auto tKeep = [&xThreshold](const T &xValue)
+    {
+        using std::abs;
+        return abs(xValue) > xThreshold;
+    };
+
+    for (std::size_t l = 0; l < tResult.majorCount(); l++)
+    {
+        for (std::size_t m = 0; m < tResult.minorCount(); m++)
+        {
+            const T &tValue = Format == SparseFormat::CSR ? xDense(l, m) : xDense(m, l);
+            if (tKeep(tValue))
+            {
+                tResult.m_Indices.push_back(m);
+                tResult.m_Values.push_back(tValue);
+            }
+        }
+        tResult.m_Offsets[l + 1] = tResult.m_Indices.size();
+    }
+    return tResult;
+}
+
+template <typename T, SparseFormat Format>
+inline T SparseMatrix<T, Format>::operator()(const std::size_t &xRow, const std::size_t &xCol) const noexcept
+{
+    const std::size_t tMajor = Format == SparseFormat::CSR ? xRow : xCol;
+    const std::size_t tMinor = Format == SparseFormat::CSR ? xCol : xRow;
+    const auto tBegin = m_Indices.cbegin() + m_Offsets[tMajor];
+    const auto tEnd = m_Indices.cbegin() + m_Offsets[tMajor + 1];
+    const auto it = std::lower_bound(tBegin, tEnd, tMinor);
+    if (it == tEnd || *it != tMinor)
+        return T{};
+    return m_Values[static_cast<std::size_t>(it - m_Indices.cbegin())];
+}
+
+template <typename T, SparseFormat Format>
+inline T SparseMatrix<T, Format>::at(const std::size_t &xRow, const std::size_t &xCol) const noexcept(false)
+{
+    if (xRow >= m_Rows.get() || xCol >= m_Columns.get())
+        throw std::out_of_range("SparseMatrix::at: (" + std::to_string(xRow) + ", " + std::to_string(xCol) + ") is outside of " + m_Rows.to_string() + "x" + m_Columns.to_string());
+    return (*this)(xRow, xCol);
+}
+
+template <typename T, SparseFormat Format>
+inline Matrix<T> SparseMatrix<T, Format>::toMatrix() const
+{
+    auto tResult = Matrix<T>::create(m_Rows, m_Columns);
+    for (std::size_t l = 0; l < majorCount(); l++)
+    {
+        for (std::size_t k = m_Offsets[l]; k < m_Offsets[l + 1]; k++)
+        {
+            if constexpr (Format == SparseFormat::CSR)
+                tResult(l, m_Indices[k]) = m_Values[k];
+            else
+                tResult(m_Indices[k], l) = m_Values[k];
+        }
+    }
+    return tResult;
+}
+
+template <typename T, SparseFormat Format>
+template <SparseFormat Other>
+inline SparseMatrix<T, Other> SparseMatrix<T, Format>::toFormat() const
+{
+    if constexpr (Other == Format)
+    {
+        return *this;
+    }
+    else
+    {
+        // Transposing the compressed arrays: count per minor index, then scatter. Walking
+        // the major lines in order keeps the new minor indices sorted.
+        SparseMatrix<T, Other> tResult{m_Rows, m_Columns};
+        for (const auto tIndex : m_Indices)
+            tResult.m_Offsets[tIndex + 1]++;
+        std::partial_sum(tResult.m_Offsets.cbegin(), tResult.m_Offsets.cend(), tResult.m_Offsets.begin());
+
+        tResult.m_Indices.resize(nonZeros());
+        tResult.m_Values.resize(nonZeros());
+        std::vector<std::size_t> tNext(tResult.m_Offsets.cbegin(), tResult.m_Offsets.cend() - 1);
+        for (std::size_t l = 0; l < majorCount(); l++)
+        {
+            for (std::size_t k = m_Offsets[l]; k < m_Offsets[l + 1]; k++)
+            {
+                const std::size_t tPos = tNext[m_Indices[k]]++;
+                tResult.m_Indices[tPos] = l;
+                tResult.m_Values[tPos] = m_Values[k];
+            }
+        }
+        return tResult;
+    }
+}
+
+template <typename T, SparseFormat Format>
+inline SparseMatrix<T, Format == SparseFormat::CSR ? SparseFormat::CSC : SparseFormat::CSR> SparseMatrix<T, Format>::transposed() const
+{
+    SparseMatrix<T, Format == SparseFormat::CSR ? SparseFormat::CSC : SparseFormat::CSR> tResult;
+    tResult.m_Rows = m_Columns.get();
+    tResult.m_Columns = m_Rows.get();
+    tResult.m_Offsets = m_Offsets;
+    tResult.m_Indices = m_Indices;
+    tResult.m_Values = m_Values;
+    return tResult;
+}
+
+template <typename T, SparseFormat Format>
+template <typename Allocator>
+inline Vector<T, Allocator> SparseMatrix<T, Format>::operator*(const Vector<T, Allocator> &xVector) const
+{
+    if (xVector.size() != m_Columns.get())
+        return Vector<T, Allocator>::create();
+
+    auto tResult = Vector<T, Allocator>::create(m_Rows, xVector.get_allocator());
+    const T *tX = xVector.getData().data();
+    T *tY = tResult.getData().data();
+    const std::size_t tParts = parallel(nonZeros()) ? Parallel::defaultExecutor().concurrency() : 1;
+    const auto tSplit = Detail::balancedSplit(m_Offsets, tParts);
+
+    if constexpr (Format == SparseFormat::CSR)
+    {
+        // Every row is an independent dot product.
+        auto tRows = [&](std::size_t xPart)
+        {
+            for (std::size_t i = tSplit[xPart]; i < tSplit[xPart + 1]; i++)
+            {
+                T tSum{};
+                for (std::size_t k = m_Offsets[i]; k < m_Offsets[i + 1]; k++)
+                    tSum += m_Values[k] * tX[m_Indices[k]];
+                tY[i] = tSum;
+            }
+        };
+        if (tParts > 1)
+            Parallel::defaultExecutor().parallelFor(tParts, tRows);
+        else
+            tRows(0);
+    }
+    else
+    {
+        // Columns scatter into y, so every part accumulates into its own buffer and the
+        // buffers are summed afterwards.
+        std::vector<std::vector<T>> tPartial(tParts - 1, std::vector<T>(m_Rows.get(), T{}));
+        auto tColumns = [&](std::size_t xPart)
+        {
+            T *tOut = xPart == 0 ? tY : tPartial[xPart - 1].data();
+            for (std::size_t j = tSplit[xPart]; j < tSplit[xPart + 1]; j++)
+            {
+                const T tXj = tX[j];
+                for (std::size_t k = m_Offsets[j]; k < m_Offsets[j + 1]; k++)
+                    tOut[m_Indices[k]] += m_Values[k] * tXj;
+            }
+        };
+        if (tParts > 1)
+        {
+            Parallel::defaultExecutor().parallelFor(tParts, tColumns);
+            for (const auto &tBuffer : tPartial)
+                Kernels::add(tY, tBuffer.data(), tY, m_Rows.get());
+        }
+        else
+        {
+            tColumns(0);
+        }
+    }
+    return tResult;
+}
+
+template <typename T, SparseFormat Format>
+template <typename Allocator>
+inline Matrix<T, Allocator> SparseMatrix<T, Format>::operator*(const Matrix<T, Allocator> &xMatrix) const
+{
+    if (xMatrix.getRows().get() != m_Columns.get())
+        return Matrix<T, Allocator>::create(xMatrix.get_allocator());
+
+    if constexpr (Format == SparseFormat::CSC)
+    {
+        // Row i of the result needs row i of A, so the product runs on the CSR layout.
+        return toFormat<SparseFormat::CSR>() * xMatrix;
+    }
+    else
+    {
+        auto tResult = Matrix<T, Allocator>::create(m_Rows, xMatrix.getCols(), xMatrix.get_allocator());
+        const std::size_t tCols = xMatrix.getCols().get();
+        const std::size_t tParts = parallel(nonZeros() * std::max<std::size_t>(tCols / 8, 1)) ? Parallel::defaultExecutor().concurrency() : 1;
+        const auto tSplit = Detail::balancedSplit(m_Offsets, tParts);
+
+        // C(i, :) += A(i, k) * B(k, :), streaming whole rows of B.
+        auto tRows = [&](std::size_t xPart)
+        {
+            for (std::size_t i = tSplit[xPart]; i < tSplit[xPart + 1]; i++)
+            {
+                T *tOut = tResult.getRow(i).data();
+                for (std::size_t k = m_Offsets[i]; k < m_Offsets[i + 1]; k++)
+                {
+                    const T tA = m_Values[k];
+                    const T *tB = xMatrix.getRow(m_Indices[k]).data();
+                    for (std::size_t j = 0; j < tCols; j++)
+                        tOut[j] += tA * tB[j];
+                }
+            }
+        };
+        if (tParts > 1)
+            Parallel::defaultExecutor().parallelFor(tParts, tRows);
+        else
+            tRows(0);
+        return tResult;
+    }
+}
+
+template <typename T, SparseFormat Format>
+template <typename Operation>
+inline SparseMatrix<T, Format> SparseMatrix<T, Format>::combine(const SparseMatrix &xOther, Operation xOperation) const
+{
+    if (m_Rows.get() != xOther.m_Rows.get() || m_Columns.get() != xOther.m_Columns.get())
+        return *this;
+
+    // Two passes over sorted index lists: count the union per line, then merge into the
+    // final positions. Both passes are independent per line.
+    SparseMatrix tResult{m_Rows, m_Columns};
+    const std::size_t tLines = majorCount();
+    const std::size_t tParts = parallel(nonZeros() + xOther.nonZeros()) ? Parallel::defaultExecutor().concurrency() : 1;
+    const auto tSplit = Detail::balancedSplit(m_Offsets, tParts);
+
+    auto tMerge = [&](std::size_t xLine, auto xEmit)
+    {
+        std::size_t a = m_Offsets[xLine], b = xOther.m_Offsets[xLine];
+        const std::size_t tEndA = m_Offsets[xLine + 1], tEndB = xOther.m_Offsets[xLine + 1];
+        while (a < tEndA || b < tEndB)
+        {
+            if (b == tEndB || (a < tEndA && m_Indices[a] < xOther.m_Indices[b]))
+            {
+                xEmit(m_Indices[a], xOperation(m_Values[a], T{}));
+                a++;
+            }
+            else if (a == tEndA || xOther.m_Indices[b] < m_Indices[a])
+            {
+                xEmit(xOther.m_Indices[b], xOperation(T{}, xOther.m_Values[b]));
+                b++;
+            }
+            else
+            {
+                xEmit(m_Indices[a], xOperation(m_Values[a], xOther.m_Values[b]));
+                a++;
+                b++;
+            }
+        }
+    };
+    auto tRun = [&](auto xBody)
+    {
+        auto tPart = [&](std::size_t xPart)
+        {
+            for (std::size_t l = tSplit[xPart]; l < tSplit[xPart + 1]; l++)
+                xBody(l);
+        };
+        if (tParts > 1)
+            Parallel::defaultExecutor().parallelFor(tParts, tPart);
+        else
+            tPart(0);
+    };
+
+    tRun([&](std::size_t xLine)
+         {
+             std::size_t tCount{0};
+             tMerge(xLine, [&](std::size_t, const T &) { tCount++; });
+             tResult.m_Offsets[xLine + 1] = tCount; });
+    std::partial_sum(tResult.m_Offsets.cbegin(), tResult.m_Offsets.cend(), tResult.m_Offsets.begin());
+
+    tResult.m_Indices.resize(tResult.m_Offsets[tLines]);
+    tResult.m_Values.resize(tResult.m_Offsets[tLines]);
+    tRun([&](std::size_t xLine)
+         {
+             std::size_t tPos = tResult.m_Offsets[xLine];
+             tMerge(xLine, [&](std::size_t xIndex, const T &xValue)
+                    {
+                        tResult.m_Indices[tPos] = xIndex;
+                        tResult.m_Values[tPos] = xValue;
+                        tPos++; }); });
+    return tResult;
+}
+
+template <typename T, SparseFormat Format>
+inline SparseMatrix<T, Format> SparseMatrix<T, Format>::operator+(const SparseMatrix &xOther) const
+{
+    return combine(xOther, std::plus<>{});
+}
+
+template <typename T, SparseFormat Format>
+inline SparseMatrix<T, Format> SparseMatrix<T, Format>::operator-(const SparseMatrix &xOther) const
+{
+    return combine(xOther, std::minus<>{});
+}
+
+template <typename T, SparseFormat Format>
+inline SparseMatrix<T, Format> &SparseMatrix<T, Format>::operator*=(const T &xScalar) noexcept
+{
+    Kernels::multiplyScalar(m_Values.data(), xScalar, m_Values.data(), m_Values.size());
+    return *this;
+}
+
+template <typename T, SparseFormat Format>
+inline bool SparseMatrix<T, Format>::operator==(const SparseMatrix &xOther) const noexcept
+{
+    return m_Rows.get() == xOther.m_Rows.get() && m_Columns.get() == xOther.m_Columns.get() &&
+           m_Offsets == xOther.m_Offsets && m_Indices == xOther.m_Indices && m_Values == xOther.m_Values;
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "matrix.h"
+#include "Types/column.h"
+#include "Types/row.h"
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// Fixed size R x C matrix with inline, row-major storage. Every operation is
+// constexpr and unrolled at compile time; shapes are checked by the type system.
+template <typename T, std::size_t R, std::size_t C>
+class StaticMatrix
+{
+    static_assert(R > 0 && C > 0, "StaticMatrix needs at least one row and one column");
+
+private:
+    std::array<T, R * C> m_Data{};
+
+    template <typename Operation, std::size_t... I>
+    static constexpr StaticMatrix elementwise(const StaticMatrix &xLhs, const StaticMatrix &xRhs, Operation xOperation, std::index_sequence<I...>) noexcept
+    {
+        StaticMatrix tResult;
+        ((tResult.m_Data[I] = xOperation(xLhs.m_Data[I], xRhs.m_Data[I])), ...);
+        return tResult;
+    }
+
+    template <typename Operation, std::size_t... I>
+    static constexpr StaticMatrix elementwise(const StaticMatrix &xLhs, const T &xScalar, Operation xOperation, std::index_sequence<I...>) noexcept
+    {
+        StaticMatrix tResult;
+        ((tResult.m_Data[I] = xOperation(xLhs.m_Data[I], xScalar)), ...);
+        return tResult;
+    }
+
+    template <std::size_t I, std::size_t J, std::size_t K, std::size_t... P>
+    static constexpr T dot(const StaticMatrix &xLhs, const StaticMatrix<T, C, K> &xRhs, std::index_sequence<P...>) noexcept
+    {
+        return ((xLhs.m_Data[I * C + P] * xRhs(P, J)) + ...);
+    }
+
+    template <std::size_t K, std::size_t... I>
+    static constexpr StaticMatrix<T, R, K> product(const StaticMatrix &xLhs, const StaticMatrix<T, C, K> &xRhs, std::index_sequence<I...>) noexcept
+    {
+        StaticMatrix<T, R, K> tResult;
+        ((tResult(I / K, I % K) = dot<I / K, I % K, K>(xLhs, xRhs, std::make_index_sequence<C>{})), ...);
+        return tResult;
+    }
+
+    template <std::size_t... I>
+    constexpr StaticMatrix<T, C, R> transposed(std::index_sequence<I...>) const noexcept
+    {
+        StaticMatrix<T, C, R> tResult;
+        ((tResult(I % C, I / C) = m_Data[I]), ...);
+        return tResult;
+    }
+
+    template <std::size_t... I>
+    constexpr bool equal(const StaticMatrix &xOther, std::index_sequence<I...>) const noexcept
+    {
+        return ((m_Data[I] == xOther.m_Data[I]) && ...);
+    }
+
+    using Indices = std::make_index_sequence<R * C>;
+
+public:
+    using value_type = T;
+
+    constexpr StaticMatrix() noexcept = default;
+
+    static constexpr StaticMatrix create() noexcept { return StaticMatrix{}; }
+    static constexpr StaticMatrix create(const std::array<T, R * C> &xData) noexcept
+    {
+        StaticMatrix tResult;
+        tResult.m_Data = xData;
+        return tResult;
+    }
+    static constexpr StaticMatrix identity() noexcept
+    {
+        static_assert(R == C, "Only square matrices have an identity");
+        StaticMatrix tResult;
+        for (std::size_t i = 0; i < R; i++)
+            tResult.m_Data[i * C + i] = static_cast<T>(1);
+        return tResult;
+    }
+    // Explicit conversion from the dynamic Matrix; std::nullopt if the shapes differ.
+    template <typename Allocator>
+    static std::optional<StaticMatrix> create(const Matrix<T, Allocator> &xMatrix)
+    {
+        if (xMatrix.getRows().get() != R || xMatrix.getCols().get() != C)
+            return std::nullopt;
+
+        StaticMatrix tResult;
+        for (std::size_t i = 0; i < R; i++)
+            for (std::size_t j = 0; j < C; j++)
+                tResult.m_Data[i * C + j] = xMatrix(i, j);
+        return tResult;
+    }
+
+    Matrix<T> toMatrix() const
+    {
+        auto tResult = Matrix<T>::create(Row{R}, Column{C});
+        for (std::size_t i = 0; i < R; i++)
+            for (std::size_t j = 0; j < C; j++)
+                tResult(i, j) = m_Data[i * C + j];
+        return tResult;
+    }
+    explicit operator Matrix<T>() const { return toMatrix(); }
+
+    static constexpr Row getRows() noexcept { return Row{R}; }
+    static constexpr Column getCols() noexcept { return Column{C}; }
+    constexpr const std::array<T, R * C> &getData() const noexcept { return m_Data; }
+    constexpr std::array<T, R * C> &getData() noexcept { return m_Data; }
+
+    constexpr const T &operator()(const std::size_t &xRow, const std::size_t &xCol) const noexcept { return m_Data[xRow * C + xCol]; }
+    constexpr T &operator()(const std::size_t &xRow, const std::size_t &xCol) noexcept { return m_Data[xRow * C + xCol]; }
+    constexpr const T &at(const std::size_t &xRow, const std::size_t &xCol) const noexcept(false)
+    {
+        if (xRow >= R || xCol >= C)
+            throw std::out_of_range("StaticMatrix::at: (" + std::to_string(xRow) + ", " + std::to_string(xCol) + ") is outside of " + std::to_string(R) + "x" + std::to_string(C));
+        return m_Data[xRow * C + xCol];
+    }
+    constexpr T &at(const std::size_t &xRow, const std::size_t &xCol) noexcept(false)
+    {
+        return const_cast<T &>(static_cast<const StaticMatrix &>(*this).at(xRow, xCol));
+    }
+
+    constexpr StaticMatrix<T, C, R> transposed() const noexcept { return transposed(Indices{}); }
+
+    constexpr StaticMatrix operator+(const StaticMatrix &xOther) const noexcept { return elementwise(*this, xOther, std::plus<>{}, Indices{}); }
+    constexpr StaticMatrix operator-(const StaticMatrix &xOther) const noexcept { return elementwise(*this, xOther, std::minus<>{}, Indices{}); }
+    constexpr StaticMatrix operator+(const T &xScalar) const noexcept { return elementwise(*this, xScalar, std::plus<>{}, Indices{}); }
+    constexpr StaticMatrix operator-(const T &xScalar) const noexcept { return elementwise(*this, xScalar, std::minus<>{}, Indices{}); }
+    constexpr StaticMatrix operator*(const T &xScalar) const noexcept { return elementwise(*this, xScalar, std::multiplies<>{}, Indices{}); }
+
+    template <std::size_t R2, std::size_t K>
+    constexpr StaticMatrix<T, R, K> operator*(const StaticMatrix<T, R2, K> &xOther) const noexcept
+    {
+        static_assert(R2 == C, "StaticMatrix product: left columns must equal right rows");
+        return product<K>(*this, xOther, std::make_index_sequence<R * K>{});
+    }
+
+    constexpr StaticMatrix &operator+=(const StaticMatrix &xOther) noexcept { return *this = *this + xOther; }
+    constexpr StaticMatrix &operator-=(const StaticMatrix &xOther) noexcept { return *this = *this - xOther; }
+    constexpr StaticMatrix &operator+=(const T &xScalar) noexcept { return *this = *this + xScalar; }
+    constexpr StaticMatrix &operator-=(const T &xScalar) noexcept { return *this = *this - xScalar; }
+    constexpr StaticMatrix &operator*=(const T &xScalar) noexcept { return *this = *this * xScalar; }
+    template <std::size_t R2, std::size_t C2>
+    constexpr StaticMatrix &operator*=(const StaticMatrix<T, R2, C2> &xOther) noexcept
+    {
+        static_assert(R2 == C && C2 == C, "StaticMatrix *= needs a square right operand matching the columns");
+        return *this = *this * xOther;
+    }
+
+    constexpr bool operator==(const StaticMatrix &xOther) const noexcept { return equal(xOther, Indices{}); }
+    constexpr bool operator!=(const StaticMatrix &xOther) const noexcept { return !(*this == xOther); }
+};
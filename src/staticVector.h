@@ -0,0 +1,275 @@
+#pragma once
+
+#include "vector.h"
+#include "Types/row.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATRIX_STATIC_VECTOR_SSE2 1
+#include <immintrin.h>
+#endif
+
+namespace Detail
+{
+    template <typename T, std::size_t N>
+    constexpr bool gStaticVectorPacked = (std::is_same_v<T, float> || std::is_same_v<T, double>) && N >= 2 && N <= 4;
+
+    // 3-vectors of float/double are padded to 4 lanes, so they fill one SSE/AVX register.
+    template <typename T, std::size_t N>
+    constexpr std::size_t gStaticVectorStorage = (gStaticVectorPacked<T, N> && N == 3) ? 4 : N;
+
+    template <typename T, std::size_t N>
+    constexpr std::size_t gStaticVectorAlignment = gStaticVectorPacked<T, N> ? sizeof(T) * gStaticVectorStorage<T, N> : alignof(T);
+
+#if MATRIX_STATIC_VECTOR_SSE2
+    // A float 2-vector fills the low half of an SSE register; the upper lanes load as zero.
+    inline __m128 loadFloat2(const float *xData) noexcept
+    {
+        return _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64 *>(xData));
+    }
+
+    inline void storeFloat2(float *xData, __m128 xValue) noexcept
+    {
+        _mm_storel_pi(reinterpret_cast<__m64 *>(xData), xValue);
+    }
+#endif
+} // namespace Detail
+
+// Fixed size vector with inline storage. For float and double with N = 2, 3 and 4
+// dotProduct, crossProduct, magnitude and normalize use packed SSE/AVX arithmetic;
+// the padding lane of 3-vectors is kept at zero.
+template <typename T, std::size_t N>
+class StaticVector
+{
+    static_assert(N > 0, "StaticVector needs at least one element");
+
+private:
+    static constexpr std::size_t gStorage = Detail::gStaticVectorStorage<T, N>;
+
+    alignas(Detail::gStaticVectorAlignment<T, N>) std::array<T, gStorage> m_Data{};
+
+    template <typename Operation>
+    constexpr StaticVector apply(const StaticVector &xOther, Operation xOperation) const noexcept
+    {
+        StaticVector tResult;
+        for (std::size_t i = 0; i < gStorage; i++)
+            tResult.m_Data[i] = xOperation(m_Data[i], xOther.m_Data[i]);
+        return tResult;
+    }
+
+    template <typename Operation>
+    constexpr StaticVector apply(const T &xScalar, Operation xOperation) const noexcept
+    {
+        StaticVector tResult;
+        for (std::size_t i = 0; i < N; i++)
+            tResult.m_Data[i] = xOperation(m_Data[i], xScalar);
+        return tResult;
+    }
+
+public:
+    using value_type = T;
+
+    constexpr StaticVector() noexcept = default;
+
+    static constexpr StaticVector create() noexcept { return StaticVector{}; }
+    static constexpr StaticVector create(const std::array<T, N> &xData) noexcept
+    {
+        StaticVector tResult;
+        for (std::size_t i = 0; i < N; i++)
+            tResult.m_Data[i] = xData[i];
+        return tResult;
+    }
+    // Explicit conversion from the dynamic Vector; std::nullopt if the sizes differ.
+    template <typename Allocator>
+    static std::optional<StaticVector> create(const Vector<T, Allocator> &xVector)
+    {
+        if (xVector.size() != N)
+            return std::nullopt;
+
+        StaticVector tResult;
+        for (std::size_t i = 0; i < N; i++)
+            tResult.m_Data[i] = xVector[i];
+        return tResult;
+    }
+
+    Vector<T> toVector() const
+    {
+        return Vector<T>::create(std::vector<T>(m_Data.cbegin(), m_Data.cbegin() + N));
+    }
+    explicit operator Vector<T>() const { return toVector(); }
+
+    static constexpr Row getRows() noexcept { return Row{N}; }
+    static constexpr std::size_t size() noexcept { return N; }
+    constexpr const T *data() const noexcept { return m_Data.data(); }
+    constexpr T *data() noexcept { return m_Data.data(); }
+
+    constexpr const T &operator[](const std::size_t &xPos) const noexcept { return m_Data[xPos]; }
+    constexpr T &operator[](const std::size_t &xPos) noexcept { return m_Data[xPos]; }
+    constexpr const T &at(const std::size_t &xPos) const noexcept(false)
+    {
+        if (xPos >= N)
+            throw std::out_of_range("StaticVector::at: " + std::to_string(xPos) + " >= " + std::to_string(N));
+        return m_Data[xPos];
+    }
+    constexpr T &at(const std::size_t &xPos) noexcept(false)
+    {
+        return const_cast<T &>(static_cast<const StaticVector &>(*this).at(xPos));
+    }
+
+    constexpr const T *begin() const noexcept { return m_Data.data(); }
+    constexpr const T *end() const noexcept { return m_Data.data() + N; }
+    constexpr T *begin() noexcept { return m_Data.data(); }
+    constexpr T *end() noexcept { return m_Data.data() + N; }
+
+    // Vector math
+    T dotProduct(const StaticVector &xOther) const noexcept;
+    StaticVector crossProduct(const StaticVector &xOther) const noexcept;
+    T magnitude() const noexcept;
+    void normalize() noexcept;
+
+    constexpr StaticVector operator+(const StaticVector &xOther) const noexcept { return apply(xOther, std::plus<>{}); }
+    constexpr StaticVector operator-(const StaticVector &xOther) const noexcept { return apply(xOther, std::minus<>{}); }
+    constexpr StaticVector operator+(const T &xScalar) const noexcept { return apply(xScalar, std::plus<>{}); }
+    constexpr StaticVector operator-(const T &xScalar) const noexcept { return apply(xScalar, std::minus<>{}); }
+    constexpr StaticVector operator*(const T &xScalar) const noexcept { return apply(xScalar, std::multiplies<>{}); }
+    constexpr StaticVector &operator+=(const StaticVector &xOther) noexcept { return *this = *this + xOther; }
+    constexpr StaticVector &operator-=(const StaticVector &xOther) noexcept { return *this = *this - xOther; }
+    constexpr StaticVector &operator+=(const T &xScalar) noexcept { return *this = *this + xScalar; }
+    constexpr StaticVector &operator-=(const T &xScalar) noexcept { return *this = *this - xScalar; }
+    constexpr StaticVector &operator*=(const T &xScalar) noexcept { return *this = *this * xScalar; }
+
+    constexpr bool operator==(const StaticVector &xOther) const noexcept
+    {
+        for (std::size_t i = 0; i < N; i++)
+            if (m_Data[i] != xOther.m_Data[i])
+                return false;
+        return true;
+    }
+    constexpr bool operator!=(const StaticVector &xOther) const noexcept { return !(*this == xOther); }
+};
+
+template <typename T, std::size_t N>
+inline T StaticVector<T, N>::dotProduct(const StaticVector &xOther) const noexcept
+{
+#if MATRIX_STATIC_VECTOR_SSE2
+    if constexpr (std::is_same_v<T, float> && gStorage == 4)
+    {
+        const __m128 tProduct = _mm_mul_ps(_mm_load_ps(m_Data.data()), _mm_load_ps(xOther.m_Data.data()));
+        const __m128 tPairs = _mm_add_ps(tProduct, _mm_movehl_ps(tProduct, tProduct));
+        return _mm_cvtss_f32(_mm_add_ss(tPairs, _mm_shuffle_ps(tPairs, tPairs, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+    else if constexpr (std::is_same_v<T, float> && gStorage == 2)
+    {
+        const __m128 tProduct = _mm_mul_ps(Detail::loadFloat2(m_Data.data()), Detail::loadFloat2(xOther.m_Data.data()));
+        return _mm_cvtss_f32(_mm_add_ss(tProduct, _mm_shuffle_ps(tProduct, tProduct, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+    else if constexpr (std::is_same_v<T, double> && gStorage == 2)
+    {
+        const __m128d tProduct = _mm_mul_pd(_mm_load_pd(m_Data.data()), _mm_load_pd(xOther.m_Data.data()));
+        return _mm_cvtsd_f64(_mm_add_sd(tProduct, _mm_unpackhi_pd(tProduct, tProduct)));
+    }
+    else if constexpr (std::is_same_v<T, double> && gStorage == 4)
+    {
+#if defined(__AVX__)
+        const __m256d tProduct = _mm256_mul_pd(_mm256_load_pd(m_Data.data()), _mm256_load_pd(xOther.m_Data.data()));
+        const __m128d tPairs = _mm_add_pd(_mm256_castpd256_pd128(tProduct), _mm256_extractf128_pd(tProduct, 1));
+#else
+        const __m128d tPairs = _mm_add_pd(_mm_mul_pd(_mm_load_pd(m_Data.data()), _mm_load_pd(xOther.m_Data.data())),
+                                          _mm_mul_pd(_mm_load_pd(m_Data.data() + 2), _mm_load_pd(xOther.m_Data.data() + 2)));
+#endif
+        return _mm_cvtsd_f64(_mm_add_sd(tPairs, _mm_unpackhi_pd(tPairs, tPairs)));
+    }
+    else
+#endif
+    {
+        T tResult{};
+        for (std::size_t i = 0; i < N; i++)
+            tResult += m_Data[i] * xOther.m_Data[i];
+        return tResult;
+    }
+}
+
+template <typename T, std::size_t N>
+inline StaticVector<T, N> StaticVector<T, N>::crossProduct(const StaticVector &xOther) const noexcept
+{
+    static_assert(N == 3, "The cross product is only defined for 3-vectors");
+
+    StaticVector tResult;
+#if MATRIX_STATIC_VECTOR_SSE2
+    if constexpr (std::is_same_v<T, float>)
+    {
+        // a.yzx * b.zxy - a.zxy * b.yzx; the zero padding lane stays zero.
+        const __m128 tA = _mm_load_ps(m_Data.data());
+        const __m128 tB = _mm_load_ps(xOther.m_Data.data());
+        const __m128 tAyzx = _mm_shuffle_ps(tA, tA, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 tByzx = _mm_shuffle_ps(tB, tB, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 tAzxy = _mm_shuffle_ps(tA, tA, _MM_SHUFFLE(3, 1, 0, 2));
+        const __m128 tBzxy = _mm_shuffle_ps(tB, tB, _MM_SHUFFLE(3, 1, 0, 2));
+        _mm_store_ps(tResult.m_Data.data(), _mm_sub_ps(_mm_mul_ps(tAyzx, tBzxy), _mm_mul_ps(tAzxy, tByzx)));
+        return tResult;
+    }
+#if defined(__AVX2__)
+    else if constexpr (std::is_same_v<T, double>)
+    {
+        const __m256d tA = _mm256_load_pd(m_Data.data());
+        const __m256d tB = _mm256_load_pd(xOther.m_Data.data());
+        const __m256d tAyzx = _mm256_permute4x64_pd(tA, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m256d tByzx = _mm256_permute4x64_pd(tB, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m256d tAzxy = _mm256_permute4x64_pd(tA, _MM_SHUFFLE(3, 1, 0, 2));
+        const __m256d tBzxy = _mm256_permute4x64_pd(tB, _MM_SHUFFLE(3, 1, 0, 2));
+        _mm256_store_pd(tResult.m_Data.data(), _mm256_sub_pd(_mm256_mul_pd(tAyzx, tBzxy), _mm256_mul_pd(tAzxy, tByzx)));
+        return tResult;
+    }
+#endif
+#endif
+    tResult.m_Data[0] = m_Data[1] * xOther.m_Data[2] - m_Data[2] * xOther.m_Data[1];
+    tResult.m_Data[1] = m_Data[2] * xOther.m_Data[0] - m_Data[0] * xOther.m_Data[2];
+    tResult.m_Data[2] = m_Data[0] * xOther.m_Data[1] - m_Data[1] * xOther.m_Data[0];
+    return tResult;
+}
+
+template <typename T, std::size_t N>
+inline T StaticVector<T, N>::magnitude() const noexcept
+{
+    return static_cast<T>(std::sqrt(dotProduct(*this)));
+}
+
+template <typename T, std::size_t N>
+inline void StaticVector<T, N>::normalize() noexcept
+{
+    const T tMagnitude = magnitude();
+#if MATRIX_STATIC_VECTOR_SSE2
+    if constexpr (std::is_same_v<T, float> && gStorage == 4)
+    {
+        _mm_store_ps(m_Data.data(), _mm_div_ps(_mm_load_ps(m_Data.data()), _mm_set1_ps(tMagnitude)));
+        return;
+    }
+    else if constexpr (std::is_same_v<T, float> && gStorage == 2)
+    {
+        Detail::storeFloat2(m_Data.data(), _mm_div_ps(Detail::loadFloat2(m_Data.data()), _mm_set1_ps(tMagnitude)));
+        return;
+    }
+    else if constexpr (std::is_same_v<T, double> && gStorage == 2)
+    {
+        _mm_store_pd(m_Data.data(), _mm_div_pd(_mm_load_pd(m_Data.data()), _mm_set1_pd(tMagnitude)));
+        return;
+    }
+#if defined(__AVX__)
+    else if constexpr (std::is_same_v<T, double> && gStorage == 4)
+    {
+        _mm256_store_pd(m_Data.data(), _mm256_div_pd(_mm256_load_pd(m_Data.data()), _mm256_set1_pd(tMagnitude)));
+        return;
+    }
+#endif
+#endif
+    for (std::size_t i = 0; i < N; i++)
+        m_Data[i] /= tMagnitude;
+}
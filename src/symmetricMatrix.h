@@ -0,0 +1,200 @@
+#pragma once
+
+#include "matrix.h"
+#include "vector.h"
+#include "Kernels/simd.h"
+#include "Types/column.h"
+#include "Types/row.h"
+#include "Types/span.h"
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// n x n symmetric matrix storing only the lower triangle, packed row by row:
+// (i, j) with j <= i lives at i * (i + 1) / 2 + j. (i, j) and (j, i) are the same element.
+template <typename T>
+class SymmetricMatrix
+{
+private:
+    std::size_t m_Size{0};
+    std::vector<T> m_Data{};
+
+    explicit SymmetricMatrix(std::size_t xSize)
+        : m_Size{xSize}, m_Data(xSize * (xSize + 1) / 2)
+    {
+    }
+
+    static constexpr std::size_t index(std::size_t xRow, std::size_t xCol) noexcept
+    {
+        return xRow >= xCol ? xRow * (xRow + 1) / 2 + xCol : xCol * (xCol + 1) / 2 + xRow;
+    }
+
+public:
+    using value_type = T;
+
+    SymmetricMatrix() noexcept = default;
+
+    static SymmetricMatrix create(std::size_t xSize = 0) { return SymmetricMatrix{xSize}; }
+    // Lower triangle of a square matrix; std::nullopt if xMatrix is not square.
+    // The upper triangle is not checked.
+    template <typename Allocator>
+    static std::optional<SymmetricMatrix> create(const Matrix<T, Allocator> &xMatrix);
+
+    std::size_t size() const noexcept { return m_Size; }
+    Row getRows() const noexcept { return Row{m_Size}; }
+    Column getCols() const noexcept { return Column{m_Size}; }
+    // Packed lower triangle.
+    Span<const T> getData() const noexcept { return {m_Data.data(), m_Data.size()}; }
+    Span<T> getData() noexcept { return {m_Data.data(), m_Data.size()}; }
+    // Stored part of row i: columns 0 ... i.
+    Span<T> getRow(std::size_t xRow) noexcept { return {m_Data.data() + index(xRow, 0), xRow + 1}; }
+    Span<const T> getRow(std::size_t xRow) const noexcept { return {m_Data.data() + index(xRow, 0), xRow + 1}; }
+
+    const T &operator()(const std::size_t &xRow, const std::size_t &xCol) const noexcept { return m_Data[index(xRow, xCol)]; }
+    T &operator()(const std::size_t &xRow, const std::size_t &xCol) noexcept { return m_Data[index(xRow, xCol)]; }
+    const T &at(const std::size_t &xRow, const std::size_t &xCol) const noexcept(false)
+    {
+        if (xRow >= m_Size || xCol >= m_Size)
+            throw std::out_of_range("SymmetricMatrix::at: (" + std::to_string(xRow) + ", " + std::to_string(xCol) + ") is outside of " + std::to_string(m_Size) + "x" + std::to_string(m_Size));
+        return (*this)(xRow, xCol);
+    }
+    T &at(const std::size_t &xRow, const std::size_t &xCol) noexcept(false)
+    {
+        return const_cast<T &>(static_cast<const SymmetricMatrix &>(*this).at(xRow, xCol));
+    }
+
+    Matrix<T> toMatrix() const;
+    // A symmetric matrix is its own transpose.
+    const SymmetricMatrix &transposed() const noexcept { return *this; }
+
+    // Elementwise on the packed triangles; a size mismatch leaves *this unchanged.
+    SymmetricMatrix &operator+=(const SymmetricMatrix &xOther) noexcept;
+    SymmetricMatrix &operator-=(const SymmetricMatrix &xOther) noexcept;
+    SymmetricMatrix &operator*=(const T &xScalar) noexcept;
+    SymmetricMatrix operator+(const SymmetricMatrix &xOther) const { return SymmetricMatrix{*this} += xOther; }
+    SymmetricMatrix operator-(const SymmetricMatrix &xOther) const { return SymmetricMatrix{*this} -= xOther; }
+    SymmetricMatrix operator*(const T &xScalar) const { return SymmetricMatrix{*this} *= xScalar; }
+
+    // Every stored element is read once and used for both (i, j) and (j, i).
+    // Empty result if the sizes differ.
+    template <typename Allocator>
+    Vector<T, Allocator> operator*(const Vector<T, Allocator> &xVector) const;
+    template <typename Allocator>
+    Matrix<T, Allocator> operator*(const Matrix<T, Allocator> &xMatrix) const;
+
+    bool operator==(const SymmetricMatrix &xOther) const noexcept { return m_Size == xOther.m_Size && m_Data == xOther.m_Data; }
+    bool operator!=(const SymmetricMatrix &xOther) const noexcept { return !(*this == xOther); }
+};
+
+template <typename T>
+template <typename Allocator>
+inline std::optional<SymmetricMatrix<T>> SymmetricMatrix<T>::create(const Matrix<T, Allocator> &xMatrix)
+{
+    if (xMatrix.getRows().get() != xMatrix.getCols().get())
+        return std::nullopt;
+
+    SymmetricMatrix tResult{xMatrix.getRows().get()};
+    for (std::size_t i = 0; i < tResult.m_Size; i++)
+    {
+        const auto tRow = xMatrix.getRow(i);
+        std::copy(tRow.begin(), tRow.begin() + i + 1, tResult.m_Data.begin() + index(i, 0));
+    }
+    return tResult;
+}
+
+template <typename T>
+inline Matrix<T> SymmetricMatrix<T>::toMatrix() const
+{
+    auto tResult = Matrix<T>::create(Row{m_Size}, Column{m_Size});
+    for (std::size_t i = 0; i < m_Size; i++)
+    {
+        for (std::size_t j = 0; j <= i; j++)
+        {
+            tResult(i, j) = m_Data[index(i, j)];
+            tResult(j, i) = m_Data[index(i, j)];
+        }
+    }
+    return tResult;
+}
+
+template <typename T>
+inline SymmetricMatrix<T> &SymmetricMatrix<T>::operator+=(const SymmetricMatrix &xOther) noexcept
+{
+    if (m_Size == xOther.m_Size)
+        Kernels::add(m_Data.data(), xOther.m_Data.data(), m_Data.data(), m_Data.size());
+    return *this;
+}
+
+template <typename T>
+inline SymmetricMatrix<T> &SymmetricMatrix<T>::operator-=(const SymmetricMatrix &xOther) noexcept
+{
+    if (m_Size == xOther.m_Size)
+        Kernels::subtract(m_Data.data(), xOther.m_Data.data(), m_Data.data(), m_Data.size());
+    return *this;
+}
+
+template <typename T>
+inline SymmetricMatrix<T> &SymmetricMatrix<T>::operator*=(const T &xScalar) noexcept
+{
+    Kernels::multiplyScalar(m_Data.data(), xScalar, m_Data.data(), m_Data.size());
+    return *this;
+}
+
+template <typename T>
+template <typename Allocator>
+inline Vector<T, Allocator> SymmetricMatrix<T>::operator*(const Vector<T, Allocator> &xVector) const
+{
+    if (xVector.size() != m_Size)
+        return Vector<T, Allocator>::create();
+
+    auto tResult = Vector<T, Allocator>::create(Row{m_Size}, xVector.get_allocator());
+    const T *tX = xVector.getData().data();
+    T *tY = tResult.getData().data();
+    for (std::size_t i = 0; i < m_Size; i++)
+    {
+        // Row i of the lower triangle gives y(i) += a(i, j) x(j) and y(j) += a(i, j) x(i).
+        const T *tRow = m_Data.data() + index(i, 0);
+        const T tXi = tX[i];
+        T tSum{};
+        for (std::size_t j = 0; j < i; j++)
+        {
+            tSum += tRow[j] * tX[j];
+            tY[j] += tRow[j] * tXi;
+        }
+        tY[i] += tSum + tRow[i] * tXi;
+    }
+    return tResult;
+}
+
+template <typename T>
+template <typename Allocator>
+inline Matrix<T, Allocator> SymmetricMatrix<T>::operator*(const Matrix<T, Allocator> &xMatrix) const
+{
+    if (xMatrix.getRows().get() != m_Size)
+        return Matrix<T, Allocator>::create(xMatrix.get_allocator());
+
+    const std::size_t tCols = xMatrix.getCols().get();
+    auto tResult = Matrix<T, Allocator>::create(Row{m_Size}, xMatrix.getCols(), xMatrix.get_allocator());
+    for (std::size_t i = 0; i < m_Size; i++)
+    {
+        const T *tRow = m_Data.data() + index(i, 0);
+        const T *tBi = xMatrix.getRow(i).data();
+        T *tCi = tResult.getRow(i).data();
+        for (std::size_t j = 0; j <= i; j++)
+        {
+            const T tA = tRow[j];
+            const T *tBj = xMatrix.getRow(j).data();
+            for (std::size_t c = 0; c < tCols; c++)
+                tCi[c] += tA * tBj[c];
+            if (j == i)
+                continue;
+            T *tCj = tResult.getRow(j).data();
+            for (std::size_t c = 0; c < tCols; c++)
+                tCj[c] += tA * tBi[c];
+        }
+    }
+    return tResult;
+}
@@ -0,0 +1,254 @@
+#pragma once
+
+#include "matrix.h"
+#include "vector.h"
+#include "Kernels/simd.h"
+#include "Types/column.h"
+#include "Types/row.h"
+#include "Types/span.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+enum class Triangle
+{
+    Lower,
+    Upper
+};
+
+// n x n triangular matrix storing only its triangle, packed row by row. Row i holds
+// columns 0 ... i (Lower) or i ... n - 1 (Upper); everything else reads as zero.
+template <typename T, Triangle Uplo = Triangle::Lower>
+class TriangularMatrix
+{
+private:
+    static constexpr Triangle gOther{Uplo == Triangle::Lower ? Triangle::Upper : Triangle::Lower};
+
+    std::size_t m_Size{0};
+    std::vector<T> m_Data{};
+
+    explicit TriangularMatrix(std::size_t xSize)
+        : m_Size{xSize}, m_Data(xSize * (xSize + 1) / 2)
+    {
+    }
+
+    // Offset of the first stored element of row i.
+    constexpr std::size_t rowOffset(std::size_t xRow) const noexcept
+    {
+        if constexpr (Uplo == Triangle::Lower)
+            return xRow * (xRow + 1) / 2;
+        else
+            return xRow * m_Size - xRow * (xRow - 1) / 2;
+    }
+    // Stored columns of row i are [first, last).
+    constexpr std::size_t firstColumn(std::size_t xRow) const noexcept { return Uplo == Triangle::Lower ? 0 : xRow; }
+    constexpr std::size_t lastColumn(std::size_t xRow) const noexcept { return Uplo == Triangle::Lower ? xRow + 1 : m_Size; }
+    constexpr bool stored(std::size_t xRow, std::size_t xCol) const noexcept { return Uplo == Triangle::Lower ? xCol <= xRow : xCol >= xRow; }
+
+public:
+    using value_type = T;
+    static constexpr Triangle gTriangle{Uplo};
+
+    TriangularMatrix() noexcept = default;
+
+    static TriangularMatrix create(std::size_t xSize = 0) { return TriangularMatrix{xSize}; }
+    // Triangle of a square matrix, the rest is ignored; std::nullopt if xMatrix is not square.
+    template <typename Allocator>
+    static std::optional<TriangularMatrix> create(const Matrix<T, Allocator> &xMatrix);
+    // Identity of size n.
+    static TriangularMatrix identity(std::size_t xSize);
+
+    std::size_t size() const noexcept { return m_Size; }
+    Row getRows() const noexcept { return Row{m_Size}; }
+    Column getCols() const noexcept { return Column{m_Size}; }
+    Span<const T> getData() const noexcept { return {m_Data.data(), m_Data.size()}; }
+    Span<T> getData() noexcept { return {m_Data.data(), m_Data.size()}; }
+    // Stored part of row i, starting at column firstColumn(i).
+    Span<const T> getRow(std::size_t xRow) const noexcept { return {m_Data.data() + rowOffset(xRow), lastColumn(xRow) - firstColumn(xRow)}; }
+    Span<T> getRow(std::size_t xRow) noexcept { return {m_Data.data() + rowOffset(xRow), lastColumn(xRow) - firstColumn(xRow)}; }
+
+    // Zero outside the triangle.
+    T operator()(const std::size_t &xRow, const std::size_t &xCol) const noexcept
+    {
+        return stored(xRow, xCol) ? m_Data[rowOffset(xRow) + xCol - firstColumn(xRow)] : T{};
+    }
+    // Only elements inside the triangle are writable; throws std::out_of_range otherwise.
+    T &at(const std::size_t &xRow, const std::size_t &xCol) noexcept(false)
+    {
+        if (xRow >= m_Size || xCol >= m_Size || !stored(xRow, xCol))
+            throw std::out_of_range("TriangularMatrix::at: (" + std::to_string(xRow) + ", " + std::to_string(xCol) + ") is outside of the stored triangle of " + std::to_string(m_Size) + "x" + std::to_string(m_Size));
+        return m_Data[rowOffset(xRow) + xCol - firstColumn(xRow)];
+    }
+
+    Matrix<T> toMatrix() const;
+    TriangularMatrix<T, gOther> transposed() const;
+
+    // Elementwise on the packed triangles; a size mismatch leaves *this unchanged.
+    TriangularMatrix &operator+=(const TriangularMatrix &xOther) noexcept;
+    TriangularMatrix &operator-=(const TriangularMatrix &xOther) noexcept;
+    TriangularMatrix &operator*=(const T &xScalar) noexcept;
+    TriangularMatrix operator+(const TriangularMatrix &xOther) const { return TriangularMatrix{*this} += xOther; }
+    TriangularMatrix operator-(const TriangularMatrix &xOther) const { return TriangularMatrix{*this} -= xOther; }
+    TriangularMatrix operator*(const T &xScalar) const { return TriangularMatrix{*this} *= xScalar; }
+
+    // Products skip the zero triangle. Empty result if the sizes differ.
+    template <typename Allocator>
+    Vector<T, Allocator> operator*(const Vector<T, Allocator> &xVector) const;
+    template <typename Allocator>
+    Matrix<T, Allocator> operator*(const Matrix<T, Allocator> &xMatrix) const;
+    // The product of two lower (upper) triangular matrices is lower (upper) triangular.
+    TriangularMatrix operator*(const TriangularMatrix &xOther) const;
+
+    bool operator==(const TriangularMatrix &xOther) const noexcept { return m_Size == xOther.m_Size && m_Data == xOther.m_Data; }
+    bool operator!=(const TriangularMatrix &xOther) const noexcept { return !(*this == xOther); }
+
+    template <typename, Triangle>
+    friend class TriangularMatrix;
+};
+
+template <typename T>
+using LowerTriangularMatrix = TriangularMatrix<T, Triangle::Lower>;
+template <typename T>
+using UpperTriangularMatrix = TriangularMatrix<T, Triangle::Upper>;
+
+template <typename T, Triangle Uplo>
+template <typename Allocator>
+inline std::optional<TriangularMatrix<T, Uplo>> TriangularMatrix<T, Uplo>::create(const Matrix<T, Allocator> &xMatrix)
+{
+    if (xMatrix.getRows().get() != xMatrix.getCols().get())
+        return std::nullopt;
+
+    TriangularMatrix tResult{xMatrix.getRows().get()};
+    for (std::size_t i = 0; i < tResult.m_Size; i++)
+    {
+        const auto tRow = xMatrix.getRow(i);
+        std::copy(tRow.begin() + tResult.firstColumn(i), tRow.begin() + tResult.lastColumn(i), tResult.m_Data.begin() + tResult.rowOffset(i));
+    }
+    return tResult;
+}
+
+template <typename T, Triangle Uplo>
+inline TriangularMatrix<T, Uplo> TriangularMatrix<T, Uplo>::identity(std::size_t xSize)
+{
+    TriangularMatrix tResult{xSize};
+    for (std::size_t i = 0; i < xSize; i++)
+        tResult.m_Data[tResult.rowOffset(i) + i - tResult.firstColumn(i)] = static_cast<T>(1);
+    return tResult;
+}
+
+template <typename T, Triangle Uplo>
+inline Matrix<T> TriangularMatrix<T, Uplo>::toMatrix() const
+{
+    auto tResult = Matrix<T>::create(Row{m_Size}, Column{m_Size});
+    for (std::size_t i = 0; i < m_Size; i++)
+    {
+        const auto tRow = getRow(i);
+        std::copy(tRow.begin(), tRow.end(), tResult.getRow(i).begin() + firstColumn(i));
+    }
+    return tResult;
+}
+
+template <typename T, Triangle Uplo>
+inline TriangularMatrix<T, TriangularMatrix<T, Uplo>::gOther> TriangularMatrix<T, Uplo>::transposed() const
+{
+    TriangularMatrix<T, gOther> tResult{m_Size};
+    for (std::size_t i = 0; i < m_Size; i++)
+    {
+        const T *tRow = m_Data.data() + rowOffset(i);
+        for (std::size_t j = firstColumn(i); j < lastColumn(i); j++)
+            tResult.m_Data[tResult.rowOffset(j) + i - tResult.firstColumn(j)] = tRow[j - firstColumn(i)];
+    }
+    return tResult;
+}
+
+template <typename T, Triangle Uplo>
+inline TriangularMatrix<T, Uplo> &TriangularMatrix<T, Uplo>::operator+=(const TriangularMatrix &xOther) noexcept
+{
+    if (m_Size == xOther.m_Size)
+        Kernels::add(m_Data.data(), xOther.m_Data.data(), m_Data.data(), m_Data.size());
+    return *this;
+}
+
+template <typename T, Triangle Uplo>
+inline TriangularMatrix<T, Uplo> &TriangularMatrix<T, Uplo>::operator-=(const TriangularMatrix &xOther) noexcept
+{
+    if (m_Size == xOther.m_Size)
+        Kernels::subtract(m_Data.data(), xOther.m_Data.data(), m_Data.data(), m_Data.size());
+    return *this;
+}
+
+template <typename T, Triangle Uplo>
+inline TriangularMatrix<T, Uplo> &TriangularMatrix<T, Uplo>::operator*=(const T &xScalar) noexcept
+{
+    Kernels::multiplyScalar(m_Data.data(), xScalar, m_Data.data(), m_Data.size());
+    return *this;
+}
+
+template <typename T, Triangle Uplo>
+template <typename Allocator>
+inline Vector<T, Allocator> TriangularMatrix<T, Uplo>::operator*(const Vector<T, Allocator> &xVector) const
+{
+    if (xVector.size() != m_Size)
+        return Vector<T, Allocator>::create();
+
+    auto tResult = Vector<T, Allocator>::create(Row{m_Size}, xVector.get_allocator());
+    const T *tX = xVector.getData().data();
+    for (std::size_t i = 0; i < m_Size; i++)
+        tResult[i] = Kernels::dot(m_Data.data() + rowOffset(i), tX + firstColumn(i), lastColumn(i) - firstColumn(i));
+    return tResult;
+}
+
+template <typename T, Triangle Uplo>
+template <typename Allocator>
+inline Matrix<T, Allocator> TriangularMatrix<T, Uplo>::operator*(const Matrix<T, Allocator> &xMatrix) const
+{
+    if (xMatrix.getRows().get() != m_Size)
+        return Matrix<T, Allocator>::create(xMatrix.get_allocator());
+
+    const std::size_t tCols = xMatrix.getCols().get();
+    auto tResult = Matrix<T, Allocator>::create(Row{m_Size}, xMatrix.getCols(), xMatrix.get_allocator());
+    for (std::size_t i = 0; i < m_Size; i++)
+    {
+        const T *tRow = m_Data.data() + rowOffset(i);
+        T *tOut = tResult.getRow(i).data();
+        for (std::size_t k = firstColumn(i); k < lastColumn(i); k++)
+        {
+            const T tA = tRow[k - firstColumn(i)];
+            const T *tB = xMatrix.getRow(k).data();
+            for (std::size_t c = 0; c < tCols; c++)
+                tOut[c] += tA * tB[c];
+        }
+    }
+    return tResult;
+}
+
+template <typename T, Triangle Uplo>
+inline TriangularMatrix<T, Uplo> TriangularMatrix<T, Uplo>::operator*(const TriangularMatrix &xOther) const
+{
+    if (xOther.m_Size != m_Size)
+        return create();
+
+    // Row i of A times the rows k of B it touches; row k of B only has columns in the
+    // stored range, so the result stays inside the triangle (about n^3 / 6 multiply-adds).
+    TriangularMatrix tResult{m_Size};
+    for (std::size_t i = 0; i < m_Size; i++)
+    {
+        const T *tRow = m_Data.data() + rowOffset(i);
+        T *tOut = tResult.m_Data.data() + rowOffset(i);
+        for (std::size_t k = firstColumn(i); k < lastColumn(i); k++)
+        {
+            const T tA = tRow[k - firstColumn(i)];
+            const T *tB = xOther.m_Data.data() + xOther.rowOffset(k);
+            // Columns of row k of B, relative to the first stored column of row i.
+            const std::size_t tBegin = xOther.firstColumn(k);
+            const std::size_t tEnd = std::min(xOther.lastColumn(k), lastColumn(i));
+            for (std::size_t c = std::max(tBegin, firstColumn(i)); c < tEnd; c++)
+                tOut[c - firstColumn(i)] += tA * tB[c - tBegin];
+        }
+    }
+    return tResult;
+}
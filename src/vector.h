@@ -1,36 +1,48 @@
+#pragma once
+
 #include "Types/row.h"
+#include "Kernels/simd.h"
 
+#include <memory>
+#include <memory_resource>
 #include <vector>
 #include <cmath>
 #include <type_traits>
 #include <numeric>
 #include <algorithm>
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class Vector
 {
 private:
     Row m_Rows{};
-    std::vector<T> m_Data{};
+    std::vector<T, Allocator> m_Data{};
 
     Vector() noexcept = default;
-    explicit Vector(const Row &xRows) noexcept;
-    explicit Vector(const std::vector<T> &xVector) noexcept;
+    explicit Vector(const Row &xRows, const Allocator &xAllocator = Allocator()) noexcept;
+    explicit Vector(const std::vector<T> &xVector, const Allocator &xAllocator = Allocator()) noexcept;
 
 public:
-    static Vector<T> create() noexcept;
-    static Vector<T> create(const Row &xRows) noexcept;
-    static Vector<T> create(const std::vector<T> &xVector) noexcept;
-    static Vector<T> create(const Vector<T> &xVector) noexcept;
+    using value_type = T;
+    using allocator_type = Allocator;
+
+    static Vector<T, Allocator> create() noexcept;
+    static Vector<T, Allocator> create(const Row &xRows) noexcept;
+    static Vector<T, Allocator> create(const std::vector<T> &xVector) noexcept;
+    static Vector<T, Allocator> create(const Vector<T, Allocator> &xVector) noexcept;
+    static Vector<T, Allocator> create(const Row &xRows, const Allocator &xAllocator) noexcept;
+    static Vector<T, Allocator> create(const std::vector<T> &xVector, const Allocator &xAllocator) noexcept;
 
-    const std::vector<T> &getData() const noexcept;
-    std::vector<T> &getData() noexcept;
+    Allocator get_allocator() const noexcept { return m_Data.get_allocator(); }
+
+    const std::vector<T, Allocator> &getData() const noexcept;
+    std::vector<T, Allocator> &getData() noexcept;
     constexpr const Row &getRows() const noexcept;
 
     void erase() noexcept;
 
-    bool operator==(const Vector<T> &xOther) noexcept;
-    bool operator!=(const Vector<T> &xOther) noexcept;
+    bool operator==(const Vector<T, Allocator> &xOther) noexcept;
+    bool operator!=(const Vector<T, Allocator> &xOther) noexcept;
     const T &operator[](const std::size_t &xPos) const noexcept(false) { return m_Data[xPos]; }
     T &operator[](const std::size_t &xPos) noexcept(false) { return m_Data[xPos]; }
     const T &at(const std::size_t &xPos) const noexcept(false) { return m_Data.at(xPos); }
@@ -40,21 +52,31 @@ public:
     // Vector math
     constexpr T magnitude() const noexcept;
     constexpr void normalize() noexcept;
-    bool opposite(const Vector<T> &xOther) const noexcept;
-    bool parallel(const Vector<T> &xOther) const noexcept;
-    bool antiParallel(const Vector<T> &xOther) const noexcept;
-    T dotProduct(const Vector<T> &) const noexcept;
-    Vector<T> crossProduct(const Vector<T> &) const noexcept;
-    Vector<T> &operator+=(const Vector<T> &) noexcept;
-    Vector<T> operator+(const Vector<T> &) const noexcept;
-    Vector<T> &operator+=(const T &) noexcept;
-    Vector<T> operator+(const T &) const noexcept;
-    Vector<T> &operator-=(const Vector<T> &) noexcept;
-    Vector<T> operator-(const Vector<T> &) const noexcept;
-    Vector<T> &operator-=(const T &) noexcept;
-    Vector<T> operator-(const T &) const noexcept;
-    Vector<T> &operator*=(const T &) noexcept;
-    Vector<T> operator*(const T &) const noexcept;
+    bool opposite(const Vector<T, Allocator> &xOther) const noexcept;
+    bool parallel(const Vector<T, Allocator> &xOther) const noexcept;
+    bool antiParallel(const Vector<T, Allocator> &xOther) const noexcept;
+    T dotProduct(const Vector<T, Allocator> &) const noexcept;
+    Vector<T, Allocator> crossProduct(const Vector<T, Allocator> &) const noexcept;
+    // Compound assignments work in place; a size mismatch leaves *this unchanged. On a
+    // mismatch, + returns zeros of the left operand's size and - the left operand.
+    // The && overloads reuse the buffer of an expiring left operand.
+    Vector<T, Allocator> &operator+=(const Vector<T, Allocator> &) noexcept;
+    Vector<T, Allocator> operator+(const Vector<T, Allocator> &) const &noexcept;
+    Vector<T, Allocator> operator+(const Vector<T, Allocator> &) &&noexcept;
+    Vector<T, Allocator> operator+(Vector<T, Allocator> &&) &&noexcept;
+    Vector<T, Allocator> &operator+=(const T &) noexcept;
+    Vector<T, Allocator> operator+(const T &) const &noexcept;
+    Vector<T, Allocator> operator+(const T &) &&noexcept;
+    Vector<T, Allocator> &operator-=(const Vector<T, Allocator> &) noexcept;
+    Vector<T, Allocator> operator-(const Vector<T, Allocator> &) const &noexcept;
+    Vector<T, Allocator> operator-(const Vector<T, Allocator> &) &&noexcept;
+    Vector<T, Allocator> operator-(Vector<T, Allocator> &&) &&noexcept;
+    Vector<T, Allocator> &operator-=(const T &) noexcept;
+    Vector<T, Allocator> operator-(const T &) const &noexcept;
+    Vector<T, Allocator> operator-(const T &) &&noexcept;
+    Vector<T, Allocator> &operator*=(const T &) noexcept;
+    Vector<T, Allocator> operator*(const T &) const &noexcept;
+    Vector<T, Allocator> operator*(const T &) &&noexcept;
 
     // Iterator
     class Iterator
@@ -126,8 +148,9 @@ public:
     Const_Iterator end() const { return Const_Iterator(&(*m_Data.end())); }
 };
 
-template <typename T>
-Vector<T>::Vector(const Row &xRows) noexcept
+template <typename T, typename Allocator>
+Vector<T, Allocator>::Vector(const Row &xRows, const Allocator &xAllocator) noexcept
+    : m_Data(xAllocator)
 {
     if (xRows.get() > 0UL)
     {
@@ -135,55 +158,65 @@ Vector<T>::Vector(const Row &xRows) noexcept
         m_Rows = xRows;
     }
 }
-template <typename T>
-Vector<T>::Vector(const std::vector<T> &xVector) noexcept
-    : m_Data{xVector}, m_Rows{xVector.size()}
+template <typename T, typename Allocator>
+Vector<T, Allocator>::Vector(const std::vector<T> &xVector, const Allocator &xAllocator) noexcept
+    : m_Rows{xVector.size()}, m_Data(xVector.cbegin(), xVector.cend(), xAllocator)
+{
+}
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::create() noexcept
+{
+    return Vector<T, Allocator>{};
+}
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::create(const Row &xRows) noexcept
 {
+    return Vector<T, Allocator>{xRows};
 }
-template <typename T>
-Vector<T> Vector<T>::create() noexcept
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::create(const std::vector<T> &xVector) noexcept
 {
-    return Vector<T>{};
+    return Vector<T, Allocator>{xVector};
 }
-template <typename T>
-Vector<T> Vector<T>::create(const Row &xRows) noexcept
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::create(const Vector<T, Allocator> &xVector) noexcept
 {
-    return Vector<T>{xRows};
+    return Vector<T, Allocator>{xVector};
 }
-template <typename T>
-Vector<T> Vector<T>::create(const std::vector<T> &xVector) noexcept
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::create(const Row &xRows, const Allocator &xAllocator) noexcept
 {
-    return Vector<T>{xVector};
+    return Vector<T, Allocator>{xRows, xAllocator};
 }
-template <typename T>
-Vector<T> Vector<T>::create(const Vector<T> &xVector) noexcept
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::create(const std::vector<T> &xVector, const Allocator &xAllocator) noexcept
 {
-    return Vector<T>{xVector};
+    return Vector<T, Allocator>{xVector, xAllocator};
 }
-template <typename T>
-const std::vector<T> &Vector<T>::getData() const noexcept
+template <typename T, typename Allocator>
+const std::vector<T, Allocator> &Vector<T, Allocator>::getData() const noexcept
 {
     return m_Data;
 }
-template <typename T>
-std::vector<T> &Vector<T>::getData() noexcept
+template <typename T, typename Allocator>
+std::vector<T, Allocator> &Vector<T, Allocator>::getData() noexcept
 {
     return m_Data;
 }
-template <typename T>
-constexpr const Row &Vector<T>::getRows() const noexcept
+template <typename T, typename Allocator>
+constexpr const Row &Vector<T, Allocator>::getRows() const noexcept
 {
     return m_Rows;
 }
-template <typename T>
-void Vector<T>::erase() noexcept
+template <typename T, typename Allocator>
+void Vector<T, Allocator>::erase() noexcept
 {
     m_Rows = 0UL;
     m_Data.clear();
 }
 
-template <typename T>
-bool Vector<T>::operator==(const Vector<T> &xOther) noexcept
+template <typename T, typename Allocator>
+bool Vector<T, Allocator>::operator==(const Vector<T, Allocator> &xOther) noexcept
 {
     if (m_Rows != xOther.m_Rows)
         return false;
@@ -195,17 +228,16 @@ bool Vector<T>::operator==(const Vector<T> &xOther) noexcept
     }
     return true;
 }
-template <typename T>
-bool Vector<T>::operator!=(const Vector<T> &xOther) noexcept
+template <typename T, typename Allocator>
+bool Vector<T, Allocator>::operator!=(const Vector<T, Allocator> &xOther) noexcept
 {
     return !(*this == xOther);
 }
 
-template <typename T>
-constexpr T Vector<T>::magnitude() const noexcept
+template <typename T, typename Allocator>
+constexpr T Vector<T, Allocator>::magnitude() const noexcept
 {
-    auto tSum = std::accumulate(m_Data.cbegin(), m_Data.cend(), static_cast<T>(0.0), [](T xSum, T xElem)
-                                { return xSum + (xElem * xElem); });
+    const auto tSum = Kernels::sumOfSquares(m_Data.data(), m_Data.size());
 
 #if defined(__clang__) || defined(_MSC_VER) // https://gcc.gnu.org/bugzilla/show_bug.cgi?id=79700 is not yet solved
     if constexpr (std::is_integral_v<T> || std::is_same_v<double, T>)
@@ -221,8 +253,8 @@ constexpr T Vector<T>::magnitude() const noexcept
 #endif
 }
 
-template <typename T>
-constexpr void Vector<T>::normalize() noexcept
+template <typename T, typename Allocator>
+constexpr void Vector<T, Allocator>::normalize() noexcept
 {
     const auto tMagnitude = magnitude();
 
@@ -230,8 +262,8 @@ constexpr void Vector<T>::normalize() noexcept
                    { return xElem / tMagnitude; });
 }
 
-template <typename T>
-bool Vector<T>::opposite(const Vector<T> &xOther) const noexcept
+template <typename T, typename Allocator>
+bool Vector<T, Allocator>::opposite(const Vector<T, Allocator> &xOther) const noexcept
 {
     if (xOther.size() != m_Data.size())
         return false;
@@ -243,8 +275,8 @@ bool Vector<T>::opposite(const Vector<T> &xOther) const noexcept
                       });
 }
 
-template <typename T>
-bool Vector<T>::parallel(const Vector<T> &xOther) const noexcept
+template <typename T, typename Allocator>
+bool Vector<T, Allocator>::parallel(const Vector<T, Allocator> &xOther) const noexcept
 {
     if (xOther.size() != size())
         return false;
@@ -260,8 +292,8 @@ bool Vector<T>::parallel(const Vector<T> &xOther) const noexcept
                                 return (tResult - tToControl) <= T::epsilon(); 
                       });
 }
-template <typename T>
-bool Vector<T>::antiParallel(const Vector<T> &xOther) const noexcept
+template <typename T, typename Allocator>
+bool Vector<T, Allocator>::antiParallel(const Vector<T, Allocator> &xOther) const noexcept
 {
     if (xOther.size() != size())
         return false;
@@ -278,134 +310,199 @@ bool Vector<T>::antiParallel(const Vector<T> &xOther) const noexcept
                       });
 }
 
-template <typename T>
-T Vector<T>::dotProduct(const Vector<T> &xOther) const noexcept
+template <typename T, typename Allocator>
+T Vector<T, Allocator>::dotProduct(const Vector<T, Allocator> &xOther) const noexcept
 {
     T tResult{static_cast<T>(0)};
 
     if (xOther.size() != size())
         return tResult;
 
-    for (std::size_t i = 0; i < size(); i++)
-    {
-        tResult += xOther.at(i) * this->at(i);
-    }
-
-    return tResult;
+    return Kernels::dot(m_Data.data(), xOther.m_Data.data(), size());
 }
 
-template <typename T>
-Vector<T> Vector<T>::crossProduct(const Vector<T> &xOther) const noexcept
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::crossProduct(const Vector<T, Allocator> &xOther) const noexcept
 {
     if (size() != xOther.size() || size() != 3)
         return create();
 
-    std::vector<T> tTemp;
-    tTemp.emplace_back(at(1) * xOther.at(2) - at(2) * xOther.at(1));
-    tTemp.emplace_back(at(2) * xOther.at(0) - at(0) * xOther.at(2));
-    tTemp.emplace_back(at(0) * xOther.at(1) - at(1) * xOther.at(0));
+    Vector<T, Allocator> tResult{Row{3}, get_allocator()};
+    tResult.m_Data[0] = m_Data[1] * xOther.m_Data[2] - m_Data[2] * xOther.m_Data[1];
+    tResult.m_Data[1] = m_Data[2] * xOther.m_Data[0] - m_Data[0] * xOther.m_Data[2];
+    tResult.m_Data[2] = m_Data[0] * xOther.m_Data[1] - m_Data[1] * xOther.m_Data[0];
 
-    return create(tTemp);
+    return tResult;
 }
 
-template <typename T>
-Vector<T> &Vector<T>::operator+=(const Vector<T> &xOther) noexcept
+template <typename T, typename Allocator>
+Vector<T, Allocator> &Vector<T, Allocator>::operator+=(const Vector<T, Allocator> &xOther) noexcept
 {
-    auto tResult = *this + xOther;
-    *this = std::move(tResult);
+    if (xOther.size() != size())
+        return *this;
+
+    T *tData = m_Data.data();
+    const T *tOther = xOther.m_Data.data();
+    Kernels::add(tData, tOther, tData, size());
     return *this;
 }
-template <typename T>
-Vector<T> Vector<T>::operator+(const Vector<T> &xOther) const noexcept
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::operator+(const Vector<T, Allocator> &xOther) const &noexcept
 {
-    Vector<T> tResult{Row{size()}};
-
+    Vector<T, Allocator> tResult{Row{size()}, get_allocator()};
     if (xOther.size() != size())
         return tResult;
 
-    for (std::size_t i = 0; i < size(); ++i)
-    {
-        tResult.at(i) = this->at(i) + xOther.at(i);
-    }
+    const T *tData = m_Data.data();
+    const T *tOther = xOther.m_Data.data();
+    T *tOut = tResult.m_Data.data();
+    Kernels::add(tData, tOther, tOut, size());
 
     return tResult;
 }
-template <typename T>
-Vector<T> &Vector<T>::operator+=(const T &xOther) noexcept
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::operator+(const Vector<T, Allocator> &xOther) &&noexcept
 {
-    auto tResult = *this + xOther;
-    *this = std::move(tResult);
-    return *this;
+    if (xOther.size() != size())
+        std::fill(m_Data.begin(), m_Data.end(), T{});
+    else
+        *this += xOther;
+    return std::move(*this);
+}
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::operator+(Vector<T, Allocator> &&xOther) &&noexcept
+{
+    return std::move(*this) + static_cast<const Vector<T, Allocator> &>(xOther);
 }
-template <typename T>
-Vector<T> Vector<T>::operator+(const T &xOther) const noexcept
+template <typename T, typename Allocator>
+Vector<T, Allocator> operator+(const Vector<T, Allocator> &xLhs, Vector<T, Allocator> &&xOther) noexcept
 {
-    Vector<T> tResult{Row{size()}};
+    if (xOther.size() != xLhs.size())
+        return xLhs + static_cast<const Vector<T, Allocator> &>(xOther);
 
-    for (std::size_t i = 0; i < size(); ++i)
-    {
-        tResult.at(i) = this->at(i) + xOther;
-    }
+    xOther += xLhs;
+    return std::move(xOther);
+}
+template <typename T, typename Allocator>
+Vector<T, Allocator> &Vector<T, Allocator>::operator+=(const T &xOther) noexcept
+{
+    T *tData = m_Data.data();
+    Kernels::addScalar(tData, xOther, tData, size());
+    return *this;
+}
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::operator+(const T &xOther) const &noexcept
+{
+    Vector<T, Allocator> tResult{Row{size()}, get_allocator()};
+    const T *tData = m_Data.data();
+    T *tOut = tResult.m_Data.data();
+    Kernels::addScalar(tData, xOther, tOut, size());
 
     return tResult;
 }
-template <typename T>
-Vector<T> &Vector<T>::operator-=(const Vector<T> &xOther) noexcept
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::operator+(const T &xOther) &&noexcept
+{
+    *this += xOther;
+    return std::move(*this);
+}
+template <typename T, typename Allocator>
+Vector<T, Allocator> &Vector<T, Allocator>::operator-=(const Vector<T, Allocator> &xOther) noexcept
 {
-    auto tResult = *this - xOther;
-    *this = std::move(tResult);
+    if (xOther.size() != size())
+        return *this;
+
+    T *tData = m_Data.data();
+    const T *tOther = xOther.m_Data.data();
+    Kernels::subtract(tData, tOther, tData, size());
     return *this;
 }
-template <typename T>
-Vector<T> Vector<T>::operator-(const Vector<T> &xOther) const noexcept
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::operator-(const Vector<T, Allocator> &xOther) const &noexcept
 {
     if (xOther.size() != size())
         return *this;
 
-    Vector<T> tResult{Row{size()}};
-
-    for (std::size_t i = 0; i < size(); ++i)
-    {
-        tResult.at(i) = this->at(i) - xOther.at(i);
-    }
+    Vector<T, Allocator> tResult{Row{size()}, get_allocator()};
+    const T *tData = m_Data.data();
+    const T *tOther = xOther.m_Data.data();
+    T *tOut = tResult.m_Data.data();
+    Kernels::subtract(tData, tOther, tOut, size());
 
     return tResult;
 }
-template <typename T>
-Vector<T> &Vector<T>::operator-=(const T &xOther) noexcept
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::operator-(const Vector<T, Allocator> &xOther) &&noexcept
 {
-    auto tResult = *this - xOther;
-    *this = std::move(tResult);
-    return *this;
+    *this -= xOther;
+    return std::move(*this);
+}
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::operator-(Vector<T, Allocator> &&xOther) &&noexcept
+{
+    *this -= xOther;
+    return std::move(*this);
 }
-template <typename T>
-Vector<T> Vector<T>::operator-(const T &xOther) const noexcept
+template <typename T, typename Allocator>
+Vector<T, Allocator> operator-(const Vector<T, Allocator> &xLhs, Vector<T, Allocator> &&xOther) noexcept
 {
-    Vector<T> tResult{Row{size()}};
+    if (xOther.size() != xLhs.size())
+        return xLhs;
 
-    for (std::size_t i = 0; i < size(); ++i)
-    {
-        tResult.at(i) = this->at(i) - xOther;
-    }
+    T *tData = xOther.getData().data();
+    const T *tLhs = xLhs.getData().data();
+    Kernels::subtract(tLhs, tData, tData, xOther.size());
+    return std::move(xOther);
+}
+template <typename T, typename Allocator>
+Vector<T, Allocator> &Vector<T, Allocator>::operator-=(const T &xOther) noexcept
+{
+    T *tData = m_Data.data();
+    Kernels::subtractScalar(tData, xOther, tData, size());
+    return *this;
+}
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::operator-(const T &xOther) const &noexcept
+{
+    Vector<T, Allocator> tResult{Row{size()}, get_allocator()};
+    const T *tData = m_Data.data();
+    T *tOut = tResult.m_Data.data();
+    Kernels::subtractScalar(tData, xOther, tOut, size());
 
     return tResult;
 }
-template <typename T>
-Vector<T> &Vector<T>::operator*=(const T &xOther) noexcept
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::operator-(const T &xOther) &&noexcept
 {
-    auto tResult = *this * xOther;
-    *this = std::move(tResult);
+    *this -= xOther;
+    return std::move(*this);
+}
+template <typename T, typename Allocator>
+Vector<T, Allocator> &Vector<T, Allocator>::operator*=(const T &xOther) noexcept
+{
+    T *tData = m_Data.data();
+    Kernels::multiplyScalar(tData, xOther, tData, size());
     return *this;
 }
-template <typename T>
-Vector<T> Vector<T>::operator*(const T &xOther) const noexcept
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::operator*(const T &xOther) const &noexcept
 {
-    Vector<T> tResult{Row{size()}};
-
-    for (std::size_t i = 0; i < size(); ++i)
-    {
-        tResult.at(i) = this->at(i) * xOther;
-    }
+    Vector<T, Allocator> tResult{Row{size()}, get_allocator()};
+    const T *tData = m_Data.data();
+    T *tOut = tResult.m_Data.data();
+    Kernels::multiplyScalar(tData, xOther, tOut, size());
 
     return tResult;
-}
\ No newline at end of file
+}
+template <typename T, typename Allocator>
+Vector<T, Allocator> Vector<T, Allocator>::operator*(const T &xOther) &&noexcept
+{
+    *this *= xOther;
+    return std::move(*this);
+}
+
+namespace Pmr
+{
+    template <typename T>
+    using Vector = ::Vector<T, std::pmr::polymorphic_allocator<T>>;
+} // namespace Pmr
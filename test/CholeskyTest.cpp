@@ -0,0 +1,132 @@
+#include "../src/Linalg/cholesky.h"
+#include "testHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+namespace
+{
+    // B B^T + n I is well conditioned and positive definite.
+    Matrix<double> spdMatrix(std::size_t xSize, unsigned xSeed)
+    {
+        const auto tB = randomMatrix(xSize, xSize, xSeed);
+        auto tResult = tB * tB.transposed();
+        for (std::size_t i = 0; i < xSize; i++)
+            tResult(i, i) += static_cast<double>(xSize);
+        return tResult;
+    }
+
+    Vector<double> randomVector(std::size_t xSize, unsigned xSeed, double xScale)
+    {
+        const auto tColumn = randomMatrix(xSize, 1, xSeed);
+        auto tResult = Vector<double>::create(Row{xSize});
+        for (std::size_t i = 0; i < xSize; i++)
+            tResult[i] = xScale * tColumn(i, 0);
+        return tResult;
+    }
+
+    Matrix<double> outerProduct(const Vector<double> &xVector)
+    {
+        auto tResult = Matrix<double>::create(Row{xVector.size()}, Column{xVector.size()});
+        for (std::size_t i = 0; i < xVector.size(); i++)
+            for (std::size_t j = 0; j < xVector.size(); j++)
+                tResult(i, j) = xVector[i] * xVector[j];
+        return tResult;
+    }
+} // namespace
+
+TEST(Cholesky, small_known_factor)
+{
+    const auto tMatrix = Matrix<double>::create(std::vector<std::vector<double>>{{4, 12, -16}, {12, 37, -43}, {-16, -43, 98}});
+    const auto tCholesky = Linalg::cholesky(tMatrix);
+    ASSERT_TRUE(tCholesky.has_value());
+
+    const auto tExpected = Matrix<double>::create(std::vector<std::vector<double>>{{2, 0, 0}, {6, 1, 0}, {-8, 5, 3}});
+    EXPECT_LT(maxDifference(tExpected, tCholesky->getL()), 1e-14);
+    EXPECT_NEAR(36.0, tCholesky->det(), 1e-12);
+    EXPECT_NEAR(std::log(36.0), tCholesky->logDet(), 1e-14);
+}
+
+TEST(Cholesky, blocked_reads_only_lower_triangle)
+{
+    Parallel::ThreadPool tPool{4};
+
+    const std::size_t tSize = 2 * Linalg::gCholeskyBlock + 45;
+    const auto tMatrix = spdMatrix(tSize, 1);
+    auto tLowerOnly = tMatrix;
+    for (std::size_t i = 0; i < tSize; i++)
+        for (std::size_t j = i + 1; j < tSize; j++)
+            tLowerOnly(i, j) = -1e6;
+
+    const auto tCholesky = Linalg::cholesky(tLowerOnly, tPool);
+    ASSERT_TRUE(tCholesky.has_value());
+    const auto &tL = tCholesky->getL();
+    for (std::size_t i = 0; i < tSize; i++)
+    {
+        EXPECT_GT(tL(i, i), 0.0);
+        for (std::size_t j = i + 1; j < tSize; j++)
+            EXPECT_EQ(0.0, tL(i, j));
+    }
+    EXPECT_LT(maxDifference(tMatrix, tL * tL.transposed()), 1e-10);
+}
+
+TEST(Cholesky, solves_multiple_right_hand_sides)
+{
+    Parallel::ThreadPool tPool{4};
+
+    const std::size_t tSize{300};
+    const auto tMatrix = spdMatrix(tSize, 2);
+    const auto tRhs = randomMatrix(tSize, 40, 3);
+    const auto tCholesky = Linalg::cholesky(tMatrix, tPool);
+    ASSERT_TRUE(tCholesky.has_value());
+
+    const auto tX = tCholesky->solve(tRhs, tPool);
+    ASSERT_TRUE(tX.has_value());
+    EXPECT_LT(maxDifference(tMatrix * *tX, tRhs), 1e-10);
+    EXPECT_LT(maxDifference(*tX, *Linalg::choleskySolve(tMatrix, tRhs)), 1e-14);
+
+    auto tVector = Vector<double>::create(Row{tSize});
+    for (std::size_t i = 0; i < tSize; i++)
+        tVector[i] = tRhs(i, 7);
+    const auto tY = tCholesky->solve(tVector);
+    ASSERT_TRUE(tY.has_value());
+    for (std::size_t i = 0; i < tSize; i++)
+        EXPECT_NEAR((*tX)(i, 7), (*tY)[i], 1e-12);
+
+    EXPECT_FALSE(tCholesky->solve(randomMatrix(tSize + 1, 2, 4)).has_value());
+}
+
+TEST(Cholesky, rejects_indefinite_and_non_square)
+{
+    const auto tIndefinite = Matrix<double>::create(std::vector<std::vector<double>>{{1, 2}, {2, 1}});
+    EXPECT_FALSE(Linalg::cholesky(tIndefinite).has_value());
+
+    auto tLarge = spdMatrix(200, 5);
+    tLarge(150, 150) = -1.0;
+    EXPECT_FALSE(Linalg::cholesky(tLarge).has_value());
+
+    EXPECT_FALSE(Linalg::cholesky(randomMatrix(3, 2, 6)).has_value());
+}
+
+TEST(Cholesky, rank_one_update_and_downdate)
+{
+    const std::size_t tSize{150};
+    const auto tMatrix = spdMatrix(tSize, 7);
+    const auto tX = randomVector(tSize, 8, 3.0);
+
+    auto tCholesky = *Linalg::cholesky(tMatrix);
+    ASSERT_TRUE(tCholesky.update(tX));
+    const Matrix<double> tUpdated = tMatrix + outerProduct(tX);
+    EXPECT_LT(maxDifference(tUpdated, tCholesky.getL() * tCholesky.getL().transposed()), 1e-9);
+    EXPECT_LT(maxDifference(Linalg::cholesky(tUpdated)->getL(), tCholesky.getL()), 1e-10);
+
+    ASSERT_TRUE(tCholesky.downdate(tX));
+    EXPECT_LT(maxDifference(Linalg::cholesky(tMatrix)->getL(), tCholesky.getL()), 1e-10);
+
+    // Removing more than is there leaves the factor unchanged.
+    const auto tBefore = tCholesky.getL();
+    EXPECT_FALSE(tCholesky.downdate(randomVector(tSize, 9, 100.0)));
+    EXPECT_TRUE(tBefore == tCholesky.getL());
+    EXPECT_FALSE(tCholesky.update(randomVector(tSize + 1, 9, 1.0)));
+}
@@ -0,0 +1,118 @@
+#include "../src/Io/csv.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace
+{
+    // xRows x xCols random doubles printed with 17 significant digits, so they parse back exactly.
+    std::string randomCsv(std::size_t xRows, std::size_t xCols, unsigned xSeed, Matrix<double> &xExpected)
+    {
+        std::mt19937 rng(xSeed);
+        std::uniform_real_distribution<double> dist(-1e6, 1e6);
+
+        xExpected = Matrix<double>::create(Row{xRows}, Column{xCols});
+        std::string tText = "a,b,c\n";
+        char tField[32];
+        for (std::size_t i = 0; i < xRows; i++)
+        {
+            for (std::size_t j = 0; j < xCols; j++)
+            {
+                xExpected(i, j) = dist(rng) * std::pow(10.0, static_cast<double>(static_cast<int>(i % 40) - 20));
+                std::snprintf(tField, sizeof(tField), "%.17g", xExpected(i, j));
+                tText += tField;
+                tText += j + 1 < xCols ? "," : (i % 3 == 0 ? "\r\n" : "\n");
+            }
+        }
+        return tText;
+    }
+} // namespace
+
+TEST(Csv, parse_fields)
+{
+    const auto tMatrix = Io::parseCsv<double>("x, y, z\r\n1, -2.5, +3e2\r\n\n  4,5.25 ,-6e-1  \r\n\n", Io::CsvSettings{',', 1});
+    ASSERT_TRUE(tMatrix.has_value());
+    ASSERT_EQ(tMatrix->getRows().get(), 2U);
+    ASSERT_EQ(tMatrix->getCols().get(), 3U);
+    EXPECT_EQ(*tMatrix, Matrix<double>::create({{1.0, -2.5, 300.0}, {4.0, 5.25, -0.6}}));
+
+    const auto tBlank = Io::parseCsv<int>("1 2\t 3\n  -4  5 6", Io::CsvSettings{' '});
+    ASSERT_TRUE(tBlank.has_value());
+    EXPECT_EQ(*tBlank, Matrix<int>::create({{1, 2, 3}, {-4, 5, 6}}));
+
+    const auto tHalf = Io::parseCsv<Half>("0.5;-2\n1e3;0.1", Io::CsvSettings{';'});
+    ASSERT_TRUE(tHalf.has_value());
+    EXPECT_EQ(static_cast<float>((*tHalf)(1, 0)), 1000.0f);
+    EXPECT_EQ((*tHalf)(1, 1), Half{0.1f});
+
+    // Only a header.
+    EXPECT_FALSE(Io::parseCsv<double>("header\n\n").has_value());
+    const auto tEmpty = Io::parseCsv<double>("header\n\n", Io::CsvSettings{',', 1});
+    ASSERT_TRUE(tEmpty.has_value());
+    EXPECT_EQ(tEmpty->getRows().get(), 0U);
+}
+
+TEST(Csv, rejects_malformed_input)
+{
+    EXPECT_FALSE(Io::parseCsv<double>("1,2,3\n4,5\n").has_value());
+    EXPECT_FALSE(Io::parseCsv<double>("1,2\n4,5,6\n").has_value());
+    EXPECT_FALSE(Io::parseCsv<double>("1,2\n4,x\n").has_value());
+    EXPECT_FALSE(Io::parseCsv<double>("1,2\n4,5,\n").has_value());
+    EXPECT_FALSE(Io::parseCsv<double>("1,,2\n").has_value());
+    EXPECT_FALSE(Io::parseCsv<double>("1 2\n").has_value());
+    EXPECT_FALSE(Io::parseCsv<int>("1.5,2\n").has_value());
+    EXPECT_FALSE(Io::parseCsv<std::int8_t>("100,200\n").has_value());
+    EXPECT_FALSE(Io::readCsv<double>("/nonexistent/matrix.csv").has_value());
+}
+
+TEST(Csv, parallel_chunks_match)
+{
+    Matrix<double> tExpected = Matrix<double>::create();
+    const auto tText = randomCsv(3000, 7, 1, tExpected);
+
+    Parallel::ThreadPool tPool{4};
+    for (std::size_t tChunkBytes : {std::size_t{1}, std::size_t{100}, std::size_t{4096}, std::size_t{1} << 20})
+    {
+        const Io::CsvSettings tSettings{',', 1, tChunkBytes};
+        const auto tParallel = Io::parseCsv<double>(tText, tSettings, tPool);
+        ASSERT_TRUE(tParallel.has_value());
+        EXPECT_EQ(*tParallel, tExpected);
+        const auto tSequential = Io::parseCsv<double>(tText, tSettings);
+        ASSERT_TRUE(tSequential.has_value());
+        EXPECT_EQ(*tSequential, tExpected);
+    }
+}
+
+TEST(Csv, read_file)
+{
+    Matrix<double> tExpected = Matrix<double>::create();
+    const auto tText = randomCsv(2000, 9, 2, tExpected);
+    const auto tPath = (std::filesystem::temp_directory_path() / "matrix_csv_test.csv").string();
+    {
+        std::ofstream tFile{tPath, std::ios::binary | std::ios::trunc};
+        tFile << tText;
+    }
+
+    Parallel::ThreadPool tPool{4};
+    // 64 bytes is shorter than a line, so the reads have to grow.
+    for (std::size_t tChunkBytes : {std::size_t{64}, std::size_t{5000}, std::size_t{1} << 20})
+    {
+        const auto tMatrix = Io::readCsv<double>(tPath, Io::CsvSettings{',', 1, tChunkBytes}, tPool);
+        ASSERT_TRUE(tMatrix.has_value());
+        EXPECT_EQ(*tMatrix, tExpected);
+    }
+
+    // A malformed row late in the file fails the whole parse.
+    {
+        std::ofstream tFile{tPath, std::ios::binary | std::ios::app};
+        tFile << "1,2,3\n";
+    }
+    EXPECT_FALSE(Io::readCsv<double>(tPath, Io::CsvSettings{',', 1, 4096}, tPool).has_value());
+    std::filesystem::remove(tPath);
+}
@@ -0,0 +1,171 @@
+#include "../src/Linalg/eigen.h"
+#include "../src/Linalg/svd.h"
+#include "testHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    Matrix<double> randomSymmetric(std::size_t xSize, unsigned xSeed)
+    {
+        const auto tRandom = randomMatrix(xSize, xSize, xSeed);
+        return tRandom + tRandom.transposed();
+    }
+
+    Matrix<double> scaleColumns(Matrix<double> xMatrix, const std::vector<double> &xScales)
+    {
+        for (std::size_t i = 0; i < xMatrix.getRows().get(); i++)
+            for (std::size_t j = 0; j < xMatrix.getCols().get(); j++)
+                xMatrix(i, j) *= xScales[j];
+        return xMatrix;
+    }
+} // namespace
+
+TEST(SymmetricEigen, reconstructs_the_matrix)
+{
+    Parallel::ThreadPool tPool{4};
+
+    for (const std::size_t n : {1, 2, 3, 10, 150})
+    {
+        const auto tMatrix = randomSymmetric(n, 3);
+        const auto tEigen = Linalg::symmetricEigen(tMatrix, tPool);
+        ASSERT_TRUE(tEigen.has_value());
+
+        const auto &tValues = tEigen->m_Eigenvalues;
+        const auto &tVectors = tEigen->m_Eigenvectors;
+        EXPECT_TRUE(std::is_sorted(tValues.begin(), tValues.end()));
+        EXPECT_LT(orthogonalityError(tVectors), 1e-12);
+        // A V = V diag(lambda)
+        EXPECT_LT(maxDifference(tMatrix * tVectors, scaleColumns(tVectors, tValues)), 1e-11) << n;
+    }
+}
+
+TEST(SymmetricEigen, known_spectrum)
+{
+    // Q diag(d) Q^T with a random orthogonal Q and repeated eigenvalues.
+    const std::vector<double> tSpectrum{-3.0, -1.0, 0.5, 0.5, 2.0, 2.0, 2.0, 7.0};
+    const auto tQ = Linalg::qr(randomMatrix(8, 8, 5)).getQ();
+    const auto tMatrix = scaleColumns(tQ, tSpectrum) * tQ.transposed();
+
+    const auto tValues = Linalg::symmetricEigenvalues(tMatrix);
+    ASSERT_TRUE(tValues.has_value());
+    ASSERT_EQ(tValues->size(), tSpectrum.size());
+    for (std::size_t i = 0; i < tSpectrum.size(); i++)
+        EXPECT_NEAR((*tValues)[i], tSpectrum[i], 1e-12);
+
+    const auto tEigen = Linalg::symmetricEigen(tMatrix);
+    ASSERT_TRUE(tEigen.has_value());
+    for (std::size_t i = 0; i < tSpectrum.size(); i++)
+        EXPECT_NEAR(tEigen->m_Eigenvalues[i], (*tValues)[i], 1e-12);
+}
+
+TEST(SymmetricEigen, reads_lower_triangle_only)
+{
+    auto tMatrix = randomSymmetric(20, 7);
+    const auto tExpected = Linalg::symmetricEigenvalues(tMatrix);
+    for (std::size_t i = 0; i < 20; i++)
+        for (std::size_t j = i + 1; j < 20; j++)
+            tMatrix(i, j) = 100.0;
+    const auto tValues = Linalg::symmetricEigenvalues(tMatrix);
+    ASSERT_TRUE(tExpected.has_value() && tValues.has_value());
+    for (std::size_t i = 0; i < 20; i++)
+        EXPECT_NEAR((*tValues)[i], (*tExpected)[i], 1e-12);
+}
+
+TEST(SymmetricEigen, diagonal_and_not_square)
+{
+    auto tDiagonal = Matrix<double>::create(Row{4}, Column{4});
+    tDiagonal(0, 0) = 3.0;
+    tDiagonal(1, 1) = -1.0;
+    tDiagonal(2, 2) = 2.0;
+    const auto tEigen = Linalg::symmetricEigen(tDiagonal);
+    ASSERT_TRUE(tEigen.has_value());
+    EXPECT_EQ(tEigen->m_Eigenvalues, (std::vector<double>{-1.0, 0.0, 2.0, 3.0}));
+    EXPECT_NEAR(std::abs(tEigen->m_Eigenvectors(1, 0)), 1.0, 1e-15);
+
+    EXPECT_FALSE(Linalg::symmetricEigen(randomMatrix(3, 4, 1)).has_value());
+    EXPECT_FALSE(Linalg::symmetricEigenvalues(randomMatrix(4, 3, 1)).has_value());
+}
+
+TEST(RandomizedSvd, recovers_leading_triplets)
+{
+    Parallel::ThreadPool tPool{4};
+
+    // A = U diag(s) V^T with a fast decaying spectrum.
+    const std::size_t m = 300, n = 120, tRank = 5;
+    const auto tU = Linalg::qr(randomMatrix(m, n, 11)).getQ();
+    const auto tV = Linalg::qr(randomMatrix(n, n, 12)).getQ();
+    std::vector<double> tSpectrum(n);
+    for (std::size_t i = 0; i < n; i++)
+        tSpectrum[i] = std::pow(0.5, static_cast<double>(i));
+    const auto tMatrix = scaleColumns(tU, tSpectrum) * tV.transposed();
+
+    const auto tSvd = Linalg::randomizedSvd(tMatrix, tRank, 10, 2, 1, tPool);
+    ASSERT_TRUE(tSvd.has_value());
+    ASSERT_EQ(tSvd->m_SingularValues.size(), tRank);
+    EXPECT_EQ(tSvd->m_U.getRows().get(), m);
+    EXPECT_EQ(tSvd->m_U.getCols().get(), tRank);
+    EXPECT_EQ(tSvd->m_V.getRows().get(), n);
+    EXPECT_EQ(tSvd->m_V.getCols().get(), tRank);
+    EXPECT_LT(orthogonalityError(tSvd->m_U), 1e-12);
+    EXPECT_LT(orthogonalityError(tSvd->m_V), 1e-12);
+
+    for (std::size_t k = 0; k < tRank; k++)
+    {
+        EXPECT_NEAR(tSvd->m_SingularValues[k], tSpectrum[k], 1e-10);
+        // Singular vectors are unique up to sign.
+        double tUDot{0.0}, tVDot{0.0};
+        for (std::size_t i = 0; i < m; i++)
+            tUDot += tSvd->m_U(i, k) * tU(i, k);
+        for (std::size_t i = 0; i < n; i++)
+            tVDot += tSvd->m_V(i, k) * tV(i, k);
+        EXPECT_NEAR(std::abs(tUDot), 1.0, 1e-8);
+        EXPECT_NEAR(std::abs(tVDot), 1.0, 1e-8);
+    }
+}
+
+TEST(RandomizedSvd, matches_eigenvalues_of_the_gram_matrix)
+{
+    // Exact rank: with l = min(m, n) the sketch spans the whole range.
+    const auto tMatrix = randomMatrix(40, 25, 4);
+    const auto tSvd = Linalg::randomizedSvd(tMatrix, 25, 0, 0);
+    const auto tEigenvalues = Linalg::symmetricEigenvalues(Matrix<double>{tMatrix.transposed() * tMatrix});
+    ASSERT_TRUE(tSvd.has_value() && tEigenvalues.has_value());
+    for (std::size_t k = 0; k < 25; k++)
+        EXPECT_NEAR(tSvd->m_SingularValues[k], std::sqrt((*tEigenvalues)[24 - k]), 1e-10);
+
+    // A ~ U diag(s) V^T
+    EXPECT_LT(maxDifference(scaleColumns(tSvd->m_U, tSvd->m_SingularValues) * tSvd->m_V.transposed(), tMatrix), 1e-12);
+}
+
+TEST(RandomizedSvd, rank_deficient_input)
+{
+    // Rank 3, asked for 6 triplets: the last three singular values are zero, and U and V
+    // still have orthonormal columns.
+    const Matrix<double> tMatrix = randomMatrix(30, 3, 7) * randomMatrix(3, 20, 8);
+    const auto tSvd = Linalg::randomizedSvd(tMatrix, 6, 4, 1);
+    ASSERT_TRUE(tSvd.has_value());
+    EXPECT_GT(tSvd->m_SingularValues[2], 0.1);
+    for (std::size_t k = 3; k < 6; k++)
+        EXPECT_EQ(0.0, tSvd->m_SingularValues[k]);
+    EXPECT_LT(orthogonalityError(tSvd->m_U), 1e-12);
+    EXPECT_LT(orthogonalityError(tSvd->m_V), 1e-12);
+    EXPECT_LT(maxDifference(scaleColumns(tSvd->m_U, tSvd->m_SingularValues) * tSvd->m_V.transposed(), tMatrix), 1e-12);
+
+    const auto tZero = Linalg::randomizedSvd(Matrix<double>::create(Row{12}, Column{8}), 4);
+    ASSERT_TRUE(tZero.has_value());
+    EXPECT_EQ(std::vector<double>(4, 0.0), tZero->m_SingularValues);
+    EXPECT_LT(orthogonalityError(tZero->m_U), 1e-12);
+    EXPECT_LT(orthogonalityError(tZero->m_V), 1e-12);
+}
+
+TEST(RandomizedSvd, rejects_bad_rank)
+{
+    const auto tMatrix = randomMatrix(10, 6, 2);
+    EXPECT_FALSE(Linalg::randomizedSvd(tMatrix, 0).has_value());
+    EXPECT_FALSE(Linalg::randomizedSvd(tMatrix, 7).has_value());
+    EXPECT_TRUE(Linalg::randomizedSvd(tMatrix, 6).has_value());
+}
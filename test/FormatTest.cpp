@@ -0,0 +1,168 @@
+#include "../src/matrix.h"
+#include "../src/Io/csv.h"
+#include "testHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iomanip>
+#include <locale>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    // Random values spread over thirty decades.
+    template <typename T>
+    Matrix<T> spreadMatrix(std::size_t xRows, std::size_t xCols, unsigned xSeed)
+    {
+        const auto tUnit = randomMatrix(xRows, xCols, xSeed);
+        auto tResult = Matrix<T>::create(Row{xRows}, Column{xCols});
+        for (std::size_t i = 0; i < xRows; i++)
+            for (std::size_t j = 0; j < xCols; j++)
+                tResult(i, j) = static_cast<T>(tUnit(i, j) * std::pow(10.0, static_cast<double>(static_cast<int>((i + j) % 30) - 15)));
+        return tResult;
+    }
+
+    // What toString() printed before it used the formatting engine.
+    template <typename T>
+    std::string toStringReference(const Matrix<T> &xMatrix)
+    {
+        std::string tResult;
+        for (std::size_t i = 0; i < xMatrix.getRows().get(); i++)
+        {
+            tResult += " | ";
+            for (std::size_t j = 0; j < xMatrix.getCols().get(); j++)
+                tResult += std::to_string(xMatrix(i, j)) + " | ";
+            tResult += "\n";
+        }
+        return tResult;
+    }
+
+    // Decimal comma and groups of three digits.
+    struct CommaPunct final : std::numpunct<char>
+    {
+        char do_decimal_point() const override { return ','; }
+        char do_thousands_sep() const override { return '.'; }
+        std::string do_grouping() const override { return "\3"; }
+    };
+
+    // What operator<< printed element by element, with the flags of xPrototype.
+    template <typename T>
+    std::string streamReference(const Matrix<T> &xMatrix, const std::ostream &xPrototype)
+    {
+        std::ostringstream tStream;
+        tStream.copyfmt(xPrototype);
+        for (std::size_t i = 0; i < xMatrix.getRows().get(); i++)
+        {
+            tStream << " | ";
+            for (std::size_t j = 0; j < xMatrix.getCols().get(); j++)
+                tStream << xMatrix(i, j) << " | ";
+            tStream << "\n";
+        }
+        return tStream.str();
+    }
+} // namespace
+
+TEST(Format, to_string_is_unchanged)
+{
+    const auto tDouble = spreadMatrix<double>(17, 9, 1);
+    EXPECT_EQ(tDouble.toString(), toStringReference(tDouble));
+    const auto tFloat = spreadMatrix<float>(5, 11, 2);
+    EXPECT_EQ(tFloat.toString(), toStringReference(tFloat));
+    auto tInt = Matrix<long>::create({{1, -2, 3}, {std::numeric_limits<long>::min(), 0, std::numeric_limits<long>::max()}});
+    EXPECT_EQ(tInt.toString(), toStringReference(tInt));
+}
+
+TEST(Format, shortest_round_trip)
+{
+    const auto tMatrix = spreadMatrix<double>(40, 13, 3);
+    Io::FormatSettings tSettings;
+    tSettings.m_RowPrefix = "";
+    tSettings.m_Separator = ",";
+    tSettings.m_RowSuffix = "\n";
+    const auto tText = tMatrix.toString(tSettings);
+    const auto tParsed = Io::parseCsv<double>(tText);
+    ASSERT_TRUE(tParsed.has_value());
+    EXPECT_EQ(*tParsed, tMatrix);
+
+    const auto tSmall = Matrix<double>::create({{0.1, -2.0}, {1e-300, 123456789.0}});
+    EXPECT_EQ(tSmall.toString(tSettings), "0.1,-2\n1e-300,123456789\n");
+}
+
+TEST(Format, precision_and_separators)
+{
+    const auto tMatrix = Matrix<double>::create({{3.14159, -0.5}, {1234.5678, 2e-7}});
+    EXPECT_EQ(tMatrix.toString(Io::FormatSettings{Io::FloatFormat::Fixed, 2, "[", ", ", "]\n"}), "[3.14, -0.50]\n[1234.57, 0.00]\n");
+    EXPECT_EQ(tMatrix.toString(Io::FormatSettings{Io::FloatFormat::Scientific, 1, "", "\t", "\n"}), "3.1e+00\t-5.0e-01\n1.2e+03\t2.0e-07\n");
+    EXPECT_EQ(tMatrix.toString(Io::FormatSettings{Io::FloatFormat::General, 3, "", " ", ";"}), "3.14 -0.5;1.23e+03 2e-07;");
+    EXPECT_EQ(Matrix<double>::create().toString(Io::FormatSettings{}), "");
+}
+
+TEST(Format, parallel_blocks)
+{
+    // More elements than one block, so the rows are split over the pool.
+    const auto tMatrix = spreadMatrix<double>(300, 200, 4);
+    Parallel::ThreadPool tPool{4};
+    const Io::FormatSettings tSettings;
+    const auto tParallel = tMatrix.toString(tSettings, tPool);
+    Parallel::SequentialExecutor tSequential;
+    EXPECT_EQ(tParallel, tMatrix.toString(tSettings, tSequential));
+    EXPECT_EQ(tMatrix.toString(Io::toStringFormat(), tPool), toStringReference(tMatrix));
+}
+
+TEST(Format, stream_operator_keeps_flags)
+{
+    const auto tMatrix = spreadMatrix<double>(6, 7, 5);
+    std::ostringstream tDefault;
+    tDefault << tMatrix;
+    EXPECT_EQ(tDefault.str(), streamReference(tMatrix, std::ostringstream{}));
+
+    std::ostringstream tFixed;
+    tFixed << std::fixed << std::setprecision(3);
+    const auto tFixedReference = streamReference(tMatrix, tFixed);
+    tFixed << tMatrix;
+    EXPECT_EQ(tFixed.str(), tFixedReference);
+
+    std::ostringstream tScientific;
+    tScientific << std::scientific << std::setprecision(10);
+    const auto tScientificReference = streamReference(tMatrix, tScientific);
+    tScientific << tMatrix;
+    EXPECT_EQ(tScientific.str(), tScientificReference);
+
+    // Flags the engine does not handle still go through the stream.
+    std::ostringstream tShowPos;
+    tShowPos << std::showpos;
+    const auto tShowPosReference = streamReference(tMatrix, tShowPos);
+    tShowPos << tMatrix;
+    EXPECT_EQ(tShowPos.str(), tShowPosReference);
+
+    const auto tInt = Matrix<int>::create({{255, -1}, {16, 0}});
+    std::ostringstream tHex;
+    tHex << std::hex;
+    tHex << tInt;
+    EXPECT_EQ(tHex.str(), " | ff | ffffffff | \n | 10 | 0 | \n");
+}
+
+TEST(Format, stream_operator_keeps_locale)
+{
+    const auto tMatrix = spreadMatrix<double>(6, 7, 6);
+    const auto tInt = Matrix<int>::create({{1234567, -1000}, {16, 0}});
+    std::ostringstream tStream;
+    tStream.imbue(std::locale{std::locale::classic(), new CommaPunct});
+    tStream << std::fixed << std::setprecision(2);
+    const auto tReference = streamReference(tMatrix, tStream) + streamReference(tInt, tStream);
+    tStream << tMatrix << tInt;
+    EXPECT_EQ(tStream.str(), tReference);
+    EXPECT_NE(tStream.str().find("1.234.567"), std::string::npos);
+}
+
+TEST(Format, rows_without_columns)
+{
+    const auto tEmptyRows = Matrix<double>::create(Row{2}, Column{0});
+    std::ostringstream tStream;
+    tStream << tEmptyRows;
+    EXPECT_EQ(tStream.str(), " | \n | \n");
+    EXPECT_EQ(tStream.str(), streamReference(tEmptyRows, std::ostringstream{}));
+    EXPECT_EQ(tEmptyRows.toString(), toStringReference(tEmptyRows));
+}
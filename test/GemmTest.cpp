@@ -0,0 +1,85 @@
+#include "../src/Kernels/gemm.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+template <typename T>
+struct GemmTest : public testing::Test
+{
+    static std::vector<T> random(std::size_t xCount)
+    {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+        std::vector<T> tResult(xCount);
+        for (auto &tElem : tResult)
+            tElem = static_cast<T>(dist(rng));
+        return tResult;
+    }
+
+    static void reference(std::size_t xM, std::size_t xN, std::size_t xK, T xAlpha,
+                          const T *xA, std::size_t xLda, const T *xB, std::size_t xLdb,
+                          T xBeta, T *xC, std::size_t xLdc)
+    {
+        for (std::size_t i = 0; i < xM; i++)
+        {
+            for (std::size_t j = 0; j < xN; j++)
+            {
+                double tSum = 0;
+                for (std::size_t k = 0; k < xK; k++)
+                    tSum += static_cast<double>(xA[i * xLda + k]) * static_cast<double>(xB[k * xLdb + j]);
+                xC[i * xLdc + j] = static_cast<T>(xAlpha * tSum + xBeta * xC[i * xLdc + j]);
+            }
+        }
+    }
+};
+
+using GemmTypes = testing::Types<float, double>;
+TYPED_TEST_SUITE(GemmTest, GemmTypes);
+
+TYPED_TEST(GemmTest, alpha_beta_leading_dimensions)
+{
+    using T = TypeParam;
+    constexpr std::size_t tM{133}, tN{97}, tK{301};
+    constexpr std::size_t tLda{tK + 3}, tLdb{tN + 5}, tLdc{tN + 7};
+
+    const auto tA = this->random(tM * tLda);
+    const auto tB = this->random(tK * tLdb);
+    auto tC = this->random(tM * tLdc);
+    auto tControl = tC;
+
+    Kernels::gemm<T>(tM, tN, tK, T(0.5), tA.data(), tLda, tB.data(), tLdb, T(-2), tC.data(), tLdc);
+    this->reference(tM, tN, tK, T(0.5), tA.data(), tLda, tB.data(), tLdb, T(-2), tControl.data(), tLdc);
+
+    const double tTolerance = std::is_same_v<T, float> ? 1e-3 : 1e-10;
+    for (std::size_t i = 0; i < tM; i++)
+    {
+        for (std::size_t j = 0; j < tLdc; j++)
+        {
+            if (j < tN)
+                EXPECT_NEAR(tControl[i * tLdc + j], tC[i * tLdc + j], tTolerance);
+            else // padding between rows stays untouched
+                EXPECT_EQ(tControl[i * tLdc + j], tC[i * tLdc + j]);
+        }
+    }
+}
+
+TYPED_TEST(GemmTest, beta_zero_overwrites)
+{
+    using T = TypeParam;
+    constexpr std::size_t tM{64}, tN{64}, tK{64};
+
+    const auto tA = this->random(tM * tK);
+    const auto tB = this->random(tK * tN);
+    std::vector<T> tC(tM * tN, std::numeric_limits<T>::quiet_NaN());
+    std::vector<T> tControl(tM * tN, T{});
+
+    Kernels::gemm<T>(tM, tN, tK, T(1), tA.data(), tK, tB.data(), tN, T(0), tC.data(), tN);
+    this->reference(tM, tN, tK, T(1), tA.data(), tK, tB.data(), tN, T(0), tControl.data(), tN);
+
+    for (std::size_t i = 0; i < tC.size(); i++)
+        EXPECT_NEAR(tControl[i], tC[i], 1e-3);
+}
@@ -0,0 +1,178 @@
+#include "../src/matrix.h"
+#include "../src/Types/half.h"
+#include "testHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+    float fromBits(std::uint32_t xBits)
+    {
+        float tResult;
+        std::memcpy(&tResult, &xBits, sizeof(tResult));
+        return tResult;
+    }
+
+    // Runs xBody once per SIMD level the CPU supports, scalar included.
+    template <typename Body>
+    void forEachSimdLevel(const Body &xBody)
+    {
+        const auto tSupported = Kernels::detectSimdLevel();
+        for (int tLevel = 0; tLevel <= static_cast<int>(tSupported); tLevel++)
+        {
+            Kernels::setSimdLevel(static_cast<Kernels::SimdLevel>(tLevel));
+            xBody();
+        }
+        Kernels::setSimdLevel(tSupported);
+    }
+
+    std::vector<float> interestingFloats()
+    {
+        std::vector<float> tResult{0.0f, -0.0f, 1.0f, -2.5f, 65504.0f, 65519.0f, 65520.0f, 1e10f, 6e-8f, 3e-8f, 1e-5f,
+                                   std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                                   std::numeric_limits<float>::quiet_NaN(), fromBits(0x3F808000), fromBits(0x3F818000)};
+        std::mt19937 rng(1);
+        std::uniform_int_distribution<std::uint32_t> tBits;
+        for (int i = 0; i < 4000; i++)
+            tResult.push_back(fromBits(tBits(rng)));
+        return tResult;
+    }
+} // namespace
+
+TEST(Half, scalar_conversion)
+{
+    EXPECT_EQ(Half{1.0f}.bits(), 0x3C00);
+    EXPECT_EQ(Half{-2.0f}.bits(), 0xC000);
+    EXPECT_EQ(Half{65504.0f}.bits(), 0x7BFF);
+    EXPECT_EQ(Half{65520.0f}.bits(), 0x7C00);
+    EXPECT_EQ(Half{5.9604645e-8f}.bits(), 0x0001);
+    // Ties round to even: 1 + 2^-11 down, 1 + 3 * 2^-11 up.
+    EXPECT_EQ(Half{1.00048828125f}.bits(), 0x3C00);
+    EXPECT_EQ(Half{1.00146484375f}.bits(), 0x3C02);
+    EXPECT_TRUE(std::isnan(static_cast<float>(Half{std::numeric_limits<float>::quiet_NaN()})));
+
+    // Every finite half survives the round trip through float.
+    for (std::uint32_t tBits = 0; tBits <= 0xFFFF; tBits++)
+    {
+        const auto tHalf = Half::fromBits(static_cast<std::uint16_t>(tBits));
+        const float tValue = static_cast<float>(tHalf);
+        if (!std::isnan(tValue))
+        {
+            ASSERT_EQ(Half{tValue}.bits(), tBits);
+        }
+    }
+}
+
+TEST(Half, bfloat16_conversion)
+{
+    EXPECT_EQ(BFloat16{1.0f}.bits(), 0x3F80);
+    EXPECT_EQ(BFloat16{1e30f}.bits(), 0x714A);
+    // Ties round to even.
+    EXPECT_EQ(BFloat16{fromBits(0x3F808000)}.bits(), 0x3F80);
+    EXPECT_EQ(BFloat16{fromBits(0x3F818000)}.bits(), 0x3F82);
+    EXPECT_TRUE(std::isnan(static_cast<float>(BFloat16{std::numeric_limits<float>::quiet_NaN()})));
+    EXPECT_EQ(static_cast<float>(std::numeric_limits<BFloat16>::max()), 3.3895314e38f);
+    EXPECT_EQ(static_cast<float>(std::numeric_limits<Half>::epsilon()), 0.0009765625f);
+}
+
+TEST(Half, vector_conversion_matches_scalar)
+{
+    const auto tFloats = interestingFloats();
+    const std::size_t n = tFloats.size();
+    forEachSimdLevel([&]
+                     {
+                         std::vector<Half> tHalf(n);
+                         std::vector<BFloat16> tBrain(n);
+                         std::vector<float> tBack(n);
+                         Kernels::narrow(tFloats.data(), tHalf.data(), n);
+                         Kernels::narrow(tFloats.data(), tBrain.data(), n);
+                         for (std::size_t i = 0; i < n; i++)
+                         {
+                             const bool tNaN = std::isnan(tFloats[i]);
+                             ASSERT_EQ(tNaN ? 0x7E00 : Half{tFloats[i]}.bits(), tNaN ? tHalf[i].bits() & 0x7E00 : tHalf[i].bits()) << i;
+                             ASSERT_EQ(BFloat16{tFloats[i]}.bits(), tBrain[i].bits()) << i;
+                         }
+
+                         Kernels::widen(tHalf.data(), tBack.data(), n);
+                         for (std::size_t i = 0; i < n; i++)
+                             ASSERT_TRUE(tBack[i] == static_cast<float>(tHalf[i]) || std::isnan(tBack[i])) << i;
+                         Kernels::widen(tBrain.data(), tBack.data(), n);
+                         for (std::size_t i = 0; i < n; i++)
+                             ASSERT_TRUE(tBack[i] == static_cast<float>(tBrain[i]) || std::isnan(tBack[i])) << i;
+                     });
+}
+
+TEST(Half, reductions_accumulate_in_float)
+{
+    // A half accumulator stops growing at 2048, where the spacing reaches 2.
+    const std::vector<Half> tOnes(5000, Half{1.0f});
+    EXPECT_EQ(static_cast<float>(Kernels::dot(tOnes.data(), tOnes.data(), tOnes.size())), 5000.0f);
+
+    std::vector<BFloat16> tLhs(1000, BFloat16{0.5f}), tRhs(1000, BFloat16{3.0f}), tOut(1000, BFloat16{1.0f});
+    Kernels::multiplyAdd(tLhs.data(), tRhs.data(), tOut.data(), tOut.size());
+    Kernels::add(tOut.data(), tLhs.data(), tOut.data(), tOut.size());
+    for (const auto &tValue : tOut)
+        ASSERT_EQ(static_cast<float>(tValue), 3.0f);
+}
+
+template <typename T>
+struct Float16Test : public testing::Test
+{
+};
+
+using Float16Types = testing::Types<Half, BFloat16>;
+TYPED_TEST_SUITE(Float16Test, Float16Types);
+
+TYPED_TEST(Float16Test, gemm_accumulates_in_float)
+{
+    // Long enough that K spans several KC blocks.
+    const std::size_t m = 37, n = 150, k = 700;
+    const auto tLhs = randomMatrix<TypeParam>(m, k, 1, -1.0f, 1.0f);
+    const auto tRhs = randomMatrix<TypeParam>(k, n, 2, -1.0f, 1.0f);
+    const double tUnit = static_cast<double>(static_cast<float>(std::numeric_limits<TypeParam>::epsilon())) / 2;
+
+    Parallel::ThreadPool tPool{4};
+    for (auto *tExecutor : {static_cast<Parallel::Executor *>(&tPool), static_cast<Parallel::Executor *>(nullptr)})
+    {
+        const auto tProduct = tExecutor ? multiply(tLhs, tRhs, *tExecutor) : tLhs * tRhs;
+        for (std::size_t i = 0; i < m; i++)
+        {
+            for (std::size_t j = 0; j < n; j++)
+            {
+                double tExact{0.0};
+                for (std::size_t p = 0; p < k; p++)
+                    tExact += static_cast<double>(static_cast<float>(tLhs(i, p))) * static_cast<double>(static_cast<float>(tRhs(p, j)));
+                // One rounding to 16 bits plus float accumulation error.
+                ASSERT_NEAR(static_cast<float>(tProduct(i, j)), tExact, tUnit * std::abs(tExact) + 1e-4) << i << ", " << j;
+            }
+        }
+    }
+
+    // alpha and beta
+    auto tC = randomMatrix<TypeParam>(m, n, 3, -1.0f, 1.0f);
+    const auto tOld = tC;
+    const auto tProduct = tLhs * tRhs;
+    Kernels::gemm(m, n, k, TypeParam{2.0f}, tLhs.getData().data(), tLhs.getLeadingDimension(), tRhs.getData().data(),
+                  tRhs.getLeadingDimension(), TypeParam{0.5f}, tC.getData().data(), tC.getLeadingDimension());
+    for (std::size_t i = 0; i < m; i++)
+        for (std::size_t j = 0; j < n; j++)
+            ASSERT_NEAR(static_cast<float>(tC(i, j)), 2.0f * static_cast<float>(tProduct(i, j)) + 0.5f * static_cast<float>(tOld(i, j)),
+                        4 * tUnit * (std::abs(2.0f * static_cast<float>(tProduct(i, j))) + 1.0f));
+}
+
+TYPED_TEST(Float16Test, matrix_operations)
+{
+    auto tMatrix = Matrix<TypeParam>::create(Row{2}, Column{2});
+    tMatrix(0, 0) = TypeParam{1.5f};
+    tMatrix(1, 1) = TypeParam{-2.0f};
+    const auto tSum = tMatrix + tMatrix;
+    EXPECT_EQ(static_cast<float>(tSum(0, 0)), 3.0f);
+    EXPECT_EQ(static_cast<float>(tSum(1, 1)), -4.0f);
+    EXPECT_EQ(static_cast<float>((tMatrix * TypeParam{2.0f})(0, 0)), 3.0f);
+    EXPECT_EQ(tMatrix.toString(), " | 1.500000 | 0.000000 | \n | 0.000000 | -2.000000 | \n");
+}
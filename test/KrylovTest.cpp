@@ -0,0 +1,191 @@
+#include "../src/Linalg/krylov.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+namespace
+{
+    // 5-point Laplacian on an xGrid x xGrid grid, plus xConvection times a first-order upwind
+    // term that makes it nonsymmetric.
+    CsrMatrix<double> poisson(std::size_t xGrid, double xConvection = 0.0)
+    {
+        const std::size_t n = xGrid * xGrid;
+        std::vector<Triplet<double>> tTriplets;
+        for (std::size_t i = 0; i < xGrid; i++)
+        {
+            for (std::size_t j = 0; j < xGrid; j++)
+            {
+                const std::size_t k = i * xGrid + j;
+                tTriplets.push_back({k, k, 4.0 + xConvection});
+                if (i > 0)
+                    tTriplets.push_back({k, k - xGrid, -1.0 - xConvection});
+                if (i + 1 < xGrid)
+                    tTriplets.push_back({k, k + xGrid, -1.0});
+                if (j > 0)
+                    tTriplets.push_back({k, k - 1, -1.0});
+                if (j + 1 < xGrid)
+                    tTriplets.push_back({k, k + 1, -1.0});
+            }
+        }
+        return CsrMatrix<double>::create(Row{n}, Column{n}, tTriplets);
+    }
+
+    Vector<double> randomVector(std::size_t xSize, unsigned xSeed)
+    {
+        std::mt19937 rng(xSeed);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+        auto tResult = Vector<double>::create(Row{xSize});
+        for (std::size_t i = 0; i < xSize; i++)
+            tResult[i] = dist(rng);
+        return tResult;
+    }
+
+    double relativeResidual(const CsrMatrix<double> &xMatrix, const Vector<double> &xSolution, const Vector<double> &xRhs)
+    {
+        const auto tProduct = xMatrix * xSolution;
+        double tResidual{0.0}, tRhs{0.0};
+        for (std::size_t i = 0; i < xRhs.size(); i++)
+        {
+            tResidual += (xRhs[i] - tProduct[i]) * (xRhs[i] - tProduct[i]);
+            tRhs += xRhs[i] * xRhs[i];
+        }
+        return std::sqrt(tResidual / tRhs);
+    }
+} // namespace
+
+TEST(Krylov, conjugate_gradient_with_preconditioners)
+{
+    const auto tMatrix = poisson(30);
+    const auto tRhs = randomVector(900, 1);
+    const Linalg::SparseOperator<double> tOperator{tMatrix};
+    const Linalg::KrylovSettings<double> tSettings{1e-10, 2000};
+
+    const auto tPlain = Linalg::conjugateGradient(tOperator, tRhs, tSettings);
+    ASSERT_TRUE(tPlain.has_value());
+    EXPECT_TRUE(tPlain->m_Converged);
+    EXPECT_LT(tPlain->m_Residual, 1e-9);
+    EXPECT_LT(relativeResidual(tMatrix, tPlain->m_Solution, tRhs), 1e-9);
+
+    const auto tJacobi = Linalg::JacobiPreconditioner<double>::create(tMatrix);
+    ASSERT_TRUE(tJacobi.has_value());
+    const auto tWithJacobi = Linalg::conjugateGradient(tOperator, tRhs, *tJacobi, tSettings);
+    ASSERT_TRUE(tWithJacobi.has_value());
+    EXPECT_TRUE(tWithJacobi->m_Converged);
+    EXPECT_LT(tWithJacobi->m_Residual, 1e-9);
+
+    // ILU(0) roughly halves the iteration count on the Laplacian.
+    const auto tIlu = Linalg::IncompleteLu<double>::create(tMatrix);
+    ASSERT_TRUE(tIlu.has_value());
+    const auto tWithIlu = Linalg::conjugateGradient(tOperator, tRhs, *tIlu, tSettings);
+    ASSERT_TRUE(tWithIlu.has_value());
+    EXPECT_TRUE(tWithIlu->m_Converged);
+    EXPECT_LT(tWithIlu->m_Residual, 1e-9);
+    EXPECT_LT(tWithIlu->m_Iterations * 3, tPlain->m_Iterations * 2);
+}
+
+TEST(Krylov, nonsymmetric_solvers)
+{
+    const auto tMatrix = poisson(25, 2.0);
+    const auto tRhs = randomVector(625, 2);
+    const Linalg::SparseOperator<double> tOperator{tMatrix};
+    const auto tIlu = Linalg::IncompleteLu<double>::create(tMatrix);
+    ASSERT_TRUE(tIlu.has_value());
+    Linalg::KrylovSettings<double> tSettings{1e-10, 2000, 20};
+
+    for (const auto &tResult : {Linalg::biCgStab(tOperator, tRhs, tSettings), Linalg::biCgStab(tOperator, tRhs, *tIlu, tSettings),
+                                Linalg::gmres(tOperator, tRhs, tSettings), Linalg::gmres(tOperator, tRhs, *tIlu, tSettings)})
+    {
+        ASSERT_TRUE(tResult.has_value());
+        EXPECT_TRUE(tResult->m_Converged);
+        EXPECT_LT(tResult->m_Residual, 1e-9);
+        EXPECT_LT(relativeResidual(tMatrix, tResult->m_Solution, tRhs), 1e-9);
+    }
+}
+
+TEST(Krylov, gmres_without_restart_is_exact_in_n_steps)
+{
+    const std::size_t n = 40;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    auto tMatrix = Matrix<double>::create(Row{n}, Column{n});
+    for (std::size_t i = 0; i < n; i++)
+        for (std::size_t j = 0; j < n; j++)
+            tMatrix(i, j) = dist(rng) + (i == j ? 10.0 : 0.0);
+    const auto tRhs = randomVector(n, 4);
+
+    Parallel::ThreadPool tPool{4};
+    const Linalg::DenseOperator tOperator{tMatrix, tPool};
+    const auto tResult = Linalg::gmres(tOperator, tRhs, Linalg::KrylovSettings<double>{1e-13, n, n});
+    ASSERT_TRUE(tResult.has_value());
+    EXPECT_TRUE(tResult->m_Converged);
+    EXPECT_LE(tResult->m_Iterations, n);
+    EXPECT_LT(tResult->m_Residual, 1e-12);
+}
+
+TEST(Krylov, ilu_of_a_tridiagonal_matrix_is_exact)
+{
+    // ILU(0) drops no fill-in on a tridiagonal pattern, so one application solves the system.
+    const std::size_t n = 50;
+    std::vector<Triplet<double>> tTriplets;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        tTriplets.push_back({i, i, 3.0 + static_cast<double>(i % 3)});
+        if (i > 0)
+            tTriplets.push_back({i, i - 1, -1.0});
+        if (i + 1 < n)
+            tTriplets.push_back({i, i + 1, -2.0});
+    }
+    const auto tMatrix = CsrMatrix<double>::create(Row{n}, Column{n}, tTriplets);
+    const auto tIlu = Linalg::IncompleteLu<double>::create(tMatrix);
+    ASSERT_TRUE(tIlu.has_value());
+
+    const auto tRhs = randomVector(n, 5);
+    auto tSolution = Vector<double>::create(Row{n});
+    tIlu->apply(tRhs.getData().data(), tSolution.getData().data());
+    EXPECT_LT(relativeResidual(tMatrix, tSolution, tRhs), 1e-13);
+
+    const auto tResult = Linalg::gmres(Linalg::SparseOperator<double>{tMatrix}, tRhs, *tIlu);
+    ASSERT_TRUE(tResult.has_value());
+    EXPECT_EQ(tResult->m_Iterations, 1UL);
+}
+
+TEST(Krylov, invalid_input)
+{
+    const auto tMatrix = poisson(4);
+    const Linalg::SparseOperator<double> tOperator{tMatrix};
+    EXPECT_FALSE(Linalg::conjugateGradient(tOperator, randomVector(15, 1)).has_value());
+
+    const auto tJacobi = Linalg::JacobiPreconditioner<double>::create(poisson(3));
+    ASSERT_TRUE(tJacobi.has_value());
+    EXPECT_FALSE(Linalg::gmres(tOperator, randomVector(16, 1), *tJacobi).has_value());
+
+    // Zero right-hand side: nothing to do.
+    const auto tZero = Linalg::biCgStab(tOperator, Vector<double>::create(Row{16}));
+    ASSERT_TRUE(tZero.has_value());
+    EXPECT_TRUE(tZero->m_Converged);
+    EXPECT_EQ(tZero->m_Iterations, 0UL);
+
+    // Missing diagonal entries.
+    const auto tHollow = CsrMatrix<double>::create(Row{2}, Column{2}, {{0, 1, 1.0}, {1, 0, 1.0}});
+    EXPECT_FALSE(Linalg::JacobiPreconditioner<double>::create(tHollow).has_value());
+    EXPECT_FALSE(Linalg::IncompleteLu<double>::create(tHollow).has_value());
+}
+
+TEST(Krylov, long_vectors_on_a_pool)
+{
+    // Long enough for the fused passes and the sparse product to split over the pool.
+    Parallel::ThreadPool tPool{4};
+    Parallel::setDefaultExecutor(&tPool);
+    const auto tMatrix = poisson(260);
+    const auto tRhs = randomVector(tMatrix.getRows().get(), 6);
+    const Linalg::SparseOperator<double> tOperator{tMatrix};
+    const auto tResult = Linalg::conjugateGradient(tOperator, tRhs, Linalg::KrylovSettings<double>{1e-8, 5000});
+    Parallel::setDefaultExecutor(nullptr);
+
+    ASSERT_TRUE(tResult.has_value());
+    EXPECT_TRUE(tResult->m_Converged);
+    EXPECT_LT(relativeResidual(tMatrix, tResult->m_Solution, tRhs), 1e-7);
+}
@@ -0,0 +1,126 @@
+#include "../src/Linalg/lu.h"
+#include "testHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    Matrix<double> permuted(const Matrix<double> &xMatrix, const std::vector<std::size_t> &xPermutation)
+    {
+        auto tResult = Matrix<double>::create(xMatrix.getRows(), xMatrix.getCols());
+        for (std::size_t i = 0; i < xPermutation.size(); i++)
+            for (std::size_t j = 0; j < xMatrix.getCols().get(); j++)
+                tResult(i, j) = xMatrix(xPermutation[i], j);
+        return tResult;
+    }
+} // namespace
+
+TEST(Lu, small_known_factorization)
+{
+    const auto tMatrix = Matrix<double>::create(std::vector<std::vector<double>>{{0, 2, 1}, {1, 1, 0}, {2, 1, 1}});
+    const auto tLu = Linalg::lu(tMatrix);
+    ASSERT_TRUE(tLu.has_value());
+
+    // Partial pivoting picks the 2 in the first column.
+    EXPECT_EQ(2UL, tLu->getPivots()[0]);
+    EXPECT_LT(maxDifference(permuted(tMatrix, tLu->getPermutation()), tLu->getL() * tLu->getU()), 1e-15);
+    EXPECT_NEAR(-3.0, tLu->det(), 1e-14);
+    EXPECT_NEAR(-3.0, *Linalg::det(tMatrix), 1e-14);
+
+    const auto tX = Linalg::solve(tMatrix, Vector<double>::create(std::vector<double>{3, 2, 4}));
+    ASSERT_TRUE(tX.has_value());
+    EXPECT_NEAR(1.0, (*tX)[0], 1e-14);
+    EXPECT_NEAR(1.0, (*tX)[1], 1e-14);
+    EXPECT_NEAR(1.0, (*tX)[2], 1e-14);
+}
+
+TEST(Lu, blocked_factorization_and_solves)
+{
+    Parallel::ThreadPool tPool{4};
+
+    // Larger than a few panels and not a multiple of the block size.
+    const std::size_t tSize = 3 * Linalg::gLuBlock + 37;
+    const auto tMatrix = randomMatrix(tSize, tSize, 1);
+    const auto tLu = Linalg::lu(tMatrix, tPool);
+    ASSERT_TRUE(tLu.has_value());
+    EXPECT_FALSE(tLu->isSingular());
+    EXPECT_LT(maxDifference(permuted(tMatrix, tLu->getPermutation()), tLu->getL() * tLu->getU()), 1e-12);
+
+    // |l_ij| <= 1 with partial pivoting.
+    const auto tL = tLu->getL();
+    for (std::size_t i = 0; i < tSize; i++)
+        for (std::size_t j = 0; j < i; j++)
+            EXPECT_LE(std::abs(tL(i, j)), 1.0);
+
+    const auto tRhs = randomMatrix(tSize, 53, 2);
+    const auto tX = tLu->solve(tRhs, tPool);
+    ASSERT_TRUE(tX.has_value());
+    EXPECT_LT(maxDifference(tMatrix * *tX, tRhs), 1e-10);
+
+    const auto tInverse = tLu->inverse(tPool);
+    ASSERT_TRUE(tInverse.has_value());
+    auto tIdentity = Matrix<double>::create(Row{tSize}, Column{tSize});
+    for (std::size_t i = 0; i < tSize; i++)
+        tIdentity(i, i) = 1.0;
+    EXPECT_LT(maxDifference(tMatrix * *tInverse, tIdentity), 1e-10);
+
+    auto tVector = Vector<double>::create(Row{tSize});
+    for (std::size_t i = 0; i < tSize; i++)
+        tVector[i] = tRhs(i, 0);
+    const auto tY = tLu->solve(tVector);
+    ASSERT_TRUE(tY.has_value());
+    for (std::size_t i = 0; i < tSize; i++)
+        EXPECT_NEAR((*tX)(i, 0), (*tY)[i], 1e-10);
+}
+
+TEST(Lu, lookahead_matches_sequential)
+{
+    // A pool factors each next panel alongside the trailing update. That must not change the
+    // pivots; the factors differ only by the rounding of the parallel gemm tiles.
+    const auto tMatrix = randomMatrix(4 * Linalg::gLuBlock + 5, 4 * Linalg::gLuBlock + 5, 3);
+    Parallel::SequentialExecutor tSequential;
+    Parallel::ThreadPool tPool{4};
+    const auto tExpected = Linalg::lu(tMatrix, tSequential);
+    const auto tLookahead = Linalg::lu(tMatrix, tPool);
+    ASSERT_TRUE(tExpected.has_value());
+    ASSERT_TRUE(tLookahead.has_value());
+    EXPECT_EQ(tExpected->getPivots(), tLookahead->getPivots());
+    EXPECT_LT(maxDifference(tExpected->getFactors(), tLookahead->getFactors()), 1e-11);
+}
+
+TEST(Lu, determinant_matches_product_of_factors)
+{
+    const auto tLhs = randomMatrix(200, 200, 3);
+    const auto tRhs = randomMatrix(200, 200, 4);
+    const double tProduct = *Linalg::det(tLhs) * *Linalg::det(tRhs);
+    EXPECT_NEAR(1.0, *Linalg::det(Matrix<double>{tLhs * tRhs}) / tProduct, 1e-9);
+}
+
+TEST(Lu, singular_and_non_square)
+{
+    auto tMatrix = randomMatrix(150, 150, 5);
+    for (std::size_t j = 0; j < 150; j++)
+        tMatrix(77, j) = tMatrix(12, j);
+
+    const auto tLu = Linalg::lu(tMatrix);
+    ASSERT_TRUE(tLu.has_value());
+    // Numerically singular: one pivot collapses to rounding level.
+    double tSmallest{1e300}, tLargest{0.0};
+    for (std::size_t i = 0; i < 150; i++)
+    {
+        tSmallest = std::min(tSmallest, std::abs(tLu->getFactors()(i, i)));
+        tLargest = std::max(tLargest, std::abs(tLu->getFactors()(i, i)));
+    }
+    EXPECT_LT(tSmallest, 1e-12 * tLargest);
+
+    auto tExact = Matrix<double>::create(std::vector<std::vector<double>>{{1, 2}, {2, 4}});
+    EXPECT_TRUE(Linalg::lu(tExact)->isSingular());
+    EXPECT_FALSE(Linalg::inverse(tExact).has_value());
+    EXPECT_FALSE(Linalg::solve(tExact, Vector<double>::create(std::vector<double>{1, 2})).has_value());
+
+    EXPECT_FALSE(Linalg::lu(randomMatrix(3, 4, 6)).has_value());
+    EXPECT_FALSE(Linalg::det(randomMatrix(3, 4, 6)).has_value());
+}
@@ -0,0 +1,151 @@
+#include "../src/matrixBatch.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    std::vector<Matrix<double>> randomMatrices(std::size_t xCount, std::size_t xRows, std::size_t xCols, unsigned xSeed)
+    {
+        std::mt19937 rng(xSeed);
+        std::uniform_int_distribution<int> dist(-5, 5);
+
+        std::vector<Matrix<double>> tResult;
+        for (std::size_t b = 0; b < xCount; b++)
+        {
+            auto tMatrix = Matrix<double>::create(Row{xRows}, Column{xCols});
+            for (std::size_t i = 0; i < xRows; i++)
+                for (std::size_t j = 0; j < xCols; j++)
+                    tMatrix(i, j) = static_cast<double>(dist(rng));
+            tResult.push_back(tMatrix);
+        }
+        return tResult;
+    }
+
+    // Diagonally dominant, so every matrix is well conditioned.
+    std::vector<Matrix<double>> invertibleMatrices(std::size_t xCount, std::size_t xSize, unsigned xSeed)
+    {
+        auto tResult = randomMatrices(xCount, xSize, xSize, xSeed);
+        for (auto &tMatrix : tResult)
+            for (std::size_t i = 0; i < xSize; i++)
+                tMatrix(i, i) += 6.0 * static_cast<double>(xSize);
+        return tResult;
+    }
+} // namespace
+
+TEST(MatrixBatch, interleaved_layout)
+{
+    const auto tMatrices = randomMatrices(21, 3, 2, 1);
+    auto tBatch = *MatrixBatch<double>::create(tMatrices);
+
+    EXPECT_EQ(21UL, tBatch.size());
+    EXPECT_EQ(0UL, tBatch.getStride() % (gMatrixAlignment / sizeof(double)));
+    EXPECT_EQ(6UL * tBatch.getStride(), tBatch.getData().size());
+    for (std::size_t b = 0; b < 21; b++)
+    {
+        EXPECT_TRUE(tMatrices[b] == tBatch.get(b));
+        EXPECT_DOUBLE_EQ(tMatrices[b](2, 1), tBatch.lane(2, 1)[b]);
+    }
+
+    EXPECT_THROW(tBatch.at(21, 0, 0), std::out_of_range);
+    EXPECT_THROW(tBatch.at(0, 3, 0), std::out_of_range);
+    EXPECT_THROW(tBatch.get(21), std::out_of_range);
+    EXPECT_FALSE(tBatch.set(0, Matrix<double>::create(Row{2}, Column{3})));
+
+    auto tMixed = tMatrices;
+    tMixed.push_back(Matrix<double>::create(Row{2}, Column{3}));
+    EXPECT_FALSE(MatrixBatch<double>::create(tMixed).has_value());
+}
+
+TEST(MatrixBatch, elementwise_and_transpose)
+{
+    const auto tLhs = randomMatrices(300, 4, 4, 2);
+    const auto tRhs = randomMatrices(300, 4, 4, 3);
+    const auto tBatchLhs = *MatrixBatch<double>::create(tLhs);
+    const auto tBatchRhs = *MatrixBatch<double>::create(tRhs);
+
+    const auto tSum = tBatchLhs + tBatchRhs;
+    const auto tDifference = tBatchLhs - tBatchRhs * 2.0;
+    const auto tTransposed = tBatchLhs.transposed();
+    for (std::size_t b = 0; b < 300; b++)
+    {
+        EXPECT_TRUE(Matrix<double>{tLhs[b] + tRhs[b]} == tSum.get(b));
+        EXPECT_TRUE(Matrix<double>{tLhs[b] - tRhs[b] * 2.0} == tDifference.get(b));
+        EXPECT_TRUE(tLhs[b].transposed() == tTransposed.get(b));
+    }
+
+    auto tOther = MatrixBatch<double>::create(Row{4}, Column{4}, 299);
+    EXPECT_EQ(0UL, (tBatchLhs + tOther).size());
+    tOther += tBatchLhs;
+    EXPECT_TRUE(tOther == MatrixBatch<double>::create(Row{4}, Column{4}, 299));
+}
+
+TEST(MatrixBatch, gemm_matches_matrix_product)
+{
+    const auto tLhs = randomMatrices(517, 6, 5, 4);
+    const auto tRhs = randomMatrices(517, 5, 6, 5);
+    const auto tProduct = *MatrixBatch<double>::create(tLhs) * *MatrixBatch<double>::create(tRhs);
+
+    EXPECT_EQ(6UL, tProduct.getRows().get());
+    EXPECT_EQ(6UL, tProduct.getCols().get());
+    for (std::size_t b = 0; b < 517; b++)
+        EXPECT_TRUE(tLhs[b] * tRhs[b] == tProduct.get(b));
+
+    EXPECT_EQ(0UL, (*MatrixBatch<double>::create(tLhs) * *MatrixBatch<double>::create(tLhs)).size());
+}
+
+TEST(MatrixBatch, inverse)
+{
+    const auto tMatrices = invertibleMatrices(333, 6, 6);
+    const auto tBatch = *MatrixBatch<double>::create(tMatrices);
+    const auto tInverse = tBatch.inverse();
+    ASSERT_TRUE(tInverse.has_value());
+
+    const auto tIdentity = tBatch * *tInverse;
+    for (std::size_t b = 0; b < 333; b++)
+        for (std::size_t i = 0; i < 6; i++)
+            for (std::size_t j = 0; j < 6; j++)
+                EXPECT_NEAR(i == j ? 1.0 : 0.0, tIdentity(b, i, j), 1e-12);
+
+    // A zero leading entry needs a row swap.
+    auto tPermutation = MatrixBatch<double>::create(Row{2}, Column{2}, 1);
+    tPermutation(0, 0, 1) = 1.0;
+    tPermutation(0, 1, 0) = 2.0;
+    const auto tPermutationInverse = tPermutation.inverse();
+    ASSERT_TRUE(tPermutationInverse.has_value());
+    EXPECT_DOUBLE_EQ(0.5, (*tPermutationInverse)(0, 0, 1));
+    EXPECT_DOUBLE_EQ(1.0, (*tPermutationInverse)(0, 1, 0));
+
+    auto tSingular = tBatch;
+    for (std::size_t j = 0; j < 6; j++)
+        tSingular(17, 3, j) = 0.0;
+    EXPECT_FALSE(tSingular.inverse().has_value());
+    EXPECT_FALSE(MatrixBatch<double>::create(Row{2}, Column{3}, 4).inverse().has_value());
+}
+
+TEST(MatrixBatch, parallel_kernels)
+{
+    Parallel::ThreadPool tPool{4};
+    Parallel::setDefaultExecutor(&tPool);
+
+    const auto tMatrices = invertibleMatrices(20000, 4, 7);
+    const auto tBatch = *MatrixBatch<double>::create(tMatrices);
+    const auto tSquare = tBatch * tBatch;
+    const auto tInverse = tBatch.inverse();
+    ASSERT_TRUE(tInverse.has_value());
+
+    for (std::size_t b = 0; b < 20000; b += 613)
+    {
+        EXPECT_TRUE(tMatrices[b] * tMatrices[b] == tSquare.get(b));
+        const auto tIdentity = tMatrices[b] * tInverse->get(b);
+        for (std::size_t i = 0; i < 4; i++)
+            for (std::size_t j = 0; j < 4; j++)
+                EXPECT_NEAR(i == j ? 1.0 : 0.0, tIdentity(i, j), 1e-12);
+    }
+
+    Parallel::setDefaultExecutor(nullptr);
+}
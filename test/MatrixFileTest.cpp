@@ -0,0 +1,223 @@
+#include "../src/matrix.h"
+#include "testHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::string tempPath(const std::string &xName)
+    {
+        return (std::filesystem::temp_directory_path() / ("matrix_file_test_" + xName + ".bin")).string();
+    }
+
+    std::string readBytes(const std::string &xPath)
+    {
+        std::ifstream tFile{xPath, std::ios::binary};
+        return std::string{std::istreambuf_iterator<char>{tFile}, std::istreambuf_iterator<char>{}};
+    }
+
+    void writeBytes(const std::string &xPath, const std::string &xBytes)
+    {
+        std::ofstream tFile{xPath, std::ios::binary | std::ios::trunc};
+        tFile.write(xBytes.data(), static_cast<std::streamsize>(xBytes.size()));
+    }
+} // namespace
+
+TEST(MatrixFile, save_and_load)
+{
+    const auto tPath = tempPath("round_trip");
+    const auto tDouble = randomMatrix<double>(37, 19, 1, -100.0f, 100.0f);
+    ASSERT_TRUE(tDouble.save(tPath));
+    EXPECT_EQ(std::filesystem::file_size(tPath), 64U + 37U * 19U * sizeof(double));
+    const auto tLoaded = Matrix<double>::load(tPath);
+    ASSERT_TRUE(tLoaded.has_value());
+    EXPECT_EQ(*tLoaded, tDouble);
+
+    const auto tInt = randomMatrix<std::int16_t>(5, 8, 2, -100.0f, 100.0f);
+    ASSERT_TRUE(tInt.save(tPath));
+    const auto tLoadedInt = Matrix<std::int16_t>::load(tPath);
+    ASSERT_TRUE(tLoadedInt.has_value());
+    EXPECT_EQ(*tLoadedInt, tInt);
+
+    const auto tHalf = randomMatrix<Half>(3, 4, 3, -100.0f, 100.0f);
+    ASSERT_TRUE(tHalf.save(tPath));
+    const auto tLoadedHalf = Matrix<Half>::load(tPath);
+    ASSERT_TRUE(tLoadedHalf.has_value());
+    EXPECT_EQ(*tLoadedHalf, tHalf);
+
+    const auto tEmpty = Matrix<float>::create();
+    ASSERT_TRUE(tEmpty.save(tPath));
+    const auto tLoadedEmpty = Matrix<float>::load(tPath);
+    ASSERT_TRUE(tLoadedEmpty.has_value());
+    EXPECT_EQ(tLoadedEmpty->getRows().get(), 0U);
+    std::filesystem::remove(tPath);
+}
+
+TEST(MatrixFile, map_file)
+{
+    const auto tPath = tempPath("mapped");
+    const auto tMatrix = randomMatrix<float>(64, 33, 4, -100.0f, 100.0f);
+    ASSERT_TRUE(tMatrix.save(tPath));
+
+    auto tMapped = Matrix<float>::mapFile(tPath);
+    ASSERT_TRUE(tMapped.has_value());
+    EXPECT_EQ(tMapped->getRows().get(), 64U);
+    EXPECT_EQ(tMapped->getCols().get(), 33U);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(tMapped->getData().data()) % 64, 0U);
+    EXPECT_TRUE(tMapped->verify());
+    for (std::size_t i = 0; i < 64; i++)
+        for (std::size_t j = 0; j < 33; j++)
+            ASSERT_EQ((*tMapped)(i, j), tMatrix(i, j));
+
+    // The view behaves like the matrix it came from.
+    const Matrix<float> tCopy = tMapped->view();
+    EXPECT_EQ(tCopy, tMatrix);
+    EXPECT_EQ(tMapped->view() * tMatrix.transposed(), tMatrix * tMatrix.transposed());
+
+    // Moving hands over the mapping.
+    const MappedMatrix<float> tMoved{std::move(*tMapped)};
+    EXPECT_EQ(tMoved(63, 32), tMatrix(63, 32));
+    EXPECT_EQ(tMapped->getRows().get(), 0U);
+    std::filesystem::remove(tPath);
+}
+
+TEST(MatrixFile, rejects_bad_files)
+{
+    const auto tPath = tempPath("bad");
+    EXPECT_FALSE(Matrix<double>::load(tPath + ".missing").has_value());
+    EXPECT_FALSE(Matrix<double>::mapFile(tPath + ".missing").has_value());
+
+    const auto tMatrix = randomMatrix<double>(10, 10, 5, -100.0f, 100.0f);
+    ASSERT_TRUE(tMatrix.save(tPath));
+    const auto tBytes = readBytes(tPath);
+
+    // Wrong element type.
+    EXPECT_FALSE(Matrix<float>::load(tPath).has_value());
+    EXPECT_FALSE(Matrix<std::int64_t>::mapFile(tPath).has_value());
+
+    // Truncated payload.
+    writeBytes(tPath, tBytes.substr(0, tBytes.size() - 8));
+    EXPECT_FALSE(Matrix<double>::load(tPath).has_value());
+    EXPECT_FALSE(Matrix<double>::mapFile(tPath).has_value());
+
+    // Not a matrix file.
+    writeBytes(tPath, std::string(200, 'x'));
+    EXPECT_FALSE(Matrix<double>::load(tPath).has_value());
+    EXPECT_FALSE(Matrix<double>::mapFile(tPath).has_value());
+
+    // A flipped payload bit fails the checksum; mapping succeeds until verify().
+    auto tCorrupt = tBytes;
+    tCorrupt[100] = static_cast<char>(tCorrupt[100] ^ 0x10);
+    writeBytes(tPath, tCorrupt);
+    EXPECT_FALSE(Matrix<double>::load(tPath).has_value());
+    const auto tMapped = Matrix<double>::mapFile(tPath);
+    ASSERT_TRUE(tMapped.has_value());
+    EXPECT_FALSE(tMapped->verify());
+    std::filesystem::remove(tPath);
+}
+
+TEST(MatrixFile, checksum_is_fixed)
+{
+    // The checksum is defined on bytes, so this value holds on hosts of either byte order.
+    unsigned char tBytes[100];
+    for (std::size_t i = 0; i < sizeof(tBytes); i++)
+        tBytes[i] = static_cast<unsigned char>(i * 7 + 3);
+    Io::Checksum tChecksum;
+    tChecksum.update(tBytes, sizeof(tBytes));
+    EXPECT_EQ(tChecksum.value(), 0x186F601AD3D68204ULL);
+}
+
+TEST(MatrixFile, foreign_byte_order)
+{
+    // A 3 x 5 int32 file as a big-endian machine writes it, built byte by byte. The checksum
+    // is the fixed value of its payload, not one computed by this host.
+    std::string tBytes(64 + 3 * 5 * 4, '\0');
+    const auto tPut = [&](std::size_t xOffset, std::uint64_t xValue, std::size_t xSize)
+    {
+        for (std::size_t k = 0; k < xSize; k++)
+            tBytes[xOffset + k] = static_cast<char>(xValue >> (8 * (xSize - 1 - k)));
+    };
+    std::memcpy(tBytes.data(), Io::gFileMagic, sizeof(Io::gFileMagic));
+    tPut(offsetof(Io::FileHeader, m_Version), Io::gFileVersion, 4);
+    tPut(offsetof(Io::FileHeader, m_ByteOrder), Io::gByteOrderMark, 4);
+    tPut(offsetof(Io::FileHeader, m_ElementType), static_cast<std::uint32_t>(Io::ElementType::Int32), 4);
+    tPut(offsetof(Io::FileHeader, m_ElementSize), 4, 4);
+    tPut(offsetof(Io::FileHeader, m_Rows), 3, 8);
+    tPut(offsetof(Io::FileHeader, m_Cols), 5, 8);
+    tPut(offsetof(Io::FileHeader, m_Stride), 5, 8);
+    tPut(offsetof(Io::FileHeader, m_PayloadOffset), 64, 8);
+    tPut(offsetof(Io::FileHeader, m_Checksum), 0x910905D248E8086AULL, 8);
+    auto tExpected = Matrix<std::int32_t>::create(Row{3}, Column{5});
+    for (std::size_t i = 0; i < 15; i++)
+    {
+        tExpected(i / 5, i % 5) = static_cast<std::int32_t>(i) * 0x01020304 - 12345;
+        tPut(64 + 4 * i, static_cast<std::uint32_t>(tExpected(i / 5, i % 5)), 4);
+    }
+
+    const auto tPath = tempPath("big_endian");
+    writeBytes(tPath, tBytes);
+    const auto tLoaded = Matrix<std::int32_t>::load(tPath);
+    // On a big-endian host the file is native; on a little-endian one it is converted.
+    ASSERT_TRUE(tLoaded.has_value());
+    EXPECT_EQ(*tLoaded, tExpected);
+    std::filesystem::remove(tPath);
+}
+
+TEST(MatrixFile, rejects_rows_without_payload)
+{
+    // A header claiming 2^50 rows of zero columns must fail, not loop over the rows.
+    const auto tPath = tempPath("no_payload");
+    auto tHeader = Io::Detail::makeHeader<double>(0, 0, 0);
+    tHeader.m_Rows = std::uint64_t{1} << 50;
+    writeBytes(tPath, std::string(reinterpret_cast<const char *>(&tHeader), sizeof(tHeader)));
+    EXPECT_FALSE(Matrix<double>::load(tPath).has_value());
+    EXPECT_FALSE(Matrix<double>::mapFile(tPath).has_value());
+
+    // A matrix without columns is stored as 0 x 0 and loads back.
+    ASSERT_TRUE(Matrix<double>::create(Row{4}, Column{0}).save(tPath));
+    const auto tLoaded = Matrix<double>::load(tPath);
+    ASSERT_TRUE(tLoaded.has_value());
+    EXPECT_EQ(tLoaded->getRows().get(), 0U);
+    std::filesystem::remove(tPath);
+}
+
+TEST(MatrixFile, stride_padding_is_bounded)
+{
+    // Rows padded up to a 64 byte line are valid: 5 doubles plus 3 zeros.
+    const auto tPath = tempPath("stride");
+    auto tHeader = Io::Detail::makeHeader<double>(2, 5, 8);
+    std::vector<double> tPayload(16, 0.0);
+    for (std::size_t j = 0; j < 5; j++)
+    {
+        tPayload[j] = static_cast<double>(j);
+        tPayload[8 + j] = static_cast<double>(10 + j);
+    }
+    Io::Checksum tChecksum;
+    tChecksum.update(tPayload.data(), tPayload.size() * sizeof(double));
+    tHeader.m_Checksum = tChecksum.value();
+    writeBytes(tPath, std::string(reinterpret_cast<const char *>(&tHeader), sizeof(tHeader)) +
+                          std::string(reinterpret_cast<const char *>(tPayload.data()), tPayload.size() * sizeof(double)));
+    const auto tLoaded = Matrix<double>::load(tPath);
+    ASSERT_TRUE(tLoaded.has_value());
+    EXPECT_DOUBLE_EQ(14.0, (*tLoaded)(1, 4));
+    ASSERT_TRUE(Matrix<double>::mapFile(tPath).has_value());
+
+    // A corrupted stride fails like any other bad header instead of sizing a padding buffer.
+    for (const std::uint64_t tStride : {std::uint64_t{13}, std::uint64_t{1} << 40, ~std::uint64_t{0}})
+    {
+        auto tCorrupt = Io::Detail::makeHeader<double>(0, 5, 0);
+        tCorrupt.m_Stride = tStride;
+        writeBytes(tPath, std::string(reinterpret_cast<const char *>(&tCorrupt), sizeof(tCorrupt)));
+        EXPECT_FALSE(Matrix<double>::load(tPath).has_value());
+        EXPECT_FALSE(Matrix<double>::mapFile(tPath).has_value());
+    }
+    std::filesystem::remove(tPath);
+}
@@ -28,12 +28,9 @@ struct MatrixTest : public testing::Test
         std::mt19937 rng(dev());
         std::uniform_real_distribution dist(0.0, 1.0);
 
-        for (auto &column : _In.getMatrix())
+        for (auto &element : _In.getData())
         {
-            for (auto &element : column)
-            {
-                element = dist(rng);
-            }
+            element = dist(rng);
         }
     }
 };
@@ -65,18 +62,15 @@ TEST_F(MatrixTest, randomize)
     std::vector<double> tControl;
     tControl.reserve(tMatrix.getCols().get() * tMatrix.getRows().get());
 
-    for (const auto &tColumn : tMatrix.getMatrix())
+    for (const auto &tElement : tMatrix.getData())
     {
-        for (const auto &tRow : tColumn)
+        EXPECT_LT(0.0, tElement);
+        EXPECT_GE(1.0, tElement);
+        for (const auto &tElem : tControl)
         {
-            EXPECT_LT(0.0, tRow);
-            EXPECT_GE(1.0, tRow);
-            for (const auto &tElem : tControl)
-            {
-                EXPECT_NE(tElem, tRow);
-            }
-            tControl.emplace_back(tRow);
+            EXPECT_NE(tElem, tElement);
         }
+        tControl.emplace_back(tElement);
     }
 }
 
@@ -85,11 +79,12 @@ TEST_F(MatrixTest, ceate_from_array)
     auto tMatrix = Get();
     RandomizeMatrix(tMatrix);
 
-    Matrix<double> tMatrixToControl = Matrix<double>::create(tMatrix.getMatrix().at(0));
+    const auto tFirstRow = tMatrix.getRow(0);
+    Matrix<double> tMatrixToControl = Matrix<double>::create(std::vector<double>(tFirstRow.begin(), tFirstRow.end()));
 
     for (size_t i = 0; i < tMatrix.getCols(); i++)
     {
-        EXPECT_DOUBLE_EQ(tMatrix.getMatrix().at(0).at(i), tMatrixToControl.getMatrix().at(i).at(0));
+        EXPECT_DOUBLE_EQ(tMatrix.at(0, i), tMatrixToControl.at(i, 0));
     }
 }
 
@@ -98,13 +93,20 @@ TEST_F(MatrixTest, create_from_vector_matrix)
     auto tMatrix = Get();
     RandomizeMatrix(tMatrix);
 
-    auto tMatrixToControl = Matrix<double>::create(tMatrix.getMatrix());
+    std::vector<std::vector<double>> tNested(tMatrix.getRows().get());
+    for (size_t i = 0; i < tMatrix.getRows(); i++)
+    {
+        const auto tRow = tMatrix.getRow(i);
+        tNested.at(i).assign(tRow.begin(), tRow.end());
+    }
+
+    auto tMatrixToControl = Matrix<double>::create(tNested);
 
     for (size_t i = 0; i < tMatrix.getRows(); i++)
     {
         for (size_t j = 0; j < tMatrix.getCols(); j++)
         {
-            EXPECT_DOUBLE_EQ(tMatrix.getMatrix().at(i).at(j), tMatrixToControl.getMatrix().at(i).at(j));
+            EXPECT_DOUBLE_EQ(tMatrix.at(i, j), tMatrixToControl.at(i, j));
         }
     }
 }
@@ -120,7 +122,7 @@ TEST_F(MatrixTest, create_from_other_matrix)
     {
         for (size_t j = 0; j < tMatrix.getCols(); j++)
         {
-            EXPECT_DOUBLE_EQ(tMatrix.getMatrix().at(i).at(j), tMatrixToControl.getMatrix().at(i).at(j));
+            EXPECT_DOUBLE_EQ(tMatrix.at(i, j), tMatrixToControl.at(i, j));
         }
     }
 }
@@ -136,7 +138,7 @@ TEST_F(MatrixTest, transpose)
     {
         for (size_t j = 0; j < tMatrix.getCols(); j++)
         {
-            EXPECT_DOUBLE_EQ(tMatrix.getMatrix().at(i).at(j), tMatrix_control.getMatrix().at(j).at(i));
+            EXPECT_DOUBLE_EQ(tMatrix.at(i, j), tMatrix_control.at(j, i));
         }
     }
 }
@@ -148,7 +150,7 @@ TEST_F(MatrixTest, erase)
 
     EXPECT_EQ(0, tMatrix.getCols().get());
     EXPECT_EQ(0, tMatrix.getRows().get());
-    EXPECT_EQ(0, tMatrix.getMatrix().size());
+    EXPECT_EQ(0, tMatrix.getData().size());
 }
 
 TEST_F(MatrixTest, operator_plus_equals_matrix)
@@ -164,7 +166,7 @@ TEST_F(MatrixTest, operator_plus_equals_matrix)
     {
         for (size_t j = 0; j < tMatrix.getCols(); j++)
         {
-            EXPECT_DOUBLE_EQ(tMatrix.getMatrix().at(i).at(j), tMatrixToControl.getMatrix().at(i).at(j) + tMatrixToControl2.getMatrix().at(i).at(j));
+            EXPECT_DOUBLE_EQ(tMatrix.at(i, j), tMatrixToControl.at(i, j) + tMatrixToControl2.at(i, j));
         }
     }
 }
@@ -182,7 +184,7 @@ TEST_F(MatrixTest, operator_minus_equals_matrix)
     {
         for (size_t j = 0; j < tMatrix.getCols(); j++)
         {
-            EXPECT_DOUBLE_EQ(tMatrix.getMatrix().at(i).at(j), tMatrixToControl2.getMatrix().at(i).at(j) - tMatrixToControl.getMatrix().at(i).at(j));
+            EXPECT_DOUBLE_EQ(tMatrix.at(i, j), tMatrixToControl2.at(i, j) - tMatrixToControl.at(i, j));
         }
     }
 }
@@ -203,7 +205,7 @@ TEST_F(MatrixTest, operator_multiply_equals_matrix_normal)
             double sum = 0;
             for (size_t k = 0; k < tMatrix.getCols().get(); k++)
             {
-                sum += tMatrix.getMatrix().at(i).at(k) * tMatrixToControl.getMatrix().at(k).at(j);
+                sum += tMatrix.at(i, k) * tMatrixToControl.at(k, j);
             }
             tMatrixToControl2.at(i).at(j) = sum;
         }
@@ -215,7 +217,7 @@ TEST_F(MatrixTest, operator_multiply_equals_matrix_normal)
     {
         for (size_t j = 0; j < tMatrix.getCols(); j++)
         {
-            EXPECT_DOUBLE_EQ(tMatrix.getMatrix().at(i).at(j), tMatrixToControl2.at(i).at(j));
+            EXPECT_DOUBLE_EQ(tMatrix.at(i, j), tMatrixToControl2.at(i).at(j));
         }
     }
 }
@@ -236,7 +238,7 @@ TEST_F(MatrixTest, operator_multiply_equals_matrix_powerOf)
     {
         for (size_t j = 0; j < tMatrix.getCols(); j++)
         {
-            EXPECT_DOUBLE_EQ(tMatrix.getMatrix().at(i).at(j), tMatrixToControl.getMatrix().at(i).at(j) * tMatrixToControl.getMatrix().at(i).at(j));
+            EXPECT_DOUBLE_EQ(tMatrix.at(i, j), tMatrixToControl.at(i, j) * tMatrixToControl.at(i, j));
         }
     }
 }
@@ -258,7 +260,7 @@ TEST_F(MatrixTest, operator_multiply_equals_matrix_Zeilenvektor_mal_Spaltenvekto
             double sum = 0;
             for (size_t k = 0; k < tMatrix.getCols().get(); k++)
             {
-                sum += tMatrix.getMatrix().at(i).at(k) * tMatrixToControl.getMatrix().at(k).at(j);
+                sum += tMatrix.at(i, k) * tMatrixToControl.at(k, j);
             }
             tMatrixToControl2.at(i).at(j) = sum;
         }
@@ -270,7 +272,7 @@ TEST_F(MatrixTest, operator_multiply_equals_matrix_Zeilenvektor_mal_Spaltenvekto
     {
         for (size_t j = 0; j < tMatrix.getCols(); j++)
         {
-            EXPECT_DOUBLE_EQ(tMatrix.getMatrix().at(i).at(j), tMatrixToControl2.at(i).at(j));
+            EXPECT_DOUBLE_EQ(tMatrix.at(i, j), tMatrixToControl2.at(i).at(j));
         }
     }
 }
@@ -292,7 +294,7 @@ TEST_F(MatrixTest, operator_multiply_equals_matrix_Spaltenvektor_mal_Zeilenvekto
             double sum = 0;
             for (size_t k = 0; k < tMatrix.getCols().get(); k++)
             {
-                sum += tMatrix.getMatrix().at(i).at(k) * tMatrixToControl.getMatrix().at(k).at(j);
+                sum += tMatrix.at(i, k) * tMatrixToControl.at(k, j);
             }
             tMatrixToControl2.at(i).at(j) = sum;
         }
@@ -304,7 +306,7 @@ TEST_F(MatrixTest, operator_multiply_equals_matrix_Spaltenvektor_mal_Zeilenvekto
     {
         for (size_t j = 0; j < tMatrix.getCols(); j++)
         {
-            EXPECT_DOUBLE_EQ(tMatrix.getMatrix().at(i).at(j), tMatrixToControl2.at(i).at(j));
+            EXPECT_DOUBLE_EQ(tMatrix.at(i, j), tMatrixToControl2.at(i).at(j));
         }
     }
 }
@@ -325,7 +327,7 @@ TEST_F(MatrixTest, operator_plus_equals_double)
     {
         for (size_t j = 0; j < tMatrix.getCols(); j++)
         {
-            EXPECT_DOUBLE_EQ(tMatrix.getMatrix().at(i).at(j), tMatrixToControl.getMatrix().at(i).at(j) + tElem);
+            EXPECT_DOUBLE_EQ(tMatrix.at(i, j), tMatrixToControl.at(i, j) + tElem);
         }
     }
 }
@@ -346,7 +348,7 @@ TEST_F(MatrixTest, operator_minus_equals_double)
     {
         for (size_t j = 0; j < tMatrix.getCols(); j++)
         {
-            EXPECT_DOUBLE_EQ(tMatrix.getMatrix().at(i).at(j), tMatrixToControl.getMatrix().at(i).at(j) - tElem);
+            EXPECT_DOUBLE_EQ(tMatrix.at(i, j), tMatrixToControl.at(i, j) - tElem);
         }
     }
 }
@@ -367,7 +369,7 @@ TEST_F(MatrixTest, operator_multiply_equals_double)
     {
         for (size_t j = 0; j < tMatrix.getCols(); j++)
         {
-            EXPECT_DOUBLE_EQ(tMatrix.getMatrix().at(i).at(j), tMatrixToControl.getMatrix().at(i).at(j) * tElem);
+            EXPECT_DOUBLE_EQ(tMatrix.at(i, j), tMatrixToControl.at(i, j) * tElem);
         }
     }
 }
@@ -380,4 +382,264 @@ TEST_F(MatrixTest, operator_not_equals)
     RandomizeMatrix(tMatrixToControl);
 
     EXPECT_TRUE(tMatrix != tMatrixToControl);
-}
\ No newline at end of file
+}
+
+TEST_F(MatrixTest, contiguous_storage)
+{
+    auto tMatrix = matrixWithData;
+
+    EXPECT_EQ(gColumns, tMatrix.getLeadingDimension());
+    EXPECT_EQ(gRows * gColumns, tMatrix.getData().size());
+    EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(tMatrix.getData().data()) % gMatrixAlignment);
+
+    for (size_t i = 0; i < tMatrix.getRows(); i++)
+    {
+        for (size_t j = 0; j < tMatrix.getCols(); j++)
+        {
+            EXPECT_EQ(&tMatrix.at(i, j), tMatrix.getData().data() + i * tMatrix.getLeadingDimension() + j);
+            EXPECT_EQ(&tMatrix.at(i, j), &tMatrix.getRow(i)[j]);
+            EXPECT_EQ(&tMatrix.at(i, j), &tMatrix.getColumn(j)[i]);
+        }
+    }
+
+    EXPECT_THROW(tMatrix.at(gRows, 0), std::out_of_range);
+    EXPECT_THROW(tMatrix.at(0, gColumns), std::out_of_range);
+}
+
+TEST_F(MatrixTest, operator_multiply_blocked)
+{
+    // Large and odd enough to cross every cache block and leave partial register tiles.
+    auto tLhs = Matrix<double>::create(Row{301}, Column{517});
+    auto tRhs = Matrix<double>::create(Row{517}, Column{263});
+    RandomizeMatrix(tLhs);
+    RandomizeMatrix(tRhs);
+
+    auto tResult = tLhs * tRhs;
+
+    ASSERT_EQ(301, tResult.getRows().get());
+    ASSERT_EQ(263, tResult.getCols().get());
+    for (size_t i = 0; i < tResult.getRows(); i++)
+    {
+        for (size_t j = 0; j < tResult.getCols(); j++)
+        {
+            double sum = 0;
+            for (size_t k = 0; k < tLhs.getCols(); k++)
+            {
+                sum += tLhs.at(i, k) * tRhs.at(k, j);
+            }
+            EXPECT_NEAR(sum, tResult.at(i, j), 1e-10);
+        }
+    }
+}
+
+TEST_F(MatrixTest, operator_multiply_blocked_integral)
+{
+    auto tLhs = Matrix<int>::create(Row{70}, Column{90});
+    auto tRhs = Matrix<int>::create(Row{90}, Column{50});
+    for (size_t i = 0; i < tLhs.getData().size(); i++)
+        tLhs.getData()[i] = static_cast<int>(i % 7) - 3;
+    for (size_t i = 0; i < tRhs.getData().size(); i++)
+        tRhs.getData()[i] = static_cast<int>(i % 5) - 2;
+
+    auto tResult = tLhs * tRhs;
+
+    for (size_t i = 0; i < tResult.getRows(); i++)
+    {
+        for (size_t j = 0; j < tResult.getCols(); j++)
+        {
+            int sum = 0;
+            for (size_t k = 0; k < tLhs.getCols(); k++)
+            {
+                sum += tLhs.at(i, k) * tRhs.at(k, j);
+            }
+            EXPECT_EQ(sum, tResult.at(i, j));
+        }
+    }
+}
+
+TEST_F(MatrixTest, expression_fused)
+{
+    const auto tA = matrixWithData;
+    auto tB = Get();
+    auto tC = Get();
+    RandomizeMatrix(tB);
+    RandomizeMatrix(tC);
+
+    Matrix<double> tResult = tA + tB - tC * 2.0 + 1.0;
+
+    ASSERT_EQ(gRows, tResult.getRows().get());
+    ASSERT_EQ(gColumns, tResult.getCols().get());
+    for (size_t i = 0; i < gRows; i++)
+    {
+        for (size_t j = 0; j < gColumns; j++)
+        {
+            EXPECT_DOUBLE_EQ(tA.at(i, j) + tB.at(i, j) - tC.at(i, j) * 2.0 + 1.0, tResult.at(i, j));
+        }
+    }
+}
+
+TEST_F(MatrixTest, expression_assign_aliasing)
+{
+    auto tMatrix = matrixWithData;
+    const auto tControl = tMatrix;
+    const auto *tStorage = tMatrix.getData().data();
+
+    tMatrix = tMatrix + tMatrix * 3.0;
+
+    EXPECT_EQ(tStorage, tMatrix.getData().data());
+    for (size_t i = 0; i < gRows; i++)
+    {
+        for (size_t j = 0; j < gColumns; j++)
+        {
+            EXPECT_DOUBLE_EQ(tControl.at(i, j) * 4.0, tMatrix.at(i, j));
+        }
+    }
+}
+
+TEST_F(MatrixTest, expression_dimension_mismatch_keeps_lhs)
+{
+    const auto tMatrix = matrixWithData;
+    auto tOther = Matrix<double>::create(Row{gColumns}, Column{gRows});
+    RandomizeMatrix(tOther);
+
+    auto tResult = evaluate(tMatrix + tOther);
+
+    EXPECT_TRUE(tResult == tMatrix);
+}
+
+TEST_F(MatrixTest, expression_product_operands)
+{
+    const auto tA = matrixWithData;
+    auto tB = Matrix<double>::create(Row{gColumns}, Column{gRows});
+    RandomizeMatrix(tB);
+
+    const auto tResult = (tA * 2.0) * tB;
+    const auto tControl = evaluate(tA * 2.0) * tB;
+
+    EXPECT_TRUE(tResult == tControl);
+}
+
+TEST_F(MatrixTest, compound_assignment_in_place)
+{
+    auto tMatrix = matrixWithData;
+    const auto tControl = tMatrix;
+    const auto *tStorage = tMatrix.getData().data();
+
+    tMatrix += tControl;
+    tMatrix -= tControl * 0.5;
+    tMatrix *= 2.0;
+    tMatrix += 1.0;
+    tMatrix -= 3.0;
+
+    auto tSquare = Matrix<double>::create(Row{gColumns}, Column{gColumns});
+    RandomizeMatrix(tSquare);
+    const auto tProduct = tMatrix * tSquare;
+    tMatrix *= tSquare;
+
+    EXPECT_EQ(tStorage, tMatrix.getData().data());
+    for (size_t i = 0; i < gRows; i++)
+    {
+        for (size_t j = 0; j < gColumns; j++)
+        {
+            EXPECT_DOUBLE_EQ(tProduct.at(i, j), tMatrix.at(i, j));
+        }
+    }
+}
+
+TEST_F(MatrixTest, compound_multiply_nested_in_parallel_for)
+{
+    // Every *= runs its product on the pool the outer tasks run on.
+    constexpr std::size_t tCount{16}, tSize{300};
+    auto tRhs = Matrix<double>::create(Row{tSize}, Column{tSize});
+    RandomizeMatrix(tRhs);
+    std::vector<Matrix<double>> tMatrices, tExpected;
+    for (std::size_t i = 0; i < tCount; i++)
+    {
+        tMatrices.push_back(Matrix<double>::create(Row{tSize}, Column{tSize}));
+        RandomizeMatrix(tMatrices.back());
+        tExpected.push_back(tMatrices.back() * tRhs);
+    }
+
+    Parallel::ThreadPool tPool{4};
+    Parallel::setDefaultExecutor(&tPool);
+    tPool.parallelFor(tCount, [&](std::size_t i)
+                      { tMatrices[i] *= tRhs; });
+    Parallel::setDefaultExecutor(nullptr);
+
+    for (std::size_t i = 0; i < tCount; i++)
+    {
+        EXPECT_EQ(tExpected[i], tMatrices[i]) << "matrix " << i;
+    }
+}
+
+TEST_F(MatrixTest, rvalue_operators_reuse_storage)
+{
+    const auto tA = matrixWithData;
+    auto tB = Get();
+    RandomizeMatrix(tB);
+
+    auto tExpiring = tA;
+    const auto *tStorage = tExpiring.getData().data();
+    Matrix<double> tSum = std::move(tExpiring) + tB;
+    EXPECT_EQ(tStorage, tSum.getData().data());
+
+    auto tExpiringRhs = tB;
+    tStorage = tExpiringRhs.getData().data();
+    Matrix<double> tDifference = tA - std::move(tExpiringRhs);
+    EXPECT_EQ(tStorage, tDifference.getData().data());
+
+    tStorage = tSum.getData().data();
+    Matrix<double> tScaled = std::move(tSum) * 3.0;
+    EXPECT_EQ(tStorage, tScaled.getData().data());
+
+    for (size_t i = 0; i < gRows; i++)
+    {
+        for (size_t j = 0; j < gColumns; j++)
+        {
+            EXPECT_DOUBLE_EQ(tA.at(i, j) - tB.at(i, j), tDifference.at(i, j));
+            EXPECT_DOUBLE_EQ((tA.at(i, j) + tB.at(i, j)) * 3.0, tScaled.at(i, j));
+        }
+    }
+}
+
+TEST_F(MatrixTest, transpose_in_place_shapes)
+{
+    for (const auto &tShape : std::vector<std::pair<size_t, size_t>>{{1, 7}, {7, 1}, {64, 64}, {67, 67}, {67, 131}, {256, 3}})
+    {
+        auto tMatrix = Matrix<double>::create(Row{tShape.first}, Column{tShape.second});
+        RandomizeMatrix(tMatrix);
+        const auto tControl = tMatrix;
+        const auto *tStorage = tMatrix.getData().data();
+
+        EXPECT_TRUE(tMatrix.transpose());
+
+        EXPECT_EQ(tStorage, tMatrix.getData().data());
+        ASSERT_EQ(tShape.second, tMatrix.getRows().get());
+        ASSERT_EQ(tShape.first, tMatrix.getCols().get());
+        for (size_t i = 0; i < tMatrix.getRows(); i++)
+        {
+            for (size_t j = 0; j < tMatrix.getCols(); j++)
+            {
+                EXPECT_EQ(tControl.at(j, i), tMatrix.at(i, j));
+            }
+        }
+    }
+}
+
+TEST_F(MatrixTest, transposed)
+{
+    auto tMatrix = Matrix<double>::create(Row{97}, Column{213});
+    RandomizeMatrix(tMatrix);
+
+    const auto tTransposed = tMatrix.transposed();
+
+    ASSERT_EQ(213, tTransposed.getRows().get());
+    ASSERT_EQ(97, tTransposed.getCols().get());
+    for (size_t i = 0; i < tTransposed.getRows(); i++)
+    {
+        for (size_t j = 0; j < tTransposed.getCols(); j++)
+        {
+            EXPECT_EQ(tMatrix.at(j, i), tTransposed.at(i, j));
+        }
+    }
+}
@@ -0,0 +1,140 @@
+#include "../src/matrix.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+class MatrixViewTest : public ::testing::Test
+{
+protected:
+    // (i, j) = 10 * i + j
+    static Matrix<double> numbered(std::size_t xRows, std::size_t xCols)
+    {
+        auto tResult = Matrix<double>::create(Row{xRows}, Column{xCols});
+        for (std::size_t i = 0; i < xRows; i++)
+            for (std::size_t j = 0; j < xCols; j++)
+                tResult(i, j) = static_cast<double>(10 * i + j);
+        return tResult;
+    }
+};
+
+TEST_F(MatrixViewTest, block_shares_storage)
+{
+    auto tMatrix = numbered(5, 6);
+    auto tBlock = tMatrix.block(1, 2, 3, 2);
+
+    EXPECT_EQ(3UL, tBlock.getRows().get());
+    EXPECT_EQ(2UL, tBlock.getCols().get());
+    EXPECT_EQ(6UL, tBlock.getLeadingDimension());
+    EXPECT_EQ(&tMatrix(1, 2), tBlock.data());
+    EXPECT_DOUBLE_EQ(32.0, tBlock(2, 0));
+
+    tBlock(0, 1) = -1.0;
+    EXPECT_DOUBLE_EQ(-1.0, tMatrix(1, 3));
+
+    // Sub-blocks, rows and columns of a view are views of the same matrix.
+    EXPECT_EQ(&tMatrix(2, 3), tBlock.block(1, 1, 1, 1).data());
+    EXPECT_DOUBLE_EQ(40.0, tMatrix.col(0)(4, 0));
+    EXPECT_DOUBLE_EQ(25.0, tMatrix.row(2)(0, 5));
+    EXPECT_EQ(6UL, tMatrix.row(2).getCols().get());
+    EXPECT_EQ(5UL, tMatrix.col(0).getRows().get());
+}
+
+TEST_F(MatrixViewTest, out_of_range)
+{
+    auto tMatrix = numbered(3, 3);
+    const auto &tConst = tMatrix;
+
+    EXPECT_THROW(tMatrix.block(2, 0, 2, 1), std::out_of_range);
+    EXPECT_THROW(tConst.block(0, 1, 1, 3), std::out_of_range);
+    EXPECT_THROW(tMatrix.row(3), std::out_of_range);
+    EXPECT_THROW(tMatrix.col(3), std::out_of_range);
+    EXPECT_THROW(tMatrix.view().at(0, 3), std::out_of_range);
+    EXPECT_NO_THROW(tMatrix.block(3, 3, 0, 0));
+}
+
+TEST_F(MatrixViewTest, expressions)
+{
+    auto tMatrix = numbered(4, 4);
+    const ConstMatrixView<double> tTop = tMatrix.block(0, 0, 2, 4);
+    const ConstMatrixView<double> tBottom = tMatrix.block(2, 0, 2, 4);
+
+    const Matrix<double> tSum = tTop + tBottom * 2.0 - 1.0;
+    ASSERT_EQ(2UL, tSum.getRows().get());
+    for (std::size_t i = 0; i < 2; i++)
+        for (std::size_t j = 0; j < 4; j++)
+            EXPECT_DOUBLE_EQ(tMatrix(i, j) + 2.0 * tMatrix(i + 2, j) - 1.0, tSum(i, j));
+
+    // Views and matrices mix.
+    const Matrix<double> tMixed = tTop - tSum;
+    EXPECT_DOUBLE_EQ(tMatrix(1, 3) - tSum(1, 3), tMixed(1, 3));
+}
+
+TEST_F(MatrixViewTest, assign_through_view)
+{
+    auto tMatrix = numbered(4, 5);
+    const auto tControl = tMatrix;
+    const auto tOnes = Matrix<double>::create(std::vector<std::vector<double>>{{1, 1}, {1, 1}});
+
+    tMatrix.block(1, 1, 2, 2) = tOnes;
+    tMatrix.block(1, 1, 2, 2) += tOnes * 3.0;
+    tMatrix.block(1, 1, 2, 2) *= 0.5;
+    for (std::size_t i = 0; i < 4; i++)
+        for (std::size_t j = 0; j < 5; j++)
+        {
+            const bool tInside = i >= 1 && i < 3 && j >= 1 && j < 3;
+            EXPECT_DOUBLE_EQ(tInside ? 2.0 : tControl(i, j), tMatrix(i, j));
+        }
+
+    // Views copy elements instead of rebinding.
+    tMatrix.row(0) = tMatrix.row(3);
+    EXPECT_DOUBLE_EQ(34.0, tMatrix(0, 4));
+    EXPECT_DOUBLE_EQ(4.0, tControl(0, 4));
+
+    // Shape mismatch leaves the block unchanged.
+    tMatrix.block(0, 0, 1, 2) = tOnes;
+    EXPECT_DOUBLE_EQ(30.0, tMatrix(0, 0));
+}
+
+TEST_F(MatrixViewTest, overlapping_assignment)
+{
+    auto tMatrix = numbered(5, 5);
+    const auto tControl = tMatrix;
+
+    // Shift a window down-right and up-left within the same buffer.
+    tMatrix.block(1, 1, 4, 4) = tMatrix.block(0, 0, 4, 4);
+    for (std::size_t i = 1; i < 5; i++)
+        for (std::size_t j = 1; j < 5; j++)
+            EXPECT_DOUBLE_EQ(tControl(i - 1, j - 1), tMatrix(i, j));
+
+    tMatrix = tControl;
+    tMatrix.block(0, 0, 4, 4) += tMatrix.block(1, 1, 4, 4);
+    for (std::size_t i = 0; i < 4; i++)
+        for (std::size_t j = 0; j < 4; j++)
+            EXPECT_DOUBLE_EQ(tControl(i, j) + tControl(i + 1, j + 1), tMatrix(i, j));
+}
+
+TEST_F(MatrixViewTest, product_and_transpose)
+{
+    const auto tMatrix = numbered(6, 7);
+    const auto tLhs = tMatrix.block(1, 0, 3, 4);
+    const auto tRhs = tMatrix.block(2, 3, 4, 2);
+
+    const auto tControl = Matrix<double>{tLhs} * Matrix<double>{tRhs};
+    EXPECT_TRUE(tControl == tLhs * tRhs);
+    EXPECT_TRUE(tControl == multiply(tLhs, tRhs));
+    Parallel::SequentialExecutor tExecutor;
+    EXPECT_TRUE(tControl == multiply(tLhs, tRhs, tExecutor));
+    EXPECT_EQ(0UL, multiply(tLhs, tLhs).getRows().get());
+
+    // Matrix * view, view * Matrix and products with expressions.
+    const Matrix<double> tLhsCopy{tLhs};
+    const Matrix<double> tRhsCopy{tRhs};
+    EXPECT_TRUE(tControl == tLhsCopy * tRhs);
+    EXPECT_TRUE(tControl == tLhs * tRhsCopy);
+    EXPECT_TRUE(tControl == tLhsCopy * (tRhs + 0.0));
+
+    const auto tTransposed = tLhs.transposed();
+    EXPECT_EQ(4UL, tTransposed.getRows().get());
+    EXPECT_TRUE(tTransposed == Matrix<double>{tLhs}.transposed());
+}
@@ -0,0 +1,139 @@
+#include "../src/Memory/monotonicArena.h"
+#include "../src/Memory/poolResource.h"
+#include "../src/matrix.h"
+#include "../src/vector.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory_resource>
+
+namespace
+{
+    bool isAligned(const void *xPtr)
+    {
+        return reinterpret_cast<std::uintptr_t>(xPtr) % gMatrixAlignment == 0;
+    }
+} // namespace
+
+TEST(MonotonicArena, aligned_and_reset)
+{
+    MonotonicArena tArena{1024};
+
+    void *tFirst = tArena.allocate(10, 1);
+    void *tSecond = tArena.allocate(100, 8);
+    EXPECT_TRUE(isAligned(tFirst));
+    EXPECT_TRUE(isAligned(tSecond));
+    EXPECT_NE(tFirst, tSecond);
+    EXPECT_EQ(110UL, tArena.used());
+
+    // Larger than the chunk: a new, bigger chunk is added.
+    void *tLarge = tArena.allocate(4096, 8);
+    EXPECT_TRUE(isAligned(tLarge));
+    const auto tCapacity = tArena.capacity();
+    EXPECT_GT(tCapacity, 4096UL);
+
+    // Only the newest chunk survives reset and is handed out again.
+    tArena.reset();
+    EXPECT_EQ(0UL, tArena.used());
+    const auto tKept = tArena.capacity();
+    EXPECT_LT(tKept, tCapacity);
+    void *tAgain = tArena.allocate(10, 1);
+    EXPECT_TRUE(isAligned(tAgain));
+    EXPECT_EQ(tKept, tArena.capacity());
+
+    tArena.release();
+    EXPECT_EQ(0UL, tArena.capacity());
+}
+
+TEST(PoolResource, size_classes)
+{
+    EXPECT_EQ(64UL, PoolResource::classSize(1));
+    EXPECT_EQ(64UL, PoolResource::classSize(64));
+    EXPECT_EQ(96UL, PoolResource::classSize(65));
+    EXPECT_EQ(128UL, PoolResource::classSize(97));
+    EXPECT_EQ(192UL, PoolResource::classSize(129));
+    EXPECT_EQ(8192UL, PoolResource::classSize(8000));
+    EXPECT_EQ(PoolResource::gPoolLargestClass, PoolResource::classSize(PoolResource::gPoolLargestClass));
+}
+
+TEST(PoolResource, reuses_freed_blocks)
+{
+    PoolResource tPool;
+
+    void *tFirst = tPool.allocate(1000, 8);
+    EXPECT_TRUE(isAligned(tFirst));
+    tPool.deallocate(tFirst, 1000, 8);
+    EXPECT_EQ(PoolResource::classSize(1000), tPool.cached());
+
+    // Same class, same block.
+    void *tSecond = tPool.allocate(900, 8);
+    EXPECT_EQ(tFirst, tSecond);
+    EXPECT_EQ(0UL, tPool.cached());
+    tPool.deallocate(tSecond, 900, 8);
+
+    void *tLarge = tPool.allocate(PoolResource::gPoolLargestClass + 1, 8);
+    EXPECT_TRUE(isAligned(tLarge));
+    tPool.deallocate(tLarge, PoolResource::gPoolLargestClass + 1, 8);
+    EXPECT_EQ(PoolResource::classSize(1000), tPool.cached());
+}
+
+TEST(Allocator, pmr_matrix_uses_resource)
+{
+    MonotonicArena tArena;
+    std::pmr::polymorphic_allocator<double> tAllocator{&tArena};
+
+    auto tLhs = Pmr::Matrix<double>::create(Row{3}, Column{4}, tAllocator);
+    auto tRhs = Pmr::Matrix<double>::create(Row{4}, Column{2}, tAllocator);
+    EXPECT_EQ(12 * sizeof(double) + 8 * sizeof(double), tArena.used());
+    for (std::size_t i = 0; i < 3; i++)
+        for (std::size_t j = 0; j < 4; j++)
+            tLhs(i, j) = static_cast<double>(i + j);
+    for (std::size_t i = 0; i < 4; i++)
+        for (std::size_t j = 0; j < 2; j++)
+            tRhs(i, j) = static_cast<double>(i * j);
+
+    // Products and transposes allocate from the left operand's resource.
+    const auto tUsed = tArena.used();
+    auto tProduct = tLhs * tRhs;
+    EXPECT_EQ(tProduct.get_allocator().resource(), &tArena);
+    EXPECT_EQ(tUsed + 6 * sizeof(double), tArena.used());
+    EXPECT_EQ(tLhs.transposed().get_allocator().resource(), &tArena);
+
+    // Same values as with the default allocator.
+    auto tHeapLhs = Matrix<double>::create(Row{3}, Column{4});
+    auto tHeapRhs = Matrix<double>::create(Row{4}, Column{2});
+    for (std::size_t i = 0; i < 3; i++)
+        for (std::size_t j = 0; j < 4; j++)
+            tHeapLhs(i, j) = tLhs(i, j);
+    for (std::size_t i = 0; i < 4; i++)
+        for (std::size_t j = 0; j < 2; j++)
+            tHeapRhs(i, j) = tRhs(i, j);
+    const auto tHeapProduct = tHeapLhs * tHeapRhs;
+    for (std::size_t i = 0; i < 3; i++)
+        for (std::size_t j = 0; j < 2; j++)
+            EXPECT_DOUBLE_EQ(tHeapProduct(i, j), tProduct(i, j));
+
+    // Expressions evaluate into the resource they are given.
+    Pmr::Matrix<double> tSum{tLhs + tLhs * 2.0, tAllocator};
+    EXPECT_EQ(tSum.get_allocator().resource(), &tArena);
+    EXPECT_DOUBLE_EQ(3.0 * tLhs(2, 3), tSum(2, 3));
+    tSum += tLhs;
+    EXPECT_DOUBLE_EQ(4.0 * tLhs(2, 3), tSum(2, 3));
+}
+
+TEST(Allocator, pmr_vector_uses_resource)
+{
+    PoolResource tPool;
+    std::pmr::polymorphic_allocator<float> tAllocator{&tPool};
+
+    auto tVector = Pmr::Vector<float>::create(std::vector<float>{1.f, 2.f, 3.f}, tAllocator);
+    auto tOther = Pmr::Vector<float>::create(std::vector<float>{4.f, 5.f, 6.f}, tAllocator);
+    EXPECT_EQ(tVector.get_allocator().resource(), &tPool);
+
+    auto tSum = tVector + tOther;
+    EXPECT_EQ(tSum.get_allocator().resource(), &tPool);
+    EXPECT_FLOAT_EQ(9.f, tSum[2]);
+    EXPECT_FLOAT_EQ(32.f, tVector.dotProduct(tOther));
+    EXPECT_EQ(tVector.crossProduct(tOther).get_allocator().resource(), &tPool);
+}
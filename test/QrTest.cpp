@@ -0,0 +1,115 @@
+#include "../src/Linalg/qr.h"
+#include "testHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // R is only unique up to the signs of its rows.
+    Matrix<double> positiveDiagonal(Matrix<double> xR)
+    {
+        for (std::size_t i = 0; i < xR.getRows().get(); i++)
+            if (xR(i, i) < 0.0)
+                for (std::size_t j = 0; j < xR.getCols().get(); j++)
+                    xR(i, j) = -xR(i, j);
+        return xR;
+    }
+} // namespace
+
+TEST(Qr, blocked_factorization)
+{
+    Parallel::ThreadPool tPool{4};
+
+    // Several reflector blocks, and a partial last one.
+    for (const auto &[m, n] : std::vector<std::pair<std::size_t, std::size_t>>{{300, 100}, {97, 97}, {40, 70}, {5, 1}})
+    {
+        const auto tMatrix = randomMatrix(m, n, 1);
+        const auto tQr = Linalg::qr(tMatrix, tPool);
+        const auto tQ = tQr.getQ(tPool);
+        const auto tR = tQr.getR();
+
+        EXPECT_EQ(std::min(m, n), tQ.getCols().get());
+        EXPECT_LT(orthogonalityError(tQ), 1e-13) << m << "x" << n;
+        EXPECT_LT(maxDifference(tMatrix, tQ * tR), 1e-13) << m << "x" << n;
+        for (std::size_t i = 0; i < tR.getRows().get(); i++)
+            for (std::size_t j = 0; j < i; j++)
+                EXPECT_EQ(0.0, tR(i, j));
+    }
+}
+
+TEST(Qr, apply_q_round_trip)
+{
+    const auto tQr = Linalg::qr(randomMatrix(120, 50, 2));
+    const auto tB = randomMatrix(120, 7, 3);
+    auto tC = tB;
+    ASSERT_TRUE(tQr.applyQt(tC));
+    ASSERT_TRUE(tQr.applyQ(tC));
+    EXPECT_LT(maxDifference(tB, tC), 1e-13);
+
+    auto tWrongSize = randomMatrix(119, 7, 3);
+    EXPECT_FALSE(tQr.applyQt(tWrongSize));
+}
+
+TEST(Qr, least_squares_residual_is_orthogonal)
+{
+    const std::size_t m{500}, n{40};
+    const auto tMatrix = randomMatrix(m, n, 4);
+    const auto tRhs = randomMatrix(m, 3, 5);
+
+    for (const auto tMode : {Linalg::QrMode::Blocked, Linalg::QrMode::TallSkinny, Linalg::QrMode::Auto})
+    {
+        const auto tX = Linalg::leastSquares(tMatrix, tRhs, tMode);
+        ASSERT_TRUE(tX.has_value());
+        // A^T (A x - b) = 0 at the minimum.
+        const Matrix<double> tResidual = tMatrix * *tX - tRhs;
+        const auto tNormal = tMatrix.transposed() * tResidual;
+        EXPECT_LT(maxDifference(tNormal, Matrix<double>::create(Row{n}, Column{3})), 1e-12);
+    }
+
+    // A consistent system is solved exactly.
+    const auto tExact = randomMatrix(n, 1, 6);
+    const auto tB = tMatrix * tExact;
+    auto tVector = Vector<double>::create(Row{m});
+    for (std::size_t i = 0; i < m; i++)
+        tVector[i] = tB(i, 0);
+    const auto tY = Linalg::leastSquares(tMatrix, tVector);
+    ASSERT_TRUE(tY.has_value());
+    for (std::size_t i = 0; i < n; i++)
+        EXPECT_NEAR(tExact(i, 0), (*tY)[i], 1e-12);
+}
+
+TEST(Qr, tall_skinny_matches_blocked)
+{
+    Parallel::ThreadPool tPool{4};
+
+    const auto tMatrix = randomMatrix(2000, 30, 7);
+    const auto tTsqr = Linalg::tsqr(tMatrix, tPool);
+    ASSERT_TRUE(tTsqr.has_value());
+    EXPECT_EQ(4UL, tTsqr->getBlocks());
+
+    EXPECT_LT(maxDifference(positiveDiagonal(tTsqr->getR()), positiveDiagonal(Linalg::qr(tMatrix).getR())), 1e-12);
+    const auto tQ = tTsqr->getQ(tPool);
+    EXPECT_LT(orthogonalityError(tQ), 1e-13);
+    EXPECT_LT(maxDifference(tMatrix, tQ * tTsqr->getR()), 1e-13);
+
+    const auto tRhs = randomMatrix(2000, 2, 8);
+    const auto tX = tTsqr->leastSquares(tRhs, tPool);
+    const auto tY = Linalg::qr(tMatrix).leastSquares(tRhs);
+    ASSERT_TRUE(tX.has_value() && tY.has_value());
+    EXPECT_LT(maxDifference(*tX, *tY), 1e-12);
+
+    EXPECT_FALSE(Linalg::tsqr(randomMatrix(3, 4, 9), tPool).has_value());
+}
+
+TEST(Qr, rank_deficient_and_wide)
+{
+    auto tMatrix = randomMatrix(60, 5, 10);
+    for (std::size_t i = 0; i < 60; i++)
+        tMatrix(i, 3) = 0.0;
+    EXPECT_FALSE(Linalg::leastSquares(tMatrix, randomMatrix(60, 1, 11), Linalg::QrMode::Blocked).has_value());
+    EXPECT_FALSE(Linalg::leastSquares(randomMatrix(4, 6, 12), randomMatrix(4, 1, 13)).has_value());
+    EXPECT_FALSE(Linalg::leastSquares(randomMatrix(8, 6, 12), randomMatrix(7, 1, 13)).has_value());
+}
@@ -0,0 +1,161 @@
+#include "../src/quantizedMatrix.h"
+#include "testHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+    template <typename T>
+    std::vector<T> randomBytes(std::size_t xSize, unsigned xSeed)
+    {
+        std::mt19937 rng(xSeed);
+        std::uniform_int_distribution<int> dist(std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+        std::vector<T> tResult(xSize);
+        for (auto &tValue : tResult)
+            tValue = static_cast<T>(dist(rng));
+        return tResult;
+    }
+
+    // Double precision product of the dequantized operands.
+    template <typename TA, typename TB>
+    void expectProduct(const QuantizedMatrix<TA> &xLhs, const QuantizedMatrix<TB> &xRhs, const Matrix<float> &xProduct)
+    {
+        const std::size_t m = xLhs.getRows().get(), k = xLhs.getCols().get(), n = xRhs.getCols().get();
+        ASSERT_EQ(xProduct.getRows().get(), m);
+        ASSERT_EQ(xProduct.getCols().get(), n);
+        for (std::size_t i = 0; i < m; i++)
+        {
+            for (std::size_t j = 0; j < n; j++)
+            {
+                double tExact{0.0}, tMagnitude{0.0};
+                for (std::size_t p = 0; p < k; p++)
+                {
+                    tExact += static_cast<double>(xLhs.value(i, p)) * static_cast<double>(xRhs.value(p, j));
+                    tMagnitude += std::abs(static_cast<double>(xLhs.value(i, p)) * static_cast<double>(xRhs.value(p, j)));
+                }
+                ASSERT_NEAR(xProduct(i, j), tExact, 1e-5 * tMagnitude + 1e-6) << i << ", " << j;
+            }
+        }
+    }
+} // namespace
+
+TEST(QuantizedMatrix, quantize_round_trip)
+{
+    const auto tMatrix = randomMatrix<float>(13, 21, 1, -3.0f, 5.0f);
+    for (auto tQuantization : {Quantization::PerTensor, Quantization::PerRow, Quantization::PerColumn})
+    {
+        const auto tSigned = QuantizedMatrix<std::int8_t>::quantize(tMatrix, tQuantization);
+        const auto tUnsigned = QuantizedMatrix<std::uint8_t>::quantize(tMatrix, tQuantization);
+        const auto tBack = tSigned.dequantize();
+        for (std::size_t i = 0; i < 13; i++)
+        {
+            for (std::size_t j = 0; j < 21; j++)
+            {
+                EXPECT_LE(std::abs(tBack(i, j) - tMatrix(i, j)), 0.5f * tSigned.scale(i, j) * 1.001f);
+                EXPECT_LE(std::abs(tUnsigned.value(i, j) - tMatrix(i, j)), 0.5f * tUnsigned.scale(i, j) * 1.001f);
+            }
+        }
+        EXPECT_EQ(tSigned.getScales().size(), tQuantization == Quantization::PerRow ? 13U : tQuantization == Quantization::PerColumn ? 21U
+                                                                                                                                    : 1U);
+    }
+
+    // Zero is exact and a constant row does not divide by zero.
+    auto tZeros = Matrix<float>::create(Row{2}, Column{3});
+    tZeros(1, 0) = tZeros(1, 1) = tZeros(1, 2) = -2.0f;
+    const auto tQuantized = QuantizedMatrix<std::uint8_t>::quantize(tZeros, Quantization::PerRow);
+    EXPECT_EQ(tQuantized.value(0, 1), 0.0f);
+    EXPECT_EQ(tQuantized.value(1, 1), -2.0f);
+}
+
+TEST(QuantizedMatrix, create_validates)
+{
+    EXPECT_TRUE(QuantizedMatrix<std::int8_t>::create(Row{2}, Column{2}, {1, 2, 3, 4}, {0.5f}, {0}).has_value());
+    EXPECT_TRUE(QuantizedMatrix<std::int8_t>::create(Row{2}, Column{3}, std::vector<std::int8_t>(6), {0.5f, 1.0f, 2.0f}, {0, 1, -1}, Quantization::PerColumn).has_value());
+    EXPECT_FALSE(QuantizedMatrix<std::int8_t>::create(Row{2}, Column{2}, {1, 2, 3}, {0.5f}, {0}).has_value());
+    EXPECT_FALSE(QuantizedMatrix<std::int8_t>::create(Row{2}, Column{2}, {1, 2, 3, 4}, {0.5f}, {0}, Quantization::PerRow).has_value());
+    EXPECT_FALSE(QuantizedMatrix<std::int8_t>::create(Row{2}, Column{2}, {1, 2, 3, 4}, {0.0f}, {0}).has_value());
+    EXPECT_FALSE(QuantizedMatrix<std::uint8_t>::create(Row{2}, Column{2}, {1, 2, 3, 4}, {1.0f}, {-1}).has_value());
+
+    const auto tMatrix = QuantizedMatrix<std::int8_t>::create(Row{1}, Column{2}, {-3, 7}, {0.25f}, {-1});
+    ASSERT_TRUE(tMatrix.has_value());
+    EXPECT_EQ((*tMatrix)(0, 1), 7);
+    EXPECT_EQ(tMatrix->value(0, 0), -0.5f);
+    EXPECT_EQ(tMatrix->value(0, 1), 2.0f);
+}
+
+TEST(QuantizedMatrix, int8_kernel_is_exact)
+{
+    // Spans several KC blocks, odd edge tiles and the extreme bytes.
+    const std::size_t m = 37, n = 53, k = 2 * Kernels::gQgemmKC + 7;
+    auto tA = randomBytes<std::uint8_t>(m * k, 1);
+    auto tB = randomBytes<std::int8_t>(k * n, 2);
+    for (std::size_t p = 0; p < k; p++)
+    {
+        tA[p] = 255;
+        tB[p * n] = -128;
+    }
+
+    std::vector<std::int64_t> tExpected(m * n, 0);
+    for (std::size_t i = 0; i < m; i++)
+        for (std::size_t p = 0; p < k; p++)
+            for (std::size_t j = 0; j < n; j++)
+                tExpected[i * n + j] += std::int64_t{tA[i * k + p]} * tB[p * n + j];
+
+    Parallel::ThreadPool tPool{4};
+    const auto tSupported = Kernels::detectSimdLevel();
+    for (int tLevel = 0; tLevel <= static_cast<int>(tSupported); tLevel++)
+    {
+        Kernels::setSimdLevel(static_cast<Kernels::SimdLevel>(tLevel));
+        std::vector<std::int32_t> tSequential(m * n, -1), tParallel(m * n, -1);
+        Kernels::gemmInt8Sequential(m, n, k, tA.data(), k, tB.data(), n, tSequential.data(), n);
+        Kernels::gemmInt8(m, n, k, tA.data(), k, tB.data(), n, tParallel.data(), n, tPool);
+        for (std::size_t p = 0; p < m * n; p++)
+        {
+            ASSERT_EQ(tSequential[p], tExpected[p]) << "level " << tLevel << ", " << p;
+            ASSERT_EQ(tParallel[p], tExpected[p]) << "level " << tLevel << ", " << p;
+        }
+    }
+    Kernels::setSimdLevel(tSupported);
+}
+
+TEST(QuantizedMatrix, multiply_dequantizes)
+{
+    const auto tLhs = randomMatrix<float>(29, 300, 3);
+    const auto tRhs = randomMatrix<float>(300, 45, 4, -0.5f, 2.0f);
+
+    const auto tSignedLhs = QuantizedMatrix<std::int8_t>::quantize(tLhs, Quantization::PerRow);
+    const auto tSignedRhs = QuantizedMatrix<std::int8_t>::quantize(tRhs, Quantization::PerColumn);
+    const auto tUnsignedLhs = QuantizedMatrix<std::uint8_t>::quantize(tLhs);
+    const auto tUnsignedRhs = QuantizedMatrix<std::uint8_t>::quantize(tRhs, Quantization::PerColumn);
+
+    expectProduct(tSignedLhs, tSignedRhs, multiply(tSignedLhs, tSignedRhs));
+    expectProduct(tUnsignedLhs, tUnsignedRhs, multiply(tUnsignedLhs, tUnsignedRhs));
+    expectProduct(tUnsignedLhs, tSignedRhs, multiply(tUnsignedLhs, tSignedRhs));
+    Parallel::ThreadPool tPool{4};
+    expectProduct(tSignedLhs, tUnsignedRhs, multiply(tSignedLhs, tUnsignedRhs, tPool));
+
+    // Close to the float product as well: per row and column scales keep the error small.
+    const auto tFloat = tLhs * tRhs;
+    const auto tQuantized = multiply(tSignedLhs, tSignedRhs);
+    for (std::size_t i = 0; i < 29; i++)
+        for (std::size_t j = 0; j < 45; j++)
+            EXPECT_NEAR(tQuantized(i, j), tFloat(i, j), 0.25f);
+}
+
+TEST(QuantizedMatrix, multiply_rejects_scales_along_k)
+{
+    const auto tMatrix = randomMatrix<float>(4, 4, 5);
+    const auto tPerRow = QuantizedMatrix<std::int8_t>::quantize(tMatrix, Quantization::PerRow);
+    const auto tPerColumn = QuantizedMatrix<std::int8_t>::quantize(tMatrix, Quantization::PerColumn);
+    const auto tWide = QuantizedMatrix<std::int8_t>::quantize(randomMatrix<float>(5, 4, 6));
+
+    EXPECT_EQ(multiply(tPerColumn, tPerColumn).getRows().get(), 0U);
+    EXPECT_EQ(multiply(tPerRow, tPerRow).getRows().get(), 0U);
+    EXPECT_EQ(multiply(tPerRow, tWide).getRows().get(), 0U);
+    EXPECT_EQ(multiply(tPerRow, tPerColumn).getRows().get(), 4U);
+}
@@ -0,0 +1,138 @@
+#include "../src/Kernels/simd.h"
+#include "../src/matrix.h"
+#include "../src/vector.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+template <typename T>
+struct SimdTest : public testing::Test
+{
+    // Small integers keep every product and sum exact, so all levels must agree bit for bit.
+    static std::vector<T> random(std::size_t xCount, unsigned xSeed)
+    {
+        std::mt19937 rng(xSeed);
+        std::uniform_int_distribution<int> dist(-8, 8);
+
+        std::vector<T> tResult(xCount);
+        for (auto &tElem : tResult)
+            tElem = static_cast<T>(dist(rng));
+        return tResult;
+    }
+
+    void TearDown() override
+    {
+        Kernels::setSimdLevel(Kernels::SimdLevel::AVX512);
+    }
+};
+
+using SimdTypes = testing::Types<float, double, std::int32_t, std::int64_t>;
+TYPED_TEST_SUITE(SimdTest, SimdTypes);
+
+TYPED_TEST(SimdTest, every_level_matches_scalar)
+{
+    using T = TypeParam;
+    const std::vector<Kernels::SimdLevel> tLevels{Kernels::SimdLevel::Scalar, Kernels::SimdLevel::SSE2,
+                                                  Kernels::SimdLevel::AVX2, Kernels::SimdLevel::AVX512};
+
+    // Lengths around the vector widths exercise the remainder loops.
+    for (std::size_t tCount : {0UL, 1UL, 3UL, 7UL, 8UL, 15UL, 16UL, 17UL, 63UL, 64UL, 65UL, 1000UL})
+    {
+        const auto tLhs = this->random(tCount, 1);
+        const auto tRhs = this->random(tCount, 2);
+        const T tScalar = static_cast<T>(3);
+
+        std::vector<T> tAdd(tCount), tSub(tCount), tMul(tCount), tAddScalar(tCount), tSubScalar(tCount), tMulScalar(tCount);
+        std::vector<T> tMulAdd(tCount), tMulSub(tCount);
+        T tDot{0};
+        for (std::size_t i = 0; i < tCount; i++)
+        {
+            tAdd[i] = tLhs[i] + tRhs[i];
+            tSub[i] = tLhs[i] - tRhs[i];
+            tMul[i] = tLhs[i] * tRhs[i];
+            tAddScalar[i] = tLhs[i] + tScalar;
+            tSubScalar[i] = tLhs[i] - tScalar;
+            tMulScalar[i] = tLhs[i] * tScalar;
+            tMulAdd[i] = tAdd[i] + tLhs[i] * tRhs[i];
+            tMulSub[i] = tAdd[i] - tLhs[i] * tRhs[i];
+            tDot += tLhs[i] * tRhs[i];
+        }
+
+        for (const auto tLevel : tLevels)
+        {
+            Kernels::setSimdLevel(tLevel);
+            std::vector<T> tOut(tCount);
+
+            Kernels::add(tLhs.data(), tRhs.data(), tOut.data(), tCount);
+            EXPECT_EQ(tAdd, tOut);
+            Kernels::subtract(tLhs.data(), tRhs.data(), tOut.data(), tCount);
+            EXPECT_EQ(tSub, tOut);
+            Kernels::multiply(tLhs.data(), tRhs.data(), tOut.data(), tCount);
+            EXPECT_EQ(tMul, tOut);
+            Kernels::addScalar(tLhs.data(), tScalar, tOut.data(), tCount);
+            EXPECT_EQ(tAddScalar, tOut);
+            Kernels::subtractScalar(tLhs.data(), tScalar, tOut.data(), tCount);
+            EXPECT_EQ(tSubScalar, tOut);
+            Kernels::multiplyScalar(tLhs.data(), tScalar, tOut.data(), tCount);
+            EXPECT_EQ(tMulScalar, tOut);
+            tOut = tAdd;
+            Kernels::multiplyAdd(tLhs.data(), tRhs.data(), tOut.data(), tCount);
+            EXPECT_EQ(tMulAdd, tOut);
+            tOut = tAdd;
+            Kernels::multiplySubtract(tLhs.data(), tRhs.data(), tOut.data(), tCount);
+            EXPECT_EQ(tMulSub, tOut);
+            EXPECT_EQ(tDot, Kernels::dot(tLhs.data(), tRhs.data(), tCount));
+        }
+    }
+}
+
+TYPED_TEST(SimdTest, in_place)
+{
+    using T = TypeParam;
+    auto tData = this->random(37, 3);
+    const auto tOriginal = tData;
+
+    Kernels::add(tData.data(), tData.data(), tData.data(), tData.size());
+    Kernels::subtractScalar(tData.data(), static_cast<T>(1), tData.data(), tData.size());
+    for (std::size_t i = 0; i < tData.size(); i++)
+        EXPECT_EQ(static_cast<T>(tOriginal[i] + tOriginal[i] - 1), tData[i]);
+}
+
+TEST(SimdLevel, set_is_capped_at_detected)
+{
+    Kernels::setSimdLevel(Kernels::SimdLevel::AVX512);
+    EXPECT_EQ(Kernels::detectSimdLevel(), Kernels::simdLevel());
+
+    Kernels::setSimdLevel(Kernels::SimdLevel::Scalar);
+    EXPECT_EQ(Kernels::SimdLevel::Scalar, Kernels::simdLevel());
+
+    Kernels::setSimdLevel(Kernels::SimdLevel::AVX512);
+}
+
+TEST(SimdLevel, matrix_and_vector_use_kernels)
+{
+    auto tMatrix = Matrix<int>::create(Row{5}, Column{19});
+    auto tVector = Vector<int>::create(Row{19});
+    for (std::size_t i = 0; i < 5; i++)
+        for (std::size_t j = 0; j < 19; j++)
+            tMatrix(i, j) = static_cast<int>(i * 19 + j);
+    for (std::size_t j = 0; j < 19; j++)
+        tVector[j] = static_cast<int>(j);
+
+    Kernels::setSimdLevel(Kernels::SimdLevel::Scalar);
+    const Matrix<int> tMatrixScalar = (tMatrix + tMatrix) * 3;
+    auto tVectorScalar = (tVector + tVector) * 3;
+    const auto tDotScalar = tVector.dotProduct(tVector);
+
+    Kernels::setSimdLevel(Kernels::SimdLevel::AVX512);
+    auto tMatrixSimd = tMatrix;
+    tMatrixSimd += tMatrix;
+    tMatrixSimd *= 3;
+    EXPECT_EQ(tMatrixScalar, tMatrixSimd);
+    EXPECT_EQ(tMatrixScalar, Matrix<int>{(tMatrix + tMatrix) * 3});
+    EXPECT_TRUE(tVectorScalar == (tVector + tVector) * 3);
+    EXPECT_EQ(tDotScalar, tVector.dotProduct(tVector));
+}
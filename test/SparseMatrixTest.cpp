@@ -0,0 +1,151 @@
+#include "../src/sparseMatrix.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <stdexcept>
+
+namespace
+{
+    // Dense xRows x xCols matrix with roughly xDensity of the entries set to small integers,
+    // so sparse and dense results agree exactly.
+    Matrix<double> randomSparse(std::size_t xRows, std::size_t xCols, double xDensity, unsigned xSeed)
+    {
+        std::mt19937 rng(xSeed);
+        std::uniform_real_distribution<double> tCoin(0.0, 1.0);
+        std::uniform_int_distribution<int> tValue(-9, 9);
+
+        auto tResult = Matrix<double>::create(Row{xRows}, Column{xCols});
+        for (std::size_t i = 0; i < xRows; i++)
+            for (std::size_t j = 0; j < xCols; j++)
+                if (tCoin(rng) < xDensity)
+                    tResult(i, j) = static_cast<double>(tValue(rng));
+        return tResult;
+    }
+} // namespace
+
+template <typename S>
+struct SparseMatrixTest : public testing::Test
+{
+};
+
+using SparseTypes = testing::Types<CsrMatrix<double>, CscMatrix<double>>;
+TYPED_TEST_SUITE(SparseMatrixTest, SparseTypes);
+
+TYPED_TEST(SparseMatrixTest, create_from_triplets)
+{
+    const std::vector<Triplet<double>> tTriplets{{2, 1, 3.0}, {0, 0, 1.0}, {2, 1, 4.0}, {1, 3, -2.0}, {0, 2, 5.0}};
+    const auto tSparse = TypeParam::create(Row{3}, Column{4}, tTriplets);
+
+    EXPECT_EQ(4UL, tSparse.nonZeros());
+    EXPECT_DOUBLE_EQ(7.0, tSparse(2, 1));
+    EXPECT_DOUBLE_EQ(-2.0, tSparse(1, 3));
+    EXPECT_DOUBLE_EQ(5.0, tSparse(0, 2));
+    EXPECT_DOUBLE_EQ(0.0, tSparse(1, 1));
+    EXPECT_THROW(tSparse.at(3, 0), std::out_of_range);
+
+    const std::vector<Triplet<double>> tOutside{{3, 0, 1.0}};
+    EXPECT_THROW(TypeParam::create(Row{3}, Column{4}, tOutside), std::out_of_range);
+}
+
+TYPED_TEST(SparseMatrixTest, create_from_dense)
+{
+    auto tDense = randomSparse(17, 23, 0.2, 1);
+    tDense(3, 4) = 0.25;
+
+    const auto tSparse = TypeParam::create(tDense);
+    EXPECT_TRUE(tDense == tSparse.toMatrix());
+
+    // Entries at or below the threshold are dropped.
+    const auto tThresholded = TypeParam::create(tDense, 0.5);
+    EXPECT_DOUBLE_EQ(0.0, tThresholded(3, 4));
+    EXPECT_EQ(tSparse.nonZeros() - 1, tThresholded.nonZeros());
+}
+
+TYPED_TEST(SparseMatrixTest, formats_and_transpose)
+{
+    const auto tDense = randomSparse(13, 9, 0.3, 2);
+    const auto tSparse = TypeParam::create(tDense);
+
+    EXPECT_TRUE(tDense == tSparse.template toFormat<SparseFormat::CSR>().toMatrix());
+    EXPECT_TRUE(tDense == tSparse.template toFormat<SparseFormat::CSC>().toMatrix());
+    EXPECT_TRUE(tDense.transposed() == tSparse.transposed().toMatrix());
+}
+
+TYPED_TEST(SparseMatrixTest, matrix_vector)
+{
+    const auto tDense = randomSparse(31, 47, 0.1, 3);
+    const auto tSparse = TypeParam::create(tDense);
+    auto tX = Vector<double>::create(Row{47});
+    for (std::size_t j = 0; j < 47; j++)
+        tX[j] = static_cast<double>(j % 5) - 2.0;
+
+    const auto tY = tSparse * tX;
+    ASSERT_EQ(31UL, tY.size());
+    for (std::size_t i = 0; i < 31; i++)
+    {
+        double tControl{0};
+        for (std::size_t j = 0; j < 47; j++)
+            tControl += tDense(i, j) * tX[j];
+        EXPECT_DOUBLE_EQ(tControl, tY[i]);
+    }
+
+    EXPECT_EQ(0UL, (tSparse * Vector<double>::create(Row{31})).size());
+}
+
+TYPED_TEST(SparseMatrixTest, matrix_matrix)
+{
+    const auto tDense = randomSparse(19, 29, 0.15, 4);
+    const auto tRhs = randomSparse(29, 11, 1.0, 5);
+    const auto tSparse = TypeParam::create(tDense);
+
+    EXPECT_TRUE(tDense * tRhs == tSparse * tRhs);
+    EXPECT_EQ(0UL, (tSparse * tDense).getRows().get());
+}
+
+TYPED_TEST(SparseMatrixTest, add_and_subtract)
+{
+    const auto tLhs = randomSparse(21, 14, 0.2, 6);
+    const auto tRhs = randomSparse(21, 14, 0.2, 7);
+    const auto tSparseLhs = TypeParam::create(tLhs);
+    const auto tSparseRhs = TypeParam::create(tRhs);
+
+    EXPECT_TRUE(Matrix<double>{tLhs + tRhs} == (tSparseLhs + tSparseRhs).toMatrix());
+    EXPECT_TRUE(Matrix<double>{tLhs - tRhs} == (tSparseLhs - tSparseRhs).toMatrix());
+
+    // Shape mismatch keeps the left operand.
+    const auto tOther = TypeParam::create(Row{2}, Column{2});
+    EXPECT_TRUE(tSparseLhs == tSparseLhs + tOther);
+
+    auto tScaled = tSparseLhs;
+    tScaled *= 2.0;
+    EXPECT_TRUE(Matrix<double>{tLhs * 2.0} == tScaled.toMatrix());
+}
+
+TYPED_TEST(SparseMatrixTest, parallel_kernels)
+{
+    // Large enough to cross the parallel threshold.
+    Parallel::ThreadPool tPool{4};
+    Parallel::setDefaultExecutor(&tPool);
+    const auto tDense = randomSparse(600, 500, 0.15, 8);
+    const auto tOther = randomSparse(600, 500, 0.15, 9);
+    const auto tRhs = randomSparse(500, 16, 1.0, 10);
+    const auto tSparse = TypeParam::create(tDense);
+    ASSERT_GT(tSparse.nonZeros(), Detail::gSparseParallelNonZeros);
+
+    auto tX = Vector<double>::create(Row{500});
+    for (std::size_t j = 0; j < 500; j++)
+        tX[j] = static_cast<double>(j % 7) - 3.0;
+    const auto tY = tSparse * tX;
+    for (std::size_t i = 0; i < 600; i += 37)
+    {
+        double tControl{0};
+        for (std::size_t j = 0; j < 500; j++)
+            tControl += tDense(i, j) * tX[j];
+        EXPECT_DOUBLE_EQ(tControl, tY[i]);
+    }
+
+    EXPECT_TRUE(tDense * tRhs == tSparse * tRhs);
+    EXPECT_TRUE(Matrix<double>{tDense + tOther} == (tSparse + TypeParam::create(tOther)).toMatrix());
+    Parallel::setDefaultExecutor(nullptr);
+}
@@ -0,0 +1,93 @@
+#include "../src/staticMatrix.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using Mat3 = StaticMatrix<double, 3, 3>;
+using Mat2x3 = StaticMatrix<double, 2, 3>;
+using Mat3x2 = StaticMatrix<double, 3, 2>;
+
+namespace
+{
+    constexpr Mat2x3 gLhs = Mat2x3::create({1, 2, 3,
+                                            4, 5, 6});
+    constexpr Mat3x2 gRhs = Mat3x2::create({7, 8,
+                                            9, 10,
+                                            11, 12});
+
+    template <typename M>
+    M randomStatic()
+    {
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        M tResult;
+        for (auto &tElem : tResult.getData())
+            tElem = dist(rng);
+        return tResult;
+    }
+} // namespace
+
+TEST(StaticMatrixTest, constexpr_arithmetic)
+{
+    constexpr auto tProduct = gLhs * gRhs;
+    static_assert(std::is_same_v<const StaticMatrix<double, 2, 2>, decltype(tProduct)>);
+    static_assert(tProduct(0, 0) == 58 && tProduct(0, 1) == 64 && tProduct(1, 0) == 139 && tProduct(1, 1) == 154);
+
+    constexpr auto tSum = (gLhs + gLhs) * 0.5 - 1.0 + 1.0;
+    static_assert(tSum == gLhs);
+
+    constexpr auto tTransposed = gLhs.transposed();
+    static_assert(tTransposed(2, 1) == 6 && tTransposed(0, 1) == 4);
+
+    static_assert(Mat3::identity() * Mat3::identity() == Mat3::identity());
+    static_assert(sizeof(Mat3) == 9 * sizeof(double));
+}
+
+TEST(StaticMatrixTest, compound_assignment)
+{
+    auto tMatrix = randomStatic<Mat3>();
+    const auto tControl = tMatrix;
+
+    tMatrix += tControl;
+    tMatrix -= 1.0;
+    tMatrix *= 2.0;
+    tMatrix *= Mat3::identity();
+
+    for (std::size_t i = 0; i < 3; i++)
+        for (std::size_t j = 0; j < 3; j++)
+            EXPECT_DOUBLE_EQ((tControl(i, j) * 2.0 - 1.0) * 2.0, tMatrix(i, j));
+}
+
+TEST(StaticMatrixTest, matches_dynamic_product)
+{
+    const auto tLhs = randomStatic<StaticMatrix<double, 4, 6>>();
+    const auto tRhs = randomStatic<StaticMatrix<double, 6, 5>>();
+
+    const auto tStatic = tLhs * tRhs;
+    const auto tDynamic = static_cast<Matrix<double>>(tLhs) * static_cast<Matrix<double>>(tRhs);
+
+    ASSERT_EQ(4, tDynamic.getRows().get());
+    ASSERT_EQ(5, tDynamic.getCols().get());
+    for (std::size_t i = 0; i < 4; i++)
+        for (std::size_t j = 0; j < 5; j++)
+            EXPECT_NEAR(tDynamic(i, j), tStatic(i, j), 1e-12);
+}
+
+TEST(StaticMatrixTest, conversion_from_matrix)
+{
+    const auto tStatic = randomStatic<Mat3>();
+
+    const auto tRoundTrip = Mat3::create(tStatic.toMatrix());
+    ASSERT_TRUE(tRoundTrip.has_value());
+    EXPECT_TRUE(*tRoundTrip == tStatic);
+
+    EXPECT_FALSE(Mat2x3::create(tStatic.toMatrix()).has_value());
+}
+
+TEST(StaticMatrixTest, at_bounds)
+{
+    auto tMatrix = Mat2x3::create();
+    EXPECT_NO_THROW(tMatrix.at(1, 2));
+    EXPECT_THROW(tMatrix.at(2, 0), std::out_of_range);
+}
@@ -0,0 +1,97 @@
+#include "../src/staticVector.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+template <typename T>
+struct StaticVectorTest : public testing::Test
+{
+    template <std::size_t N>
+    static StaticVector<T, N> random()
+    {
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<double> dist(-10.0, 10.0);
+        StaticVector<T, N> tResult;
+        for (auto &tElem : tResult)
+            tElem = static_cast<T>(dist(rng));
+        return tResult;
+    }
+
+    static constexpr double tolerance() { return std::is_same_v<T, float> ? 1e-4 : 1e-12; }
+};
+
+using StaticVectorTypes = testing::Types<float, double, int>;
+TYPED_TEST_SUITE(StaticVectorTest, StaticVectorTypes);
+
+TYPED_TEST(StaticVectorTest, dot_product_and_magnitude)
+{
+    using T = TypeParam;
+    const auto tCheck = [](auto xLhs, auto xRhs)
+    {
+        double tDot{0};
+        for (std::size_t i = 0; i < xLhs.size(); i++)
+            tDot += static_cast<double>(xLhs[i]) * static_cast<double>(xRhs[i]);
+
+        EXPECT_NEAR(tDot, static_cast<double>(xLhs.dotProduct(xRhs)), std::abs(tDot) * StaticVectorTest<T>::tolerance());
+        EXPECT_EQ(static_cast<T>(std::sqrt(xLhs.dotProduct(xLhs))), xLhs.magnitude());
+    };
+
+    tCheck(this->template random<2>(), this->template random<2>() * static_cast<T>(2));
+    tCheck(this->template random<3>(), this->template random<3>() - static_cast<T>(1));
+    tCheck(this->template random<4>(), this->template random<4>() + static_cast<T>(3));
+    tCheck(this->template random<7>(), this->template random<7>());
+}
+
+TYPED_TEST(StaticVectorTest, cross_product)
+{
+    using T = TypeParam;
+    const auto tLhs = StaticVector<T, 3>::create({1, 2, 3});
+    const auto tRhs = StaticVector<T, 3>::create({-7, 8, 9});
+
+    const auto tCross = tLhs.crossProduct(tRhs);
+
+    EXPECT_EQ(static_cast<T>(-6), tCross[0]);
+    EXPECT_EQ(static_cast<T>(-30), tCross[1]);
+    EXPECT_EQ(static_cast<T>(22), tCross[2]);
+    // Orthogonal to both operands, which also checks the padding lane stayed zero.
+    EXPECT_EQ(static_cast<T>(0), tCross.dotProduct(tLhs));
+    EXPECT_EQ(static_cast<T>(0), tCross.dotProduct(tRhs));
+}
+
+TYPED_TEST(StaticVectorTest, normalize)
+{
+    using T = TypeParam;
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        auto tVector = this->template random<3>() + static_cast<T>(20);
+        tVector.normalize();
+        EXPECT_NEAR(1.0, static_cast<double>(tVector.magnitude()), StaticVectorTest<T>::tolerance());
+
+        auto tVector4 = this->template random<4>();
+        tVector4.normalize();
+        EXPECT_NEAR(1.0, static_cast<double>(tVector4.magnitude()), StaticVectorTest<T>::tolerance());
+    }
+}
+
+TYPED_TEST(StaticVectorTest, conversion_from_vector)
+{
+    using T = TypeParam;
+    const auto tStatic = this->template random<3>();
+
+    const auto tDynamic = static_cast<Vector<T>>(tStatic);
+    ASSERT_EQ(3U, tDynamic.size());
+
+    const auto tRoundTrip = StaticVector<T, 3>::create(tDynamic);
+    ASSERT_TRUE(tRoundTrip.has_value());
+    EXPECT_TRUE(*tRoundTrip == tStatic);
+    EXPECT_FALSE((StaticVector<T, 4>::create(tDynamic).has_value()));
+}
+
+TEST(StaticVectorLayoutTest, packed_storage)
+{
+    static_assert(sizeof(StaticVector<float, 3>) == 16 && alignof(StaticVector<float, 3>) == 16);
+    static_assert(sizeof(StaticVector<double, 2>) == 16 && alignof(StaticVector<double, 2>) == 16);
+    static_assert(sizeof(StaticVector<double, 4>) == 32 && alignof(StaticVector<double, 4>) == 32);
+    static_assert(sizeof(StaticVector<int, 3>) == 3 * sizeof(int));
+}
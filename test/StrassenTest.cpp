@@ -0,0 +1,75 @@
+#include "../src/Kernels/strassen.h"
+#include "../src/matrix.h"
+#include "testHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    Matrix<double> strassenProduct(const Matrix<double> &xLhs, const Matrix<double> &xRhs, std::size_t xCutoff)
+    {
+        const std::size_t m = xLhs.getRows().get(), n = xRhs.getCols().get(), k = xLhs.getCols().get();
+        auto tResult = Matrix<double>::create(Row{m}, Column{n});
+        std::vector<double> tWorkspace(Kernels::strassenWorkspace(m, n, k, xCutoff));
+        Kernels::strassen(m, n, k, xLhs.getData().data(), xLhs.getLeadingDimension(), xRhs.getData().data(), xRhs.getLeadingDimension(),
+                          tResult.getData().data(), tResult.getLeadingDimension(), tWorkspace.data(), xCutoff, Parallel::defaultExecutor());
+        return tResult;
+    }
+} // namespace
+
+TEST(Strassen, exact_on_integers_with_odd_sizes)
+{
+    // Small cutoffs force several levels and peeling at every one of them.
+    for (const auto &[m, n, k, tCutoff] : std::vector<std::array<std::size_t, 4>>{
+             {64, 64, 64, 8}, {65, 65, 65, 8}, {127, 131, 129, 16}, {100, 37, 81, 9}, {3, 3, 3, 1}})
+    {
+        const auto tLhs = randomIntegerMatrix(m, k, 1, -4, 4);
+        const auto tRhs = randomIntegerMatrix(k, n, 2, -4, 4);
+        EXPECT_TRUE(tLhs * tRhs == strassenProduct(tLhs, tRhs, tCutoff)) << m << "x" << k << "x" << n;
+    }
+}
+
+TEST(Strassen, workspace_is_bounded)
+{
+    EXPECT_EQ(0UL, Kernels::strassenWorkspace(512, 512, 512));
+    EXPECT_EQ(3UL * 512 * 512, Kernels::strassenWorkspace(1024, 1024, 1024));
+    // Geometric series: at most (mk + kn + mn) / 3 over all levels.
+    EXPECT_LE(Kernels::strassenWorkspace(1000, 1000, 1000, 8), 1000UL * 1000UL);
+}
+
+TEST(Strassen, within_error_bound)
+{
+    const std::size_t tSize{300}, tCutoff{16};
+    const auto tLhs = randomMatrix(tSize, tSize, 3);
+    const auto tRhs = randomMatrix(tSize, tSize, 4);
+    const auto tClassic = tLhs * tRhs;
+    const auto tFast = strassenProduct(tLhs, tRhs, tCutoff);
+
+    const double tError = maxDifference(tClassic, tFast);
+
+    // First order bound from Kernels/strassen.h with ||A|| = ||B|| <= 1, plus the classic one.
+    const double n = static_cast<double>(tSize), n0 = static_cast<double>(tCutoff);
+    const double u = std::numeric_limits<double>::epsilon() / 2;
+    const double tBound = ((std::pow(n / n0, std::log2(18.0)) * (n0 * n0 + 6 * n0) - 6 * n) + n * n) * u;
+    EXPECT_GT(tError, 0.0);
+    EXPECT_LT(tError, tBound);
+}
+
+TEST(Strassen, multiply_algorithm)
+{
+    Parallel::ThreadPool tPool{4};
+    const auto tLhs = randomIntegerMatrix(1100, 1030, 5, -4, 4);
+    const auto tRhs = randomIntegerMatrix(1030, 1070, 6, -4, 4);
+
+    const auto tClassic = multiply(tLhs, tRhs, MultiplyAlgorithm::Classic, tPool);
+    EXPECT_TRUE(tClassic == multiply(tLhs, tRhs, MultiplyAlgorithm::Strassen, tPool));
+    EXPECT_TRUE(tClassic == multiply(tLhs, tRhs, MultiplyAlgorithm::Strassen));
+
+    const auto tMismatch = multiply(tLhs, tLhs, MultiplyAlgorithm::Strassen);
+    EXPECT_EQ(0UL, tMismatch.getRows().get());
+}
@@ -0,0 +1,194 @@
+#include "../src/bandedMatrix.h"
+#include "../src/symmetricMatrix.h"
+#include "../src/triangularMatrix.h"
+#include "../src/staticMatrix.h"
+#include "testHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+namespace
+{
+    // Small integers keep structured and dense products exactly equal.
+    Matrix<double> smallIntegerMatrix(std::size_t xRows, std::size_t xCols, unsigned xSeed)
+    {
+        return randomIntegerMatrix(xRows, xCols, xSeed, -5, 5);
+    }
+
+    Vector<double> randomVector(std::size_t xSize, unsigned xSeed)
+    {
+        const auto tMatrix = smallIntegerMatrix(xSize, 1, xSeed);
+        auto tResult = Vector<double>::create(Row{xSize});
+        for (std::size_t i = 0; i < xSize; i++)
+            tResult[i] = tMatrix(i, 0);
+        return tResult;
+    }
+
+    Vector<double> denseProduct(const Matrix<double> &xMatrix, const Vector<double> &xVector)
+    {
+        auto tResult = Vector<double>::create(Row{xMatrix.getRows().get()});
+        for (std::size_t i = 0; i < xMatrix.getRows().get(); i++)
+            for (std::size_t j = 0; j < xMatrix.getCols().get(); j++)
+                tResult[i] += xMatrix(i, j) * xVector[j];
+        return tResult;
+    }
+} // namespace
+
+TEST(SymmetricMatrix, packed_storage)
+{
+    auto tSymmetric = SymmetricMatrix<double>::create(4);
+    EXPECT_EQ(10UL, tSymmetric.getData().size());
+
+    tSymmetric(1, 3) = 7.0;
+    EXPECT_DOUBLE_EQ(7.0, tSymmetric(3, 1));
+    EXPECT_DOUBLE_EQ(7.0, tSymmetric.at(3, 1));
+    EXPECT_THROW(tSymmetric.at(4, 0), std::out_of_range);
+
+    const auto tDense = tSymmetric.toMatrix();
+    EXPECT_TRUE(tDense == tDense.transposed());
+    EXPECT_FALSE(SymmetricMatrix<double>::create(smallIntegerMatrix(2, 3, 1)).has_value());
+}
+
+TEST(SymmetricMatrix, products_and_sums)
+{
+    const auto tRandom = smallIntegerMatrix(23, 23, 2);
+    const Matrix<double> tDense = tRandom + tRandom.transposed();
+    const auto tSymmetric = *SymmetricMatrix<double>::create(tDense);
+    EXPECT_TRUE(tDense == tSymmetric.toMatrix());
+
+    const auto tX = randomVector(23, 3);
+    EXPECT_TRUE(denseProduct(tDense, tX).getData() == (tSymmetric * tX).getData());
+
+    const auto tB = smallIntegerMatrix(23, 5, 4);
+    EXPECT_TRUE(tDense * tB == tSymmetric * tB);
+
+    EXPECT_TRUE(Matrix<double>{tDense * 2.0 - tDense} == (tSymmetric * 2.0 - tSymmetric).toMatrix());
+    EXPECT_TRUE(Matrix<double>{tDense + tDense} == (tSymmetric + tSymmetric).toMatrix());
+    EXPECT_TRUE(tSymmetric == tSymmetric.transposed());
+}
+
+template <typename M>
+struct TriangularMatrixTest : public testing::Test
+{
+};
+
+using TriangularTypes = testing::Types<LowerTriangularMatrix<double>, UpperTriangularMatrix<double>>;
+TYPED_TEST_SUITE(TriangularMatrixTest, TriangularTypes);
+
+TYPED_TEST(TriangularMatrixTest, packed_storage)
+{
+    const auto tDense = smallIntegerMatrix(9, 9, 5);
+    auto tTriangular = *TypeParam::create(tDense);
+    EXPECT_EQ(45UL, tTriangular.getData().size());
+
+    const bool tLower = TypeParam::gTriangle == Triangle::Lower;
+    for (std::size_t i = 0; i < 9; i++)
+        for (std::size_t j = 0; j < 9; j++)
+            EXPECT_DOUBLE_EQ((tLower ? j <= i : j >= i) ? tDense(i, j) : 0.0, tTriangular(i, j));
+
+    EXPECT_THROW(tTriangular.at(tLower ? 0 : 1, tLower ? 1 : 0), std::out_of_range);
+    EXPECT_NO_THROW(tTriangular.at(4, 4) = 1.0);
+    EXPECT_TRUE(tTriangular.toMatrix().transposed() == tTriangular.transposed().toMatrix());
+    EXPECT_TRUE(TypeParam::identity(3).toMatrix() == (StaticMatrix<double, 3, 3>::identity().toMatrix()));
+}
+
+TYPED_TEST(TriangularMatrixTest, products_and_sums)
+{
+    const auto tLhs = *TypeParam::create(smallIntegerMatrix(17, 17, 6));
+    const auto tRhs = *TypeParam::create(smallIntegerMatrix(17, 17, 7));
+    const auto tDenseLhs = tLhs.toMatrix();
+    const auto tDenseRhs = tRhs.toMatrix();
+
+    const auto tX = randomVector(17, 8);
+    EXPECT_TRUE(denseProduct(tDenseLhs, tX).getData() == (tLhs * tX).getData());
+
+    const auto tB = smallIntegerMatrix(17, 4, 9);
+    EXPECT_TRUE(tDenseLhs * tB == tLhs * tB);
+    EXPECT_TRUE(tDenseLhs * tDenseRhs == (tLhs * tRhs).toMatrix());
+
+    EXPECT_TRUE(Matrix<double>{tDenseLhs + tDenseRhs} == (tLhs + tRhs).toMatrix());
+    EXPECT_TRUE(Matrix<double>{tDenseLhs - tDenseRhs * 3.0} == (tLhs - tRhs * 3.0).toMatrix());
+}
+
+TEST(BandedMatrix, band_storage)
+{
+    const auto tDense = smallIntegerMatrix(8, 8, 10);
+    auto tBanded = *BandedMatrix<double>::create(tDense, 1, 2);
+    EXPECT_EQ(8UL * 4UL, tBanded.getData().size());
+
+    for (std::size_t i = 0; i < 8; i++)
+        for (std::size_t j = 0; j < 8; j++)
+        {
+            const bool tInside = j + 1 >= i && j <= i + 2;
+            EXPECT_DOUBLE_EQ(tInside ? tDense(i, j) : 0.0, tBanded(i, j));
+        }
+
+    EXPECT_THROW(tBanded.at(0, 3), std::out_of_range);
+    EXPECT_THROW(tBanded.at(2, 0), std::out_of_range);
+    EXPECT_NO_THROW(tBanded.at(7, 6) = 1.0);
+
+    const auto tTransposed = tBanded.transposed();
+    EXPECT_EQ(2UL, tTransposed.getLower());
+    EXPECT_EQ(1UL, tTransposed.getUpper());
+    EXPECT_TRUE(tBanded.toMatrix().transposed() == tTransposed.toMatrix());
+
+    // Bandwidths are capped at n - 1.
+    EXPECT_EQ(7UL, BandedMatrix<double>::create(8, 20, 0).getLower());
+}
+
+TEST(BandedMatrix, products_and_sums)
+{
+    const auto tLhs = *BandedMatrix<double>::create(smallIntegerMatrix(40, 40, 11), 2, 1);
+    const auto tRhs = *BandedMatrix<double>::create(smallIntegerMatrix(40, 40, 12), 0, 3);
+    const auto tDenseLhs = tLhs.toMatrix();
+    const auto tDenseRhs = tRhs.toMatrix();
+
+    const auto tX = randomVector(40, 13);
+    EXPECT_TRUE(denseProduct(tDenseLhs, tX).getData() == (tLhs * tX).getData());
+
+    const auto tB = smallIntegerMatrix(40, 6, 14);
+    EXPECT_TRUE(tDenseLhs * tB == tLhs * tB);
+
+    const auto tProduct = tLhs * tRhs;
+    EXPECT_EQ(2UL, tProduct.getLower());
+    EXPECT_EQ(4UL, tProduct.getUpper());
+    EXPECT_TRUE(tDenseLhs * tDenseRhs == tProduct.toMatrix());
+
+    EXPECT_TRUE(Matrix<double>{tDenseLhs + tDenseRhs} == (tLhs + tRhs).toMatrix());
+    EXPECT_TRUE(Matrix<double>{tDenseLhs - tDenseLhs * 2.0} == (tLhs - tLhs * 2.0).toMatrix());
+}
+
+TEST(BandedMatrix, parallel_products)
+{
+    Parallel::ThreadPool tPool{4};
+    Parallel::setDefaultExecutor(&tPool);
+
+    // Tridiagonal operator, large enough to run on the pool.
+    const std::size_t tSize{20000};
+    auto tBanded = BandedMatrix<double>::create(tSize, 1, 1);
+    for (std::size_t i = 0; i < tSize; i++)
+    {
+        tBanded.at(i, i) = -2.0;
+        if (i > 0)
+            tBanded.at(i, i - 1) = 1.0;
+        if (i + 1 < tSize)
+            tBanded.at(i, i + 1) = 1.0;
+    }
+    auto tX = Vector<double>::create(Row{tSize});
+    for (std::size_t i = 0; i < tSize; i++)
+        tX[i] = static_cast<double>(i * i);
+
+    // Second differences of i^2 are 2 away from the boundaries.
+    const auto tY = tBanded * tX;
+    for (std::size_t i = 1; i + 1 < tSize; i += 997)
+        EXPECT_DOUBLE_EQ(2.0, tY[i]);
+
+    const auto tB = smallIntegerMatrix(tSize, 8, 15);
+    const auto tProduct = tBanded * tB;
+    for (std::size_t i = 1; i + 1 < tSize; i += 1999)
+        for (std::size_t c = 0; c < 8; c++)
+            EXPECT_DOUBLE_EQ(tB(i - 1, c) - 2.0 * tB(i, c) + tB(i + 1, c), tProduct(i, c));
+
+    Parallel::setDefaultExecutor(nullptr);
+}
@@ -0,0 +1,177 @@
+#include "../src/Parallel/threadPool.h"
+#include "../src/matrix.h"
+#include "testHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <initializer_list>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    struct CountingExecutor final : public Parallel::Executor
+    {
+        std::size_t m_Calls{0};
+        Parallel::ThreadPool m_Pool{3};
+
+        std::size_t concurrency() const noexcept override { return m_Pool.concurrency(); }
+        void parallelFor(std::size_t xCount, const std::function<void(std::size_t)> &xTask) override
+        {
+            m_Calls++;
+            m_Pool.parallelFor(xCount, xTask);
+        }
+    };
+} // namespace
+
+TEST(ThreadPoolTest, runs_every_task_once)
+{
+    Parallel::ThreadPool tPool{4};
+    EXPECT_EQ(4U, tPool.concurrency());
+
+    std::vector<std::atomic<int>> tHits(1000);
+    tPool.parallelFor(tHits.size(), [&](std::size_t i)
+                      { tHits[i]++; });
+
+    for (const auto &tHit : tHits)
+        EXPECT_EQ(1, tHit.load());
+}
+
+TEST(ThreadPoolTest, nested_parallel_for)
+{
+    Parallel::ThreadPool tPool{4};
+    std::atomic<std::size_t> tSum{0};
+
+    tPool.parallelFor(16, [&](std::size_t i)
+                      { tPool.parallelFor(16, [&](std::size_t j)
+                                          { tSum += i * 16 + j; }); });
+
+    EXPECT_EQ(255U * 256U / 2U, tSum.load());
+}
+
+TEST(ThreadPoolTest, nested_waits_only_for_own_batch)
+{
+    // Every outer task checks that its nested batch ran completely before parallelFor
+    // returned, even though the pool is busy with the other outer tasks.
+    Parallel::ThreadPool tPool{4};
+    std::atomic<std::size_t> tIncomplete{0};
+
+    tPool.parallelFor(64, [&](std::size_t)
+                      {
+                          std::vector<int> tDone(32, 0);
+                          tPool.parallelFor(tDone.size(), [&](std::size_t j)
+                                            { tDone[j] = 1; });
+                          for (const int tValue : tDone)
+                              if (tValue != 1)
+                                  tIncomplete++; });
+
+    EXPECT_EQ(0U, tIncomplete.load());
+}
+
+TEST(ThreadPoolTest, rethrows_first_exception)
+{
+    Parallel::ThreadPool tPool{4};
+    std::atomic<std::size_t> tRan{0};
+
+    EXPECT_THROW(tPool.parallelFor(100, [&](std::size_t i)
+                                   {
+                                       tRan++;
+                                       if (i % 10 == 3)
+                                           throw std::runtime_error{"task failed"}; }),
+                 std::runtime_error);
+    EXPECT_EQ(100U, tRan.load());
+
+    // The pool is still usable afterwards.
+    std::atomic<std::size_t> tSum{0};
+    tPool.parallelFor(100, [&](std::size_t i)
+                      { tSum += i; });
+    EXPECT_EQ(99U * 100U / 2U, tSum.load());
+}
+
+TEST(ThreadPoolTest, nested_exception_reaches_caller)
+{
+    Parallel::ThreadPool tPool{4};
+    std::atomic<std::size_t> tCaught{0};
+
+    EXPECT_THROW(tPool.parallelFor(8, [&](std::size_t i)
+                                   {
+                                       try
+                                       {
+                                           tPool.parallelFor(8, [&](std::size_t j)
+                                                             {
+                                                                 if (j == 5)
+                                                                     throw std::logic_error{"inner"}; });
+                                       }
+                                       catch (const std::logic_error &)
+                                       {
+                                           tCaught++;
+                                       }
+                                       if (i == 2)
+                                           throw std::runtime_error{"outer"}; }),
+                 std::runtime_error);
+    EXPECT_EQ(8U, tCaught.load());
+}
+
+TEST(ThreadPoolTest, every_task_runs_after_a_throw)
+{
+    Parallel::ThreadPool tPool{4};
+    Parallel::ThreadPool tSingle{1};
+    Parallel::SequentialExecutor tSequential;
+
+    for (Parallel::Executor *tExecutor : std::initializer_list<Parallel::Executor *>{&tPool, &tSingle, &tSequential})
+    {
+        for (std::size_t tCount : {1UL, 2UL, 57UL})
+        {
+            std::atomic<std::size_t> tRan{0};
+            EXPECT_THROW(tExecutor->parallelFor(tCount, [&](std::size_t i)
+                                                {
+                                                    tRan++;
+                                                    if (i == 0 || i == tCount - 1)
+                                                        throw std::runtime_error{"task failed"}; }),
+                         std::runtime_error);
+            EXPECT_EQ(tCount, tRan.load());
+        }
+    }
+}
+
+TEST(ThreadPoolTest, single_thread_runs_inline)
+{
+    Parallel::ThreadPool tPool{1};
+    const auto tCaller = std::this_thread::get_id();
+
+    tPool.parallelFor(8, [&](std::size_t)
+                      { EXPECT_EQ(tCaller, std::this_thread::get_id()); });
+}
+
+TEST(ThreadPoolTest, multiply_on_custom_executor)
+{
+    const auto tLhs = randomMatrix(257, 311, 7);
+    const auto tRhs = randomMatrix(311, 199, 7);
+
+    Parallel::SequentialExecutor tSequential;
+    CountingExecutor tExecutor;
+
+    const auto tControl = multiply(tLhs, tRhs, tSequential);
+    const auto tResult = multiply(tLhs, tRhs, tExecutor);
+
+    EXPECT_EQ(1U, tExecutor.m_Calls);
+    ASSERT_EQ(tControl.getData().size(), tResult.getData().size());
+    for (std::size_t i = 0; i < tControl.getData().size(); i++)
+        EXPECT_DOUBLE_EQ(tControl.getData()[i], tResult.getData()[i]);
+}
+
+TEST(ThreadPoolTest, default_executor_override)
+{
+    CountingExecutor tExecutor;
+    Parallel::setDefaultExecutor(&tExecutor);
+
+    auto tLhs = randomMatrix(128, 128, 7);
+    const auto tRhs = randomMatrix(128, 128, 7);
+    const auto tResult = tLhs * tRhs;
+
+    Parallel::setDefaultExecutor(nullptr);
+
+    EXPECT_EQ(1U, tExecutor.m_Calls);
+    EXPECT_EQ(128U, tResult.getRows().get());
+}
@@ -332,4 +332,59 @@ TEST_F(VectorTest, cross_product)
     {
         EXPECT_DOUBLE_EQ(tVectorResult.at(i), tVectorToControl.at(i));
     }
-}
\ No newline at end of file
+}
+TEST_F(VectorTest, rvalue_operators_reuse_storage)
+{
+    auto tVector = Get();
+    randomize(tVector);
+    auto tOther = Get();
+    randomize(tOther);
+
+    auto tExpiring = tVector;
+    const auto *tStorage = &tExpiring.at(0);
+    auto tResult = std::move(tExpiring) + tOther;
+    EXPECT_EQ(tStorage, &tResult.at(0));
+
+    auto tExpiringRhs = tOther;
+    tStorage = &tExpiringRhs.at(0);
+    auto tDifference = tVector - std::move(tExpiringRhs);
+    EXPECT_EQ(tStorage, &tDifference.at(0));
+
+    auto tScaled = (tVector + tOther) * 2.0;
+
+    for (std::size_t i = 0; i < tVector.size(); i++)
+    {
+        EXPECT_DOUBLE_EQ(tVector.at(i) + tOther.at(i), tResult.at(i));
+        EXPECT_DOUBLE_EQ(tVector.at(i) - tOther.at(i), tDifference.at(i));
+        EXPECT_DOUBLE_EQ((tVector.at(i) + tOther.at(i)) * 2.0, tScaled.at(i));
+    }
+}
+
+TEST_F(VectorTest, compound_size_mismatch_is_noop)
+{
+    auto tVector = Get();
+    randomize(tVector);
+    const auto tControl = tVector;
+
+    tVector += Vector<double>::create(Row{3});
+    tVector -= Vector<double>::create(Row{3});
+
+    EXPECT_TRUE(tVector == tControl);
+}
+
+TEST_F(VectorTest, binary_size_mismatch)
+{
+    auto tVector = Get();
+    randomize(tVector);
+    const auto tZeros = Vector<double>::create(Row{tVector.size()});
+    const auto tShort = Vector<double>::create(std::vector<double>{1.0, 2.0, 3.0});
+
+    // + returns zeros of the left size, - returns the left operand, whatever the overload.
+    EXPECT_TRUE(tVector + tShort == tZeros);
+    EXPECT_TRUE(Vector<double>{tVector} + tShort == tZeros);
+    EXPECT_TRUE(Vector<double>{tVector} + Vector<double>{tShort} == tZeros);
+    EXPECT_TRUE(tVector + Vector<double>{tShort} == tZeros);
+    EXPECT_TRUE(tVector - tShort == tVector);
+    EXPECT_TRUE(Vector<double>{tVector} - tShort == tVector);
+    EXPECT_TRUE(tVector - Vector<double>{tShort} == tVector);
+}
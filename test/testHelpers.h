@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../src/matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <type_traits>
+
+// Reproducible test inputs: the same seed always gives the same matrix. Float and double
+// matrices draw in their own precision, other element types (Half, integers) draw doubles
+// unless the bounds say otherwise.
+template <typename T = double, typename Real = std::conditional_t<std::is_floating_point_v<T>, T, double>>
+Matrix<T> randomMatrix(std::size_t xRows, std::size_t xCols, unsigned xSeed, Real xLow = Real(-1), Real xHigh = Real(1))
+{
+    std::mt19937 rng(xSeed);
+    std::uniform_real_distribution<Real> dist(xLow, xHigh);
+
+    auto tResult = Matrix<T>::create(Row{xRows}, Column{xCols});
+    for (std::size_t i = 0; i < xRows; i++)
+        for (std::size_t j = 0; j < xCols; j++)
+            tResult(i, j) = static_cast<T>(dist(rng));
+    return tResult;
+}
+
+// Whole numbers in [xLow, xHigh], for products that have to be exact.
+template <typename T = double>
+Matrix<T> randomIntegerMatrix(std::size_t xRows, std::size_t xCols, unsigned xSeed, int xLow, int xHigh)
+{
+    std::mt19937 rng(xSeed);
+    std::uniform_int_distribution<int> dist(xLow, xHigh);
+
+    auto tResult = Matrix<T>::create(Row{xRows}, Column{xCols});
+    for (std::size_t i = 0; i < xRows; i++)
+        for (std::size_t j = 0; j < xCols; j++)
+            tResult(i, j) = static_cast<T>(dist(rng));
+    return tResult;
+}
+
+// Largest absolute elementwise difference of two matrices of the same shape.
+inline double maxDifference(const Matrix<double> &xLhs, const Matrix<double> &xRhs)
+{
+    double tResult{0.0};
+    for (std::size_t i = 0; i < xLhs.getRows().get(); i++)
+        for (std::size_t j = 0; j < xLhs.getCols().get(); j++)
+            tResult = std::max(tResult, std::abs(xLhs(i, j) - xRhs(i, j)));
+    return tResult;
+}
+
+// How far Q^T Q is from the identity.
+inline double orthogonalityError(const Matrix<double> &xQ)
+{
+    const auto tGram = xQ.transposed() * xQ;
+    auto tIdentity = Matrix<double>::create(tGram.getRows(), tGram.getCols());
+    for (std::size_t i = 0; i < tGram.getRows().get(); i++)
+        tIdentity(i, i) = 1.0;
+    return maxDifference(tGram, tIdentity);
+}